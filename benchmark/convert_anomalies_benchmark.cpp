@@ -8,16 +8,23 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iostream>
 #include <random>
+#include <vector>
 
 #include <fmt/core.h>
 
+#include <kep3/core_astro/constants.hpp>
 #include <kep3/core_astro/convert_anomalies.hpp>
+#include <kep3/detail/kepler_simd.hpp>
 
 using kep3::e2m;
+using kep3::h2n;
 using kep3::m2e;
+using kep3::n2h;
 using std::chrono::duration_cast;
 using std::chrono::high_resolution_clock;
 using std::chrono::microseconds;
@@ -97,12 +104,131 @@ void perform_test_accuracy(double min_ecc, double max_ecc, unsigned N)
     fmt::print("{:.3e} avg, {:.3e} min, {:.3e} max\n", avg, *min_it, *max_it);
 }
 
+void perform_test_speed_simd(double min_ecc, double max_ecc, unsigned N)
+{
+    //
+    // Engines
+    //
+    // NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp)
+    std::mt19937 rng_engine(122012203u);
+    //
+    // Distributions
+    //
+    std::uniform_real_distribution<double> ecc_d(min_ecc, max_ecc);
+    std::uniform_real_distribution<double> M_d(-1e8, 1e8);
+
+    // We generate the random dataset
+    std::vector<double> eccenricities(N);
+    std::vector<double> mean_anomalies(N);
+    std::vector<double> E_boost(N), M_cropped(N), E_simd(N);
+
+    for (auto i = 0u; i < N; ++i) {
+        mean_anomalies[i] = M_d(rng_engine);
+        eccenricities[i] = ecc_d(rng_engine);
+    }
+
+    // We log progress
+    fmt::print("{:.2f} min_ecc, {:.2f} max_ecc, on {} data points: ", min_ecc, max_ecc, N);
+
+    auto start = high_resolution_clock::now();
+    for (auto i = 0u; i < N; ++i) {
+        E_boost[i] = m2e(mean_anomalies[i], eccenricities[i]);
+    }
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    fmt::print("{:.3f}s (Boost), ", (static_cast<double>(duration.count()) / 1e6));
+
+    // The same reduction and initial guess as in m2e, then the vectorized solver.
+    start = high_resolution_clock::now();
+    for (auto i = 0u; i < N; ++i) {
+        const double ecc = eccenricities[i];
+        const double sinM = std::sin(mean_anomalies[i]), cosM = std::cos(mean_anomalies[i]);
+        M_cropped[i] = std::atan2(sinM, cosM);
+        E_simd[i] = M_cropped[i] + ecc * sinM + ecc * ecc * sinM * cosM
+                    + ecc * ecc * ecc * sinM * (1.5 * cosM * cosM - 0.5);
+    }
+    const double zero = 0.;
+    kep3::detail::kepDE_simd(N, M_cropped.data(), &zero, 0u, eccenricities.data(), 1u, kep3::pi, E_simd.data());
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    double max_err = 0.;
+    for (auto i = 0u; i < N; ++i) {
+        max_err = std::max(max_err, std::abs(E_boost[i] - E_simd[i]));
+    }
+    fmt::print("{:.3f}s (SIMD), {:.3e} max difference, ", (static_cast<double>(duration.count()) / 1e6), max_err);
+
+    // The array interface, which also runs in parallel.
+    start = high_resolution_clock::now();
+    m2e(mean_anomalies, eccenricities, E_simd);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    fmt::print("{:.3f}s (array)\n", (static_cast<double>(duration.count()) / 1e6));
+}
+
+// The hyperbolic regime: n2h on each point against the array interface, for mean anomalies with magnitude
+// up to max_N (the Newton iterations from a fixed initial guess converge slowly for large |N|).
+void perform_test_speed_simd_hyperbolic(double min_ecc, double max_ecc, double max_N, unsigned N)
+{
+    //
+    // Engines
+    //
+    // NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp)
+    std::mt19937 rng_engine(122012203u);
+    //
+    // Distributions
+    //
+    std::uniform_real_distribution<double> ecc_d(min_ecc, max_ecc);
+    std::uniform_real_distribution<double> N_d(-max_N, max_N);
+
+    // We generate the random dataset
+    std::vector<double> eccenricities(N);
+    std::vector<double> mean_anomalies(N);
+    std::vector<double> H_scalar(N), H_array(N);
+
+    for (auto i = 0u; i < N; ++i) {
+        mean_anomalies[i] = N_d(rng_engine);
+        eccenricities[i] = ecc_d(rng_engine);
+    }
+
+    // We log progress
+    fmt::print("{:.2f} min_ecc, {:.2f} max_ecc, |N| < {:.0e}, on {} data points: ", min_ecc, max_ecc, max_N, N);
+
+    auto start = high_resolution_clock::now();
+    for (auto i = 0u; i < N; ++i) {
+        H_scalar[i] = n2h(mean_anomalies[i], eccenricities[i]);
+    }
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    fmt::print("{:.3f}s (scalar), ", (static_cast<double>(duration.count()) / 1e6));
+
+    start = high_resolution_clock::now();
+    n2h(mean_anomalies, eccenricities, H_array);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    double max_err = 0.;
+    for (auto i = 0u; i < N; ++i) {
+        const double res = h2n(H_array[i], eccenricities[i]);
+        max_err = std::max(max_err, std::abs(res - mean_anomalies[i]) / std::max(1., std::abs(mean_anomalies[i])));
+    }
+    fmt::print("{:.3f}s (array), {:.3e} max relative error on N\n", (static_cast<double>(duration.count()) / 1e6),
+               max_err);
+}
+
 int main()
 {
     fmt::print("\nComputes speed at different eccentricity ranges:\n");
     perform_test_speed(0, 0.5, 1000000);
     perform_test_speed(0.5, 0.9, 1000000);
     perform_test_speed(0.9, 0.99, 1000000);
+    fmt::print("\nComputes speed of the vectorized solver against the Boost one:\n");
+    perform_test_speed_simd(0, 0.5, 1000000);
+    perform_test_speed_simd(0.5, 0.9, 1000000);
+    perform_test_speed_simd(0.9, 0.99, 1000000);
+    fmt::print("\nComputes speed of the hyperbolic solvers at different mean anomaly ranges:\n");
+    perform_test_speed_simd_hyperbolic(1.01, 5., 1., 1000000);
+    perform_test_speed_simd_hyperbolic(1.01, 5., 100., 1000000);
+    perform_test_speed_simd_hyperbolic(1.01, 5., 1000., 1000000);
+    perform_test_speed_simd_hyperbolic(1.01, 5., 1e6, 1000000);
     fmt::print("\nComputes error at different eccentricity ranges:\n");
     perform_test_accuracy(0, 0.5, 100000);
     perform_test_accuracy(0.5, 0.9, 100000);
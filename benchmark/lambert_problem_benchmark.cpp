@@ -25,7 +25,10 @@
 
 #include <array>
 #include <chrono>
+#include <memory>
 #include <random>
+#include <span>
+#include <vector>
 
 #include <fmt/core.h>
 #include <fmt/ranges.h>
@@ -95,4 +98,90 @@ int main()
                (static_cast<double>(duration.count()) / 1e6));
     fmt::print("Projected number of solutions per second: {}\n",
                static_cast<double>(count) / ((static_cast<double>(duration.count()) / 1e6)));
-}
\ No newline at end of file
+
+    count = 0; // reset counter
+    double check = 0.;
+    start = high_resolution_clock::now();
+    for (auto i = 0u; i < trials; ++i) {
+        // 4 - Solve the same problems with the allocation free single rev fast path
+        const auto [v1, v2, it] = kep3::lambert_0rev(r1s[i], r2s[i], tof[i], mu[i], cw[i]);
+        check += v1[0];
+        count += 1u;
+    }
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    fmt::print("\nLambert 0rev fast path:\n{} solutions computed in {:.3f}s (checksum {:.3f})\n", count,
+               (static_cast<double>(duration.count()) / 1e6), check);
+    fmt::print("Projected number of solutions per second: {}\n",
+               static_cast<double>(count) / ((static_cast<double>(duration.count()) / 1e6)));
+
+    // We now flatten the same problems in the structure of arrays form used by kep3::lambert_batch.
+    std::vector<double> r1s_flat(3u * trials), r2s_flat(3u * trials);
+    // NOTE: std::vector<bool> is not contiguous, hence we cannot use it to build a span.
+    auto cw_flat = std::make_unique<bool[]>(trials);
+    for (auto i = 0u; i < trials; ++i) {
+        for (auto j = 0u; j < 3u; ++j) {
+            r1s_flat[3u * i + j] = r1s[i][j];
+            r2s_flat[3u * i + j] = r2s[i][j];
+        }
+        cw_flat[i] = cw[i];
+    }
+    const std::span<const bool> cw_span(cw_flat.get(), trials);
+
+    // The output buffers are allocated once, outside of the timed region.
+    std::vector<double> v1s(3u * (2u * revs_max + 1u) * trials), v2s(3u * (2u * revs_max + 1u) * trials);
+    std::vector<unsigned> iters((2u * revs_max + 1u) * trials);
+
+    start = high_resolution_clock::now();
+    kep3::lambert_batch(r1s_flat, r2s_flat, tof, mu, cw_span, v1s, v2s, iters, revs_max);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    // Slots with zero iterations correspond to non existing solutions.
+    count = 0;
+    for (auto it : iters) {
+        count += (it > 0u) ? 1u : 0u;
+    }
+    fmt::print("\nLambert batch:\n{} solutions computed in {:.3f}s\n", count,
+               (static_cast<double>(duration.count()) / 1e6));
+    fmt::print("Projected number of solutions per second: {}\n",
+               static_cast<double>(count) / ((static_cast<double>(duration.count()) / 1e6)));
+
+    // With no multiple revolutions the batch solver uses the vectorized kernel.
+    start = high_resolution_clock::now();
+    kep3::lambert_batch(r1s_flat, r2s_flat, tof, mu, cw_span, std::span<double>(v1s.data(), 3u * trials),
+                        std::span<double>(v2s.data(), 3u * trials), std::span<unsigned>(iters.data(), trials), 0u);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    fmt::print("\nLambert batch (0 revs only, vectorized):\n{} solutions computed in {:.3f}s\n", trials,
+               (static_cast<double>(duration.count()) / 1e6));
+    fmt::print("Projected number of solutions per second: {}\n",
+               static_cast<double>(trials) / ((static_cast<double>(duration.count()) / 1e6)));
+
+    // Finally we sweep the time of flight along a line for a fixed geometry, comparing cold solves
+    // with solves warm started from the x of the previous point.
+    const unsigned n_sweep = 50000u;
+    const unsigned revs_sweep = 5u;
+    const std::array<double, 3> r0_sweep = {1., 0.1, 0.};
+    const std::array<double, 3> r1_sweep = {-0.2, 1.1, 0.1};
+    for (auto warm : {false, true}) {
+        unsigned total_iters = 0u;
+        kep3::lambert_problem prev(r0_sweep, r1_sweep, 2., 1., false, revs_sweep);
+        start = high_resolution_clock::now();
+        for (auto i = 0u; i < n_sweep; ++i) {
+            const double tof_sweep = 2. + 48. * i / n_sweep;
+            if (warm) {
+                prev = kep3::lambert_problem(r0_sweep, r1_sweep, tof_sweep, 1., false, revs_sweep, prev.get_x());
+            } else {
+                prev = kep3::lambert_problem(r0_sweep, r1_sweep, tof_sweep, 1., false, revs_sweep);
+            }
+            for (auto it : prev.get_iters()) {
+                total_iters += it;
+            }
+        }
+        stop = high_resolution_clock::now();
+        duration = duration_cast<microseconds>(stop - start);
+        fmt::print("\nLambert tof sweep ({}):\n{} problems solved in {:.3f}s, {} total iterations\n",
+                   warm ? "warm start" : "cold start", n_sweep, (static_cast<double>(duration.count()) / 1e6),
+                   total_iters);
+    }
+}
@@ -8,9 +8,16 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdlib>
 #include <iostream>
+#include <new>
 #include <random>
+#include <tuple>
+#include <vector>
 
 #include <fmt/core.h>
 #include <fmt/ranges.h>
@@ -33,6 +40,79 @@
 using std::chrono::duration_cast;
 using std::chrono::high_resolution_clock;
 using std::chrono::microseconds;
+using std::chrono::nanoseconds;
+
+// We count the heap allocations by replacing the global operator new.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::size_t> n_allocations{0u};
+
+void *operator new(std::size_t size)
+{
+    ++n_allocations;
+    // NOLINTNEXTLINE(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+    if (void *ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+    std::free(ptr);
+}
+
+// Times compute_mc_grad, allocating the results at each call or reusing a workspace, and counts the allocations.
+void perform_gradient_benchmark(unsigned N, unsigned nseg)
+{
+    // NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp)
+    std::mt19937 rng_engine(122012203u);
+    std::uniform_real_distribution<double> throttle_random(-0.5, 0.5);
+    std::vector<double> throttles(nseg * 3u);
+    for (auto &t : throttles) {
+        t = throttle_random(rng_engine);
+    }
+    const std::array<std::array<double, 3>, 2> rvs{{{1., 0.1, -0.1}, {0.2, 1., -0.2}}};
+    const std::array<std::array<double, 3>, 2> rvf{{{1.2, -0.1, 0.1}, {-0.2, 1.023, -0.44}}};
+    const kep3::leg::sims_flanagan sf{rvs, 1., throttles, rvf, 0.9, 2.3, 0.05, 2., 1., 0.5};
+
+    double ns_tuple = 0., ns_ws = 0.;
+    std::size_t allocs_tuple = 0u, allocs_ws = 0u;
+    {
+        const auto allocs = n_allocations.load();
+        auto start = high_resolution_clock::now();
+        for (decltype(N) i = 0u; i < N; ++i) {
+            auto grads = sf.compute_mc_grad();
+            std::get<2>(grads)[0] += 1.;
+        }
+        auto stop = high_resolution_clock::now();
+        ns_tuple = static_cast<double>(duration_cast<nanoseconds>(stop - start).count());
+        allocs_tuple = n_allocations.load() - allocs;
+    }
+    {
+        kep3::leg::sims_flanagan::workspace ws(nseg);
+        std::array<double, 49> grad_rvms{}, grad_rvmf{};
+        std::vector<double> grad(7u * (nseg * 3u + 1u));
+        const auto allocs = n_allocations.load();
+        auto start = high_resolution_clock::now();
+        for (decltype(N) i = 0u; i < N; ++i) {
+            sf.compute_mc_grad(ws, grad_rvms, grad_rvmf, grad);
+        }
+        auto stop = high_resolution_clock::now();
+        ns_ws = static_cast<double>(duration_cast<nanoseconds>(stop - start).count());
+        allocs_ws = n_allocations.load() - allocs;
+    }
+    fmt::print("{} nseg - ns per segment: {:.1f} (allocating), {:.1f} (workspace) - allocations per call: {} "
+               "(allocating), {} (workspace)\n",
+               nseg, ns_tuple / N / nseg, ns_ws / N / nseg, static_cast<double>(allocs_tuple) / N,
+               static_cast<double>(allocs_ws) / N);
+}
 
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
 void perform_convergence_benchmark(unsigned N, unsigned nseg)
@@ -210,6 +290,12 @@ void perform_speed_benchmark(unsigned N, unsigned nseg, unsigned pop_size)
 
 int main()
 {
+    fmt::print("\nComputes the mismatch constraints gradients:\n");
+    perform_gradient_benchmark(1000, 5);
+    perform_gradient_benchmark(1000, 20);
+    perform_gradient_benchmark(1000, 100);
+    perform_gradient_benchmark(100, 300);
+
     fmt::print("\nComputes the same analytical and numerical gradients and tests for speed:\n");
     perform_speed_benchmark(100, 5, 10);
     perform_speed_benchmark(100, 10, 10);
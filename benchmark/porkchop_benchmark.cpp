@@ -0,0 +1,68 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include <kep3/core_astro/constants.hpp>
+#include <kep3/epoch.hpp>
+#include <kep3/planet.hpp>
+#include <kep3/porkchop.hpp>
+#include <kep3/udpla/keplerian.hpp>
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::microseconds;
+
+// In this benchmark we test the speed of the porkchop grid engine on an Earth-Mars
+// launch window, reporting the grid cells computed per second and per core.
+
+void perform_test_speed(unsigned n_dep, unsigned n_arr, unsigned multi_revs)
+{
+    const kep3::epoch ref_epoch{0., kep3::epoch::julian_type::MJD2000};
+    const std::array<double, 6> par_earth = {1. * kep3::AU, 0.0167, 0.0001, 0., 1.99, 6.24};
+    const std::array<double, 6> par_mars = {1.5237 * kep3::AU, 0.0934, 0.0323, 0.865, 5.0, 0.338};
+    const kep3::planet earth{kep3::udpla::keplerian{ref_epoch, par_earth, kep3::MU_SUN}};
+    const kep3::planet mars{kep3::udpla::keplerian{ref_epoch, par_mars, kep3::MU_SUN}};
+
+    // Departures over two years, arrivals between 100 and 1100 days after the first departure.
+    std::vector<double> t0s(n_dep), t1s(n_arr);
+    for (auto i = 0u; i < n_dep; ++i) {
+        t0s[i] = 730. * i / n_dep;
+    }
+    for (auto i = 0u; i < n_arr; ++i) {
+        t1s[i] = 100. + 1000. * i / n_arr;
+    }
+
+    auto start = high_resolution_clock::now();
+    const auto pc = kep3::porkchop(earth, mars, t0s, t1s, multi_revs);
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+
+    const auto cells = static_cast<double>(pc.n_dep * pc.n_arr);
+    const auto cores = static_cast<double>(std::max(1u, std::thread::hardware_concurrency()));
+    const auto seconds = static_cast<double>(duration.count()) / 1e6;
+    fmt::print("{}x{} grid, multi_revs={}: {:.3f}s, {:.0f} cells/s, {:.0f} cells/s/core ({} cores)\n", n_dep, n_arr,
+               multi_revs, seconds, cells / seconds, cells / seconds / cores, cores);
+}
+
+int main()
+{
+    fmt::print("\nPorkchop grid engine:\n");
+    perform_test_speed(100u, 100u, 0u);
+    perform_test_speed(500u, 500u, 0u);
+    perform_test_speed(1000u, 1000u, 0u);
+    perform_test_speed(500u, 500u, 2u);
+}
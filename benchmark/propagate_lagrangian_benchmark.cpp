@@ -8,10 +8,13 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <functional>
 
 #include <random>
+#include <vector>
 
 #include <fmt/core.h>
 #include <fmt/ranges.h>
@@ -133,6 +136,104 @@ void perform_test_accuracy(
     fmt::print("{:.3e} avg, {:.3e} min, {:.3e} max\n", avg, *min_it, *max_it);
 }
 
+// NOTE: a large max_tof gives fast hyperbolas, i.e. large hyperbolic mean anomalies.
+void perform_test_speed_batch(double min_ecc, double max_ecc, unsigned N, bool stm, double max_tof = 100.)
+{
+    //
+    // Engines
+    //
+    // NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp)
+    std::mt19937 rng_engine(122012203u);
+    //
+    // Distributions
+    //
+    std::uniform_real_distribution<double> sma_d(0.5, 20.);
+    std::uniform_real_distribution<double> ecc_d(min_ecc, max_ecc);
+    std::uniform_real_distribution<double> incl_d(0., kep3::pi);
+    std::uniform_real_distribution<double> Omega_d(0, 2 * kep3::pi);
+    std::uniform_real_distribution<double> omega_d(0., 2 * kep3::pi);
+    std::uniform_real_distribution<double> f_d(0, 2 * kep3::pi);
+    std::uniform_real_distribution<double> tof_d(10., max_tof);
+
+    // We generate the random dataset, both as a vector of states and in the batched layout.
+    std::vector<std::array<std::array<double, 3>, 2>> pos_vels(N);
+    std::vector<double> rs(3u * N), vs(3u * N), tofs(N);
+    for (auto i = 0u; i < N; ++i) {
+        auto ecc = ecc_d(rng_engine);
+        auto sma = sma_d(rng_engine);
+        ecc > 1. ? sma = -sma : sma;
+        double f = kep3::pi;
+        while (std::cos(f) < -1. / ecc && sma < 0.) {
+            f = f_d(rng_engine);
+        }
+        pos_vels[i] = kep3::par2ic({sma, ecc, incl_d(rng_engine), Omega_d(rng_engine), omega_d(rng_engine), f}, 1.);
+        tofs[i] = tof_d(rng_engine);
+        for (auto j = 0u; j < 3u; ++j) {
+            rs[3u * i + j] = pos_vels[i][0][j];
+            vs[3u * i + j] = pos_vels[i][1][j];
+        }
+    }
+    std::vector<double> rfs(3u * N), vfs(3u * N), stms(stm ? 36u * N : 0u);
+    const std::vector<double> mus = {1.};
+
+    // We log progress
+    fmt::print("{:.2f} min_ecc, {:.2f} max_ecc, tof < {:.0e}, on {} data points, stm={}: ", min_ecc, max_ecc, max_tof,
+               N, stm);
+
+    auto start = high_resolution_clock::now();
+    for (auto i = 0u; i < N; ++i) {
+        auto res = kep3::propagate_lagrangian(pos_vels[i], tofs[i], 1., stm);
+        for (auto j = 0u; j < 3u; ++j) {
+            rfs[3u * i + j] = res.first[0][j];
+            vfs[3u * i + j] = res.first[1][j];
+        }
+        if (stm) {
+            std::copy(res.second->begin(), res.second->end(), stms.begin() + 36u * i);
+        }
+    }
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    fmt::print("{:.3f}s (loop), ", (static_cast<double>(duration.count()) / 1e6));
+
+    start = high_resolution_clock::now();
+    kep3::propagate_lagrangian_batch(rs, vs, tofs, mus, rfs, vfs, stms);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    fmt::print("{:.3f}s (batch)\n", (static_cast<double>(duration.count()) / 1e6));
+}
+
+void perform_test_speed_grid(unsigned N, bool stm)
+{
+    // An elliptical orbit sampled over 100 revolutions.
+    const std::array<std::array<double, 3>, 2> pos_vel = {{{1.223, 0.3123, -0.432}, {0.06345, 0.43234, -0.874634}}};
+    std::vector<double> time_grid(N);
+    for (auto i = 0u; i < N; ++i) {
+        time_grid[i] = 1000. * i / N;
+    }
+    std::vector<double> pos_vels(6u * N), stms(stm ? 36u * N : 0u);
+
+    // We log progress
+    fmt::print("{} grid points, stm={}: ", N, stm);
+
+    auto start = high_resolution_clock::now();
+    auto res = kep3::propagate_lagrangian_grid(pos_vel, time_grid, 1., stm);
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    fmt::print("{:.3f}s (from t0), ", (static_cast<double>(duration.count()) / 1e6));
+
+    start = high_resolution_clock::now();
+    kep3::propagate_lagrangian_grid(pos_vel, time_grid, 1., pos_vels, stms, true, false);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    fmt::print("{:.3f}s (streaming), ", (static_cast<double>(duration.count()) / 1e6));
+
+    start = high_resolution_clock::now();
+    kep3::propagate_lagrangian_grid(pos_vel, time_grid, 1., pos_vels, stms, true, true);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    fmt::print("{:.3f}s (streaming, parallel)\n", (static_cast<double>(duration.count()) / 1e6));
+}
+
 int main()
 {
     fmt::print("\nComputes speed at different eccentricity ranges:\n");
@@ -141,6 +242,17 @@ int main()
     perform_test_speed(0.9, 0.99, 1000000, &kep3::propagate_lagrangian);
     perform_test_speed(1.1, 10., 1000000, &kep3::propagate_lagrangian);
 
+    fmt::print("\nComputes speed of the batched interface against a loop over single calls:\n");
+    perform_test_speed_batch(0, 0.5, 1000000, false);
+    perform_test_speed_batch(0.9, 0.99, 1000000, false);
+    perform_test_speed_batch(1.1, 10., 1000000, false);
+    perform_test_speed_batch(1.1, 10., 1000000, false, 1e4);
+    perform_test_speed_batch(0, 0.5, 1000000, true);
+
+    fmt::print("\nComputes speed of the streaming grid propagation:\n");
+    perform_test_speed_grid(1000000, false);
+    perform_test_speed_grid(100000, true);
+
     fmt::print("\nComputes error at different eccentricity ranges:\n");
     perform_test_accuracy(0, 0.5, 100000, &kep3::propagate_lagrangian);
     perform_test_accuracy(0.5, 0.9, 100000, &kep3::propagate_lagrangian);
@@ -0,0 +1,69 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include <kep3/planet.hpp>
+#include <kep3/udpla/vsop2013.hpp>
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::microseconds;
+
+// In this benchmark we compare the speed of the VSOP2013 ephemerides computed one epoch
+// at a time (eph) and with the batch-mode compiled function (eph_v).
+
+void perform_test_speed(const std::string &name, double thresh, unsigned N)
+{
+    const kep3::planet pla{kep3::udpla::vsop2013{name, thresh}};
+
+    // Epochs spanning a century.
+    std::vector<double> mjd2000s(N);
+    for (auto i = 0u; i < N; ++i) {
+        mjd2000s[i] = -18262. + 36525. / N * i;
+    }
+
+    fmt::print("{}, thresh={}, on {} epochs:\n", name, thresh, N);
+
+    auto start = high_resolution_clock::now();
+    for (auto i = 0u; i < N; ++i) {
+        [[maybe_unused]] auto pos_vel = pla.eph(mjd2000s[i]);
+    }
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    fmt::print("eph (loop): {:.3f}s\n", (static_cast<double>(duration.count()) / 1e6));
+
+    // A size below the threshold of the multithreaded path, repeated to cover N epochs.
+    const auto n_small = 10000u;
+    const std::vector<double> small(mjd2000s.begin(), mjd2000s.begin() + n_small);
+    start = high_resolution_clock::now();
+    for (auto i = 0u; i < N / n_small; ++i) {
+        [[maybe_unused]] auto pos_vels = pla.eph_v(small);
+    }
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    fmt::print("eph_v (batches of {}): {:.3f}s\n", n_small, (static_cast<double>(duration.count()) / 1e6));
+
+    start = high_resolution_clock::now();
+    [[maybe_unused]] auto pos_vels = pla.eph_v(mjd2000s);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    fmt::print("eph_v (multithreaded): {:.3f}s\n\n", (static_cast<double>(duration.count()) / 1e6));
+}
+
+int main()
+{
+    perform_test_speed("earth_moon", 1e-5, 1000000u);
+    perform_test_speed("jupiter", 1e-8, 1000000u);
+}
@@ -13,6 +13,7 @@
 
 #include <cmath>
 #include <limits>
+#include <span>
 #include <stdexcept>
 
 #include <boost/math/constants/constants.hpp>
@@ -20,6 +21,7 @@
 
 #include <kep3/core_astro/constants.hpp>
 #include <kep3/core_astro/kepler_equations.hpp>
+#include <kep3/detail/visibility.hpp>
 
 namespace kep3
 {
@@ -190,5 +192,24 @@ inline double f2n(double f, double ecc)
     return h2n(f2h(f, ecc), ecc);
 }
 
+// Array versions of the conversions above. The first argument holds the N anomalies to convert, eccs the
+// eccentricities (size N, or size 1 to share one value across all anomalies) and out the N results (it may
+// coincide with the first argument). Kepler's equation is solved by vectorized kernels (m2e, m2f, n2h, n2f)
+// and large arrays are processed in parallel. They throw std::invalid_argument if the sizes are inconsistent.
+kep3_DLL_PUBLIC void m2e(std::span<const double> Ms, std::span<const double> eccs, std::span<double> out);
+kep3_DLL_PUBLIC void e2m(std::span<const double> Es, std::span<const double> eccs, std::span<double> out);
+kep3_DLL_PUBLIC void e2f(std::span<const double> Es, std::span<const double> eccs, std::span<double> out);
+kep3_DLL_PUBLIC void f2e(std::span<const double> fs, std::span<const double> eccs, std::span<double> out);
+kep3_DLL_PUBLIC void m2f(std::span<const double> Ms, std::span<const double> eccs, std::span<double> out);
+kep3_DLL_PUBLIC void f2m(std::span<const double> fs, std::span<const double> eccs, std::span<double> out);
+kep3_DLL_PUBLIC void zeta2f(std::span<const double> zetas, std::span<const double> eccs, std::span<double> out);
+kep3_DLL_PUBLIC void f2zeta(std::span<const double> fs, std::span<const double> eccs, std::span<double> out);
+kep3_DLL_PUBLIC void n2h(std::span<const double> Ns, std::span<const double> eccs, std::span<double> out);
+kep3_DLL_PUBLIC void h2n(std::span<const double> Hs, std::span<const double> eccs, std::span<double> out);
+kep3_DLL_PUBLIC void h2f(std::span<const double> Hs, std::span<const double> eccs, std::span<double> out);
+kep3_DLL_PUBLIC void f2h(std::span<const double> fs, std::span<const double> eccs, std::span<double> out);
+kep3_DLL_PUBLIC void n2f(std::span<const double> Ns, std::span<const double> eccs, std::span<double> out);
+kep3_DLL_PUBLIC void f2n(std::span<const double> fs, std::span<const double> eccs, std::span<double> out);
+
 } // namespace kep3
 #endif // kep3_TOOLBOX_M2E_H
@@ -13,6 +13,7 @@
 
 #include <array>
 #include <optional>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -33,10 +34,53 @@ namespace kep3
 kep3_DLL_PUBLIC std::pair<std::array<std::array<double, 3>, 2>, std::optional<std::array<double, 36>>>
 propagate_lagrangian(const std::array<std::array<double, 3>, 2> &pos_vel, double tof, double mu, bool stm = false);
 
+/// Batched Lagrangian propagation
+/**
+ * Propagates N Cartesian states, each by its own time of flight, using the same algorithm as
+ * kep3::propagate_lagrangian but without any per-state allocation. Inputs and outputs are given
+ * in a structure of arrays form and the output buffers are owned by the caller:
+ *
+ * - rs, vs: the N initial positions and velocities, flattened as [x0, y0, z0, x1, y1, z1, ...] (size 3N).
+ * - tofs: the N times of flight.
+ * - mus: the gravity parameters (size N, or size 1 to share one value across all states).
+ * - rfs, vfs: the N final positions and velocities (size 3N). They may coincide with rs, vs.
+ * - stms: the N state transition matrices, each row-major and stored contiguously (size 36N).
+ *   Can be empty if not needed, in which case the matrices are not computed.
+ *
+ * @throws std::invalid_argument if the buffer sizes are inconsistent.
+ * @throws std::domain_error if Kepler's equation cannot be solved for some state (as in kep3::propagate_lagrangian).
+ */
+kep3_DLL_PUBLIC void propagate_lagrangian_batch(std::span<const double> rs, std::span<const double> vs,
+                                                std::span<const double> tofs, std::span<const double> mus,
+                                                std::span<double> rfs, std::span<double> vfs,
+                                                std::span<double> stms = {});
+
 kep3_DLL_PUBLIC std::vector<std::pair<std::array<std::array<double, 3>, 2>, std::optional<std::array<double, 36>>>>
 propagate_lagrangian_grid(const std::array<std::array<double, 3>, 2> &pos_vel, const std::vector<double> &time_grid, double mu,
                        bool stm = false);
 
+/// Streaming Lagrangian propagation on a time grid
+/**
+ * Propagates an initial Cartesian state, given at time_grid[0], to all the epochs in time_grid. Unlike the
+ * overload returning a std::vector, each point is propagated from the previous one, so that the cost of each
+ * step does not grow with the span of the grid. The results are written in caller-owned buffers:
+ *
+ * - pos_vels: the states at the grid epochs, as [x, y, z, vx, vy, vz] per point (size 6N).
+ * - stms: the state transition matrices, row-major, contiguous (size 36N). Can be empty if not needed.
+ *   If compose_stm is true they map the initial state to each point (they are composed step by step),
+ *   otherwise they map each point to the next (the first one being the identity).
+ *
+ * In parallel mode the grid is split in chunks propagated concurrently, each seeded by a direct
+ * propagation from the initial state to the point preceding the chunk.
+ *
+ * @throws std::invalid_argument if the buffer sizes are inconsistent.
+ * @throws std::domain_error if Kepler's equation cannot be solved (as in kep3::propagate_lagrangian).
+ */
+kep3_DLL_PUBLIC void propagate_lagrangian_grid(const std::array<std::array<double, 3>, 2> &pos_vel,
+                                               std::span<const double> time_grid, double mu,
+                                               std::span<double> pos_vels, std::span<double> stms = {},
+                                               bool compose_stm = true, bool parallel = false);
+
 // These are backup functions that use a different algorithm to get the same as propagate_lagrangian.
 // We offer them with an identical interface even if the stm is not implemented.
 kep3_DLL_PUBLIC std::pair<std::array<std::array<double, 3>, 2>, std::optional<std::array<double, 36>>>
@@ -0,0 +1,114 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef kep3_DETAIL_JIT_CACHE_H
+#define kep3_DETAIL_JIT_CACHE_H
+
+#include <filesystem>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include <fmt/core.h>
+
+#include <kep3/core_astro/constants.hpp>
+#include <kep3/detail/s11n.hpp>
+#include <kep3/detail/visibility.hpp>
+
+// Implementation details of the persistent JIT cache (see kep3/jit_cache.hpp), defined in
+// src/jit_cache.cpp.
+
+namespace kep3::detail
+{
+
+// The location of an object in the persistent JIT cache. The full key (model, parameters,
+// versions and CPU) is also stored in the file, and checked on load.
+struct jit_cache_entry {
+    std::filesystem::path path;
+    std::string key;
+};
+
+enum class jit_cache_event { hit, miss, store, error };
+
+// Returns the entry of the object described by model and params, or an empty optional if the
+// persistent cache is disabled. model must be a valid file name.
+kep3_DLL_PUBLIC std::optional<jit_cache_entry> jit_cache_find(const std::string &model, const std::string &params);
+// Returns the content of the entry's file, or an empty optional if it does not exist or cannot be read.
+kep3_DLL_PUBLIC std::optional<std::string> jit_cache_read(const jit_cache_entry &);
+// Writes (atomically) the entry's file, recording a store or an error.
+kep3_DLL_PUBLIC void jit_cache_write(const jit_cache_entry &, const std::string &);
+kep3_DLL_PUBLIC void jit_cache_record(jit_cache_event);
+
+// The parameters of the cached Taylor integrators. The tolerance is formatted exactly (hexfloat).
+inline std::string jit_cache_params(double tol)
+{
+    return fmt::format("tol={:a}", tol);
+}
+
+inline std::string jit_cache_params(double tol, kep3::optimality_type optimality)
+{
+    return fmt::format("tol={:a};optimality={}", tol, static_cast<int>(optimality));
+}
+
+// Returns the object described by model and params. It is loaded from the persistent JIT cache
+// if possible, otherwise it is built by build() and stored. T must be default constructible and
+// serializable with Boost binary archives (e.g. heyoka::taylor_adaptive, heyoka::llvm_state).
+template <typename T, typename F>
+T jit_cache_load_or_build(const std::string &model, const std::string &params, const F &build)
+{
+    const auto entry = jit_cache_find(model, params);
+    if (!entry) {
+        return build();
+    }
+
+    if (auto data = jit_cache_read(*entry)) {
+        try {
+            std::istringstream iss(std::move(*data));
+            boost::archive::binary_iarchive iarchive(iss);
+            std::string key;
+            iarchive >> key;
+            if (key == entry->key) {
+                T retval;
+                iarchive >> retval;
+                jit_cache_record(jit_cache_event::hit);
+                return retval;
+            }
+            // LCOV_EXCL_START
+        } catch (...) {
+        }
+        // LCOV_EXCL_STOP
+        // The file is corrupted, was written by a different LLVM version or has a colliding
+        // name. It will be overwritten.
+        jit_cache_record(jit_cache_event::error);
+    }
+
+    jit_cache_record(jit_cache_event::miss);
+    T retval = build();
+    try {
+        std::ostringstream oss;
+        {
+            boost::archive::binary_oarchive oarchive(oss);
+            const auto &cretval = retval;
+            oarchive << entry->key;
+            oarchive << cretval;
+        }
+        jit_cache_write(*entry, oss.str());
+        // LCOV_EXCL_START
+    } catch (...) {
+        jit_cache_record(jit_cache_event::error);
+    }
+    // LCOV_EXCL_STOP
+    return retval;
+}
+
+} // namespace kep3::detail
+
+#endif // kep3_DETAIL_JIT_CACHE_H
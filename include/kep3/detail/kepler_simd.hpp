@@ -0,0 +1,51 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef kep3_DETAIL_KEPLER_SIMD_H
+#define kep3_DETAIL_KEPLER_SIMD_H
+
+#include <cstddef>
+
+#include <kep3/detail/visibility.hpp>
+
+// Vectorized solvers for Kepler's equation, used by the batched interfaces. They are defined in
+// src/core_astro/kepler_simd.cpp, where the best kernel for the host CPU (AVX-512, AVX2 or a
+// portable fallback) is selected at runtime.
+
+namespace kep3::detail
+{
+
+// Solves n instances of the elliptic Kepler's equation written as:
+//
+//     x + s0 (1 - cos x) - c0 sin x = M
+//
+// This is kepDE with s0 = sigma0 / sqrta and c0 = 1 - R / a, and kepE with s0 = 0 and c0 = ecc.
+// On entry xs contains the initial guesses IG, on exit the solutions. The Newton iterations are
+// confined to [IG - bound, IG + bound]. s0s and c0s are read with strides s0_stride and c0_stride
+// (0 to broadcast a single value). Lanes that do not converge are solved again by the scalar
+// Boost root finder.
+//
+// Throws std::domain_error if the scalar fallback does not converge either.
+kep3_DLL_PUBLIC void kepDE_simd(std::size_t n, const double *Ms, const double *s0s, std::size_t s0_stride,
+                                const double *c0s, std::size_t c0_stride, double bound, double *xs);
+
+// As kep3::detail::kepDE_simd, for the hyperbolic Kepler's equation written as:
+//
+//     -x + s0 (cosh x - 1) + c0 sinh x = N
+//
+// This is kepDH with s0 = sigma0 / sqrta and c0 = 1 - R / a, and kepH with s0 = 0 and c0 = ecc.
+// Here the Newton iterations start from an analytic upper bound of the root (clamped to
+// [IG - bound, IG + bound]), so that the number of iterations does not grow with |N|.
+kep3_DLL_PUBLIC void kepDH_simd(std::size_t n, const double *Ns, const double *s0s, std::size_t s0_stride,
+                                const double *c0s, std::size_t c0_stride, double bound, double *xs);
+
+} // namespace kep3::detail
+
+#endif // kep3_DETAIL_KEPLER_SIMD_H
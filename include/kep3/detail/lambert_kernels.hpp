@@ -0,0 +1,492 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef kep3_DETAIL_LAMBERT_KERNELS_H
+#define kep3_DETAIL_LAMBERT_KERNELS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+#include <kep3/core_astro/constants.hpp>
+
+// Scalar building blocks of the Lambert solver described in:
+//
+// Izzo, Dario. "Revisiting Lambert’s problem." Celestial Mechanics and
+// Dynamical Astronomy 121 (2015): 1-15.
+//
+// They are shared by kep3::lambert_problem and by the batched / fast path entry points
+// and operate on plain doubles only, so that no allocation takes place.
+namespace kep3::detail
+{
+
+// The geometry of a Lambert problem, computed once and used by all branches.
+struct lambert_geometry {
+    // Chord, semiperimeter and lambda.
+    double c, s, lambda;
+    // Non dimensional time of flight.
+    double T;
+    // Norms of the terminal positions.
+    double R0, R1;
+    // Radial and tangential unit vectors at the terminal positions.
+    std::array<double, 3> ir0, ir1, it0, it1;
+};
+
+// Computes the geometry of the Lambert problem (r0, r1, tof, mu, cw).
+inline lambert_geometry lambert_setup(const double *r0, const double *r1, double tof, double mu, bool cw)
+{
+    lambert_geometry g{};
+    const double d[3] = {r1[0] - r0[0], r1[1] - r0[1], r1[2] - r0[2]};
+    g.c = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+    g.R0 = std::sqrt(r0[0] * r0[0] + r0[1] * r0[1] + r0[2] * r0[2]);
+    g.R1 = std::sqrt(r1[0] * r1[0] + r1[1] * r1[1] + r1[2] * r1[2]);
+    g.s = (g.c + g.R0 + g.R1) / 2.0;
+
+    for (auto j = 0u; j < 3u; ++j) {
+        g.ir0[j] = r0[j] / g.R0;
+        g.ir1[j] = r1[j] / g.R1;
+    }
+    std::array<double, 3> ih = {g.ir0[1] * g.ir1[2] - g.ir0[2] * g.ir1[1], g.ir0[2] * g.ir1[0] - g.ir0[0] * g.ir1[2],
+                                g.ir0[0] * g.ir1[1] - g.ir0[1] * g.ir1[0]};
+    const double H = std::sqrt(ih[0] * ih[0] + ih[1] * ih[1] + ih[2] * ih[2]);
+    for (auto &item : ih) {
+        item /= H;
+    }
+
+    if (ih[2] == 0) {
+        throw std::domain_error("lambert_problem: The angular momentum vector has no z component, "
+                                "impossible to define automatically clock or "
+                                "counterclockwise");
+    }
+    const double lambda2 = 1.0 - g.c / g.s;
+    g.lambda = std::sqrt(lambda2);
+
+    g.it0 = {ih[1] * g.ir0[2] - ih[2] * g.ir0[1], ih[2] * g.ir0[0] - ih[0] * g.ir0[2],
+             ih[0] * g.ir0[1] - ih[1] * g.ir0[0]};
+    g.it1 = {ih[1] * g.ir1[2] - ih[2] * g.ir1[1], ih[2] * g.ir1[0] - ih[0] * g.ir1[2],
+             ih[0] * g.ir1[1] - ih[1] * g.ir1[0]};
+    const double IT0 = std::sqrt(g.it0[0] * g.it0[0] + g.it0[1] * g.it0[1] + g.it0[2] * g.it0[2]);
+    const double IT1 = std::sqrt(g.it1[0] * g.it1[0] + g.it1[1] * g.it1[1] + g.it1[2] * g.it1[2]);
+    // Transfer angle larger than 180 degrees as seen from above the z axis and retrograde motion
+    // both flip the sign of lambda and of the tangential directions.
+    double sign = 1.;
+    if (ih[2] < 0.0) {
+        sign = -sign;
+    }
+    if (cw) {
+        sign = -sign;
+    }
+    g.lambda *= sign;
+    for (auto j = 0u; j < 3u; ++j) {
+        g.it0[j] = sign * g.it0[j] / IT0;
+        g.it1[j] = sign * g.it1[j] / IT1;
+    }
+    g.T = std::sqrt(2.0 * mu / g.s / g.s / g.s) * tof;
+    return g;
+}
+
+inline double lambert_hypergeometricF(double z, double tol)
+{
+    double Sj = 1.0;
+    double Cj = 1.0;
+    double err = 1.0;
+    double Cj1 = 0.0;
+    double Sj1 = 0.0;
+    int j = 0;
+    while (err > tol) {
+        Cj1 = Cj * (3.0 + j) * (1.0 + j) / (2.5 + j) * z / (j + 1);
+        Sj1 = Sj + Cj1;
+        err = std::abs(Cj1);
+        Sj = Sj1;
+        Cj = Cj1;
+        j = j + 1;
+    }
+    return Sj;
+}
+
+// First three derivatives of the non dimensional time of flight w.r.t. x.
+inline void lambert_dTdx(double &DT, double &DDT, double &DDDT, double x, double T, double lambda)
+{
+    const double l2 = lambda * lambda;
+    const double l3 = l2 * lambda;
+    const double umx2 = 1.0 - x * x;
+    const double y = std::sqrt(1.0 - l2 * umx2);
+    const double y2 = y * y;
+    const double y3 = y2 * y;
+    DT = 1.0 / umx2 * (3.0 * T * x - 2.0 + 2.0 * l3 * x / y);
+    DDT = 1.0 / umx2 * (3.0 * T + 5.0 * x * DT + 2.0 * (1.0 - l2) * l3 / y3);
+    DDDT = 1.0 / umx2 * (7.0 * x * DDT + 8.0 * DT - 6.0 * (1.0 - l2) * l2 * l3 * x / y3 / y2);
+}
+
+// Lagrange expression of the time of flight.
+inline void lambert_x2tof2(double &tof, double x, unsigned N, double lambda)
+{
+    const double a = 1.0 / (1.0 - x * x);
+    if (a > 0) // ellipse
+    {
+        const double alfa = 2.0 * std::acos(x);
+        double beta = 2.0 * std::asin(std::sqrt(lambda * lambda / a));
+        if (lambda < 0.0) {
+            beta = -beta;
+        }
+        tof = ((a * std::sqrt(a) * ((alfa - std::sin(alfa)) - (beta - std::sin(beta)) + 2.0 * kep3::pi * N)) / 2.0);
+    } else {
+        const double alfa = 2.0 * std::acosh(x);
+        double beta = 2.0 * std::asinh(std::sqrt(-lambda * lambda / a));
+        if (lambda < 0.0) {
+            beta = -beta;
+        }
+        tof = (-a * std::sqrt(-a) * ((beta - std::sinh(beta)) - (alfa - std::sinh(alfa))) / 2.0);
+    }
+}
+
+// Non dimensional time of flight as a function of x, switching between the Lagrange,
+// Battin and Lancaster expressions according to the distance from the parabola (x=1).
+inline void lambert_x2tof(double &tof, double x, unsigned N, double lambda)
+{
+    const double battin = 0.01;
+    const double lagrange = 0.2;
+    const double dist = std::abs(x - 1);
+    if (dist < lagrange && dist > battin) { // We use Lagrange tof expression
+        lambert_x2tof2(tof, x, N, lambda);
+        return;
+    }
+    const double K = lambda * lambda;
+    const double E = x * x - 1.0;
+    const double rho = std::abs(E);
+    const double z = std::sqrt(1 + K * E);
+    if (dist < battin) { // We use Battin series tof expression
+        const double eta = z - lambda * x;
+        const double S1 = 0.5 * (1.0 - lambda - x * eta);
+        double Q = lambert_hypergeometricF(S1, 1e-11);
+        Q = 4.0 / 3.0 * Q;
+        tof = (eta * eta * eta * Q + 4.0 * lambda * eta) / 2.0 + N * kep3::pi / std::pow(rho, 1.5);
+        return;
+    } else { // We use Lancaster tof expresion
+        const double y = std::sqrt(rho);
+        const double g = x * z - lambda * E;
+        double d = 0.0;
+        if (E < 0) {
+            const double l = std::acos(g);
+            d = N * kep3::pi + l;
+        } else {
+            const double f = y * (z - lambda * x);
+            d = std::log(f + g);
+        }
+        tof = (x - lambda * z - d / y) / E;
+        return;
+    }
+}
+
+// Householder iterations on the time of flight equation. Returns the number of iterations, err is set to the
+// size of the last step (the iterations converged if err <= eps).
+inline unsigned lambert_householder(double T, double &x0, unsigned N, double eps, unsigned iter_max, double lambda,
+                                    double &err)
+{
+    unsigned it = 0;
+    err = 1.0;
+    double xnew = 0.0;
+    double tof = 0.0, delta = 0.0, DT = 0.0, DDT = 0.0, DDDT = 0.0;
+    while ((err > eps) && (it < iter_max)) {
+        lambert_x2tof(tof, x0, N, lambda);
+        lambert_dTdx(DT, DDT, DDDT, x0, tof, lambda);
+        delta = tof - T;
+        const double DT2 = DT * DT;
+        xnew = x0 - delta * (DT2 - delta * DDT / 2.0) / (DT * (DT2 - delta * DDT) + DDDT * delta * delta / 6.0);
+        err = std::abs(x0 - xnew);
+        x0 = xnew;
+        it++;
+    }
+    return it;
+}
+
+inline unsigned lambert_householder(double T, double &x0, unsigned N, double eps, unsigned iter_max, double lambda)
+{
+    double err = 0.;
+    return lambert_householder(T, x0, N, eps, iter_max, lambda, err);
+}
+
+// The T at x=0 for the zero revolution curve.
+inline double lambert_T00(double lambda)
+{
+    return std::acos(lambda) + lambda * std::sqrt(1.0 - lambda * lambda);
+}
+
+// Maximum number of revolutions, capped to multi_revs, for which a solution exists.
+inline unsigned lambert_nmax(double T, double lambda, unsigned multi_revs)
+{
+    auto Nmax = static_cast<unsigned>(T / kep3::pi);
+    Nmax = std::min(multi_revs, Nmax);
+    const double T0 = (lambert_T00(lambda) + Nmax * kep3::pi);
+    double DT = 0.0, DDT = 0.0, DDDT = 0.0;
+    if (Nmax > 0) {
+        if (T < T0) { // We use Halley iterations to find xM and TM
+            int it = 0;
+            double err = 1.0;
+            double T_min = T0;
+            double x_old = 0.0, x_new = 0.0;
+            while (true) {
+                lambert_dTdx(DT, DDT, DDDT, x_old, T_min, lambda);
+                if (DT != 0.0) {
+                    x_new = x_old - DT * DDT / (DDT * DDT - DT * DDDT / 2.0);
+                }
+                err = std::abs(x_old - x_new);
+                if ((err < 1e-13) || (it > 12)) {
+                    break;
+                }
+                lambert_x2tof(T_min, x_new, Nmax, lambda);
+                x_old = x_new;
+                it++;
+            }
+            if (T_min > T) {
+                Nmax -= 1;
+            }
+        }
+    }
+    return Nmax;
+}
+
+// Initial guess for the zero revolution solution.
+inline double lambert_x0_guess(double T, double lambda)
+{
+    const double lambda2 = lambda * lambda;
+    const double lambda3 = lambda * lambda2;
+    const double T00 = lambert_T00(lambda);
+    const double T1 = 2.0 / 3.0 * (1.0 - lambda3);
+    if (T >= T00) {
+        return -(T - T00) / (T - T00 + 4);
+    } else if (T <= T1) {
+        return T1 * (T1 - T) / (2.0 / 5.0 * (1 - lambda2 * lambda3) * T) + 1;
+    } else {
+        return std::pow((T / T00), 0.69314718055994529 / std::log(T1 / T00)) - 1.0;
+    }
+}
+
+// Initial guesses for the left and right N revolutions solutions.
+inline double lambert_xl_guess(double T, unsigned N)
+{
+    const double tmp = std::pow((static_cast<double>(N) * kep3::pi + kep3::pi) / (8.0 * T), 2.0 / 3.0);
+    return (tmp - 1) / (tmp + 1);
+}
+
+inline double lambert_xr_guess(double T, unsigned N)
+{
+    const double tmp = std::pow((8.0 * T) / (static_cast<double>(N) * kep3::pi), 2.0 / 3.0);
+    return (tmp - 1) / (tmp + 1);
+}
+
+// Solves for x along the branch with index b, numbered as in kep3::lambert_problem (0 for the single
+// revolution solution, 2N-1 and 2N for the left and right N revolutions solutions). The branch
+// must exist (i.e. N must not exceed lambert_nmax). Returns the number of iterations.
+inline unsigned lambert_solve_branch(const lambert_geometry &g, unsigned b, double &x)
+{
+    if (b == 0u) {
+        x = lambert_x0_guess(g.T, g.lambda);
+        return lambert_householder(g.T, x, 0u, 1e-5, 15u, g.lambda);
+    }
+    const unsigned N = (b + 1u) / 2u;
+    x = (b % 2u == 1u) ? lambert_xl_guess(g.T, N) : lambert_xr_guess(g.T, N);
+    return lambert_householder(g.T, x, N, 1e-8, 15u, g.lambda);
+}
+
+// Warm started version of lambert_solve_branch: on input x holds a guess (e.g. the solution of a nearby
+// problem). We fall back to the default guess when the iterations from the warm start do not converge,
+// leave the domain or land on the wrong branch (for N > 0 left solutions have dT/dx < 0, right ones
+// dT/dx > 0). Returns the total number of iterations.
+inline unsigned lambert_solve_branch_warm(const lambert_geometry &g, unsigned b, double &x)
+{
+    const unsigned N = (b + 1u) / 2u;
+    const double eps = (b == 0u) ? 1e-5 : 1e-8;
+    constexpr unsigned iter_max = 15u;
+    const auto in_domain = [N](double xx) { return std::isfinite(xx) && xx > -1. && (N == 0u || xx < 1.); };
+
+    unsigned it = 0u;
+    double xw = x;
+    if (in_domain(xw)) {
+        double err = 0.;
+        it = lambert_householder(g.T, xw, N, eps, iter_max, g.lambda, err);
+        // NOTE: we test the last step, not the iteration count, as the iterations may converge on the last one.
+        bool ok = err <= eps && in_domain(xw);
+        if (ok && N > 0u) {
+            double tof = 0., DT = 0., DDT = 0., DDDT = 0.;
+            lambert_x2tof(tof, xw, N, g.lambda);
+            lambert_dTdx(DT, DDT, DDDT, xw, tof, g.lambda);
+            ok = (b % 2u == 1u) ? (DT < 0.) : (DT > 0.);
+        }
+        if (ok) {
+            x = xw;
+            return it;
+        }
+    }
+    return it + lambert_solve_branch(g, b, x);
+}
+
+// Reconstructs the terminal velocities from a converged x.
+inline void lambert_velocities(const lambert_geometry &g, double mu, double x, double *v0, double *v1)
+{
+    const double lambda2 = g.lambda * g.lambda;
+    const double gamma = std::sqrt(mu * g.s / 2.0);
+    const double rho = (g.R0 - g.R1) / g.c;
+    const double sigma = std::sqrt(1 - rho * rho);
+    const double y = std::sqrt(1.0 - lambda2 + lambda2 * x * x);
+    const double vr0 = gamma * ((g.lambda * y - x) - rho * (g.lambda * y + x)) / g.R0;
+    const double vr1 = -gamma * ((g.lambda * y - x) + rho * (g.lambda * y + x)) / g.R1;
+    const double vt = gamma * sigma * (y + g.lambda * x);
+    const double vt0 = vt / g.R0;
+    const double vt1 = vt / g.R1;
+    for (auto j = 0u; j < 3u; ++j) {
+        v0[j] = vr0 * g.ir0[j] + vt0 * g.it0[j];
+        v1[j] = vr1 * g.ir1[j] + vt1 * g.it1[j];
+    }
+}
+
+// Jacobians of the terminal velocities w.r.t. the problem data (r0, r1, tof), given a converged x on the
+// branch with N revolutions. dv0 and dv1 are 3x7 row major matrices (columns: r0, r1, tof).
+// The sensitivity of x follows from the implicit differentiation of the time of flight equation
+// T(x, lambda) = T, using dT/dlambda = -2 lambda^2 / y at constant x. The rest is plain chain rule.
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+inline void lambert_jacobians(const lambert_geometry &g, const double *r0, const double *r1, double tof, double mu,
+                              double x, unsigned N, double *dv0, double *dv1)
+{
+    using grad = std::array<double, 7>;
+    using vgrad = std::array<grad, 3>;
+    const auto cross = [](const auto &a, const auto &b) {
+        return std::array<double, 3>{a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+    };
+
+    // 1 - Norms, chord and semiperimeter.
+    grad dR0{}, dR1{}, dc{}, ds{};
+    for (auto j = 0u; j < 3u; ++j) {
+        dR0[j] = g.ir0[j];
+        dR1[3u + j] = g.ir1[j];
+        dc[j] = -(r1[j] - r0[j]) / g.c;
+        dc[3u + j] = (r1[j] - r0[j]) / g.c;
+    }
+    for (auto k = 0u; k < 7u; ++k) {
+        ds[k] = (dR0[k] + dR1[k] + dc[k]) / 2.;
+    }
+
+    // 2 - Lambda, non dimensional time of flight and x.
+    const double lambda2 = g.lambda * g.lambda;
+    double tof_x = 0., DT = 0., DDT = 0., DDDT = 0.;
+    lambert_x2tof(tof_x, x, N, g.lambda);
+    lambert_dTdx(DT, DDT, DDDT, x, tof_x, g.lambda);
+    const double y = std::sqrt(1.0 - lambda2 + lambda2 * x * x);
+    const double dTdlambda = -2. * lambda2 / y;
+    grad dlambda{}, dT{}, dx{}, dy{};
+    for (auto k = 0u; k < 7u; ++k) {
+        dlambda[k] = -(dc[k] - g.c / g.s * ds[k]) / (2. * g.s * g.lambda);
+        dT[k] = -1.5 * g.T * ds[k] / g.s;
+    }
+    dT[6] += g.T / tof;
+    for (auto k = 0u; k < 7u; ++k) {
+        dx[k] = (dT[k] - dTdlambda * dlambda[k]) / DT;
+        dy[k] = (g.lambda * (x * x - 1.) * dlambda[k] + lambda2 * x * dx[k]) / y;
+    }
+
+    // 3 - Radial and tangential velocity components (as in lambert_velocities).
+    const double gamma = std::sqrt(mu * g.s / 2.0);
+    const double rho = (g.R0 - g.R1) / g.c;
+    const double sigma = std::sqrt(1 - rho * rho);
+    const double A = g.lambda * y - x;
+    const double B = g.lambda * y + x;
+    const double vr0 = gamma * (A - rho * B) / g.R0;
+    const double vr1 = -gamma * (A + rho * B) / g.R1;
+    const double vt = gamma * sigma * (y + g.lambda * x);
+    const double vt0 = vt / g.R0;
+    const double vt1 = vt / g.R1;
+    grad dvr0{}, dvr1{}, dvt0{}, dvt1{};
+    for (auto k = 0u; k < 7u; ++k) {
+        const double dgamma = gamma * ds[k] / (2. * g.s);
+        const double drho = (dR0[k] - dR1[k] - rho * dc[k]) / g.c;
+        const double dsigma = -rho * drho / sigma;
+        const double dly = y * dlambda[k] + g.lambda * dy[k];
+        const double dA = dly - dx[k];
+        const double dB = dly + dx[k];
+        dvr0[k] = (dgamma * (A - rho * B) + gamma * (dA - drho * B - rho * dB)) / g.R0 - vr0 * dR0[k] / g.R0;
+        dvr1[k] = -(dgamma * (A + rho * B) + gamma * (dA + drho * B + rho * dB)) / g.R1 - vr1 * dR1[k] / g.R1;
+        const double dvt = dgamma * sigma * (y + g.lambda * x) + gamma * dsigma * (y + g.lambda * x)
+                           + gamma * sigma * (dy[k] + x * dlambda[k] + g.lambda * dx[k]);
+        dvt0[k] = dvt / g.R0 - vt0 * dR0[k] / g.R0;
+        dvt1[k] = dvt / g.R1 - vt1 * dR1[k] / g.R1;
+    }
+
+    // 4 - Radial and tangential directions. The tangential ones are sign * ih x ir, with ih the
+    // unit vector along r0 x r1.
+    const std::array<double, 3> r0v = {r0[0], r0[1], r0[2]};
+    const std::array<double, 3> r1v = {r1[0], r1[1], r1[2]};
+    auto ih = cross(r0v, r1v);
+    const double H = std::sqrt(ih[0] * ih[0] + ih[1] * ih[1] + ih[2] * ih[2]);
+    for (auto &item : ih) {
+        item /= H;
+    }
+    const auto ihxir0 = cross(ih, g.ir0);
+    const double sign
+        = (ihxir0[0] * g.it0[0] + ihxir0[1] * g.it0[1] + ihxir0[2] * g.it0[2]) < 0. ? -1. : 1.;
+    vgrad dir0{}, dir1{}, dn{}, dih{}, dit0{}, dit1{};
+    for (auto i = 0u; i < 3u; ++i) {
+        for (auto j = 0u; j < 3u; ++j) {
+            const double delta = (i == j) ? 1. : 0.;
+            dir0[i][j] = (delta - g.ir0[i] * g.ir0[j]) / g.R0;
+            dir1[i][3u + j] = (delta - g.ir1[i] * g.ir1[j]) / g.R1;
+        }
+    }
+    // d(r0 x r1) = dr0 x r1 + r0 x dr1.
+    for (auto j = 0u; j < 3u; ++j) {
+        std::array<double, 3> e{};
+        e[j] = 1.;
+        const auto c0 = cross(e, r1v);
+        const auto c1 = cross(r0v, e);
+        for (auto i = 0u; i < 3u; ++i) {
+            dn[i][j] = c0[i];
+            dn[i][3u + j] = c1[i];
+        }
+    }
+    for (auto i = 0u; i < 3u; ++i) {
+        for (auto k = 0u; k < 7u; ++k) {
+            dih[i][k] = (dn[i][k] - ih[i] * (ih[0] * dn[0][k] + ih[1] * dn[1][k] + ih[2] * dn[2][k])) / H;
+        }
+    }
+    for (auto k = 0u; k < 7u; ++k) {
+        const std::array<double, 3> dihk = {dih[0][k], dih[1][k], dih[2][k]};
+        const std::array<double, 3> dir0k = {dir0[0][k], dir0[1][k], dir0[2][k]};
+        const std::array<double, 3> dir1k = {dir1[0][k], dir1[1][k], dir1[2][k]};
+        const auto a0 = cross(dihk, g.ir0);
+        const auto b0 = cross(ih, dir0k);
+        const auto a1 = cross(dihk, g.ir1);
+        const auto b1 = cross(ih, dir1k);
+        for (auto i = 0u; i < 3u; ++i) {
+            dit0[i][k] = sign * (a0[i] + b0[i]);
+            dit1[i][k] = sign * (a1[i] + b1[i]);
+        }
+    }
+
+    // 5 - Assemble v = vr ir + vt it.
+    for (auto i = 0u; i < 3u; ++i) {
+        for (auto k = 0u; k < 7u; ++k) {
+            dv0[7u * i + k] = g.ir0[i] * dvr0[k] + vr0 * dir0[i][k] + g.it0[i] * dvt0[k] + vt0 * dit0[i][k];
+            dv1[7u * i + k] = g.ir1[i] * dvr1[k] + vr1 * dir1[i][k] + g.it1[i] * dvt1[k] + vt1 * dit1[i][k];
+        }
+    }
+}
+
+// Solves n zero revolution problems using the best vectorized kernel available on the host CPU
+// (8 lanes with AVX-512, 4 with AVX2, else 2; the runtime selection only exists in x86 GCC-like builds,
+// the others always use the 2 lanes kernel). mus and cws are read with strides
+// mu_stride and cw_stride (0 to broadcast a single value), iters can be null. Defined in src/lambert_simd.cpp.
+void lambert_0rev_simd(std::size_t n, const double *r0s, const double *r1s, const double *tofs, const double *mus,
+                       std::size_t mu_stride, const bool *cws, std::size_t cw_stride, double *v0s, double *v1s,
+                       unsigned *iters);
+
+} // namespace kep3::detail
+
+#endif // kep3_DETAIL_LAMBERT_KERNELS_H
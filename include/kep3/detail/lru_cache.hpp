@@ -0,0 +1,254 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef kep3_DETAIL_LRU_CACHE_H
+#define kep3_DETAIL_LRU_CACHE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <kep3/detail/s11n.hpp>
+#include <kep3/detail/visibility.hpp>
+#include <kep3/jit_cache.hpp>
+
+// The in-memory caches of JIT compiled objects (see kep3/jit_cache.hpp). The registry and the
+// global settings are defined in src/jit_cache.cpp.
+
+namespace kep3::detail
+{
+
+// The interface of the caches seen by the registry.
+class kep3_DLL_PUBLIC lru_cache_base
+{
+public:
+    lru_cache_base() = default;
+    lru_cache_base(const lru_cache_base &) = delete;
+    lru_cache_base &operator=(const lru_cache_base &) = delete;
+    virtual ~lru_cache_base();
+
+    [[nodiscard]] virtual jit_memory_cache_stats stats() const = 0;
+    virtual void reset_stats() = 0;
+    // Evicts entries until the size is within the capacity.
+    virtual void trim(std::size_t) = 0;
+};
+
+kep3_DLL_PUBLIC void lru_cache_register(const std::string &name, lru_cache_base *);
+
+// Returns tol rounded to the number of significant digits set by kep3::set_jit_cache_tol_digits.
+kep3_DLL_PUBLIC double normalize_tol(double tol);
+
+// A cache of (expensive to build) objects, shared by all threads. Lookups hitting the cache take a
+// shared lock. On a miss a placeholder is inserted for the key and the object is built outside the
+// lock, so that the objects of different keys are built concurrently and the threads asking for a key
+// under construction wait for it (rather than building it again). When the number of entries exceeds
+// the capacity set by kep3::set_jit_memory_cache_capacity, the least recently used ones are evicted.
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+class lru_cache final : public lru_cache_base
+{
+    using future_t = std::shared_future<std::shared_ptr<const T>>;
+
+    struct entry {
+        future_t fut;
+        // The id of the build which inserted the entry.
+        std::uint64_t id = 0;
+        std::size_t bytes = 0;
+        // Tick of the last use. It is updated under the shared lock, hence atomic.
+        mutable std::atomic<std::uint64_t> last_used{0};
+    };
+
+public:
+    explicit lru_cache(const std::string &name)
+    {
+        lru_cache_register(name, this);
+    }
+
+    // Returns the object of the given key, building it with build() on a miss.
+    // NOTE: the object is kept alive by the returned pointer also if the entry is evicted, callers
+    // must hold it for as long as they use the object (e.g. while copying it).
+    template <typename F>
+    std::shared_ptr<const T> get_ptr(const Key &key, const F &build)
+    {
+        // Fast path: on a cache hit the lock is shared, so that concurrent lookups do not contend.
+        // NOTE: the wait for an object under construction happens after the lock is released.
+        future_t fut;
+        {
+            std::shared_lock const lock(m_mutex);
+            if (auto it = m_map.find(key); it != m_map.end()) {
+                it->second.last_used.store(++m_tick, std::memory_order_relaxed);
+                ++m_hits;
+                fut = it->second.fut;
+            }
+        }
+        if (fut.valid()) {
+            return fut.get();
+        }
+
+        std::promise<std::shared_ptr<const T>> prom;
+        std::uint64_t id = 0;
+        {
+            std::lock_guard const lock(m_mutex);
+
+            // Lookup again, as another thread may have inserted the key in the meantime.
+            if (auto it = m_map.find(key); it != m_map.end()) {
+                it->second.last_used.store(++m_tick, std::memory_order_relaxed);
+                ++m_hits;
+                fut = it->second.fut;
+            } else {
+                ++m_misses;
+                id = ++m_builds;
+                auto &e = m_map[key];
+                e.fut = prom.get_future().share();
+                e.id = id;
+                e.last_used.store(++m_tick, std::memory_order_relaxed);
+            }
+        }
+        if (fut.valid()) {
+            return fut.get();
+        }
+
+        // Build the object without holding the lock.
+        std::shared_ptr<const T> ptr;
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            ptr = std::make_shared<const T>(build());
+        } catch (...) {
+            // The waiting threads see the error, the entry is removed so that the next lookup builds again.
+            prom.set_exception(std::current_exception());
+            {
+                std::lock_guard const lock(m_mutex);
+                if (auto it = m_map.find(key); it != m_map.end() && it->second.id == id) {
+                    m_map.erase(it);
+                }
+            }
+            throw;
+        }
+        const auto compile_ns = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        prom.set_value(ptr);
+
+        // The footprint requires a full serialization pass, we do not block the readers meanwhile.
+        const auto bytes = footprint(*ptr);
+        {
+            std::lock_guard const lock(m_mutex);
+            m_compile_ns += compile_ns;
+            // NOTE: the entry may have been evicted in the meantime.
+            if (auto it = m_map.find(key); it != m_map.end() && it->second.id == id) {
+                it->second.bytes = bytes;
+                m_bytes += bytes;
+            }
+            trim_impl(get_jit_memory_cache_capacity());
+        }
+
+        return ptr;
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        std::shared_lock const lock(m_mutex);
+        return m_map.size();
+    }
+
+    [[nodiscard]] jit_memory_cache_stats stats() const final
+    {
+        std::shared_lock const lock(m_mutex);
+        return {m_map.size(), m_hits.load(), m_misses, m_evictions, static_cast<double>(m_compile_ns) * 1e-9,
+                m_bytes};
+    }
+
+    void reset_stats() final
+    {
+        std::lock_guard const lock(m_mutex);
+        m_hits = 0u;
+        m_misses = 0u;
+        m_evictions = 0u;
+        m_compile_ns = 0u;
+    }
+
+    void trim(std::size_t capacity) final
+    {
+        std::lock_guard const lock(m_mutex);
+        trim_impl(capacity);
+    }
+
+private:
+    // The memory held by the object, estimated by the size of its serialized form (which contains the
+    // compiled code).
+    static std::size_t footprint(const T &x)
+    {
+        try {
+            std::ostringstream oss;
+            {
+                boost::archive::binary_oarchive oarchive(oss);
+                oarchive << x;
+            }
+            return static_cast<std::size_t>(oss.tellp());
+            // LCOV_EXCL_START
+        } catch (...) {
+            return 0u;
+        }
+        // LCOV_EXCL_STOP
+    }
+
+    static bool is_ready(const entry &e)
+    {
+        return e.fut.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    // NOTE: to be called with the exclusive lock held. A capacity of zero means unbounded. The entries
+    // under construction are not evicted.
+    void trim_impl(std::size_t capacity)
+    {
+        while (capacity != 0u && m_map.size() > capacity) {
+            auto lru = m_map.end();
+            for (auto it = m_map.begin(); it != m_map.end(); ++it) {
+                if (is_ready(it->second)
+                    && (lru == m_map.end()
+                        || it->second.last_used.load(std::memory_order_relaxed)
+                               < lru->second.last_used.load(std::memory_order_relaxed))) {
+                    lru = it;
+                }
+            }
+            if (lru == m_map.end()) {
+                break;
+            }
+            m_bytes -= lru->second.bytes;
+            m_map.erase(lru);
+            ++m_evictions;
+        }
+    }
+
+    mutable std::shared_mutex m_mutex;
+    std::unordered_map<Key, entry, Hash> m_map;
+    std::atomic<std::uint64_t> m_tick{0};
+    std::atomic<std::size_t> m_hits{0};
+    // NOTE: the members below are only modified under the exclusive lock.
+    std::uint64_t m_builds = 0;
+    std::size_t m_misses = 0;
+    std::size_t m_evictions = 0;
+    std::uint64_t m_compile_ns = 0;
+    std::size_t m_bytes = 0;
+};
+
+} // namespace kep3::detail
+
+#endif // kep3_DETAIL_LRU_CACHE_H
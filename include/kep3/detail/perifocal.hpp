@@ -0,0 +1,39 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef kep3_DETAIL_PERIFOCAL_H
+#define kep3_DETAIL_PERIFOCAL_H
+
+#include <array>
+
+#include <kep3/detail/visibility.hpp>
+
+// The perifocal description of a Keplerian orbit, used to evaluate it at many epochs solving
+// Kepler's equation with the vectorized anomaly conversions. Shared by kep3::udpla::keplerian
+// and kep3::planet_catalog.
+namespace kep3::detail
+{
+
+// The quantities needed to evaluate a Keplerian orbit at many epochs, computed once from the
+// reference state. The perifocal frame (P, Q) is built from the eccentricity vector, so that
+// circular and equatorial orbits need no special treatment.
+struct perifocal_data {
+    std::array<double, 3> P, Q;
+    double a, ecc, n, anomaly0, ref_mjd2000, mu;
+    bool ellipse;
+};
+
+// NOTE: defined in src/udpla/keplerian.cpp.
+kep3_DLL_PUBLIC perifocal_data perifocal_setup(const std::array<std::array<double, 3>, 2> &pos_vel, double mu,
+                                               double ref_mjd2000);
+
+} // namespace kep3::detail
+
+#endif // kep3_DETAIL_PERIFOCAL_H
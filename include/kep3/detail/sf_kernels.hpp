@@ -0,0 +1,93 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef kep3_DETAIL_SF_KERNELS_H
+#define kep3_DETAIL_SF_KERNELS_H
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+// Small fixed size building blocks of the analytical gradients of the Sims-Flanagan legs,
+// shared by kep3::leg::sims_flanagan and kep3::leg::sims_flanagan_alpha.
+namespace kep3::detail
+{
+
+// C = A @ B, for 6x6 row major matrices.
+inline void mat66_dot(const std::array<double, 36> &A, const std::array<double, 36> &B, std::array<double, 36> &C)
+{
+    for (auto i = 0u; i < 6u; ++i) {
+        for (auto j = 0u; j < 6u; ++j) {
+            double acc = 0.;
+            for (auto l = 0u; l < 6u; ++l) {
+                acc += A[6u * i + l] * B[6u * l + j];
+            }
+            C[6u * i + j] = acc;
+        }
+    }
+}
+
+// y += s * A @ x, for a 6x6 row major matrix.
+inline void mat61_axpy(double s, const std::array<double, 36> &A, const std::array<double, 6> &x,
+                       std::array<double, 6> &y)
+{
+    for (auto i = 0u; i < 6u; ++i) {
+        double acc = 0.;
+        for (auto l = 0u; l < 6u; ++l) {
+            acc += A[6u * i + l] * x[l];
+        }
+        y[i] += s * acc;
+    }
+}
+
+// The Keplerian dynamics.
+inline std::array<double, 6> kep_dyn(const std::array<std::array<double, 3>, 2> &rv, double mu)
+{
+    const auto R3 = std::pow(rv[0][0] * rv[0][0] + rv[0][1] * rv[0][1] + rv[0][2] * rv[0][2], 1.5);
+    return {rv[1][0], rv[1][1], rv[1][2], -mu / R3 * rv[0][0], -mu / R3 * rv[0][1], -mu / R3 * rv[0][2]};
+}
+
+// The buffers of sf_grad_fwd() and sf_grad_bck().
+struct sf_grad_buffers {
+    // Grows the buffers to fit a half leg of nseg segments.
+    void reserve(unsigned nseg);
+
+    unsigned m_nseg = 0u;
+    // The STMs of the half leg and their products Mc[i] = M[n] @ ... @ M[i] (6x6, row major).
+    std::vector<std::array<double, 36>> m_M;
+    std::vector<std::array<double, 36>> m_Mc;
+    // The dynamics after each propagation.
+    std::vector<std::array<double, 6>> m_f;
+    // The mass schedule.
+    std::vector<double> m_m;
+    // The throttles and the segment durations of the backward half leg, in reverse order.
+    std::vector<double> m_throttles;
+    std::vector<double> m_dts;
+};
+
+// The gradients of a half leg made of nseg impulses, the i-th one in the middle of a segment of duration dts[i]
+// (i.e. the propagations last dts[0] / 2, (dts[i - 1] + dts[i]) / 2 and dts[nseg - 1] / 2). grad_rvm (7x7) is
+// the gradient of the final state and mass w.r.t. the initial ones and grad (7 x 4 nseg) the gradient w.r.t. the
+// throttles (3 nseg) and the durations (nseg). Both are row major.
+void sf_grad_fwd(sf_grad_buffers &buf, const double *throttles, const double *dts, unsigned nseg,
+                 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+                 const std::array<std::array<double, 3>, 2> &rvs, double ms, double max_thrust, double veff, double mu,
+                 std::array<double, 49> &grad_rvm, double *grad);
+
+// As sf_grad_fwd(), for the backward half leg ending in rvf, mf: the gradients are those of the state and mass at
+// the match point w.r.t. the final ones, the throttles and the durations (in forward order).
+void sf_grad_bck(sf_grad_buffers &buf, const double *throttles, const double *dts, unsigned nseg,
+                 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+                 const std::array<std::array<double, 3>, 2> &rvf, double mf, double max_thrust, double veff, double mu,
+                 std::array<double, 49> &grad_rvm, double *grad);
+
+} // namespace kep3::detail
+
+#endif // kep3_DETAIL_SF_KERNELS_H
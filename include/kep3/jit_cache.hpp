@@ -0,0 +1,135 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef kep3_JIT_CACHE_H
+#define kep3_JIT_CACHE_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+#include <kep3/detail/visibility.hpp>
+
+namespace kep3
+{
+
+/// Statistics of the persistent JIT cache
+/**
+ * Counts the events of the persistent JIT cache since the start of the process (or the last call to
+ * kep3::reset_jit_cache_stats). Lookups answered by the in-memory caches are not counted.
+ */
+struct kep3_DLL_PUBLIC jit_cache_stats {
+    // Objects loaded from the cache directory.
+    std::size_t hits = 0u;
+    // Objects that were not found (or not usable) in the cache directory, and were thus compiled.
+    std::size_t misses = 0u;
+    // Objects written to the cache directory.
+    std::size_t stores = 0u;
+    // Files that could not be used (corrupted, or produced by another LLVM version) or written.
+    std::size_t errors = 0u;
+};
+
+/// Sets the persistent JIT cache directory
+/**
+ * The Taylor integrators (e.g. kep3::ta::get_ta_zoh_kep) and the compiled functions (e.g. those of
+ * kep3::udpla::vsop2013) are JIT compiled the first time they are requested in a process. When a
+ * cache directory is set, the compiled objects are also serialized there and, on later requests in
+ * the same or in other processes, loaded instead of being compiled again.
+ *
+ * Cached objects are keyed by model, tolerance (and other construction parameters), kep3 and heyoka
+ * versions and host CPU. Files that cannot be loaded are recompiled and overwritten. The directory is
+ * created if it does not exist.
+ *
+ * The persistent cache is disabled by default. It is enabled at startup if the environment variable
+ * KEP3_JIT_CACHE_DIR is set.
+ *
+ * @param dir the cache directory. An empty string disables the persistent cache.
+ */
+kep3_DLL_PUBLIC void set_jit_cache_dir(const std::string &dir);
+
+/// Gets the persistent JIT cache directory
+/**
+ * @return the cache directory, empty if the persistent cache is disabled.
+ */
+kep3_DLL_PUBLIC std::string get_jit_cache_dir();
+
+/// Gets the persistent JIT cache statistics
+kep3_DLL_PUBLIC jit_cache_stats get_jit_cache_stats();
+
+/// Resets the persistent JIT cache statistics
+kep3_DLL_PUBLIC void reset_jit_cache_stats();
+
+/// Statistics of an in-memory cache of JIT compiled objects
+/**
+ * Each family of compiled objects (e.g. the integrators returned by kep3::ta::get_ta_zoh_kep, or the
+ * VSOP2013 series) is kept in its own in-memory cache. The counters are kept since the start of the process
+ * (or the last call to kep3::reset_jit_memory_cache_stats).
+ */
+struct kep3_DLL_PUBLIC jit_memory_cache_stats {
+    // Number of cached objects.
+    std::size_t size = 0u;
+    // Lookups answered by the cache.
+    std::size_t hits = 0u;
+    // Lookups that required compiling (or loading from the persistent cache) the object.
+    std::size_t misses = 0u;
+    // Objects evicted to respect the capacity.
+    std::size_t evictions = 0u;
+    // Total time (in seconds) spent compiling (or loading) objects.
+    double compile_time = 0.;
+    // Estimated memory (in bytes) held by the cached objects.
+    std::size_t resident_bytes = 0u;
+};
+
+/// Sets the capacity of the in-memory JIT caches
+/**
+ * When a cache holds more objects than its capacity, the least recently used ones are evicted (and
+ * compiled again if requested later). The capacity applies to each cache separately, and existing caches
+ * are trimmed right away.
+ *
+ * The getters of kep3::ta return copies of the cached integrators, which are not affected by evictions. The
+ * capacity should however not be smaller than the number of objects of a family in use at the same time,
+ * else they would be compiled over and over.
+ *
+ * @param capacity the maximum number of objects in each cache. Zero (the default) means unbounded.
+ */
+kep3_DLL_PUBLIC void set_jit_memory_cache_capacity(std::size_t capacity);
+
+/// Gets the capacity of the in-memory JIT caches
+kep3_DLL_PUBLIC std::size_t get_jit_memory_cache_capacity();
+
+/// Sets the tolerance normalization of the in-memory JIT caches
+/**
+ * The tolerances requested to the getters of kep3::ta are rounded to the given number of significant
+ * decimal digits before the lookup, and the integrators are built with the rounded tolerance. This avoids
+ * compiling many integrators for tolerances which differ only by noise (e.g. 1e-10 and 1.0000000001e-10).
+ *
+ * @param digits the number of significant digits. Zero (the default) disables the normalization.
+ */
+kep3_DLL_PUBLIC void set_jit_cache_tol_digits(unsigned digits);
+
+/// Gets the tolerance normalization of the in-memory JIT caches
+kep3_DLL_PUBLIC unsigned get_jit_cache_tol_digits();
+
+/// Gets the statistics of the in-memory JIT caches
+/**
+ * @return the statistics of each cache created so far in the process, by name (e.g. "ta_zoh_kep",
+ * "ta_zoh_kep_var", "ta_pc", "vsop2013").
+ */
+kep3_DLL_PUBLIC std::map<std::string, jit_memory_cache_stats> get_jit_memory_cache_stats();
+
+/// Resets the statistics of the in-memory JIT caches
+/**
+ * The counters are reset, the sizes and resident bytes are not.
+ */
+kep3_DLL_PUBLIC void reset_jit_memory_cache_stats();
+
+} // namespace kep3
+
+#endif // kep3_JIT_CACHE_H
@@ -12,6 +12,9 @@
 #define kep3_LAMBERT_PROBLEM_H
 
 #include <array>
+#include <span>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include <fmt/ostream.h>
@@ -54,6 +57,8 @@ public:
     friend kep3_DLL_PUBLIC std::ostream &operator<<(std::ostream &, const lambert_problem &);
     explicit lambert_problem(const std::array<double, 3> &r0  = default_r0, const std::array<double, 3> &r1 = default_r1,
                              double tof = kep3::pi / 2, double mu = 1., bool cw = false, unsigned multi_revs = 1);
+    lambert_problem(const std::array<double, 3> &r0, const std::array<double, 3> &r1, double tof, double mu, bool cw,
+                    unsigned multi_revs, const std::vector<double> &x_guess);
     [[nodiscard]] const std::vector<std::array<double, 3>> &get_v0() const;
     [[nodiscard]] const std::vector<std::array<double, 3>> &get_v1() const;
     [[nodiscard]] const std::array<double, 3> &get_r0() const;
@@ -65,12 +70,12 @@ public:
     [[nodiscard]] unsigned get_Nmax() const;
     [[nodiscard]] const bool &get_cw() const;
 
+    // Jacobians of the terminal velocities w.r.t. (r0, r1, tof), one 3x7 row major matrix per solution
+    // (columns 0-2: r0, 3-5: r1, 6: tof). Computed analytically from the converged x, no new solve is needed.
+    [[nodiscard]] std::pair<std::vector<std::array<double, 21>>, std::vector<std::array<double, 21>>>
+    compute_grad() const;
+
 private:
-    unsigned householder(double, double &, unsigned, double, unsigned) const;
-    void dTdx(double &, double &, double &, double, double) const;
-    void x2tof(double &tof, double x0, unsigned N) const;
-    void x2tof2(double &tof, double x0, unsigned N) const;
-    [[nodiscard]] static double hypergeometricF(double z, double tol);
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive &ar, const unsigned int)
@@ -107,6 +112,54 @@ private:
     bool m_cw;
 };
 
+/// Single revolution Lambert solver
+/**
+ * Solves the Lambert problem (r0, r1, tof, mu, cw) for the single (zero revolutions) solution only,
+ * using the same algorithm as kep3::lambert_problem. No allocation takes place and the results are
+ * returned by value.
+ *
+ * @return the tuple (v0, v1, iters) with the terminal velocities and the number of Householder iterations.
+ *
+ * @throws std::domain_error if the problem is ill defined (as in kep3::lambert_problem).
+ */
+kep3_DLL_PUBLIC std::tuple<std::array<double, 3>, std::array<double, 3>, unsigned>
+lambert_0rev(const std::array<double, 3> &r0, const std::array<double, 3> &r1, double tof, double mu, bool cw = false);
+
+/// Batched Lambert solver
+/**
+ * Solves N Lambert problems in one call, reusing the same algorithm as kep3::lambert_problem
+ * but without any per-problem allocation. Inputs and outputs are given in a structure of arrays
+ * form and the output buffers are owned by the caller:
+ *
+ * - r0s, r1s: the N terminal positions, flattened as [x0, y0, z0, x1, y1, z1, ...] (size 3N).
+ * - tofs: the N times of flight.
+ * - mus: the gravity parameters (size N, or size 1 to share one value across all problems).
+ * - cws: the clockwise flags (size N, or size 1 to share one value across all problems).
+ *
+ * Each problem has 2*multi_revs+1 slots in the output (0 rev, then left and right solutions for
+ * 1, 2, ..., multi_revs revolutions), thus:
+ *
+ * - v0s, v1s: the terminal velocities, size 3N(2*multi_revs+1), problem-major.
+ * - iters: the Householder iterations, size N(2*multi_revs+1). Can be empty if not needed.
+ *
+ * Slots corresponding to revolutions for which no solution exists are filled with NaNs
+ * in the velocities and a zero in the iterations.
+ *
+ * When multi_revs is zero, the problems are solved in lockstep groups by a vectorized kernel. On x86
+ * builds with GCC-like compilers the kernel is chosen at runtime according to the host CPU: 8 lanes
+ * with AVX-512, 4 lanes with AVX2 and 2 lanes otherwise. All other builds (e.g. MSVC, ARM) always
+ * use the portable 2 lanes kernel. Only the Householder update is vectorized (the time of flight
+ * evaluations remain scalar), so the gain over a loop of scalar solves is modest. The results agree
+ * with kep3::lambert_problem to within floating point round-off.
+ *
+ * @throws std::invalid_argument if the buffer sizes are inconsistent.
+ * @throws std::domain_error if any of the problems is ill defined (as in kep3::lambert_problem).
+ */
+kep3_DLL_PUBLIC void lambert_batch(std::span<const double> r0s, std::span<const double> r1s,
+                                   std::span<const double> tofs, std::span<const double> mus,
+                                   std::span<const bool> cws, std::span<double> v0s, std::span<double> v1s,
+                                   std::span<unsigned> iters = {}, unsigned multi_revs = 0u);
+
 } // namespace kep3
 
 template <>
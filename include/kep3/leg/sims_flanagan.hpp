@@ -12,14 +12,18 @@
 #define kep3_LEG_SIMS_FLANAGAN_H
 
 #include <array>
+#include <cstddef>
+#include <span>
 #include <tuple>
 #include <vector>
 
 #include <fmt/ostream.h>
 
 #include <kep3/core_astro/constants.hpp>
+#include <kep3/detail/sf_kernels.hpp>
 #include <kep3/detail/visibility.hpp>
 #include <kep3/epoch.hpp>
+#include <kep3/leg/sparsity.hpp>
 
 namespace kep3::leg
 {
@@ -34,6 +38,35 @@ namespace kep3::leg
 class kep3_DLL_PUBLIC sims_flanagan
 {
 public:
+    /// Reusable memory for the gradients
+    /**
+     * Holds the buffers used by compute_mc_grad(workspace &, ...) and compute_grad_sparse(). They grow to the
+     * number of segments of the leg on the first call, after which the gradients of legs with as many (or fewer)
+     * segments are computed without heap allocations. A workspace must not be used by concurrent calls.
+     */
+    class kep3_DLL_PUBLIC workspace
+    {
+        friend class sims_flanagan;
+
+        // Grows the buffers to fit a leg of nseg segments.
+        void reserve(unsigned nseg);
+
+        unsigned m_nseg = 0u;
+        // The buffers of the half leg gradients.
+        kep3::detail::sf_grad_buffers m_buf;
+        // The segment durations.
+        std::vector<double> m_dts;
+        // The gradients of the two half legs w.r.t. [throttles, segment durations].
+        std::vector<double> m_grad_fwd;
+        std::vector<double> m_grad_bck;
+        // The dense gradient of the mismatch constraints w.r.t. [throttles, tof].
+        std::vector<double> m_grad;
+
+    public:
+        workspace();
+        explicit workspace(unsigned nseg);
+    };
+
     // Default Constructor.
     sims_flanagan() = default;
     // Constructors
@@ -79,27 +112,23 @@ public:
     // Compute mismatch constraint gradients (w.r.t. rvm state and w.r.t. throttles, tof)
     [[nodiscard]] std::tuple<std::array<double, 49>, std::array<double, 49>, std::vector<double>>
     compute_mc_grad() const;
+    // Allocation free version, writing the three gradients in caller-owned buffers (grad has size 7 (3 nseg + 1),
+    // else std::invalid_argument is thrown).
+    void compute_mc_grad(workspace &ws, std::array<double, 49> &grad_rvms, std::array<double, 49> &grad_rvmf,
+                         std::span<double> grad) const;
 
     // Compute throttle constraint gradients
     [[nodiscard]] std::vector<double> compute_tc_grad() const;
 
-private:
-    [[nodiscard]] std::pair<std::array<double, 49>, std::vector<double>>
-    gradients_multiple_impulses(std::vector<double>::const_iterator th1, std::vector<double>::const_iterator th2,
-                                // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-                                const std::array<std::array<double, 3>, 2> &rvs, double ms, double c, double a,
-                                double dt) const;
-
-    [[nodiscard]] std::pair<std::array<double, 49>, std::vector<double>>
-    gradients_fwd(std::vector<double>::const_iterator th1, std::vector<double>::const_iterator th2,
-                  // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-                  const std::array<std::array<double, 3>, 2> &rvs, double ms, double c, double a, double dt) const;
-
-    [[nodiscard]] std::pair<std::array<double, 49>, std::vector<double>>
-    gradients_bck(std::vector<double>::const_iterator th1, std::vector<double>::const_iterator th2,
-                  // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-                  const std::array<std::array<double, 3>, 2> &rvf_orig, double mf, double c, double a, double dt) const;
+    // Sparse Jacobian of the constraints [mc (7), tc (nseg)] w.r.t. [xs (7), throttles (3 nseg), xf (7), tof].
+    // The values are written in the order of the pattern, see kep3::leg::sparsity_pattern.
+    [[nodiscard]] sparsity_pattern get_grad_sparsity() const;
+    [[nodiscard]] std::size_t get_grad_nnz() const;
+    [[nodiscard]] std::vector<double> compute_grad_sparse() const;
+    // Allocation free version (values has size get_grad_nnz(), else std::invalid_argument is thrown).
+    void compute_grad_sparse(workspace &ws, std::span<double> values) const;
 
+private:
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive &ar, const unsigned int)
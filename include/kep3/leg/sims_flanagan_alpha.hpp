@@ -83,8 +83,15 @@ public:
     [[nodiscard]] std::array<double, 7> compute_mismatch_constraints() const;
     [[nodiscard]] std::vector<double> compute_throttle_constraints() const;
 
-private:
+    // Compute mismatch constraint gradients (w.r.t. rvm state and w.r.t. throttles, talphas, tof). The third
+    // gradient has size 7 x (4 nseg + 1), its tof column is zero as the segment durations are the talphas.
+    [[nodiscard]] std::tuple<std::array<double, 49>, std::array<double, 49>, std::vector<double>>
+    compute_mc_grad() const;
+
+    // Compute throttle constraint gradients
+    [[nodiscard]] std::vector<double> compute_tc_grad() const;
 
+private:
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive &ar, const unsigned int)
@@ -0,0 +1,149 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef kep3_LEG_SIMS_FLANAGAN_SEQUENCE_H
+#define kep3_LEG_SIMS_FLANAGAN_SEQUENCE_H
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include <fmt/ostream.h>
+
+#include <kep3/detail/s11n.hpp>
+#include <kep3/detail/visibility.hpp>
+#include <kep3/leg/sims_flanagan.hpp>
+#include <kep3/leg/sparsity.hpp>
+#include <kep3/planet.hpp>
+
+namespace kep3::leg
+{
+
+/// A sequence of Sims-Flanagan legs
+/**
+ * Chains N kep3::leg::sims_flanagan legs along a sequence of N + 1 planets. Leg i departs from the planet i at the
+ * epoch t_i and arrives at the planet i + 1 at the epoch t_{i+1} = t_i + tof_i, starting with the final mass of the
+ * previous leg (or with the initial mass, for the first leg). The legs are set from the flat decision vector:
+ *
+ * x = [t0, leg_0, leg_1, ..., leg_{N-1}], with leg_i = [mf, vinfs (3), vinff (3), throttles (3 nseg_i), tof]
+ *
+ * where t0 and the tofs are in days (t0 in MJD2000), vinfs and vinff are the departure and arrival velocities
+ * relative to the planets and all the other quantities are in the units of the ephemerides of the planets (S.I.).
+ *
+ * The constraints are [mc_0, ..., mc_{N-1}, tc_0, ..., tc_{N-1}], i.e. the mismatch constraints (equalities) of all
+ * the legs followed by their throttle constraints (inequalities). They, and their sparse Jacobian with respect to x,
+ * are computed in one call, evaluating the legs in parallel. The constraints at the planets (e.g. on the relative
+ * velocities at the flybys) are left to the caller (typically a UDP).
+ */
+class kep3_DLL_PUBLIC sims_flanagan_sequence
+{
+    std::vector<kep3::planet> m_seq;
+    double m_ms = 1.;
+    std::vector<sims_flanagan> m_legs;
+    // The decision vector (empty until set_x() is called).
+    std::vector<double> m_x;
+    // The epochs (MJD2000) and the ephemerides of the planets at the nodes.
+    std::vector<double> m_epochs;
+    std::vector<std::array<std::array<double, 3>, 2>> m_rv;
+    // Where the block of each leg starts in x, and where the mismatch and throttle constraints of each leg start in
+    // the values of the sparse Jacobian (with the total as last element).
+    std::vector<std::size_t> m_x_offset;
+    std::vector<std::size_t> m_mc_nnz_offset;
+    std::vector<std::size_t> m_tc_nnz_offset;
+    // The memory used by compute_grad_sparse() for the gradient of each leg, kept across the calls so that they do
+    // not allocate (not archived).
+    struct leg_scratch {
+        sims_flanagan::workspace m_ws;
+        std::vector<double> m_grad;
+    };
+    mutable std::vector<leg_scratch> m_scratch;
+    // The accelerations of the planets at the nodes, computed by the first compute_grad_sparse() after set_x() (not
+    // archived).
+    mutable std::vector<std::array<double, 3>> m_acc;
+
+    friend class boost::serialization::access;
+    template <typename Archive>
+    void serialize(Archive &ar, unsigned)
+    {
+        ar & m_seq;
+        ar & m_ms;
+        ar & m_legs;
+        ar & m_x;
+        ar & m_epochs;
+        ar & m_rv;
+        ar & m_x_offset;
+        ar & m_mc_nnz_offset;
+        ar & m_tc_nnz_offset;
+    }
+
+    void check_x_set() const;
+
+public:
+    sims_flanagan_sequence();
+    /// Constructor
+    /**
+     * @param seq the N + 1 planets.
+     * @param nsegs the number of segments of each of the N legs.
+     * @param ms the initial mass.
+     * @param max_thrust, veff, mu, cut the parameters of the legs (see kep3::leg::sims_flanagan).
+     *
+     * @throws std::invalid_argument if the sizes of seq and nsegs are inconsistent or a leg has no segments.
+     */
+    sims_flanagan_sequence(const std::vector<kep3::planet> &seq, const std::vector<unsigned> &nsegs, double ms,
+                           double max_thrust, double veff, double mu, double cut = 0.5);
+
+    /// Sets the legs from a decision vector
+    /**
+     * Computes the ephemerides of the planets at the N + 1 epochs, serially. Their accelerations, only needed by
+     * the gradient, are computed by compute_grad_sparse() (by central differences of the ephemerides for the planets
+     * not implementing kep3::planet::acc()).
+     *
+     * @throws std::invalid_argument if x does not have size get_nx().
+     */
+    void set_x(const std::vector<double> &x);
+
+    // Getters
+    [[nodiscard]] const std::vector<kep3::planet> &get_seq() const;
+    [[nodiscard]] double get_ms() const;
+    [[nodiscard]] const std::vector<sims_flanagan> &get_legs() const;
+    [[nodiscard]] std::size_t get_nlegs() const;
+    [[nodiscard]] const std::vector<double> &get_x() const;
+    [[nodiscard]] const std::vector<double> &get_epochs() const;
+    // The size of the decision vector.
+    [[nodiscard]] std::size_t get_nx() const;
+    // The number of mismatch (7 N) and throttle (sum of the nseg_i) constraints.
+    [[nodiscard]] std::size_t get_nec() const;
+    [[nodiscard]] std::size_t get_nic() const;
+
+    // The constraints (throw std::logic_error if set_x() was never called).
+    [[nodiscard]] std::vector<double> compute_constraints() const;
+    // Sparse Jacobian of the constraints w.r.t. x. The values are written in the order of the pattern, see
+    // kep3::leg::sparsity_pattern.
+    [[nodiscard]] sparsity_pattern get_grad_sparsity() const;
+    [[nodiscard]] std::size_t get_grad_nnz() const;
+    // NOTE: the legs reuse their memory across the calls, so that compute_grad_sparse() must not be called
+    // concurrently on the same object.
+    [[nodiscard]] std::vector<double> compute_grad_sparse() const;
+    // Version writing in a caller-owned buffer (of size get_grad_nnz(), else std::invalid_argument is thrown).
+    void compute_grad_sparse(std::span<double> values) const;
+};
+
+// Streaming operator for the class kep3::leg::sims_flanagan_sequence.
+kep3_DLL_PUBLIC std::ostream &operator<<(std::ostream &, const sims_flanagan_sequence &);
+
+} // namespace kep3::leg
+
+template <>
+struct fmt::formatter<kep3::leg::sims_flanagan_sequence> : fmt::ostream_formatter {
+};
+
+#endif // kep3_LEG_SIMS_FLANAGAN_SEQUENCE_H
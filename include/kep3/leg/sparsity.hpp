@@ -0,0 +1,45 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef kep3_LEG_SPARSITY_H
+#define kep3_LEG_SPARSITY_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace kep3::leg
+{
+
+/// The sparsity pattern of a Jacobian
+/**
+ * The (row, column) indices of the structural nonzeros, sorted in row major order (the layout of
+ * pagmo::sparsity_pattern). The values written by the compute_grad_sparse() methods of the legs follow the
+ * same order, so that they are, at the same time, the values of the COO format and the data of the CSR format.
+ */
+using sparsity_pattern = std::vector<std::pair<std::size_t, std::size_t>>;
+
+// The CSR row pointers (of size n_rows + 1) of a sparsity pattern. The CSR column indices are the second
+// elements of the pattern.
+inline std::vector<std::size_t> csr_row_ptr(const sparsity_pattern &sp, std::size_t n_rows)
+{
+    std::vector<std::size_t> retval(n_rows + 1u, 0u);
+    for (const auto &rc : sp) {
+        ++retval[rc.first + 1u];
+    }
+    for (std::size_t r = 0u; r < n_rows; ++r) {
+        retval[r + 1u] += retval[r];
+    }
+    return retval;
+}
+
+} // namespace kep3::leg
+
+#endif // kep3_LEG_SPARSITY_H
@@ -11,7 +11,9 @@
 #ifndef kep3_LEG_ZOH_H
 #define kep3_LEG_ZOH_H
 
+#include <cstddef>
 #include <optional>
+#include <span>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -21,6 +23,8 @@
 #include <heyoka/taylor.hpp>
 
 #include <kep3/detail/visibility.hpp>
+#include <kep3/leg/sparsity.hpp>
+#include <kep3/ta/pool.hpp>
 
 namespace kep3::leg
 {
@@ -55,6 +59,11 @@ public:
         const std::vector<double> &tgrid, double cut,
         const std::pair<heyoka::taylor_adaptive<double>, std::optional<heyoka::taylor_adaptive<double>>> &tas,
         std::optional<unsigned> max_steps = std::nullopt, unsigned dim_dynamics = 7u, unsigned dim_controls = 4u);
+    // Constructor taking integrators acquired from the pools of kep3::ta (e.g. kep3::ta::acquire_ta_zoh_kep). They
+    // are returned to the pool when the leg is destroyed, so that constructing legs in a loop does not deep copy them.
+    zoh(const std::vector<double> &state0, const std::vector<double> &controls, const std::vector<double> &state1,
+        const std::vector<double> &tgrid, double cut, ta::ta_handle ta, std::optional<ta::ta_handle> ta_var,
+        std::optional<unsigned> max_steps = std::nullopt, unsigned dim_dynamics = 7u, unsigned dim_controls = 4u);
 
     // Setters
     void set_state0(const std::vector<double> &state0);
@@ -77,7 +86,10 @@ public:
     [[nodiscard]] unsigned get_dim_controls() const;
     [[nodiscard]] std::optional<unsigned> get_max_steps() const;
     [[nodiscard]] const heyoka::taylor_adaptive<double> &get_ta() const;
-    [[nodiscard]] const std::optional<heyoka::taylor_adaptive<double>> &get_ta_var() const;
+    // Null if the leg has no variational integrator.
+    // NOTE: up to 3.0 this returned a const std::optional<heyoka::taylor_adaptive<double>> &, the integrators are
+    // now held by (possibly pooled) ta::ta_handle objects.
+    [[nodiscard]] const heyoka::taylor_adaptive<double> *get_ta_var() const;
     [[nodiscard]] bool has_ta_var() const;
     [[nodiscard]] unsigned get_nseg() const;
     [[nodiscard]] unsigned get_nseg_fwd() const;
@@ -92,6 +104,16 @@ public:
     [[nodiscard]] std::tuple<std::vector<double>, std::vector<double>, std::vector<double>, std::vector<double>>
     compute_mc_grad() const;
 
+    // Sparse Jacobian of the mismatch constraints w.r.t. [x0 (d), controls (c * nseg), x1 (d), tgrid (nseg + 1)].
+    // NOTE: the dynamics are generic, so that the pattern is dense and the sparse API is only a layout adapter:
+    // compute_grad_sparse() calls compute_mc_grad() (which allocates the four dense blocks) and interleaves their
+    // rows in the output. Unlike for sims_flanagan, passing a caller-owned buffer does not avoid the allocations.
+    [[nodiscard]] sparsity_pattern get_grad_sparsity() const;
+    [[nodiscard]] std::size_t get_grad_nnz() const;
+    [[nodiscard]] std::vector<double> compute_grad_sparse() const;
+    // Version writing in a caller-owned buffer (of size get_grad_nnz(), else std::invalid_argument is thrown).
+    void compute_grad_sparse(std::span<double> values) const;
+
     /**
      * Returns state histories sampled along each ZOH segment, for both the forward and backward propagation parts of
      * the leg. The sampling is performed by propagating the nominal integrator on a uniformly-spaced grid of N points
@@ -122,8 +144,8 @@ private:
     unsigned m_dim_controls = 4u;
 
     // Taylor-adaptive integrators
-    mutable heyoka::taylor_adaptive<double> m_ta;
-    mutable std::optional<heyoka::taylor_adaptive<double>> m_ta_var;
+    ta::ta_handle m_ta;
+    std::optional<ta::ta_handle> m_ta_var;
 
     // Derived quantities
     std::vector<double> m_pars_no_control;
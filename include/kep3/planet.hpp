@@ -11,10 +11,15 @@
 #ifndef kep3_PLANET_H
 #define kep3_PLANET_H
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <exception>
+#include <span>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 #include <boost/core/demangle.hpp>
 #include <boost/safe_numerics/safe_integer.hpp>
@@ -61,6 +66,12 @@ concept udpla_has_eph_v = requires(const T &p, const std::vector<double> &mjd200
     { p.eph_v(mjd2000s) } -> std::same_as<std::vector<double>>;
 };
 
+// The allocation free versions, writing the results of N epochs in an output of size 6N.
+template <typename T>
+concept udpla_has_eph_v_span = requires(const T &p, std::span<const double> mjd2000s, std::span<double> out) {
+    { p.eph_v(mjd2000s, out) } -> std::same_as<void>;
+};
+
 template <typename T>
 concept udpla_has_acc = requires(const T &p, double mjd2000) {
     { p.acc(mjd2000) } -> std::same_as<std::array<double, 3>>;
@@ -71,6 +82,12 @@ concept udpla_has_acc_v = requires(const T &p, const std::vector<double> &mjd200
     { p.acc_v(mjd2000s) } -> std::same_as<std::vector<double>>;
 };
 
+// The allocation free versions, writing the results of N epochs in an output of size 3N.
+template <typename T>
+concept udpla_has_acc_v_span = requires(const T &p, std::span<const double> mjd2000s, std::span<double> out) {
+    { p.acc_v(mjd2000s, out) } -> std::same_as<void>;
+};
+
 template <typename T>
 concept udpla_has_period = requires(const T &p, double mjd2000) {
     { p.period(mjd2000) } -> std::same_as<double>;
@@ -103,10 +120,13 @@ struct kep3_DLL_PUBLIC planet_iface {
 
     [[nodiscard]] virtual std::array<std::array<double, 3>, 2> eph(double) const = 0;
     [[nodiscard]] virtual std::vector<double> eph_v(const std::vector<double> &) const = 0;
+    // Writes the ephemerides of N epochs in an output of size 6N, without allocating.
+    virtual void eph_v(std::span<const double>, std::span<double>) const = 0;
     // If implemented returns the acceleration vector at mjd2000
     [[nodiscard]] virtual std::array<double, 3> acc(double) const = 0;
     [[nodiscard]] virtual std::vector<double> acc_v(const std::vector<double> &) const = 0;
-
+    // Writes the accelerations at N epochs in an output of size 3N, without allocating.
+    virtual void acc_v(std::span<const double>, std::span<double>) const = 0;
 
     // NOLINTNEXTLINE(google-default-arguments)
     [[nodiscard]] virtual double period(double = 0.) const = 0;
@@ -144,39 +164,58 @@ struct kep3_DLL_PUBLIC planet_iface {
 kep3_DLL_PUBLIC double period_from_energy(const std::array<double, 3> &, const std::array<double, 3> &, double);
 kep3_DLL_PUBLIC std::array<double, 6> elements_from_posvel(const std::array<std::array<double, 3>, 2> &, double,
                                                            kep3::elements_type);
+// Throws std::invalid_argument if out does not have size dim * mjd2000s.size().
+kep3_DLL_PUBLIC void check_vectorized_output(const char *name, std::size_t n_epochs, std::size_t dim,
+                                             std::size_t out_size);
+
 template <typename T>
-std::vector<double> default_eph_vectorization(const T *self, const std::vector<double> &mjd2000s)
+void default_eph_vectorization(const T *self, std::span<const double> mjd2000s, std::span<double> out)
 {
+    check_vectorized_output("eph_v", mjd2000s.size(), 6u, out.size());
     // We simply call a for loop.
     const auto size = mjd2000s.size();
-    using size_type = std::vector<double>::size_type;
-    std::vector<double> retval;
-    retval.resize(boost::safe_numerics::safe<size_type>(size) * 6);
     for (decltype(mjd2000s.size()) i = 0u; i < size; ++i) {
         auto values = self->eph(mjd2000s[i]);
-        retval[6 * i] = values[0][0];
-        retval[6 * i + 1] = values[0][1];
-        retval[6 * i + 2] = values[0][2];
-        retval[6 * i + 3] = values[1][0];
-        retval[6 * i + 4] = values[1][1];
-        retval[6 * i + 5] = values[1][2];
+        out[6 * i] = values[0][0];
+        out[6 * i + 1] = values[0][1];
+        out[6 * i + 2] = values[0][2];
+        out[6 * i + 3] = values[1][0];
+        out[6 * i + 4] = values[1][1];
+        out[6 * i + 5] = values[1][2];
     }
+}
+
+template <typename T>
+std::vector<double> default_eph_vectorization(const T *self, const std::vector<double> &mjd2000s)
+{
+    using size_type = std::vector<double>::size_type;
+    std::vector<double> retval;
+    retval.resize(boost::safe_numerics::safe<size_type>(mjd2000s.size()) * 6);
+    default_eph_vectorization(self, std::span<const double>(mjd2000s), std::span<double>(retval));
     return retval;
 }
 
 template <typename T>
-std::vector<double> default_acc_vectorization(const T *self, const std::vector<double> &mjd2000s)
+void default_acc_vectorization(const T *self, std::span<const double> mjd2000s, std::span<double> out)
 {
+    check_vectorized_output("acc_v", mjd2000s.size(), 3u, out.size());
     // We simply call a for loop.
     const auto size = mjd2000s.size();
-    std::vector<double> retval(size * 3);
     for (decltype(mjd2000s.size()) i = 0u; i < size; ++i) {
         auto value = self->acc(mjd2000s[i]);
-        retval[3*i] = value[0];
-        retval[3*i + 1] = value[1];
-        retval[3*i + 2] = value[2];
-
+        out[3 * i] = value[0];
+        out[3 * i + 1] = value[1];
+        out[3 * i + 2] = value[2];
     }
+}
+
+template <typename T>
+std::vector<double> default_acc_vectorization(const T *self, const std::vector<double> &mjd2000s)
+{
+    using size_type = std::vector<double>::size_type;
+    std::vector<double> retval;
+    retval.resize(boost::safe_numerics::safe<size_type>(mjd2000s.size()) * 3);
+    default_acc_vectorization(self, std::span<const double>(mjd2000s), std::span<double>(retval));
     return retval;
 }
 
@@ -200,11 +239,31 @@ struct planet_iface_impl : public Base {
     {
         if constexpr (udpla_has_eph_v<T>) {
             return getval<Holder>(this).eph_v(mjd2000s);
+        } else if constexpr (udpla_has_eph_v_span<T>) {
+            std::vector<double> retval;
+            retval.resize(boost::safe_numerics::safe<std::size_t>(mjd2000s.size()) * 6);
+            getval<Holder>(this).eph_v(std::span<const double>(mjd2000s), std::span<double>(retval));
+            return retval;
         } else {
             return default_eph_vectorization(this, mjd2000s);
         }
     }
 
+    void eph_v(std::span<const double> mjd2000s, std::span<double> out) const final
+    {
+        check_vectorized_output("eph_v", mjd2000s.size(), 6u, out.size());
+        if constexpr (udpla_has_eph_v_span<T>) {
+            getval<Holder>(this).eph_v(mjd2000s, out);
+        } else if constexpr (udpla_has_eph_v<T>) {
+            // Only the allocating version is available.
+            const auto retval = getval<Holder>(this).eph_v(std::vector<double>(mjd2000s.begin(), mjd2000s.end()));
+            check_vectorized_output("eph_v", mjd2000s.size(), 6u, retval.size());
+            std::copy(retval.begin(), retval.end(), out.begin());
+        } else {
+            default_eph_vectorization(this, mjd2000s, out);
+        }
+    }
+
     [[nodiscard]] std::array<double, 3> acc(double mjd2000) const final
     {
         if constexpr (udpla_has_acc<T>) {
@@ -232,11 +291,31 @@ struct planet_iface_impl : public Base {
     {
         if constexpr (udpla_has_acc_v<T>) {
             return getval<Holder>(this).acc_v(mjd2000s);
+        } else if constexpr (udpla_has_acc_v_span<T>) {
+            std::vector<double> retval;
+            retval.resize(boost::safe_numerics::safe<std::size_t>(mjd2000s.size()) * 3);
+            getval<Holder>(this).acc_v(std::span<const double>(mjd2000s), std::span<double>(retval));
+            return retval;
         } else {
             return default_acc_vectorization(this, mjd2000s);
         }
     }
 
+    void acc_v(std::span<const double> mjd2000s, std::span<double> out) const final
+    {
+        check_vectorized_output("acc_v", mjd2000s.size(), 3u, out.size());
+        if constexpr (udpla_has_acc_v_span<T>) {
+            getval<Holder>(this).acc_v(mjd2000s, out);
+        } else if constexpr (udpla_has_acc_v<T>) {
+            // Only the allocating version is available.
+            const auto retval = getval<Holder>(this).acc_v(std::vector<double>(mjd2000s.begin(), mjd2000s.end()));
+            check_vectorized_output("acc_v", mjd2000s.size(), 3u, retval.size());
+            std::copy(retval.begin(), retval.end(), out.begin());
+        } else {
+            default_acc_vectorization(this, mjd2000s, out);
+        }
+    }
+
     // NOLINTNEXTLINE(google-default-arguments)
     [[nodiscard]] double period(double mjd2000 = 0.) const final
     {
@@ -401,6 +480,11 @@ public:
     {
         return m_wrap.eph_v(mjd2000s);
     }
+    // NOTE: out must have size 6 mjd2000s.size(), else std::invalid_argument is thrown.
+    void eph_v(std::span<const double> mjd2000s, std::span<double> out) const
+    {
+        m_wrap.eph_v(mjd2000s, out);
+    }
     [[nodiscard]] std::array<double, 3> acc(double mjd2000) const
     {
         return m_wrap.acc(mjd2000);
@@ -409,6 +493,11 @@ public:
     {
         return m_wrap.acc_v(mjd2000s);
     }
+    // NOTE: out must have size 3 mjd2000s.size(), else std::invalid_argument is thrown.
+    void acc_v(std::span<const double> mjd2000s, std::span<double> out) const
+    {
+        m_wrap.acc_v(mjd2000s, out);
+    }
     [[nodiscard]] double period(double mjd2000 = 0.) const
     {
         return m_wrap.period(mjd2000);
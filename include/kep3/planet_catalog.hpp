@@ -0,0 +1,142 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef kep3_PLANET_CATALOG_H
+#define kep3_PLANET_CATALOG_H
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <fmt/ostream.h>
+
+#include <kep3/detail/s11n.hpp>
+#include <kep3/detail/visibility.hpp>
+#include <kep3/epoch.hpp>
+#include <kep3/planet.hpp>
+#include <kep3/udpla/keplerian.hpp>
+
+namespace kep3
+{
+
+/// A catalog of Keplerian bodies
+/**
+ * Stores many Keplerian bodies (e.g. the asteroids of a database) in structure of arrays form, so
+ * that the ephemerides of the whole catalog, or of a subset of it, are computed in one call solving
+ * Kepler's equation with the vectorized anomaly conversions and, for large queries, in parallel.
+ * This avoids the per body type erased calls (and the scattered memory) of a std::vector<kep3::planet>.
+ *
+ * Bodies are added as kep3::udpla::keplerian (or kep3::planet holding one) and can be retrieved
+ * individually as kep3::planet.
+ */
+class kep3_DLL_PUBLIC planet_catalog
+{
+    // The reference state, kept to rebuild the bodies as kep3::planet.
+    std::vector<kep3::epoch> m_ref_epoch;
+    std::vector<std::array<std::array<double, 3>, 2>> m_pos_vel_0;
+    std::vector<std::string> m_name;
+    std::vector<double> m_mu_self;
+    std::vector<double> m_radius;
+    std::vector<double> m_safe_radius;
+    // The perifocal data (see kep3/detail/perifocal.hpp), one array per quantity.
+    std::array<std::vector<double>, 3> m_P;
+    std::array<std::vector<double>, 3> m_Q;
+    std::vector<double> m_a;
+    std::vector<double> m_ecc;
+    std::vector<double> m_n;
+    std::vector<double> m_anomaly0;
+    std::vector<double> m_ref_mjd2000;
+    std::vector<double> m_mu;
+
+    friend class boost::serialization::access;
+    template <typename Archive>
+    void serialize(Archive &ar, unsigned)
+    {
+        ar & m_ref_epoch;
+        ar & m_pos_vel_0;
+        ar & m_name;
+        ar & m_mu_self;
+        ar & m_radius;
+        ar & m_safe_radius;
+        ar & m_P;
+        ar & m_Q;
+        ar & m_a;
+        ar & m_ecc;
+        ar & m_n;
+        ar & m_anomaly0;
+        ar & m_ref_mjd2000;
+        ar & m_mu;
+    }
+
+    // Writes the ephemerides of bodies[k] at mjd2000s[k * stride] in out[6k, 6k + 6).
+    void eph_impl(const std::size_t *bodies, std::size_t n, const double *mjd2000s, std::size_t stride,
+                  double *out) const;
+
+public:
+    planet_catalog();
+    /// Constructor from planets
+    /**
+     * @param planets the bodies, each holding a kep3::udpla::keplerian.
+     *
+     * @throws std::invalid_argument if a planet does not hold a kep3::udpla::keplerian.
+     */
+    explicit planet_catalog(const std::vector<kep3::planet> &planets);
+
+    // Adds a body at the end of the catalog.
+    void push_back(const kep3::udpla::keplerian &);
+    void push_back(const kep3::planet &);
+
+    [[nodiscard]] std::size_t size() const;
+
+    /// Single body access
+    /**
+     * @param i the index of the body.
+     *
+     * @return a kep3::planet holding the i-th body as kep3::udpla::keplerian.
+     *
+     * @throws std::out_of_range if i is not smaller than the catalog size.
+     */
+    [[nodiscard]] kep3::planet get_planet(std::size_t i) const;
+    [[nodiscard]] std::string get_name(std::size_t i) const;
+
+    /// Ephemerides of all the bodies
+    /**
+     * @param mjd2000 the epoch.
+     *
+     * @return the flattened positions and velocities of all the bodies, size 6 N.
+     */
+    [[nodiscard]] std::vector<double> eph_all(double mjd2000) const;
+    [[nodiscard]] std::vector<double> eph_all(const kep3::epoch &) const;
+
+    /// Ephemerides of some of the bodies
+    /**
+     * @param indices the indices of the bodies (repetitions allowed).
+     * @param mjd2000s the epochs, one per index or a single one shared by all.
+     *
+     * @return the flattened positions and velocities, size 6 K with K the number of indices.
+     *
+     * @throws std::out_of_range if an index is not smaller than the catalog size.
+     * @throws std::invalid_argument if the number of epochs is neither 1 nor the number of indices.
+     */
+    [[nodiscard]] std::vector<double> eph_subset(const std::vector<std::size_t> &indices,
+                                                 const std::vector<double> &mjd2000s) const;
+};
+
+kep3_DLL_PUBLIC std::ostream &operator<<(std::ostream &, const planet_catalog &);
+
+} // namespace kep3
+
+template <>
+struct fmt::formatter<kep3::planet_catalog> : fmt::ostream_formatter {
+};
+
+#endif // kep3_PLANET_CATALOG_H
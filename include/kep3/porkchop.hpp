@@ -0,0 +1,73 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef kep3_PORKCHOP_H
+#define kep3_PORKCHOP_H
+
+#include <cstddef>
+#include <vector>
+
+#include <kep3/detail/visibility.hpp>
+#include <kep3/planet.hpp>
+
+namespace kep3
+{
+
+/// The results of a porkchop grid evaluation
+/**
+ * All quantities are stored densely in row major order, with one row per departure epoch and
+ * one column per arrival epoch (n_dep x n_arr). Vectors have an additional trailing dimension of size 3.
+ * For each cell, only the Lambert solution (branch) with the lowest total DV is retained.
+ *
+ * Cells where the arrival epoch does not follow the departure epoch, or where the Lambert problem is
+ * ill defined (e.g. coincident positions), are filled with NaNs and have a branch index of -1.
+ */
+struct kep3_DLL_PUBLIC porkchop_data {
+    std::size_t n_dep = 0u;
+    std::size_t n_arr = 0u;
+    // Departure DV, i.e. the magnitude of the departure hyperbolic excess velocity.
+    std::vector<double> dv_dep;
+    // Arrival DV, i.e. the magnitude of the arrival hyperbolic excess velocity.
+    std::vector<double> dv_arr;
+    // Departure characteristic energy (dv_dep squared).
+    std::vector<double> c3;
+    // Departure hyperbolic excess velocity (v0 - v_planet0), size 3 n_dep n_arr.
+    std::vector<double> vinf_dep;
+    // Arrival hyperbolic excess velocity (v1 - v_planet1), size 3 n_dep n_arr.
+    std::vector<double> vinf_arr;
+    // Index of the retained Lambert solution as in kep3::lambert_problem (0 for the single revolution,
+    // 2N-1 and 2N for the left and right N revolutions solutions).
+    std::vector<int> branch;
+};
+
+/// Porkchop grid
+/**
+ * Computes a launch window (porkchop) grid between two planets. The ephemerides are computed once per
+ * grid axis via kep3::planet::eph_v, then the departure x arrival grid of Lambert problems is solved
+ * in parallel. All solutions up to multi_revs revolutions are considered and the one with the lowest
+ * total DV (dv_dep + dv_arr) is returned for each cell.
+ *
+ * @param pl0 the departure planet.
+ * @param pl1 the arrival planet.
+ * @param t0s the departure epochs (mjd2000).
+ * @param t1s the arrival epochs (mjd2000).
+ * @param multi_revs maximum number of revolutions to consider.
+ * @param cw true for retrograde (clockwise) transfers.
+ *
+ * @return the porkchop_data.
+ *
+ * @throws std::invalid_argument if the planets do not share the same (positive) central body parameter.
+ */
+kep3_DLL_PUBLIC porkchop_data porkchop(const planet &pl0, const planet &pl1, const std::vector<double> &t0s,
+                                       const std::vector<double> &t1s, unsigned multi_revs = 0u, bool cw = false);
+
+} // namespace kep3
+
+#endif // kep3_PORKCHOP_H
@@ -0,0 +1,59 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef kep3_PREWARM_H
+#define kep3_PREWARM_H
+
+#include <string>
+#include <vector>
+
+#include <kep3/core_astro/constants.hpp>
+#include <kep3/detail/visibility.hpp>
+
+namespace kep3
+{
+
+/// An item to be compiled by kep3::prewarm
+struct kep3_DLL_PUBLIC prewarm_spec {
+    // The model. One of the Taylor integrators of kep3::ta, named as their getter without the get_ta_
+    // prefix ("kep", "kep_var", "cr3bp", "cr3bp_var", "bcp", "bcp_var", "zoh_kep", "zoh_kep_var", "zoh_eq",
+    // "zoh_eq_var", "zoh_cr3bp", "zoh_cr3bp_var", "zoh_ss", "zoh_ss_var", "pc", "pc_var", "peq", "peq_var"),
+    // the compiled functions of the Pontryagin problems ("pc_cfuncs", "peq_cfuncs") or the VSOP2013 series
+    // of a body ("vsop2013:" followed by the body name, e.g. "vsop2013:earth_moon").
+    std::string model;
+    // The tolerance of the Taylor integrators, or the truncation threshold of the VSOP2013 series.
+    double tol = 1e-16;
+    // The optimality of the Pontryagin problems. Ignored by the other models.
+    optimality_type optimality = optimality_type::MASS;
+};
+
+/// Compiles integrators and compiled functions ahead of use
+/**
+ * The Taylor integrators of kep3::ta, their auxiliary compiled functions and the VSOP2013 series are JIT
+ * compiled (or loaded from the persistent JIT cache, see kep3::set_jit_cache_dir) the first time they are
+ * requested in a process, which can take from seconds to minutes. This function compiles the requested
+ * items concurrently and returns once they are all in the in-memory caches, so that later requests do not
+ * incur the compilation latency.
+ *
+ * Items already in the in-memory caches are not compiled again.
+ *
+ * @param specs the items to compile.
+ *
+ * @return the wall clock time (in seconds) spent on each item, in the order of \p specs.
+ *
+ * @throws std::invalid_argument if a model is not known. No item is compiled in that case.
+ * @throws unspecified any exception thrown while compiling an item (e.g. by kep3::udpla::vsop2013 for an
+ * unknown body).
+ */
+kep3_DLL_PUBLIC std::vector<double> prewarm(const std::vector<prewarm_spec> &specs);
+
+} // namespace kep3
+
+#endif // kep3_PREWARM_H
@@ -25,10 +25,9 @@ namespace kep3::ta
 // From Newton to Chaos: modern techniques for understanding and coping with chaos in n-body dynamical systems. Boston, MA: Springer US, 1995. 343-370.
 kep3_DLL_PUBLIC std::vector<std::pair<heyoka::expression, heyoka::expression>> bcp_dyn();
 
-// These return const references to function level static variables of type heyoka::taylor_adaptive<double>.
-// NOTE: The object retruned are expected to be copied to then be modified.
-kep3_DLL_PUBLIC const heyoka::taylor_adaptive<double> &get_ta_bcp(double tol);
-kep3_DLL_PUBLIC const heyoka::taylor_adaptive<double> &get_ta_bcp_var(double tol); // variational (x,y,z,vx,vy,vz) first order
+// These return copies of the integrators kept in an in-memory cache (see kep3/jit_cache.hpp).
+kep3_DLL_PUBLIC heyoka::taylor_adaptive<double> get_ta_bcp(double tol);
+kep3_DLL_PUBLIC heyoka::taylor_adaptive<double> get_ta_bcp_var(double tol); // variational (x,y,z,vx,vy,vz) first order
 
 // Methods to access the cache dimensions.
 kep3_DLL_PUBLIC size_t get_ta_bcp_cache_dim();
@@ -29,10 +29,9 @@ kep3_DLL_PUBLIC heyoka::expression cr3bp_jacobi_C();
 // Returns the effective potential of the cr3bp (heyoka expression). 6 states, 1 parameter: mu.
 kep3_DLL_PUBLIC heyoka::expression cr3bp_effective_potential_U();
 
-// These return const references to function level static variables of type heyoka::taylor_adaptive<double>.
-// NOTE: The object retruned are expected to be copied to then be modified.
-kep3_DLL_PUBLIC const heyoka::taylor_adaptive<double> &get_ta_cr3bp(double tol);
-kep3_DLL_PUBLIC const heyoka::taylor_adaptive<double> &get_ta_cr3bp_var(double tol); // variational (x,y,z,vx,vy,vz) first order
+// These return copies of the integrators kept in an in-memory cache (see kep3/jit_cache.hpp).
+kep3_DLL_PUBLIC heyoka::taylor_adaptive<double> get_ta_cr3bp(double tol);
+kep3_DLL_PUBLIC heyoka::taylor_adaptive<double> get_ta_cr3bp_var(double tol); // variational (x,y,z,vx,vy,vz) first order
 
 // Methods to access the cache dimensions.
 kep3_DLL_PUBLIC size_t get_ta_cr3bp_cache_dim();
@@ -23,10 +23,9 @@ namespace kep3::ta
 // Returns the Keplerian dynamics in Cartesian coordinates. 6 states, 1 parameter: mu.
 kep3_DLL_PUBLIC std::vector<std::pair<heyoka::expression, heyoka::expression>> kep_dyn();
 
-// These return const references to function level static variables of type heyoka::taylor_adaptive<double>.
-// NOTE: The object returned are expected to be copied to then be modified.
-kep3_DLL_PUBLIC const heyoka::taylor_adaptive<double> &get_ta_kep(double tol);
-kep3_DLL_PUBLIC const heyoka::taylor_adaptive<double> &get_ta_kep_var(double tol); // variational (x,y,z,vx,vy,vz) first order
+// These return copies of the integrators kept in an in-memory cache (see kep3/jit_cache.hpp).
+kep3_DLL_PUBLIC heyoka::taylor_adaptive<double> get_ta_kep(double tol);
+kep3_DLL_PUBLIC heyoka::taylor_adaptive<double> get_ta_kep_var(double tol); // variational (x,y,z,vx,vy,vz) first order
 
 // Methods to access the cache dimensions.
 kep3_DLL_PUBLIC size_t get_ta_kep_cache_dim();
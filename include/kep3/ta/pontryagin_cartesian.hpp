@@ -34,9 +34,9 @@ pc_expression_factory(kep3::optimality_type optimality);
 // Returns the dynamics only. Offered for convenience and consistency within the ta namespace.
 kep3_DLL_PUBLIC std::vector<std::pair<heyoka::expression, heyoka::expression>> pc_dyn(kep3::optimality_type optimality);
 
-// These return const references to function level static variables of type heyoka::taylor_adaptive<double>.
-kep3_DLL_PUBLIC const heyoka::taylor_adaptive<double> &get_ta_pc(double tol, kep3::optimality_type optimality);
-kep3_DLL_PUBLIC const heyoka::taylor_adaptive<double> &
+// These return copies of the integrators kept in an in-memory cache (see kep3/jit_cache.hpp).
+kep3_DLL_PUBLIC heyoka::taylor_adaptive<double> get_ta_pc(double tol, kep3::optimality_type optimality);
+kep3_DLL_PUBLIC heyoka::taylor_adaptive<double>
 get_ta_pc_var(double tol, kep3::optimality_type optimality); // variational (lx,ly,lz,lvx,lvy,lvz,lm,l0) first order
 
 // Methods to access the cache dimensions.
@@ -0,0 +1,95 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef kep3_TA_POOL_H
+#define kep3_TA_POOL_H
+
+#include <cstddef>
+#include <memory>
+
+#include <boost/serialization/level.hpp>
+#include <boost/serialization/tracking.hpp>
+
+#include <kep3/detail/s11n.hpp>
+#include <kep3/detail/visibility.hpp>
+
+#include <heyoka/taylor.hpp>
+
+namespace kep3::ta
+{
+// The getters of the cached integrators that can be pooled (e.g. get_ta_zoh_kep).
+using ta_getter_t = heyoka::taylor_adaptive<double> (*)(double);
+
+// The maximum number of free copies kept by the pool of a thread, per integrator and tolerance and in total.
+// Copies released to a full pool are destroyed.
+inline constexpr std::size_t ta_pool_max_free = 8;
+inline constexpr std::size_t ta_pool_max_size = 32;
+
+// Owning handle to a Taylor integrator, with value semantics.
+// A handle acquired for a cached integrator (e.g. by acquire_ta_zoh_kep) takes its copy from a pool local
+// to the calling thread and, on destruction, returns it to the pool of the destroying thread, where it is
+// handed out again by the next acquire_* call for the same integrator and (normalized) tolerance, avoiding
+// a deep copy. Copies of such a handle are pooled as well. A handle built from an integrator, or loaded
+// from an archive, is not pooled.
+// NOTE: a pooled copy keeps the time, state and parameters left by its previous user, they must
+// be set before use.
+class kep3_DLL_PUBLIC ta_handle
+{
+public:
+    // A non pooled, default constructed integrator.
+    ta_handle();
+    explicit ta_handle(heyoka::taylor_adaptive<double>);
+    ta_handle(ta_getter_t, double);
+    ta_handle(const ta_handle &);
+    ta_handle(ta_handle &&) noexcept;
+    ta_handle &operator=(const ta_handle &);
+    ta_handle &operator=(ta_handle &&) noexcept;
+    ~ta_handle();
+
+    [[nodiscard]] heyoka::taylor_adaptive<double> &operator*() const;
+    heyoka::taylor_adaptive<double> *operator->() const;
+    [[nodiscard]] heyoka::taylor_adaptive<double> *get() const;
+    [[nodiscard]] bool is_pooled() const;
+
+private:
+    void release() noexcept;
+
+    // NOTE: only the integrator is archived, so that the archives match those of a heyoka::taylor_adaptive.
+    friend class boost::serialization::access;
+    template <typename Archive>
+    void save(Archive &ar, unsigned) const
+    {
+        ar << *m_ta;
+    }
+    template <typename Archive>
+    void load(Archive &ar, unsigned)
+    {
+        auto ta = std::make_unique<heyoka::taylor_adaptive<double>>();
+        ar >> *ta;
+        release();
+        m_getter = nullptr;
+        m_tol = 0.;
+        m_ta = std::move(ta);
+    }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+    ta_getter_t m_getter = nullptr;
+    double m_tol = 0.;
+    std::unique_ptr<heyoka::taylor_adaptive<double>> m_ta;
+};
+
+// Number of copies currently in the pool of the calling thread.
+kep3_DLL_PUBLIC size_t get_ta_pool_dim();
+} // namespace kep3::ta
+
+BOOST_CLASS_IMPLEMENTATION(kep3::ta::ta_handle, boost::serialization::object_serializable)
+BOOST_CLASS_TRACKING(kep3::ta::ta_handle, boost::serialization::track_never)
+
+#endif
@@ -24,10 +24,9 @@ namespace kep3::ta
 // 7 states, 6 parameters: [T, i_x, i_y, i_z, c, mu].
 kep3_DLL_PUBLIC std::vector<std::pair<heyoka::expression, heyoka::expression>> zoh_cr3bp_dyn();
 
-// These return const references to function level static variables of type heyoka::taylor_adaptive<double>.
-// NOTE: The object returned are expected to be copied to then be modified.
-kep3_DLL_PUBLIC const heyoka::taylor_adaptive<double> &get_ta_zoh_cr3bp(double tol);
-kep3_DLL_PUBLIC const heyoka::taylor_adaptive<double> &
+// These return copies of the integrators kept in an in-memory cache (see kep3/jit_cache.hpp).
+kep3_DLL_PUBLIC heyoka::taylor_adaptive<double> get_ta_zoh_cr3bp(double tol);
+kep3_DLL_PUBLIC heyoka::taylor_adaptive<double>
 get_ta_zoh_cr3bp_var(double tol); // variational wrt (x,y,z,vx,vy,vz,m,T,ix,iy,iz), first order.
 
 // Methods to access the cache dimensions.
@@ -24,10 +24,9 @@ namespace kep3::ta
 // 7 states, 5 parameters: [T, i_r, i_t, i_n, c].
 kep3_DLL_PUBLIC std::vector<std::pair<heyoka::expression, heyoka::expression>> zoh_eq_dyn();
 
-// These return const references to function level static variables of type heyoka::taylor_adaptive<double>.
-// NOTE: The object returned are expected to be copied to then be modified.
-kep3_DLL_PUBLIC const heyoka::taylor_adaptive<double> &get_ta_zoh_eq(double tol);
-kep3_DLL_PUBLIC const heyoka::taylor_adaptive<double> &
+// These return copies of the integrators kept in an in-memory cache (see kep3/jit_cache.hpp).
+kep3_DLL_PUBLIC heyoka::taylor_adaptive<double> get_ta_zoh_eq(double tol);
+kep3_DLL_PUBLIC heyoka::taylor_adaptive<double>
 get_ta_zoh_eq_var(double tol); // variational wrt (p,f,g,h,k,L,m,T,ir,it,in), first order.
 
 // Methods to access the cache dimensions.
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include <kep3/detail/visibility.hpp>
+#include <kep3/ta/pool.hpp>
 
 #include <heyoka/expression.hpp>
 #include <heyoka/taylor.hpp>
@@ -24,12 +25,16 @@ namespace kep3::ta
 // 7 states, 5 parameters: [T, i_x, i_y, i_z, c].
 kep3_DLL_PUBLIC std::vector<std::pair<heyoka::expression, heyoka::expression>> zoh_kep_dyn();
 
-// These return const references to function level static variables of type heyoka::taylor_adaptive<double>.
-// NOTE: The object returned are expected to be copied to then be modified.
-kep3_DLL_PUBLIC const heyoka::taylor_adaptive<double> &get_ta_zoh_kep(double tol);
-kep3_DLL_PUBLIC const heyoka::taylor_adaptive<double> &
+// These return copies of the integrators kept in an in-memory cache (see kep3/jit_cache.hpp).
+kep3_DLL_PUBLIC heyoka::taylor_adaptive<double> get_ta_zoh_kep(double tol);
+kep3_DLL_PUBLIC heyoka::taylor_adaptive<double>
 get_ta_zoh_kep_var(double tol); // variational wrt (x,y,z,vx,vy,vz,m,T,ix,iy,iz), first order.
 
+// These return a copy of the integrators above, taken from a pool local to the calling thread.
+// NOTE: Use them on hot paths needing a modifiable integrator, to avoid a deep copy per call.
+kep3_DLL_PUBLIC ta_handle acquire_ta_zoh_kep(double tol);
+kep3_DLL_PUBLIC ta_handle acquire_ta_zoh_kep_var(double tol);
+
 // Methods to access the cache dimensions.
 kep3_DLL_PUBLIC size_t get_ta_zoh_kep_cache_dim();
 kep3_DLL_PUBLIC size_t get_ta_zoh_kep_var_cache_dim();
@@ -0,0 +1,115 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifndef kep3_UDPLA_CHEBYSHEV_H
+#define kep3_UDPLA_CHEBYSHEV_H
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <fmt/ostream.h>
+
+#include <kep3/detail/s11n.hpp>
+#include <kep3/detail/visibility.hpp>
+#include <kep3/planet.hpp>
+
+namespace kep3::udpla
+{
+
+// Piecewise Chebyshev interpolation of the ephemerides of a source planet over a time window.
+// The window is bisected until, on each segment, the fits of the position and of the velocity
+// match the source within a relative tolerance. Once built, the object does not reference the
+// source anymore: it can be serialized and shipped (e.g. to the workers of a parallel optimization)
+// in place of expensive ephemerides (vsop2013, spice, ...).
+class kep3_DLL_PUBLIC chebyshev
+{
+    double m_start = 0.;
+    double m_end = 0.;
+    double m_tol = 0.;
+    unsigned m_order = 0u;
+    double m_max_error = 0.;
+    // The boundaries of the segments (size n_segments + 1).
+    std::vector<double> m_breaks;
+    // The coefficients, laid out as [segment][component (x, y, z, vx, vy, vz)][order + 1].
+    std::vector<double> m_coeffs;
+    std::string m_name;
+    double m_mu_central_body = -1.;
+    double m_mu_self = -1.;
+    double m_radius = -1.;
+    double m_safe_radius = -1.;
+
+    friend class boost::serialization::access;
+    template <typename Archive>
+    void serialize(Archive &ar, unsigned)
+    {
+        ar & m_start;
+        ar & m_end;
+        ar & m_tol;
+        ar & m_order;
+        ar & m_max_error;
+        ar & m_breaks;
+        ar & m_coeffs;
+        ar & m_name;
+        ar & m_mu_central_body;
+        ar & m_mu_self;
+        ar & m_radius;
+        ar & m_safe_radius;
+    }
+
+    [[nodiscard]] std::size_t segment(double) const;
+
+public:
+    // NOTE: tol is relative to the largest norm of the position (velocity) on each segment, and is checked
+    // at the fitting nodes midpoints and at the segment boundaries. It must be at least 100 times the machine
+    // epsilon, and std::domain_error is thrown if it cannot be reached within a fixed budget of fits.
+    explicit chebyshev(const kep3::planet &source = kep3::planet{}, double mjd2000_start = 0.,
+                       double mjd2000_end = 1., double tol = 1e-12, unsigned order = 15u);
+
+    // Mandatory UDPLA methods
+    [[nodiscard]] std::array<std::array<double, 3>, 2> eph(double) const;
+
+    // Optional UDPLA methods
+    [[nodiscard]] std::vector<double> eph_v(const std::vector<double> &) const;
+    // NOTE: the output of the span overloads must have size 6 (eph_v) or 3 (acc_v) times the number of epochs, else
+    // std::invalid_argument is thrown.
+    void eph_v(std::span<const double>, std::span<double>) const;
+    // NOTE: the acceleration is the derivative of the velocity fit.
+    [[nodiscard]] std::array<double, 3> acc(double) const;
+    [[nodiscard]] std::vector<double> acc_v(const std::vector<double> &) const;
+    void acc_v(std::span<const double>, std::span<double>) const;
+    [[nodiscard]] std::string get_name() const;
+    [[nodiscard]] double get_mu_central_body() const;
+    [[nodiscard]] double get_mu_self() const;
+    [[nodiscard]] double get_radius() const;
+    [[nodiscard]] double get_safe_radius() const;
+    [[nodiscard]] std::string get_extra_info() const;
+
+    // Other methods
+    [[nodiscard]] std::array<double, 2> get_window() const;
+    [[nodiscard]] double get_tol() const;
+    [[nodiscard]] unsigned get_order() const;
+    [[nodiscard]] std::size_t get_n_segments() const;
+    // The largest relative error found while checking the fit against the source.
+    [[nodiscard]] double get_max_error() const;
+};
+kep3_DLL_PUBLIC std::ostream &operator<<(std::ostream &, const kep3::udpla::chebyshev &);
+} // namespace kep3::udpla
+
+// fmt formatter redirecting to the stream operator
+template <>
+struct fmt::formatter<kep3::udpla::chebyshev> : ostream_formatter {
+};
+
+KEP3_S11N_EXPORT_KEY_AND_EXTERN_TEMPLATES(kep3::udpla::chebyshev, kep3::detail::planet_iface)
+
+#endif // kep3_UDPLA_CHEBYSHEV_H
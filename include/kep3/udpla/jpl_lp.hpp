@@ -12,6 +12,8 @@
 #define kep3_UDPLA_JPL_LP_H
 
 #include <array>
+#include <span>
+#include <vector>
 
 #include <fmt/ostream.h>
 
@@ -63,6 +65,12 @@ public:
     [[nodiscard]] std::array<std::array<double, 3>, 2> eph(double) const;
 
     // Optional UDPLA methods
+    [[nodiscard]] std::vector<double> eph_v(const std::vector<double> &) const;
+    // NOTE: the output of the span overloads must have size 6 (eph_v) or 3 (acc_v) times the number of epochs, else
+    // std::invalid_argument is thrown.
+    void eph_v(std::span<const double>, std::span<double>) const;
+    [[nodiscard]] std::vector<double> acc_v(const std::vector<double> &) const;
+    void acc_v(std::span<const double>, std::span<double>) const;
     [[nodiscard]] std::string get_name() const;
     [[nodiscard]] double get_mu_central_body() const;
     [[nodiscard]] double get_mu_self() const;
@@ -12,6 +12,8 @@
 #define kep3_UDPLA_KEPLERIAN_H
 
 #include <array>
+#include <span>
+#include <vector>
 
 #include <fmt/ostream.h>
 
@@ -68,6 +70,12 @@ public:
     [[nodiscard]] std::array<std::array<double, 3>, 2> eph(double) const;
 
     // Optional UDPLA methods
+    [[nodiscard]] std::vector<double> eph_v(const std::vector<double> &) const;
+    // NOTE: the output of the span overloads must have size 6 (eph_v) or 3 (acc_v) times the number of epochs, else
+    // std::invalid_argument is thrown.
+    void eph_v(std::span<const double>, std::span<double>) const;
+    [[nodiscard]] std::vector<double> acc_v(const std::vector<double> &) const;
+    void acc_v(std::span<const double>, std::span<double>) const;
     [[nodiscard]] std::string get_name() const;
     [[nodiscard]] double get_mu_central_body() const;
     [[nodiscard]] double get_mu_self() const;
@@ -78,6 +86,7 @@ public:
 
     // Other methods
     [[nodiscard]] kep3::epoch get_ref_epoch() const;
+    [[nodiscard]] std::array<std::array<double, 3>, 2> get_ref_pos_vel() const;
     //[[nodiscard]] std::array<double, 6> elements(double = 0., kep3::elements_type = kep3::elements_type::KEP_F) const;
 };
 kep3_DLL_PUBLIC std::ostream &operator<<(std::ostream &, const kep3::udpla::keplerian &);
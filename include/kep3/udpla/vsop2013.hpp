@@ -13,7 +13,9 @@
 
 #include <array>
 #include <memory>
+#include <span>
 #include <string>
+#include <vector>
 
 #include <kep3/detail/s11n.hpp>
 #include <kep3/detail/visibility.hpp>
@@ -46,6 +48,11 @@ public:
     [[nodiscard]] std::array<std::array<double, 3>, 2> eph(double) const;
 
     // Optional UDPLA methods
+    // NOTE: eph_v uses a batch-mode compiled function, fetched on its first call, and runs in parallel on long
+    // epoch vectors.
+    [[nodiscard]] std::vector<double> eph_v(const std::vector<double> &) const;
+    // NOTE: out must have size 6 times the number of epochs, else std::invalid_argument is thrown.
+    void eph_v(std::span<const double>, std::span<double>) const;
     [[nodiscard]] std::string get_name() const;
 };
 
@@ -8,9 +8,12 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <initializer_list>
 #include <iterator>
+#include <span>
 #include <string>
 #include <tuple>
 #include <utility> 
@@ -108,4 +111,110 @@ void check_not_type(const py::object &o, const char *target)
     }
 }
 
+py::object anomaly_conversion_v(anomaly_conversion_v_t f, const dbl_array &x, const dbl_array &ecc)
+{
+    // Scalars in, scalar out.
+    if (x.ndim() == 0 && ecc.ndim() == 0) {
+        double retval = 0.;
+        f(std::span<const double>(x.data(), 1u), std::span<const double>(ecc.data(), 1u),
+          std::span<double>(&retval, 1u));
+        return py::float_(retval);
+    }
+
+    // A single eccentricity for all anomalies, or arrays of the same shape: we can work on the
+    // NumPy buffers directly.
+    const bool same_shape = x.ndim() == ecc.ndim() && std::equal(x.shape(), x.shape() + x.ndim(), ecc.shape());
+    if (same_shape || (ecc.size() == 1 && ecc.ndim() <= x.ndim())) {
+        dbl_array retval(std::vector<py::ssize_t>(x.shape(), x.shape() + x.ndim()));
+        const auto n = boost::numeric_cast<std::size_t>(x.size());
+        const std::span<const double> x_s(x.data(), n);
+        const std::span<const double> ecc_s(ecc.data(), boost::numeric_cast<std::size_t>(ecc.size()));
+        const std::span<double> out_s(retval.mutable_data(), n);
+        {
+            py::gil_scoped_release release;
+            f(x_s, ecc_s, out_s);
+        }
+        return retval;
+    }
+
+    // Otherwise we let NumPy broadcast the arguments.
+    auto np = py::module::import("numpy");
+    auto bcast = np.attr("broadcast_arrays")(x, ecc);
+    return anomaly_conversion_v(f, py::cast<dbl_array>(np.attr("ascontiguousarray")(bcast[py::int_(0)])),
+                                py::cast<dbl_array>(np.attr("ascontiguousarray")(bcast[py::int_(1)])));
+}
+
+py::array_t<double> planet_eph_v(const kep3::planet &pl, bool acc, const dbl_array &when, const py::object &out)
+{
+    const auto dim = acc ? py::ssize_t(3) : py::ssize_t(6);
+    if (when.ndim() != 1) {
+        py_throw(PyExc_ValueError,
+                 ("The epochs must be a one dimensional array, while an array with " + std::to_string(when.ndim())
+                  + " dimensions was passed")
+                     .c_str());
+    }
+    const auto n = when.shape(0);
+
+    auto retval = output_ndarray(out, py::array::ShapeContainer{n, dim});
+
+    const std::span<const double> when_s(when.data(), boost::numeric_cast<std::size_t>(n));
+    const std::span<double> out_s(retval.mutable_data(), boost::numeric_cast<std::size_t>(retval.size()));
+    const auto call = [&]() {
+        if (acc) {
+            pl.acc_v(when_s, out_s);
+        } else {
+            pl.eph_v(when_s, out_s);
+        }
+    };
+    if (pl.extract<pykep::python_udpla>() != nullptr) {
+        call();
+    } else {
+        py::gil_scoped_release release;
+        call();
+    }
+    return retval;
+}
+
+py::array_t<double> output_ndarray(const py::object &out, py::array::ShapeContainer shape)
+{
+    if (out.is_none()) {
+        return py::array_t<double>(std::move(shape));
+    }
+    // NOTE: no conversions here, as the results would be written in a temporary copy.
+    if (!py::isinstance<py::array_t<double>>(out)) {
+        py_throw(PyExc_TypeError, "The output must be a NumPy array of doubles");
+    }
+    auto retval = py::reinterpret_borrow<py::array_t<double>>(out);
+    if ((retval.flags() & py::array::c_style) == 0 || !retval.writeable()) {
+        py_throw(PyExc_ValueError, "The output must be a C-contiguous and writeable NumPy array");
+    }
+    // NOTE: the size alone is not enough, as an array with the right size and the wrong shape would be silently
+    // filled with a different layout.
+    if (!std::equal(shape->begin(), shape->end(), retval.shape(), retval.shape() + retval.ndim())) {
+        const auto to_str = [](auto begin, auto end) {
+            std::string s = "(";
+            for (auto it = begin; it != end; ++it) {
+                s += (it == begin ? "" : ", ") + std::to_string(*it);
+            }
+            return s + ")";
+        };
+        py_throw(PyExc_ValueError, ("The output must have shape " + to_str(shape->begin(), shape->end())
+                                    + ", while an array with shape "
+                                    + to_str(retval.shape(), retval.shape() + retval.ndim()) + " was passed")
+                                       .c_str());
+    }
+    return retval;
+}
+
+py::array_t<py::ssize_t> sparsity_to_ndarray(const kep3::leg::sparsity_pattern &sp)
+{
+    std::vector<py::ssize_t> retval(2u * sp.size());
+    for (decltype(sp.size()) k = 0u; k < sp.size(); ++k) {
+        retval[2u * k] = boost::numeric_cast<py::ssize_t>(sp[k].first);
+        retval[2u * k + 1u] = boost::numeric_cast<py::ssize_t>(sp[k].second);
+    }
+    return vector_to_ndarray(std::move(retval),
+                             py::array::ShapeContainer{boost::numeric_cast<py::ssize_t>(sp.size()), py::ssize_t(2)});
+}
+
 } // namespace pykep
\ No newline at end of file
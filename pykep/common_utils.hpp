@@ -11,13 +11,18 @@
 #ifndef PYKEP_COMMON_UTILS_HPP
 #define PYKEP_COMMON_UTILS_HPP
 
+#include <memory>
+#include <span>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <kep3/detail/s11n.hpp>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
+#include "kep3/leg/sparsity.hpp"
 #include "kep3/planet.hpp"
 #include "python_udpla.hpp"
 
@@ -57,6 +62,53 @@ inline std::string ostream_repr(const T &x)
     return oss.str();
 }
 
+// Zero-copy conversion of a std::vector into a NumPy array with the given shape. The vector is moved
+// to the heap and its ownership is transferred to a capsule, which frees it when the array is
+// garbage collected.
+template <typename T>
+inline py::array_t<T> vector_to_ndarray(std::vector<T> &&v, py::array::ShapeContainer shape)
+{
+    // We create a capsule for the py::array_t to manage ownership change.
+    auto vec_ptr = std::make_unique<std::vector<T>>(std::move(v));
+
+    py::capsule vec_caps(vec_ptr.get(), [](void *ptr) {
+        const std::unique_ptr<std::vector<T>> vptr(static_cast<std::vector<T> *>(ptr));
+    });
+
+    // NOTE: at this point, the capsule has been created successfully (including
+    // the registration of the destructor). We can thus release ownership from vec_ptr,
+    // as now the capsule is responsible for destroying its contents. If the capsule constructor
+    // throws, the destructor function is not registered/invoked, and the destructor
+    // of vec_ptr will take care of cleaning up.
+    auto *ptr = vec_ptr.release();
+
+    return py::array_t<T>(std::move(shape), ptr->data(), std::move(vec_caps));
+}
+
+// NumPy arrays of doubles, converted (if needed) to C-contiguous layout.
+using dbl_array = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+// Array-level anomaly conversions, as kep3::m2e(std::span<const double>, ...).
+using anomaly_conversion_v_t = void (*)(std::span<const double>, std::span<const double>, std::span<double>);
+
+// Calls an array-level anomaly conversion on the anomalies x and eccentricities ecc, following the
+// NumPy broadcasting rules. The computation runs with the GIL released. Returns a float if both
+// arguments are scalars, an array otherwise.
+py::object anomaly_conversion_v(anomaly_conversion_v_t f, const dbl_array &x, const dbl_array &ecc);
+
+// Calls the allocation free kep3::planet::eph_v (or acc_v, if acc is true) on the NumPy buffer of the epochs
+// when, writing in out if it is not None (it must then be a C-contiguous, writeable array of doubles of size
+// 6N, or 3N), else in a new (N, 6), or (N, 3), array. The GIL is released unless the udpla is pythonic.
+py::array_t<double> planet_eph_v(const kep3::planet &pl, bool acc, const dbl_array &when, const py::object &out);
+
+// Returns out, if it is not None, checked to be a C-contiguous and writeable array of doubles with the given
+// shape (no conversions are done, as the results would be written in a temporary copy). Else returns a new
+// array of the given shape.
+py::array_t<double> output_ndarray(const py::object &out, py::array::ShapeContainer shape);
+
+// Converts a sparsity pattern into an (nnz, 2) array of indices.
+py::array_t<py::ssize_t> sparsity_to_ndarray(const kep3::leg::sparsity_pattern &sp);
+
 // Generic copy wrappers.
 template <typename T>
 inline T generic_copy_wrapper(const T &x)
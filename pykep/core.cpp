@@ -22,16 +22,22 @@
 #include <kep3/core_astro/mima.hpp>
 #include <kep3/core_astro/propagate_lagrangian.hpp>
 #include <kep3/epoch.hpp>
+#include <kep3/jit_cache.hpp>
 #include <kep3/lambert_problem.hpp>
 #include <kep3/leg/sims_flanagan.hpp>
 #include <kep3/leg/sims_flanagan_alpha.hpp>
+#include <kep3/leg/sims_flanagan_sequence.hpp>
 #include <kep3/leg/zoh.hpp>
 #include <kep3/planet.hpp>
+#include <kep3/planet_catalog.hpp>
+#include <kep3/porkchop.hpp>
+#include <kep3/prewarm.hpp>
 #include <kep3/ta/bcp.hpp>
 #include <kep3/ta/cr3bp.hpp>
 #include <kep3/ta/kep.hpp>
 #include <kep3/ta/pontryagin_cartesian.hpp>
 #include <kep3/ta/pontryagin_equinoctial.hpp>
+#include <kep3/ta/pool.hpp>
 #include <kep3/ta/zoh_cr3bp.hpp>
 #include <kep3/ta/zoh_eq.hpp>
 #include <kep3/ta/zoh_kep.hpp>
@@ -100,36 +106,42 @@ PYBIND11_MODULE(core, m) // NOLINT
         .export_values();
 
     // We expose the various anomaly conversions
-    m.def("m2e", &kep3::m2e, pk::m2e_doc().c_str());
-    m.def("e2m", &kep3::e2m, pk::e2m_doc().c_str());
-    m.def("m2f", &kep3::m2f, pk::m2f_doc().c_str());
-    m.def("f2m", &kep3::f2m, pk::f2m_doc().c_str());
-    m.def("e2f", &kep3::e2f, pk::e2f_doc().c_str());
-    m.def("f2e", &kep3::f2e, pk::f2e_doc().c_str());
-    m.def("n2h", &kep3::n2h, pk::n2h_doc().c_str());
-    m.def("h2n", &kep3::h2n, pk::h2n_doc().c_str());
-    m.def("n2f", &kep3::n2f, pk::n2f_doc().c_str());
-    m.def("f2n", &kep3::f2n, pk::f2n_doc().c_str());
-    m.def("h2f", &kep3::h2f, pk::h2f_doc().c_str());
-    m.def("f2h", &kep3::f2h, pk::f2h_doc().c_str());
-    m.def("zeta2f", &kep3::zeta2f, pk::zeta2f_doc().c_str());
-    m.def("f2zeta", &kep3::f2zeta, pk::f2zeta_doc().c_str());
-
-    // And their vectorized versions
-    m.def("m2e_v", py::vectorize(kep3::m2e), pk::m2e_v_doc().c_str());
-    m.def("e2m_v", py::vectorize(kep3::e2m), pk::e2m_v_doc().c_str());
-    m.def("m2f_v", py::vectorize(kep3::m2f), pk::m2f_v_doc().c_str());
-    m.def("f2m_v", py::vectorize(kep3::f2m), pk::f2m_v_doc().c_str());
-    m.def("e2f_v", py::vectorize(kep3::e2f), pk::e2f_v_doc().c_str());
-    m.def("f2e_v", py::vectorize(kep3::f2e), pk::f2e_v_doc().c_str());
-    m.def("n2h_v", py::vectorize(kep3::n2h), pk::n2h_v_doc().c_str());
-    m.def("h2n_v", py::vectorize(kep3::h2n), pk::h2n_v_doc().c_str());
-    m.def("n2f_v", py::vectorize(kep3::n2f), pk::n2f_v_doc().c_str());
-    m.def("f2n_v", py::vectorize(kep3::f2n), pk::f2n_v_doc().c_str());
-    m.def("h2f_v", py::vectorize(kep3::h2f), pk::h2f_v_doc().c_str());
-    m.def("f2h_v", py::vectorize(kep3::f2h), pk::f2h_v_doc().c_str());
-    m.def("zeta2f_v", py::vectorize(kep3::zeta2f), pk::zeta2f_v_doc().c_str());
-    m.def("f2zeta_v", py::vectorize(kep3::f2zeta), pk::f2zeta_v_doc().c_str());
+    m.def("m2e", py::overload_cast<double, double>(&kep3::m2e), pk::m2e_doc().c_str());
+    m.def("e2m", py::overload_cast<double, double>(&kep3::e2m), pk::e2m_doc().c_str());
+    m.def("m2f", py::overload_cast<double, double>(&kep3::m2f), pk::m2f_doc().c_str());
+    m.def("f2m", py::overload_cast<double, double>(&kep3::f2m), pk::f2m_doc().c_str());
+    m.def("e2f", py::overload_cast<double, double>(&kep3::e2f), pk::e2f_doc().c_str());
+    m.def("f2e", py::overload_cast<double, double>(&kep3::f2e), pk::f2e_doc().c_str());
+    m.def("n2h", py::overload_cast<double, double>(&kep3::n2h), pk::n2h_doc().c_str());
+    m.def("h2n", py::overload_cast<double, double>(&kep3::h2n), pk::h2n_doc().c_str());
+    m.def("n2f", py::overload_cast<double, double>(&kep3::n2f), pk::n2f_doc().c_str());
+    m.def("f2n", py::overload_cast<double, double>(&kep3::f2n), pk::f2n_doc().c_str());
+    m.def("h2f", py::overload_cast<double, double>(&kep3::h2f), pk::h2f_doc().c_str());
+    m.def("f2h", py::overload_cast<double, double>(&kep3::f2h), pk::f2h_doc().c_str());
+    m.def("zeta2f", py::overload_cast<double, double>(&kep3::zeta2f), pk::zeta2f_doc().c_str());
+    m.def("f2zeta", py::overload_cast<double, double>(&kep3::f2zeta), pk::f2zeta_doc().c_str());
+
+    // And their vectorized versions. These call the array-level C++ functions with the GIL released.
+    const auto expose_anomaly_conversion_v = [&m](const char *name, pk::anomaly_conversion_v_t f,
+                                                  const std::string &doc) {
+        m.def(
+            name, [f](const pk::dbl_array &x, const pk::dbl_array &ecc) { return pk::anomaly_conversion_v(f, x, ecc); },
+            doc.c_str());
+    };
+    expose_anomaly_conversion_v("m2e_v", &kep3::m2e, pk::m2e_v_doc());
+    expose_anomaly_conversion_v("e2m_v", &kep3::e2m, pk::e2m_v_doc());
+    expose_anomaly_conversion_v("m2f_v", &kep3::m2f, pk::m2f_v_doc());
+    expose_anomaly_conversion_v("f2m_v", &kep3::f2m, pk::f2m_v_doc());
+    expose_anomaly_conversion_v("e2f_v", &kep3::e2f, pk::e2f_v_doc());
+    expose_anomaly_conversion_v("f2e_v", &kep3::f2e, pk::f2e_v_doc());
+    expose_anomaly_conversion_v("n2h_v", &kep3::n2h, pk::n2h_v_doc());
+    expose_anomaly_conversion_v("h2n_v", &kep3::h2n, pk::h2n_v_doc());
+    expose_anomaly_conversion_v("n2f_v", &kep3::n2f, pk::n2f_v_doc());
+    expose_anomaly_conversion_v("f2n_v", &kep3::f2n, pk::f2n_v_doc());
+    expose_anomaly_conversion_v("h2f_v", &kep3::h2f, pk::h2f_v_doc());
+    expose_anomaly_conversion_v("f2h_v", &kep3::f2h, pk::f2h_v_doc());
+    expose_anomaly_conversion_v("zeta2f_v", &kep3::zeta2f, pk::zeta2f_v_doc());
+    expose_anomaly_conversion_v("f2zeta_v", &kep3::f2zeta, pk::f2zeta_v_doc());
 
     // Exposing element conversions
     m.def("ic2par", &kep3::ic2par, py::arg("posvel"), py::arg("mu"), pk::ic2par_doc().c_str());
@@ -265,51 +277,17 @@ PYBIND11_MODULE(core, m) // NOLINT
     // Vectorized versions. Note that the udpla method flattens everything but planet returns a non flat array.
     planet_class.def(
         "eph_v",
-        [](const kep3::planet &pl, const std::vector<double> &eps) {
-            std::vector<double> res = pl.eph_v(eps);
-            // We create a capsule for the py::array_t to manage ownership change.
-            auto vec_ptr = std::make_unique<std::vector<double>>(std::move(res));
-
-            py::capsule vec_caps(vec_ptr.get(), [](void *ptr) {
-                const std::unique_ptr<std::vector<double>> vptr(static_cast<std::vector<double> *>(ptr));
-            });
-
-            // NOTE: at this point, the capsule has been created successfully (including
-            // the registration of the destructor). We can thus release ownership from vec_ptr,
-            // as now the capsule is responsible for destroying its contents. If the capsule constructor
-            // throws, the destructor function is not registered/invoked, and the destructor
-            // of vec_ptr will take care of cleaning up.
-            auto *ptr = vec_ptr.release();
-
-            return py::array_t<double>(py::array::ShapeContainer{boost::numeric_cast<py::ssize_t>(eps.size()),
-                                                                 static_cast<py::ssize_t>(6)}, // shape
-                                       ptr->data(), std::move(vec_caps));
+        [](const kep3::planet &pl, const pk::dbl_array &when, const py::object &out) {
+            return pk::planet_eph_v(pl, false, when, out);
         },
-        py::arg("when"), pykep::planet_eph_v_docstring().c_str());
+        py::arg("when"), py::arg("out") = py::none(), pykep::planet_eph_v_docstring().c_str());
 
     planet_class.def(
         "acc_v",
-        [](const kep3::planet &pl, const std::vector<double> &mjd2000s) {
-            std::vector<double> res = pl.acc_v(mjd2000s);
-            // We create a capsule for the py::array_t to manage ownership change.
-            auto vec_ptr = std::make_unique<std::vector<double>>(std::move(res));
-
-            py::capsule vec_caps(vec_ptr.get(), [](void *ptr) {
-                const std::unique_ptr<std::vector<double>> vptr(static_cast<std::vector<double> *>(ptr));
-            });
-
-            // NOTE: at this point, the capsule has been created successfully (including
-            // the registration of the destructor). We can thus release ownership from vec_ptr,
-            // as now the capsule is responsible for destroying its contents. If the capsule constructor
-            // throws, the destructor function is not registered/invoked, and the destructor
-            // of vec_ptr will take care of cleaning up.
-            auto *ptr = vec_ptr.release();
-
-            return py::array_t<double>(py::array::ShapeContainer{boost::numeric_cast<py::ssize_t>(mjd2000s.size()),
-                                                                 static_cast<py::ssize_t>(3)}, // shape
-                                       ptr->data(), std::move(vec_caps));
+        [](const kep3::planet &pl, const pk::dbl_array &when, const py::object &out) {
+            return pk::planet_eph_v(pl, true, when, out);
         },
-        py::arg("when"), pykep::planet_acc_v_docstring().c_str());
+        py::arg("when"), py::arg("out") = py::none(), pykep::planet_acc_v_docstring().c_str());
 
 #define PYKEP3_EXPOSE_PLANET_GETTER(name)                                                                              \
     planet_class.def(                                                                                                  \
@@ -363,12 +341,56 @@ PYBIND11_MODULE(core, m) // NOLINT
     // Finalize (this constructor must be the last one of planet_class: else overload will fail with all the others)
     planet_class.def(py::init([](const py::object &o) { return kep3::planet{pk::python_udpla(o)}; }), py::arg("udpla"));
 
+    // Exposing the planet catalog
+    py::class_<kep3::planet_catalog> planet_catalog(m, "planet_catalog", pykep::planet_catalog_docstring().c_str());
+    planet_catalog
+        .def(py::init<const std::vector<kep3::planet> &>(), py::arg("planets") = std::vector<kep3::planet>{})
+        // repr().
+        .def("__repr__", &pykep::ostream_repr<kep3::planet_catalog>)
+        // Copy and deepcopy.
+        .def("__copy__", &pykep::generic_copy_wrapper<kep3::planet_catalog>)
+        .def("__deepcopy__", &pykep::generic_deepcopy_wrapper<kep3::planet_catalog>)
+        // Pickle support.
+        .def(py::pickle(&pykep::pickle_getstate_wrapper<kep3::planet_catalog>,
+                        &pykep::pickle_setstate_wrapper<kep3::planet_catalog>))
+        .def("__len__", &kep3::planet_catalog::size)
+        .def("__getitem__", &kep3::planet_catalog::get_planet, py::arg("i"))
+        .def("append", py::overload_cast<const kep3::planet &>(&kep3::planet_catalog::push_back), py::arg("pla"),
+             "Appends a planet (constructed from a :class:`~pykep.udpla.keplerian`) to the catalog.")
+        .def(
+            "eph_all",
+            [](const kep3::planet_catalog &cat, const std::variant<double, kep3::epoch> &when) {
+                std::vector<double> res;
+                {
+                    const py::gil_scoped_release release;
+                    res = std::visit([&](const auto &v) { return cat.eph_all(v); }, when);
+                }
+                return pykep::vector_to_ndarray(std::move(res),
+                                                {boost::numeric_cast<py::ssize_t>(cat.size()), py::ssize_t(6)});
+            },
+            py::arg("when"), pykep::planet_catalog_eph_all_docstring().c_str())
+        .def(
+            "eph_subset",
+            [](const kep3::planet_catalog &cat, const std::vector<std::size_t> &indices,
+               const std::vector<double> &mjd2000s) {
+                std::vector<double> res;
+                {
+                    const py::gil_scoped_release release;
+                    res = cat.eph_subset(indices, mjd2000s);
+                }
+                return pykep::vector_to_ndarray(std::move(res),
+                                                {boost::numeric_cast<py::ssize_t>(indices.size()), py::ssize_t(6)});
+            },
+            py::arg("indices"), py::arg("mjd2000s"), pykep::planet_catalog_eph_subset_docstring().c_str());
+
     // Exposing the Lambert problem class
     py::class_<kep3::lambert_problem> lambert_problem(m, "lambert_problem", pykep::lambert_problem_docstring().c_str());
     lambert_problem
-        .def(py::init<const std::array<double, 3> &, const std::array<double, 3> &, double, double, bool, unsigned>(),
+        .def(py::init<const std::array<double, 3> &, const std::array<double, 3> &, double, double, bool, unsigned,
+                      const std::vector<double> &>(),
              py::arg("r0") = std::array<double, 3>{{1., 0., 0}}, py::arg("r1") = std::array<double, 3>{{0., 1., 0}},
-             py::arg("tof") = kep3::pi / 2, py::arg("mu") = 1., py::arg("cw") = false, py::arg("multi_revs") = 1)
+             py::arg("tof") = kep3::pi / 2, py::arg("mu") = 1., py::arg("cw") = false, py::arg("multi_revs") = 1,
+             py::arg("x_guess") = std::vector<double>{})
         // repr().
         .def("__repr__", &pykep::ostream_repr<kep3::lambert_problem>)
         // Copy and deepcopy.
@@ -388,7 +410,24 @@ PYBIND11_MODULE(core, m) // NOLINT
                                "The Battin variable x along the time of flight curves.")
         .def_property_readonly("iters", &kep3::lambert_problem::get_iters, "The number of iterations made.")
         .def_property_readonly("Nmax", &kep3::lambert_problem::get_Nmax, "The maximum number of iterations allowed.")
-        .def_property_readonly("cw", &kep3::lambert_problem::get_cw, "The clockwise parameter.");
+        .def_property_readonly("cw", &kep3::lambert_problem::get_cw, "The clockwise parameter.")
+        .def(
+            "compute_grad",
+            [](const kep3::lambert_problem &lp) {
+                auto [dv0, dv1] = lp.compute_grad();
+                const auto n_sol = boost::numeric_cast<py::ssize_t>(dv0.size());
+                std::vector<double> dv0_flat, dv1_flat;
+                dv0_flat.reserve(21u * dv0.size());
+                dv1_flat.reserve(21u * dv1.size());
+                for (decltype(dv0.size()) i = 0u; i < dv0.size(); ++i) {
+                    dv0_flat.insert(dv0_flat.end(), dv0[i].begin(), dv0[i].end());
+                    dv1_flat.insert(dv1_flat.end(), dv1[i].begin(), dv1[i].end());
+                }
+                const py::array::ShapeContainer shape{n_sol, static_cast<py::ssize_t>(3), static_cast<py::ssize_t>(7)};
+                return py::make_tuple(pykep::vector_to_ndarray(std::move(dv0_flat), shape),
+                                      pykep::vector_to_ndarray(std::move(dv1_flat), shape));
+            },
+            pykep::lambert_problem_compute_grad_docstring().c_str());
 
     // Exposing Taylor adaptive propagators
     // Create submodule "ta_cxx"
@@ -398,117 +437,61 @@ PYBIND11_MODULE(core, m) // NOLINT
     sys.attr("modules")["pykep.ta_cxx"] = ta;
 
     // KEP
-    ta.def(
-        "get_kep",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_kep(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_kep_docstring().c_str());
-    ta.def(
-        "get_kep_var",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_kep_var(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_kep_var_docstring().c_str());
+    ta.def("get_kep", &kep3::ta::get_ta_kep, py::arg("tol"), pykep::get_kep_docstring().c_str());
+    ta.def("get_kep_var", &kep3::ta::get_ta_kep_var, py::arg("tol"), pykep::get_kep_var_docstring().c_str());
     ta.def("kep_dyn", &kep3::ta::kep_dyn, pykep::kep_dyn_docstring().c_str());
 
     // ZOH KEP
-    ta.def(
-        "get_zoh_kep",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_zoh_kep(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_zoh_kep_docstring().c_str());
-    ta.def(
-        "get_zoh_kep_var",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_zoh_kep_var(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_zoh_kep_var_docstring().c_str());
+    ta.def("get_zoh_kep", &kep3::ta::get_ta_zoh_kep, py::arg("tol"), pykep::get_zoh_kep_docstring().c_str());
+    ta.def("get_zoh_kep_var", &kep3::ta::get_ta_zoh_kep_var, py::arg("tol"),
+           pykep::get_zoh_kep_var_docstring().c_str());
     ta.def("zoh_kep_dyn", &kep3::ta::zoh_kep_dyn, pykep::zoh_kep_dyn_docstring().c_str());
+    ta.def("acquire_zoh_kep", &kep3::ta::acquire_ta_zoh_kep, py::arg("tol"),
+           pykep::acquire_zoh_kep_docstring().c_str());
+    ta.def("acquire_zoh_kep_var", &kep3::ta::acquire_ta_zoh_kep_var, py::arg("tol"),
+           pykep::acquire_zoh_kep_var_docstring().c_str());
+
+    // Handles to pooled integrators.
+    // NOTE: a handle is moved into the zoh leg it constructs, after that it is empty.
+    const auto checked_handle = [](const kep3::ta::ta_handle &h) -> const kep3::ta::ta_handle & {
+        if (h.get() == nullptr) {
+            throw std::invalid_argument("This integrator handle is empty, it was moved into a zoh leg");
+        }
+        return h;
+    };
+    py::class_<kep3::ta::ta_handle> ta_handle(ta, "ta_handle", pykep::ta_handle_docstring().c_str());
+    ta_handle.def_property_readonly(
+        "ta",
+        [checked_handle](const kep3::ta::ta_handle &h) -> heyoka::taylor_adaptive<double> & {
+            return *checked_handle(h);
+        },
+        py::return_value_policy::reference_internal, pykep::ta_handle_ta_docstring().c_str());
+    ta_handle.def_property_readonly("is_pooled", &kep3::ta::ta_handle::is_pooled,
+                                    pykep::ta_handle_is_pooled_docstring().c_str());
+    ta_handle.def("__copy__", [checked_handle](const kep3::ta::ta_handle &h) { return checked_handle(h); });
+    ta_handle.def("__deepcopy__", [checked_handle](const kep3::ta::ta_handle &h, const py::dict &) {
+        return checked_handle(h);
+    });
 
     // ZOH EQ
-    ta.def(
-        "get_zoh_eq",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_zoh_eq(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_zoh_eq_docstring().c_str());
-    ta.def(
-        "get_zoh_eq_var",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_zoh_eq_var(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_zoh_eq_var_docstring().c_str());
+    ta.def("get_zoh_eq", &kep3::ta::get_ta_zoh_eq, py::arg("tol"), pykep::get_zoh_eq_docstring().c_str());
+    ta.def("get_zoh_eq_var", &kep3::ta::get_ta_zoh_eq_var, py::arg("tol"), pykep::get_zoh_eq_var_docstring().c_str());
     ta.def("zoh_eq_dyn", &kep3::ta::zoh_eq_dyn, pykep::zoh_eq_dyn_docstring().c_str());
 
     // ZOH CR3BP
-    ta.def(
-        "get_zoh_cr3bp",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_zoh_cr3bp(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_zoh_cr3bp_docstring().c_str());
-    ta.def(
-        "get_zoh_cr3bp_var",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_zoh_cr3bp_var(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_zoh_cr3bp_var_docstring().c_str());
+    ta.def("get_zoh_cr3bp", &kep3::ta::get_ta_zoh_cr3bp, py::arg("tol"), pykep::get_zoh_cr3bp_docstring().c_str());
+    ta.def("get_zoh_cr3bp_var", &kep3::ta::get_ta_zoh_cr3bp_var, py::arg("tol"),
+           pykep::get_zoh_cr3bp_var_docstring().c_str());
     ta.def("zoh_cr3bp_dyn", &kep3::ta::zoh_cr3bp_dyn, pykep::zoh_cr3bp_dyn_docstring().c_str());
 
     // ZOH SS
-    ta.def(
-        "get_zoh_ss",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_zoh_ss(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_zoh_ss_docstring().c_str());
-    ta.def(
-        "get_zoh_ss_var",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_zoh_ss_var(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_zoh_ss_var_docstring().c_str());
+    ta.def("get_zoh_ss", &kep3::ta::get_ta_zoh_ss, py::arg("tol"), pykep::get_zoh_ss_docstring().c_str());
+    ta.def("get_zoh_ss_var", &kep3::ta::get_ta_zoh_ss_var, py::arg("tol"), pykep::get_zoh_ss_var_docstring().c_str());
     ta.def("zoh_ss_dyn", &kep3::ta::zoh_ss_dyn, pykep::zoh_ss_dyn_docstring().c_str());
 
     // BCP
-    ta.def(
-        "get_bcp",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_bcp(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_bcp_docstring().c_str());
-    ta.def(
-        "get_bcp_var",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_bcp_var(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_bcp_var_docstring().c_str());
+    ta.def("get_bcp", &kep3::ta::get_ta_bcp, py::arg("tol"), pykep::get_bcp_docstring().c_str());
+    ta.def("get_bcp_var", &kep3::ta::get_ta_bcp_var, py::arg("tol"), pykep::get_bcp_var_docstring().c_str());
     ta.def("bcp_dyn", &kep3::ta::bcp_dyn, pykep::bcp_dyn_docstring().c_str());
 
     // CR3BP
@@ -517,58 +500,17 @@ PYBIND11_MODULE(core, m) // NOLINT
     ta.def("cr3bp_effective_potential_U", &kep3::ta::cr3bp_effective_potential_U,
            pykep::cr3bp_effective_potential_U_docstring().c_str());
 
-    ta.def(
-        "get_cr3bp",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_cr3bp(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_cr3bp_docstring().c_str());
-    ta.def(
-        "get_cr3bp_var",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_cr3bp_var(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_cr3bp_var_docstring().c_str());
+    ta.def("get_cr3bp", &kep3::ta::get_ta_cr3bp, py::arg("tol"), pykep::get_cr3bp_docstring().c_str());
+    ta.def("get_cr3bp_var", &kep3::ta::get_ta_cr3bp_var, py::arg("tol"), pykep::get_cr3bp_var_docstring().c_str());
     ta.def("cr3bp_dyn", &kep3::ta::cr3bp_dyn, pykep::cr3bp_dyn_docstring().c_str());
     // BCP
-    ta.def(
-        "get_bcp",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_bcp(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_bcp_docstring().c_str());
-    ta.def(
-        "get_bcp_var",
-        [](double tol) {
-            auto ta_cache = kep3::ta::get_ta_bcp_var(tol);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), pykep::get_bcp_var_docstring().c_str());
+    ta.def("get_bcp", &kep3::ta::get_ta_bcp, py::arg("tol"), pykep::get_bcp_docstring().c_str());
+    ta.def("get_bcp_var", &kep3::ta::get_ta_bcp_var, py::arg("tol"), pykep::get_bcp_var_docstring().c_str());
     ta.def("bcp_dyn", &kep3::ta::bcp_dyn, pykep::bcp_dyn_docstring().c_str());
     // Pontryagin Cartesian
-    ta.def(
-        "get_pc",
-        [](double tol, kep3::optimality_type optimality) {
-            auto ta_cache = kep3::ta::get_ta_pc(tol, optimality);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), py::arg("optimality"), pykep::get_pc_docstring().c_str());
-    ta.def(
-        "get_pc_var",
-        [](double tol, kep3::optimality_type optimality) {
-            auto ta_cache = kep3::ta::get_ta_pc_var(tol, optimality);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), py::arg("optimality"), pykep::get_pc_var_docstring().c_str());
+    ta.def("get_pc", &kep3::ta::get_ta_pc, py::arg("tol"), py::arg("optimality"), pykep::get_pc_docstring().c_str());
+    ta.def("get_pc_var", &kep3::ta::get_ta_pc_var, py::arg("tol"), py::arg("optimality"),
+           pykep::get_pc_var_docstring().c_str());
     ta.def("pc_dyn", &kep3::ta::pc_dyn, pykep::pc_dyn_docstring().c_str());
     ta.def("get_pc_H_cfunc", &kep3::ta::get_pc_H_cfunc, pykep::get_pc_H_cfunc_docstring().c_str());
     ta.def("get_pc_SF_cfunc", &kep3::ta::get_pc_SF_cfunc, pykep::get_pc_SF_cfunc_docstring().c_str());
@@ -577,25 +519,9 @@ PYBIND11_MODULE(core, m) // NOLINT
     ta.def("get_pc_dyn_cfunc", &kep3::ta::get_pc_dyn_cfunc, pykep::get_pc_dyn_cfunc_docstring().c_str());
 
     // Pontryagin Equinoctial (TPBVP)
-    ta.def(
-        "get_peq",
-        [](double tol, kep3::optimality_type optimality) {
-            // retreive from cache
-            auto ta_cache = kep3::ta::get_ta_peq(tol, optimality);
-            // copy
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            // return a copy
-            return ta;
-        },
-        py::arg("tol"), py::arg("optimality"), pykep::get_peq_docstring().c_str());
-    ta.def(
-        "get_peq_var",
-        [](double tol, kep3::optimality_type optimality) {
-            auto ta_cache = kep3::ta::get_ta_peq_var(tol, optimality);
-            heyoka::taylor_adaptive<double> ta(ta_cache);
-            return ta;
-        },
-        py::arg("tol"), py::arg("optimality"), pykep::get_peq_var_docstring().c_str());
+    ta.def("get_peq", &kep3::ta::get_ta_peq, py::arg("tol"), py::arg("optimality"), pykep::get_peq_docstring().c_str());
+    ta.def("get_peq_var", &kep3::ta::get_ta_peq_var, py::arg("tol"), py::arg("optimality"),
+           pykep::get_peq_var_docstring().c_str());
     ta.def("peq_dyn", &kep3::ta::peq_dyn, pykep::peq_dyn_docstring().c_str());
     ta.def("get_peq_H_cfunc", &kep3::ta::get_peq_H_cfunc, pykep::get_peq_H_cfunc_docstring().c_str());
     ta.def("get_peq_SF_cfunc", &kep3::ta::get_peq_SF_cfunc, pykep::get_peq_SF_cfunc_docstring().c_str());
@@ -603,6 +529,77 @@ PYBIND11_MODULE(core, m) // NOLINT
     ta.def("get_peq_i_vers_cfunc", &kep3::ta::get_peq_i_vers_cfunc, pykep::get_peq_i_vers_cfunc_docstring().c_str());
     ta.def("get_peq_dyn_cfunc", &kep3::ta::get_peq_dyn_cfunc, pykep::get_peq_dyn_cfunc_docstring().c_str());
 
+    // Persistent JIT cache
+    m.def("set_jit_cache_dir", &kep3::set_jit_cache_dir, py::arg("dir"), pykep::set_jit_cache_dir_docstring().c_str());
+    m.def("get_jit_cache_dir", &kep3::get_jit_cache_dir, pykep::get_jit_cache_dir_docstring().c_str());
+    m.def(
+        "get_jit_cache_stats",
+        []() {
+            const auto stats = kep3::get_jit_cache_stats();
+            py::dict retval;
+            retval["hits"] = stats.hits;
+            retval["misses"] = stats.misses;
+            retval["stores"] = stats.stores;
+            retval["errors"] = stats.errors;
+            return retval;
+        },
+        pykep::get_jit_cache_stats_docstring().c_str());
+    m.def("reset_jit_cache_stats", &kep3::reset_jit_cache_stats, pykep::reset_jit_cache_stats_docstring().c_str());
+    m.def("set_jit_memory_cache_capacity", &kep3::set_jit_memory_cache_capacity, py::arg("capacity"),
+          pykep::set_jit_memory_cache_capacity_docstring().c_str());
+    m.def("get_jit_memory_cache_capacity", &kep3::get_jit_memory_cache_capacity,
+          pykep::get_jit_memory_cache_capacity_docstring().c_str());
+    m.def("set_jit_cache_tol_digits", &kep3::set_jit_cache_tol_digits, py::arg("digits"),
+          pykep::set_jit_cache_tol_digits_docstring().c_str());
+    m.def("get_jit_cache_tol_digits", &kep3::get_jit_cache_tol_digits,
+          pykep::get_jit_cache_tol_digits_docstring().c_str());
+    m.def(
+        "get_jit_memory_cache_stats",
+        []() {
+            py::dict retval;
+            for (const auto &[name, stats] : kep3::get_jit_memory_cache_stats()) {
+                py::dict d;
+                d["size"] = stats.size;
+                d["hits"] = stats.hits;
+                d["misses"] = stats.misses;
+                d["evictions"] = stats.evictions;
+                d["compile_time"] = stats.compile_time;
+                d["resident_bytes"] = stats.resident_bytes;
+                retval[py::str(name)] = d;
+            }
+            return retval;
+        },
+        pykep::get_jit_memory_cache_stats_docstring().c_str());
+    m.def("reset_jit_memory_cache_stats", &kep3::reset_jit_memory_cache_stats,
+          pykep::reset_jit_memory_cache_stats_docstring().c_str());
+
+    // Prewarm of the JIT compiled objects
+    m.def(
+        "prewarm",
+        [](const std::vector<py::tuple> &specs) {
+            std::vector<kep3::prewarm_spec> specs_c;
+            specs_c.reserve(specs.size());
+            for (const auto &spec : specs) {
+                if (spec.empty() || spec.size() > 3u) {
+                    throw std::invalid_argument(fmt::format(
+                        "prewarm: each item must be a tuple (model, tol, optimality) with at least the model, "
+                        "but a tuple of size {} was found",
+                        spec.size()));
+                }
+                kep3::prewarm_spec spec_c{spec[0].cast<std::string>()};
+                if (spec.size() > 1u) {
+                    spec_c.tol = spec[1].cast<double>();
+                }
+                if (spec.size() > 2u) {
+                    spec_c.optimality = spec[2].cast<kep3::optimality_type>();
+                }
+                specs_c.push_back(std::move(spec_c));
+            }
+            const py::gil_scoped_release release;
+            return kep3::prewarm(specs_c);
+        },
+        py::arg("specs"), pykep::prewarm_docstring().c_str());
+
     // Exposing propagators
     m.def(
         "propagate_lagrangian",
@@ -674,6 +671,32 @@ PYBIND11_MODULE(core, m) // NOLINT
         , py::arg("rv") = std::array<std::array<double, 3>, 2>{{{1, 0, 0}, {0, 1, 0}}}, py::arg("tofs") = std::vector<double>{kep3::pi / 2,},
         py::arg("mu") = 1, py::arg("stm") = false, pykep::propagate_lagrangian_grid_docstring().c_str());
 
+    // Exposing the porkchop grid engine
+    m.def(
+        "porkchop",
+        [](const kep3::planet &pl0, const kep3::planet &pl1, const std::vector<double> &t0s,
+           const std::vector<double> &t1s, unsigned multi_revs, bool cw) {
+            // NOTE: the planets implemented in Python need the GIL.
+            auto pc = [&]() {
+                if (pl0.extract<pykep::python_udpla>() != nullptr || pl1.extract<pykep::python_udpla>() != nullptr) {
+                    return kep3::porkchop(pl0, pl1, t0s, t1s, multi_revs, cw);
+                }
+                const py::gil_scoped_release release;
+                return kep3::porkchop(pl0, pl1, t0s, t1s, multi_revs, cw);
+            }();
+            const auto n_dep = boost::numeric_cast<py::ssize_t>(pc.n_dep);
+            const auto n_arr = boost::numeric_cast<py::ssize_t>(pc.n_arr);
+            return py::make_tuple(
+                pykep::vector_to_ndarray(std::move(pc.dv_dep), {n_dep, n_arr}),
+                pykep::vector_to_ndarray(std::move(pc.dv_arr), {n_dep, n_arr}),
+                pykep::vector_to_ndarray(std::move(pc.c3), {n_dep, n_arr}),
+                pykep::vector_to_ndarray(std::move(pc.vinf_dep), {n_dep, n_arr, static_cast<py::ssize_t>(3)}),
+                pykep::vector_to_ndarray(std::move(pc.vinf_arr), {n_dep, n_arr, static_cast<py::ssize_t>(3)}),
+                pykep::vector_to_ndarray(std::move(pc.branch), {n_dep, n_arr}));
+        },
+        py::arg("pl0"), py::arg("pl1"), py::arg("t0s"), py::arg("t1s"), py::arg("multi_revs") = 0u,
+        py::arg("cw") = false, pykep::porkchop_docstring().c_str());
+
     // Exposing fly-by routines
     m.def("fb_con",
           py::overload_cast<const std::array<double, 3> &, const std::array<double, 3> &, const kep3::planet &>(
@@ -805,6 +828,23 @@ PYBIND11_MODULE(core, m) // NOLINT
             return tc_python;
         },
         pykep::leg_sf_tc_grad_docstring().c_str());
+    sims_flanagan.def(
+        "get_grad_sparsity",
+        [](const kep3::leg::sims_flanagan &leg) { return pykep::sparsity_to_ndarray(leg.get_grad_sparsity()); },
+        pykep::leg_sf_grad_sparsity_docstring().c_str());
+    sims_flanagan.def(
+        "compute_grad_sparse",
+        [](const kep3::leg::sims_flanagan &leg, const py::object &out) {
+            auto retval
+                = pykep::output_ndarray(out, py::array::ShapeContainer{static_cast<py::ssize_t>(leg.get_grad_nnz())});
+            // NOTE: the workspace is reused across the calls (and legs) of a thread, so that repeated
+            // evaluations do not allocate.
+            thread_local kep3::leg::sims_flanagan::workspace ws;
+            leg.compute_grad_sparse(ws,
+                                    std::span<double>(retval.mutable_data(), static_cast<std::size_t>(retval.size())));
+            return retval;
+        },
+        py::arg("out") = py::none(), pykep::leg_sf_grad_sparse_docstring().c_str());
     sims_flanagan.def_property_readonly("nseg", &kep3::leg::sims_flanagan::get_nseg,
                                         pykep::leg_sf_nseg_docstring().c_str());
     sims_flanagan.def_property_readonly("nseg_fwd", &kep3::leg::sims_flanagan::get_nseg_fwd,
@@ -867,6 +907,25 @@ PYBIND11_MODULE(core, m) // NOLINT
     sims_flanagan_alpha.def("compute_throttle_constraints",
                             &kep3::leg::sims_flanagan_alpha::compute_throttle_constraints,
                             pykep::leg_sf_tc_docstring().c_str());
+    sims_flanagan_alpha.def(
+        "compute_mc_grad",
+        [](const kep3::leg::sims_flanagan_alpha &leg) {
+            auto [grad_rvms, grad_rvmf, grad] = leg.compute_mc_grad();
+            const auto n_cols = static_cast<py::ssize_t>(leg.get_nseg() * 4u + 1u);
+            const py::array::ShapeContainer shape_rvm{py::ssize_t(7), py::ssize_t(7)};
+            return py::make_tuple(
+                pykep::vector_to_ndarray(std::vector<double>(grad_rvms.begin(), grad_rvms.end()), shape_rvm),
+                pykep::vector_to_ndarray(std::vector<double>(grad_rvmf.begin(), grad_rvmf.end()), shape_rvm),
+                pykep::vector_to_ndarray(std::move(grad), {py::ssize_t(7), n_cols}));
+        },
+        pykep::leg_sf_alpha_mc_grad_docstring().c_str());
+    sims_flanagan_alpha.def(
+        "compute_tc_grad",
+        [](const kep3::leg::sims_flanagan_alpha &leg) {
+            const auto nseg = static_cast<py::ssize_t>(leg.get_nseg());
+            return pykep::vector_to_ndarray(leg.compute_tc_grad(), {nseg, 3 * nseg});
+        },
+        pykep::leg_sf_tc_grad_docstring().c_str());
     sims_flanagan_alpha.def_property_readonly("nseg", &kep3::leg::sims_flanagan_alpha::get_nseg,
                                               pykep::leg_sf_nseg_docstring().c_str());
     sims_flanagan_alpha.def_property_readonly("nseg_fwd", &kep3::leg::sims_flanagan_alpha::get_nseg_fwd,
@@ -874,6 +933,74 @@ PYBIND11_MODULE(core, m) // NOLINT
     sims_flanagan_alpha.def_property_readonly("nseg_bck", &kep3::leg::sims_flanagan_alpha::get_nseg_bck,
                                               pykep::leg_sf_nseg_bck_docstring().c_str());
 
+    // Exposing the sims_flanagan_sequence
+    py::class_<kep3::leg::sims_flanagan_sequence> sims_flanagan_sequence(m, "_sims_flanagan_sequence",
+                                                                         pykep::leg_sf_sequence_docstring().c_str());
+    sims_flanagan_sequence.def(py::init<const std::vector<kep3::planet> &, const std::vector<unsigned> &, double,
+                                        double, double, double, double>(),
+                               py::arg("seq"), py::arg("nsegs"), py::arg("ms"), py::arg("max_thrust"), py::arg("veff"),
+                               py::arg("mu"), py::arg("cut") = 0.5);
+    // repr().
+    sims_flanagan_sequence.def("__repr__", &pykep::ostream_repr<kep3::leg::sims_flanagan_sequence>);
+    // Copy and deepcopy.
+    sims_flanagan_sequence.def("__copy__", &pykep::generic_copy_wrapper<kep3::leg::sims_flanagan_sequence>);
+    sims_flanagan_sequence.def("__deepcopy__", &pykep::generic_deepcopy_wrapper<kep3::leg::sims_flanagan_sequence>);
+    // Pickle support.
+    sims_flanagan_sequence.def(py::pickle(&pykep::pickle_getstate_wrapper<kep3::leg::sims_flanagan_sequence>,
+                                          &pykep::pickle_setstate_wrapper<kep3::leg::sims_flanagan_sequence>));
+    // The rest
+    sims_flanagan_sequence.def_property(
+        "x", [](const kep3::leg::sims_flanagan_sequence &sfs) { return sfs.get_x(); },
+        &kep3::leg::sims_flanagan_sequence::set_x, pykep::leg_sf_sequence_x_docstring().c_str());
+    sims_flanagan_sequence.def_property_readonly("seq", &kep3::leg::sims_flanagan_sequence::get_seq,
+                                                 "The planets of the sequence.");
+    sims_flanagan_sequence.def_property_readonly("ms", &kep3::leg::sims_flanagan_sequence::get_ms,
+                                                 "The initial mass.");
+    sims_flanagan_sequence.def_property_readonly("legs", &kep3::leg::sims_flanagan_sequence::get_legs,
+                                                 "A copy of the legs, as set by the last decision vector.");
+    sims_flanagan_sequence.def_property_readonly("epochs", &kep3::leg::sims_flanagan_sequence::get_epochs,
+                                                 "The epochs (MJD2000) at the planets, as set by the last decision "
+                                                 "vector.");
+    sims_flanagan_sequence.def_property_readonly("nlegs", &kep3::leg::sims_flanagan_sequence::get_nlegs,
+                                                 "The number of legs.");
+    sims_flanagan_sequence.def_property_readonly("nx", &kep3::leg::sims_flanagan_sequence::get_nx,
+                                                 "The size of the decision vector.");
+    sims_flanagan_sequence.def("get_nec", &kep3::leg::sims_flanagan_sequence::get_nec,
+                               "The number of mismatch (equality) constraints.");
+    sims_flanagan_sequence.def("get_nic", &kep3::leg::sims_flanagan_sequence::get_nic,
+                               "The number of throttle (inequality) constraints.");
+    sims_flanagan_sequence.def(
+        "compute_constraints",
+        [](const kep3::leg::sims_flanagan_sequence &sfs) {
+            std::vector<double> retval;
+            {
+                const py::gil_scoped_release release;
+                retval = sfs.compute_constraints();
+            }
+            const auto size = static_cast<py::ssize_t>(retval.size());
+            return pykep::vector_to_ndarray(std::move(retval), py::array::ShapeContainer{size});
+        },
+        pykep::leg_sf_sequence_constraints_docstring().c_str());
+    sims_flanagan_sequence.def(
+        "get_grad_sparsity",
+        [](const kep3::leg::sims_flanagan_sequence &sfs) {
+            return pykep::sparsity_to_ndarray(sfs.get_grad_sparsity());
+        },
+        pykep::leg_sf_sequence_grad_sparsity_docstring().c_str());
+    sims_flanagan_sequence.def(
+        "compute_grad_sparse",
+        [](const kep3::leg::sims_flanagan_sequence &sfs, const py::object &out) {
+            auto retval
+                = pykep::output_ndarray(out, py::array::ShapeContainer{static_cast<py::ssize_t>(sfs.get_grad_nnz())});
+            const std::span<double> values(retval.mutable_data(), static_cast<std::size_t>(retval.size()));
+            {
+                const py::gil_scoped_release release;
+                sfs.compute_grad_sparse(values);
+            }
+            return retval;
+        },
+        py::arg("out") = py::none(), pykep::leg_sf_sequence_grad_sparse_docstring().c_str());
+
     // Exposing the zoh leg
     py::class_<kep3::leg::zoh> zoh(m, "_zoh_cpp", pykep::leg_zoh_docstring().c_str());
         zoh.def(py::init<const std::vector<double> &, const std::vector<double> &, const std::vector<double> &,
@@ -883,6 +1010,26 @@ PYBIND11_MODULE(core, m) // NOLINT
             py::arg("state0"), py::arg("controls"), py::arg("state1"), py::arg("tgrid"), py::arg("cut"),
               py::arg("tas"), py::arg("max_steps") = std::nullopt, py::arg("dim_dynamics") = 7u,
               py::arg("dim_controls") = 4u);
+    // Construction from the handles returned by pk.ta.acquire_*, which are moved into the leg (so that the integrators
+    // are not deep copied and go back to the pool when the leg is destroyed).
+    zoh.def(py::init([](const std::vector<double> &state0, const std::vector<double> &controls,
+                        const std::vector<double> &state1, const std::vector<double> &tgrid, double cut,
+                        const std::pair<kep3::ta::ta_handle *, kep3::ta::ta_handle *> &tas,
+                        std::optional<unsigned> max_steps, unsigned dim_dynamics, unsigned dim_controls) {
+                auto [ta, ta_var] = tas;
+                if (ta == nullptr || ta->get() == nullptr || ta == ta_var
+                    || (ta_var != nullptr && ta_var->get() == nullptr)) {
+                    throw std::invalid_argument("The integrator handles of a zoh leg must be two distinct non empty "
+                                                "handles (or a handle and None)");
+                }
+                return kep3::leg::zoh(state0, controls, state1, tgrid, cut, std::move(*ta),
+                                      ta_var == nullptr ? std::nullopt
+                                                        : std::optional<kep3::ta::ta_handle>(std::move(*ta_var)),
+                                      max_steps, dim_dynamics, dim_controls);
+            }),
+            py::arg("state0"), py::arg("controls"), py::arg("state1"), py::arg("tgrid"), py::arg("cut"),
+            py::arg("tas"), py::arg("max_steps") = std::nullopt, py::arg("dim_dynamics") = 7u,
+            py::arg("dim_controls") = 4u);
     zoh.def("__repr__", &pykep::ostream_repr<kep3::leg::zoh>);
     zoh.def("__copy__", &pykep::generic_copy_wrapper<kep3::leg::zoh>);
     zoh.def("__deepcopy__", &pykep::generic_deepcopy_wrapper<kep3::leg::zoh>);
@@ -966,6 +1113,19 @@ PYBIND11_MODULE(core, m) // NOLINT
             return py::make_tuple(dx0_py, dx1_py, du_py, dtgrid_py);
         },
         pykep::leg_zoh_mc_grad_docstring().c_str());
+    zoh.def(
+        "get_grad_sparsity",
+        [](const kep3::leg::zoh &leg) { return pykep::sparsity_to_ndarray(leg.get_grad_sparsity()); },
+        pykep::leg_zoh_grad_sparsity_docstring().c_str());
+    zoh.def(
+        "compute_grad_sparse",
+        [](const kep3::leg::zoh &leg, const py::object &out) {
+            auto retval
+                = pykep::output_ndarray(out, py::array::ShapeContainer{static_cast<py::ssize_t>(leg.get_grad_nnz())});
+            leg.compute_grad_sparse(std::span<double>(retval.mutable_data(), static_cast<std::size_t>(retval.size())));
+            return retval;
+        },
+        py::arg("out") = py::none(), pykep::leg_zoh_grad_sparse_docstring().c_str());
 
     // Expose get_state_info with array conversion
     zoh.def(
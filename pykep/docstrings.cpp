@@ -1552,7 +1552,7 @@ Returns:
 
 std::string planet_eph_v_docstring()
 {
-    return R"(eph_v(mjd2000s)
+    return R"(eph_v(mjd2000s, out = None)
 
 The planet ephemerides, i.e. position and velocity (vectorized version over many epochs).
 
@@ -1569,12 +1569,87 @@ in his UDPLA by coding a method having the signature:
 
 see, for example, the python implementation of the UDPLAS :class:`~pykep.udpla.tle` and :class:`~pykep.udpla.spice`.
 
+For C++ UDPLAs the epochs are read, and the results written, directly from and to the NumPy buffers, without
+intermediate copies. Passing a preallocated *out* array allows to reuse it across calls.
+
 Args:
     *mjd2000s* (:class:`numpy.ndarray` or :class:`list`): the Modified Julian Dates at which to compute the ephemerides.
 
+    *out* (:class:`numpy.ndarray`, optional): a C-contiguous, writeable array of doubles of shape (N, 6), where
+    the results are written. Defaults to None (a new array is returned).
+
 Returns:
-    :class:`list` [:class:`list`, :class:`list`]: r and v, that is the final position and velocity after the propagation.
+    :class:`numpy.ndarray`: the positions and velocities, shape (N, 6) (or *out*, if passed).
+
+Raises:
+    :class:`ValueError`: if *out* does not have shape (N, 6) or is not C-contiguous and writeable.
+
+    :class:`TypeError`: if *out* is not a NumPy array of doubles.
+
+)";
+}
+
+std::string planet_catalog_docstring()
+{
+    return R"(__init__(planets = [])
+
+A catalog of Keplerian bodies (e.g. the asteroids of a database).
+
+The bodies are stored in structure of arrays form, so that the ephemerides of the whole
+catalog, or of a subset of it, are computed in one call solving Kepler's equation with vectorized
+kernels and, for large queries, in parallel. This is much faster than looping over a :class:`list`
+of :class:`~pykep.planet`.
+
+Individual bodies are accessed by index as :class:`~pykep.planet` (holding a :class:`~pykep.udpla.keplerian`).
+
+Args:
+    *planets* (:class:`list` [:class:`~pykep.planet`]): the bodies, each constructed from a :class:`~pykep.udpla.keplerian`.
+
+Raises:
+    :class:`ValueError`: if a planet is not constructed from a :class:`~pykep.udpla.keplerian`.
+
+Examples:
+    >>> import pykep as pk
+    >>> import numpy as np
+    >>> pls = [pk.planet(pk.udpla.keplerian(pk.epoch(0.), [pk.AU * (1 + 0.1 * i), 0.1, 0., 0., 0., 0.], pk.MU_SUN)) for i in range(100)]
+    >>> cat = pk.planet_catalog(pls)
+    >>> rv = cat.eph_all(1000.) # shape (100, 6)
+    >>> rv = cat.eph_subset([3, 5, 7], [1000., 1100., 1200.]) # shape (3, 6)
+)";
+}
 
+std::string planet_catalog_eph_all_docstring()
+{
+    return R"(eph_all(when)
+
+The ephemerides of all the bodies of the catalog at one epoch.
+
+Args:
+    *when* (:class:`float` or :class:`~pykep.epoch`): the epoch (if a float, in MJD2000).
+
+Returns:
+    :class:`numpy.ndarray`: the positions and velocities of the bodies, shape (N, 6).
+)";
+}
+
+std::string planet_catalog_eph_subset_docstring()
+{
+    return R"(eph_subset(indices, mjd2000s)
+
+The ephemerides of some of the bodies of the catalog.
+
+Args:
+    *indices* (:class:`list` [:class:`int`]): the indices of the bodies (repetitions are allowed).
+
+    *mjd2000s* (:class:`list` [:class:`float`]): the epochs (MJD2000), one per index or a single one shared by all.
+
+Returns:
+    :class:`numpy.ndarray`: the positions and velocities of the bodies, shape (K, 6) with K the number of indices.
+
+Raises:
+    :class:`IndexError`: if an index is out of range.
+
+    :class:`ValueError`: if the number of epochs is neither 1 nor the number of indices.
 )";
 }
 
@@ -1610,7 +1685,7 @@ Returns:
 
 std::string planet_acc_v_docstring()
 {
-    return R"(acc_v(mjd2000s)
+    return R"(acc_v(mjd2000s, out = None)
 
 The planet acceleration (vectorized version over many epochs).
 
@@ -1624,11 +1699,17 @@ in his UDPLA by coding a method having the signature:
       ...
       return np.array((len(mjd2000s), 3))
 
+As for :func:`~pykep.planet.eph_v`, a preallocated *out* array can be passed and C++ UDPLAs work on the
+NumPy buffers directly.
+
 Args:
     *mjd2000s* (:class:`numpy.ndarray` or :class:`list`): the Modified Julian Dates at which to compute the accelerations.
 
+    *out* (:class:`numpy.ndarray`, optional): a C-contiguous, writeable array of doubles of shape (N, 3), where
+    the results are written. Defaults to None (a new array is returned).
+
 Returns:
-    :class:`list` [:class:`list`]: a, that is the acceleration vectors at the requested epochs.
+    :class:`numpy.ndarray`: the acceleration vectors, shape (N, 3) (or *out*, if passed).
 )";
 }
 
@@ -1769,9 +1850,51 @@ Examples:
 )";
 }
 
+std::string udpla_chebyshev_docstring()
+{
+    return R"(__init__(source, mjd2000_start, mjd2000_end, tol = 1e-12, order = 15)
+
+Constructs a planet whose ephemerides are a piecewise Chebyshev interpolation of those of *source*
+over a time window. The window is bisected until, on each segment, the fits of the position and
+of the velocity match the source within the relative tolerance *tol*. The fit is then evaluated
+at the cost of a few polynomial evaluations, and does not need the source anymore: pickling the
+planet ships the fit, not the source, to (e.g.) the workers of a parallel optimization.
+
+The physical parameters (name, gravitational parameters, radii) are copied from the source. The
+acceleration returned by :func:`~pykep.planet.acc` is the derivative of the velocity fit.
+
+Args:
+    *source* (:class:`~pykep.planet`): the planet to interpolate.
+
+    *mjd2000_start* (:class:`float`): the start of the time window (MJD2000).
+
+    *mjd2000_end* (:class:`float`): the end of the time window (MJD2000).
+
+    *tol* (:class:`float`): the tolerance, relative to the largest position (velocity) norm on each segment.
+
+    *order* (:class:`int`): the order of the Chebyshev polynomials.
+
+Raises:
+    :class:`ValueError`: if the window is empty, or *tol* (smaller than 100 times the machine epsilon) or *order* are
+    not valid.
+
+    :class:`ValueError`: if the tolerance cannot be reached (the number of fits is capped), and for epochs outside the
+    window.
+
+.. note::
+   The error is checked on each segment at the midpoints between the fitting nodes and at the segment
+   boundaries, it is hence an estimate, not a rigorous bound.
+
+Examples:
+    >>> import pykep as pk
+    >>> mars = pk.planet(pk.udpla.vsop2013(body="mars"))
+    >>> pla = pk.planet(pk.udpla.chebyshev(mars, 10000., 11000., tol = 1e-10))
+)";
+}
+
 std::string lambert_problem_docstring()
 {
-    return R"(__init__(r0 = [1,0,0], r1 = [0,1,0], tof = pi/2, mu = 1., cw = False, multi_revs = 0)
+    return R"(__init__(r0 = [1,0,0], r1 = [0,1,0], tof = pi/2, mu = 1., cw = False, multi_revs = 0, x_guess = [])
 
       Args:
           *r0* (1D array-like): Cartesian components of the first position vector [xs, ys, zs]. Defaults to [1,0,0].
@@ -1786,6 +1909,10 @@ std::string lambert_problem_docstring()
 
           *multi_revs* (:class:`float`): Maximum number of multiple revolutions to be computed. Defaults to 0.
 
+          *x_guess* (1D array-like): initial guesses for the x of each solution, ordered as in :attr:`x`. Typically the
+          x of a previously solved nearby problem (warm start). Solutions without a guess, or whose iterations
+          from the guess fail, use the default initial guess. Defaults to [].
+
       .. note::
 
         Units need to be consistent. The multirev Lambert's problem will be solved upon construction
@@ -1804,6 +1931,248 @@ std::string lambert_problem_docstring()
 )";
 }
 
+std::string lambert_problem_compute_grad_docstring()
+{
+    return R"(compute_grad()
+
+Computes the Jacobians of the terminal velocities with respect to the problem data.
+
+The Jacobians are computed analytically from the converged solutions, via the implicit
+differentiation of the time of flight equation, so that no further Lambert solve is needed.
+
+Returns:
+    :class:`tuple`: (dv0, dv1), two numpy arrays of shape (n_sol, 3, 7) containing, for each solution, 
+    the derivatives of v0 and v1 with respect to r0 (columns 0-2), r1 (columns 3-5) and tof (column 6).
+
+Examples:
+    >>> import pykep as pk
+    >>> lp = pk.lambert_problem([1,0,0], [0,1,0], 20., 1., False, 1)
+    >>> dv0, dv1 = lp.compute_grad()
+    >>> dv0.shape
+    (3, 3, 7)
+)";
+}
+
+std::string porkchop_docstring()
+{
+    return R"(porkchop(pl0, pl1, t0s, t1s, multi_revs = 0, cw = False)
+
+Computes a launch window (porkchop) grid between two planets orbiting the same central body.
+
+The ephemerides are computed once per grid axis, then the Lambert problems for all departure and arrival
+epoch pairs are solved in parallel. For each cell, all solutions up to *multi_revs* revolutions are considered
+and only the one with the lowest total DV (departure plus arrival) is returned.
+
+Args:
+    *pl0* (:class:`~pykep.planet`): the departure planet.
+
+    *pl1* (:class:`~pykep.planet`): the arrival planet.
+
+    *t0s* (1D array-like): the departure epochs (mjd2000).
+
+    *t1s* (1D array-like): the arrival epochs (mjd2000).
+
+    *multi_revs* (:class:`int`): maximum number of revolutions to consider. Defaults to 0.
+
+    *cw* (:class:`bool`): True for retrograde motion (clockwise). Defaults to False.
+
+Returns:
+    :class:`tuple`: (dv_dep, dv_arr, c3, vinf_dep, vinf_arr, branch), where the first three and the last are 
+    numpy arrays of shape (len(t0s), len(t1s)) and the hyperbolic excess velocities have shape (len(t0s), len(t1s), 3).
+    *branch* is the index of the retained Lambert solution (as in :class:`~pykep.lambert_problem`). Cells where 
+    the arrival does not follow the departure, or where the Lambert problem is ill defined (e.g. coincident
+    positions), contain NaNs and a branch index of -1.
+
+Raises:
+    :class:`ValueError`: if the planets do not orbit the same central body.
+
+Examples:
+    >>> import pykep as pk
+    >>> import numpy as np
+    >>> earth = pk.planet(pk.udpla.jpl_lp("earth"))
+    >>> mars = pk.planet(pk.udpla.jpl_lp("mars"))
+    >>> t0s = np.linspace(7000., 7700., 100)
+    >>> t1s = np.linspace(7200., 8200., 100)
+    >>> dv_dep, dv_arr, c3, vinf_dep, vinf_arr, branch = pk.porkchop(earth, mars, t0s, t1s)
+)";
+}
+
+std::string set_jit_cache_dir_docstring()
+{
+    return R"(set_jit_cache_dir(dir)
+
+Sets the persistent JIT cache directory.
+
+The Taylor adaptive integrators of :mod:`pykep.ta`, their auxiliary compiled functions and the
+:class:`~pykep.udpla.vsop2013` ephemerides are JIT compiled the first time they are requested in a
+process, which can take from seconds to minutes. When a cache directory is set, the compiled objects are
+also stored there and later loaded, in the same or in other processes, instead of being compiled again.
+
+Cached objects are keyed by model, tolerance (and other construction parameters), pykep and heyoka versions
+and host CPU. Files that cannot be loaded are recompiled and overwritten. The directory is created if it does
+not exist.
+
+The persistent cache is disabled by default. It is enabled at import if the environment variable
+``KEP3_JIT_CACHE_DIR`` is set.
+
+Args:
+    *dir* (:class:`str`): the cache directory. An empty string disables the persistent cache.
+
+Examples:
+    >>> import pykep as pk
+    >>> pk.set_jit_cache_dir("/tmp/pykep_jit_cache")
+    >>> ta = pk.ta.get_zoh_kep(1e-16)
+)";
+}
+
+std::string get_jit_cache_dir_docstring()
+{
+    return R"(get_jit_cache_dir()
+
+Gets the persistent JIT cache directory (see :func:`~pykep.set_jit_cache_dir`).
+
+Returns:
+    :class:`str`: the cache directory, empty if the persistent cache is disabled.
+)";
+}
+
+std::string get_jit_cache_stats_docstring()
+{
+    return R"(get_jit_cache_stats()
+
+Gets the persistent JIT cache statistics (see :func:`~pykep.set_jit_cache_dir`).
+
+Requests answered by the in-memory caches of the current process are not counted.
+
+Returns:
+    :class:`dict`: the number of objects loaded from the cache directory ("hits"), compiled as not found
+    there ("misses"), written there ("stores") and of files that could not be loaded or written ("errors").
+)";
+}
+
+std::string reset_jit_cache_stats_docstring()
+{
+    return R"(reset_jit_cache_stats()
+
+Resets the persistent JIT cache statistics (see :func:`~pykep.get_jit_cache_stats`).
+)";
+}
+
+std::string set_jit_memory_cache_capacity_docstring()
+{
+    return R"(set_jit_memory_cache_capacity(capacity)
+
+Sets the capacity of the in-memory JIT caches.
+
+Each family of JIT compiled objects (e.g. the integrators returned by :func:`~pykep.ta.get_zoh_kep`, or the
+:class:`~pykep.udpla.vsop2013` series) is kept in memory in its own cache. When a cache holds more objects
+than its capacity, the least recently used ones are evicted, and compiled again if requested later. Existing
+caches are trimmed right away.
+
+Args:
+    *capacity* (:class:`int`): the maximum number of objects in each cache. Zero (the default) means unbounded.
+)";
+}
+
+std::string get_jit_memory_cache_capacity_docstring()
+{
+    return R"(get_jit_memory_cache_capacity()
+
+Gets the capacity of the in-memory JIT caches (see :func:`~pykep.set_jit_memory_cache_capacity`).
+
+Returns:
+    :class:`int`: the maximum number of objects in each cache, zero if unbounded.
+)";
+}
+
+std::string set_jit_cache_tol_digits_docstring()
+{
+    return R"(set_jit_cache_tol_digits(digits)
+
+Sets the tolerance normalization of the in-memory JIT caches.
+
+The tolerances requested to the getters of :mod:`pykep.ta` are rounded to the given number of significant
+digits, and the integrators are built with the rounded tolerance. This avoids compiling many integrators
+for tolerances which differ only by noise (e.g. 1e-10 and 1.0000000001e-10).
+
+Args:
+    *digits* (:class:`int`): the number of significant digits. Zero (the default) disables the normalization.
+)";
+}
+
+std::string get_jit_cache_tol_digits_docstring()
+{
+    return R"(get_jit_cache_tol_digits()
+
+Gets the tolerance normalization of the in-memory JIT caches (see :func:`~pykep.set_jit_cache_tol_digits`).
+
+Returns:
+    :class:`int`: the number of significant digits, zero if the normalization is disabled.
+)";
+}
+
+std::string get_jit_memory_cache_stats_docstring()
+{
+    return R"(get_jit_memory_cache_stats()
+
+Gets the statistics of the in-memory JIT caches.
+
+Returns:
+    :class:`dict`: for each cache created so far (e.g. "ta_zoh_kep", "ta_pc_var", "vsop2013"), a :class:`dict`
+    with the number of cached objects ("size"), of lookups answered by the cache ("hits"), of objects compiled
+    or loaded from the persistent cache ("misses") and of evicted objects ("evictions"), the time spent
+    compiling in seconds ("compile_time") and the estimated memory held by the cached objects in bytes
+    ("resident_bytes").
+
+Examples:
+    >>> import pykep as pk
+    >>> ta = pk.ta.get_zoh_kep(1e-16)
+    >>> pk.get_jit_memory_cache_stats()["ta_zoh_kep"]["size"] # doctest: +SKIP
+    1
+)";
+}
+
+std::string reset_jit_memory_cache_stats_docstring()
+{
+    return R"(reset_jit_memory_cache_stats()
+
+Resets the counters of the in-memory JIT caches (see :func:`~pykep.get_jit_memory_cache_stats`). The sizes
+and resident bytes are not affected.
+)";
+}
+
+std::string prewarm_docstring()
+{
+    return R"(prewarm(specs)
+
+Compiles Taylor integrators, compiled functions and ephemerides ahead of use.
+
+The Taylor adaptive integrators of :mod:`pykep.ta`, their auxiliary compiled functions and the
+:class:`~pykep.udpla.vsop2013` series are JIT compiled (or loaded from the persistent JIT cache, see
+:func:`~pykep.set_jit_cache_dir`) the first time they are requested in a process. This function compiles the
+requested items concurrently and returns once they are all cached in memory, so that services can warm up
+before accepting work. Items already cached are not compiled again.
+
+Args:
+    *specs* (:class:`list`): the items to compile, as tuples (model, tol, optimality). The model is the name
+    of a getter in :mod:`pykep.ta` without the get\_ prefix (e.g. "zoh_kep_var", "pc"), "pc_cfuncs" or "peq_cfuncs"
+    for the compiled functions of the Pontryagin problems, or "vsop2013:" followed by a body name (e.g.
+    "vsop2013:earth_moon"). The tolerance (the truncation threshold for VSOP2013) defaults to 1e-16 and
+    the optimality (:class:`~pykep.optimality_type`), only used by the Pontryagin problems, to MASS.
+
+Returns:
+    :class:`list`: the wall clock time (in seconds) spent on each item.
+
+Raises:
+    :class:`ValueError`: if a model is not known (in which case nothing is compiled).
+
+Examples:
+    >>> import pykep as pk
+    >>> times = pk.prewarm([("zoh_kep", 1e-16), ("zoh_kep_var", 1e-16), ("pc", 1e-16, pk.optimality_type.TIME)])
+    >>> ta = pk.ta.get_zoh_kep_var(1e-16) # no compilation here
+)";
+}
+
 std::string get_kep_docstring()
 {
     return R"(ta.get_kep(tol)
@@ -1958,6 +2327,73 @@ Examples:
 )";
 }
 
+std::string acquire_zoh_kep_docstring()
+{
+    return R"(ta.acquire_zoh_kep(tol)
+
+Returns a handle to a copy of the Taylor adaptive propagator returned by :func:`~pykep.ta.get_zoh_kep`, taken
+from a pool local to the calling thread.
+
+When the handle (or the :class:`~pykep.leg.zoh` constructed from it) is destroyed, the copy goes back to the pool
+and is handed out again by the next call with the same tolerance, avoiding a deep copy of the propagator.
+
+.. note::
+   A pooled copy keeps the time, state and parameters left by its previous user, they must be set before use.
+
+Args:
+  *tol* (:class:`float`): the tolerance of the Taylor adaptive propagator.
+
+Returns:
+  :class:`~pykep.ta.ta_handle`: The handle to the Taylor adaptive propagator.
+
+Examples:
+  >>> import pykep as pk
+  >>> h = pk.ta.acquire_zoh_kep(tol = 1e-16)
+  >>> h.ta.pars[4] = 1. / 1.32
+)";
+}
+
+std::string acquire_zoh_kep_var_docstring()
+{
+    return R"(ta.acquire_zoh_kep_var(tol)
+
+Returns a handle to a copy of the variational Taylor adaptive propagator returned by
+:func:`~pykep.ta.get_zoh_kep_var`, taken from a pool local to the calling thread.
+
+See :func:`~pykep.ta.acquire_zoh_kep`.
+
+Args:
+  *tol* (:class:`float`): the tolerance of the variational Taylor adaptive propagator.
+
+Returns:
+  :class:`~pykep.ta.ta_handle`: The handle to the variational Taylor adaptive propagator.
+)";
+}
+
+std::string ta_handle_docstring()
+{
+    return R"(A handle to a Taylor adaptive propagator, as returned by :func:`~pykep.ta.acquire_zoh_kep`.
+
+Passing a pair of handles as *tas* to :class:`~pykep.leg.zoh` moves them into the leg, after which they are
+empty.
+)";
+}
+
+std::string ta_handle_ta_docstring()
+{
+    return R"(The Taylor adaptive propagator owned by the handle.
+
+Raises:
+  :exc:`ValueError`: if the handle is empty.
+)";
+}
+
+std::string ta_handle_is_pooled_docstring()
+{
+    return R"(True if the propagator goes back to a pool when the handle is destroyed.
+)";
+}
+
 std::string zoh_kep_dyn_docstring()
 {
     return R"(zoh_kep_dyn()
@@ -3081,6 +3517,38 @@ Examples:
 )";
 };
 
+std::string leg_sf_alpha_mc_grad_docstring()
+{
+    return R"(compute_mc_grad()
+
+Computes the gradients of the mismatch constraints. Indicating the initial augmented state with :math:`\mathbf x_s = [\mathbf r_s, \mathbf v_s, m_s]`, the
+final augmented state with :math:`\mathbf x_f = [\mathbf r_f, \mathbf v_f, m_f]`, the total time of flight with :math:`T`, the segment durations with
+:math:`\mathbf t = [t_0, t_1]` and introducing the throttle vector :math:`\mathbf u = [u_{x0}, u_{y0}, u_{z0}, u_{x1}, u_{y1}, u_{z1} ]` and
+:math:`\mathbf {\tilde u} = [\mathbf u, \mathbf t, T]`, this method computes the following gradients:
+
+.. math::
+  \frac{\partial \mathbf {mc}}{\partial \mathbf x_s}  \rightarrow (7\times7)
+
+.. math::
+  \frac{\partial \mathbf {mc}}{\partial \mathbf x_f} \rightarrow (7\times7)
+
+.. math::
+  \frac{\partial \mathbf {mc}}{\partial \mathbf {\tilde u}} \rightarrow (7\times(4\mathbf{nseg} + 1))
+
+The segment durations being the :attr:`talphas`, the mismatch constraints do not depend on :math:`T` and the last column is zero.
+
+Returns:
+    :class:`tuple` [:class:`numpy.ndarray`, :class:`numpy.ndarray`, :class:`numpy.ndarray`]: The three gradients. sizes will be (7,7), (7,7) and (7, 4nseg + 1)
+
+Examples:
+  >>> import pykep as pk
+  >>> import numpy as np
+  >>> sf = pk.leg.sims_flanagan_alpha()
+  >>  sf.throttles = [0.8]*6
+  >>> sf.compute_mc_grad()
+)";
+};
+
 std::string leg_sf_tc_grad_docstring()
 {
     return R"(compute_tc_grad()
@@ -3103,6 +3571,169 @@ Examples:
 )";
 };
 
+std::string leg_sf_grad_sparsity_docstring()
+{
+    return R"(get_grad_sparsity()
+
+Returns the sparsity pattern of the Jacobian of all the constraints of the leg, i.e. of :math:`[\mathbf {mc}, \mathbf {tc}]` (the
+7 mismatch constraints followed by the nseg throttle constraints) with respect to :math:`[\mathbf x_s, \mathbf u, \mathbf x_f, T]`.
+Only the structural nonzeros are listed: the mass mismatch does not depend on the positions and velocities and each throttle
+constraint only depends on the three throttles of its segment.
+
+The indices are sorted in row major order, as required by :func:`pygmo.problem.gradient_sparsity`.
+
+Returns:
+    :class:`numpy.ndarray`: The (row, column) indices of the nonzeros. Shape will be (24nseg + 93, 2).
+
+Examples:
+  >>> import pykep as pk
+  >>> sf = pk.leg.sims_flanagan()
+  >>> sf.get_grad_sparsity().shape
+  (141, 2)
+)";
+};
+
+std::string leg_sf_grad_sparse_docstring()
+{
+    return R"(compute_grad_sparse(out = None)
+
+Computes the nonzero entries of the Jacobian of all the constraints of the leg, in the order given by
+:func:`~pykep.leg.sims_flanagan.get_grad_sparsity`. The result can be used as the values of a COO matrix or, since the
+entries are sorted in row major order, as the data of a CSR matrix.
+
+Args:
+    *out* (:class:`numpy.ndarray`, optional): a C-contiguous, writeable array of doubles with 24nseg + 93 elements, where
+    the results are written. Passing a preallocated *out* array allows to reuse it across calls.
+
+Returns:
+    :class:`numpy.ndarray`: The nonzero entries of the Jacobian (or *out*, if passed).
+
+Raises:
+    :exc:`TypeError`: if *out* is not an array of doubles.
+
+    :exc:`ValueError`: if *out* is not C-contiguous and writeable, or has the wrong size.
+
+Examples:
+  >>> import pykep as pk
+  >>> import numpy as np
+  >>> import scipy.sparse
+  >>> sf = pk.leg.sims_flanagan()
+  >>> sp = sf.get_grad_sparsity()
+  >>> J = scipy.sparse.coo_matrix((sf.compute_grad_sparse(), (sp[:, 0], sp[:, 1])))
+)";
+};
+
+std::string leg_sf_sequence_docstring()
+{
+    return R"(__init__(seq, nsegs, ms, max_thrust, veff, mu, cut = 0.5)
+
+A sequence of :class:`~pykep.leg.sims_flanagan` legs.
+
+The leg :math:`i` departs from the planet ``seq[i]`` at the epoch :math:`t_i` and arrives at the planet ``seq[i+1]`` at the
+epoch :math:`t_{i+1} = t_i + T_i`, starting with the final mass of the previous leg (or with *ms*, for the first leg). All
+the legs are set from one flat decision vector (see :attr:`~pykep.leg.sims_flanagan_sequence.x`), and the constraints of all
+the legs, as well as their sparse Jacobian, are computed by one call, evaluating the legs in parallel.
+
+The constraints at the planets (e.g. on the relative velocities at the flybys) and the objective are left to the user
+(typically a UDP).
+
+Args:
+    *seq* (:class:`list` [:class:`~pykep.planet`]): the N + 1 planets of the sequence.
+
+    *nsegs* (:class:`list` [:class:`int`]): the number of segments of each of the N legs.
+
+    *ms* (:class:`float`): the initial mass (kg).
+
+    *max_thrust* (:class:`float`): the maximum thrust (N).
+
+    *veff* (:class:`float`): the effective velocity (m/s).
+
+    *mu* (:class:`float`): the gravitational parameter of the central body (m^3/s^2).
+
+    *cut* (:class:`float`): the cut parameter of the legs. Defaults to 0.5.
+
+Raises:
+    :exc:`ValueError`: if the sizes of *seq* and *nsegs* are inconsistent or a leg has no segments.
+
+Examples:
+  >>> import pykep as pk
+  >>> seq = [pk.planet(pk.udpla.jpl_lp(name)) for name in ["earth", "venus", "earth"]]
+  >>> sfs = pk.leg.sims_flanagan_sequence(seq, [10, 10], 1500., 0.12, 3000. * pk.G0, pk.MU_SUN)
+)";
+}
+
+std::string leg_sf_sequence_x_docstring()
+{
+    return R"(The decision vector.
+
+.. math::
+   \mathbf x = [t_0, \mathbf l_0, \mathbf l_1, \ldots, \mathbf l_{N-1}], \quad \mathbf l_i = [m_{f}, \mathbf v_{\infty s}, \mathbf v_{\infty f}, \mathbf u, T]_i
+
+where :math:`t_0` is the departure epoch (MJD2000), :math:`T_i` the times of flight (days), :math:`\mathbf v_{\infty s}` and
+:math:`\mathbf v_{\infty f}` the departure and arrival velocities relative to the planets (m/s), :math:`m_f` the final masses
+(kg) and :math:`\mathbf u` the throttles of the legs.
+
+Setting it computes the ephemerides of the planets at the N + 1 epochs and sets the legs.
+
+Returns:
+    :class:`list` [:class:`float`]: the decision vector (empty if never set).
+)";
+}
+
+std::string leg_sf_sequence_constraints_docstring()
+{
+    return R"(compute_constraints()
+
+Computes the mismatch constraints of all the legs, followed by their throttle constraints, i.e.
+:math:`[\mathbf {mc}_0, \ldots, \mathbf {mc}_{N-1}, \mathbf {tc}_0, \ldots, \mathbf {tc}_{N-1}]`. The legs are evaluated in parallel.
+
+Returns:
+    :class:`numpy.ndarray`: the constraints, 7N equalities followed by :math:`\sum_i n_{seg, i}` inequalities.
+
+Raises:
+    :exc:`RuntimeError`: if the decision vector was never set.
+)";
+}
+
+std::string leg_sf_sequence_grad_sparsity_docstring()
+{
+    return R"(get_grad_sparsity()
+
+Returns the sparsity pattern of the Jacobian of the constraints with respect to the decision vector, sorted in row major
+order as required by :func:`pygmo.problem.gradient_sparsity`. The Jacobian is block sparse: the constraints of a leg only
+depend on the variables of the leg, on the final mass of the previous leg and on the epoch of its departure (i.e. on
+:math:`t_0` and on the times of flight of the previous legs).
+
+Returns:
+    :class:`numpy.ndarray`: The (row, column) indices of the nonzeros, shape (nnz, 2).
+)";
+}
+
+std::string leg_sf_sequence_grad_sparse_docstring()
+{
+    return R"(compute_grad_sparse(out = None)
+
+Computes the nonzero entries of the Jacobian of the constraints, in the order given by
+:func:`~pykep.leg.sims_flanagan_sequence.get_grad_sparsity` (i.e. both the COO values and the CSR data). The legs are
+evaluated in parallel. The derivatives with respect to the epochs assume that the accelerations of the planets are
+those returned by :func:`pykep.planet.acc`.
+
+Args:
+    *out* (:class:`numpy.ndarray`, optional): a C-contiguous, writeable array of doubles of the size of the pattern, where
+    the results are written. Passing a preallocated *out* array allows to reuse it across calls.
+
+Returns:
+    :class:`numpy.ndarray`: The nonzero entries of the Jacobian (or *out*, if passed).
+
+Raises:
+    :exc:`RuntimeError`: if the decision vector was never set.
+
+    :exc:`TypeError`: if *out* is not an array of doubles.
+
+    :exc:`ValueError`: if *out* is not C-contiguous and writeable, or has the wrong size.
+)";
+}
+
 // ------------------- ZOH LEG DOCSTRINGS -------------------
 std::string leg_zoh_docstring()
 {
@@ -3119,6 +3750,11 @@ The formulation generalises :class:`pykep.leg.sims_flanagan` to arbitrary dynami
   fulfilled by :class:`pykep.ta.zoh_kep`, :class:`pykep.ta.zoh_eq`, :class:`pykep.ta.zoh_cr3bp`,
   :class:`pykep.ta.zoh_ss` and their variational versions.
 
+The integrators in `tas` are copied into the leg. Alternatively, `tas` can be a pair of handles returned by
+:func:`pykep.ta.acquire_zoh_kep` and :func:`pykep.ta.acquire_zoh_kep_var` (the second one can be None), which are
+moved into the leg and whose integrators go back to a pool when the leg is destroyed, avoiding a deep copy when
+legs are constructed repeatedly.
+
 A transfer is feasible when the state mismatch equality constraints are satisfied. Any additional
 constraints on controls (e.g. throttle constraints) are to be enforced by the caller.
 
@@ -3219,6 +3855,49 @@ Returns:
   :class:`tuple` [:class:`numpy.ndarray`, :class:`numpy.ndarray`, :class:`numpy.ndarray`, :class:`numpy.ndarray`]: The four gradients. Sizes will be (7,7), (7,7), (7,4nseg), and (7,nseg+1).
 )";
 }
+std::string leg_zoh_grad_sparsity_docstring()
+{
+    return R"(get_grad_sparsity()
+
+Returns the sparsity pattern of the Jacobian of the mismatch constraints with respect to
+:math:`[\mathbf x_s, \mathbf u, \mathbf x_f, T_{grid}]`, sorted in row major order as required by
+:func:`pygmo.problem.gradient_sparsity`.
+
+.. note::
+   The dynamics of the leg are generic, so that the pattern is dense.
+
+Returns:
+    :class:`numpy.ndarray`: The (row, column) indices of the nonzeros. Shape will be (d(2d + (c+1)nseg + 1), 2), with d the
+    dimension of the dynamics and c the dimension of the controls.
+)";
+}
+
+std::string leg_zoh_grad_sparse_docstring()
+{
+    return R"(compute_grad_sparse(out = None)
+
+Computes the entries of the Jacobian of the mismatch constraints, in the order given by
+:func:`~pykep.leg.zoh.get_grad_sparsity`.
+
+.. note::
+   The pattern of a zoh leg is dense, and this method is only a layout adapter: it computes the dense blocks
+   returned by :func:`~pykep.leg.zoh.compute_mc_grad` and copies their rows in the pattern order. Passing *out*
+   avoids allocating the result, not the dense blocks.
+
+Args:
+    *out* (:class:`numpy.ndarray`, optional): a C-contiguous, writeable array of doubles of the size of the pattern, where
+    the results are written.
+
+Returns:
+    :class:`numpy.ndarray`: The entries of the Jacobian (or *out*, if passed).
+
+Raises:
+    :exc:`TypeError`: if *out* is not an array of doubles.
+
+    :exc:`ValueError`: if *out* is not C-contiguous and writeable, or has the wrong size.
+)";
+}
+
 std::string leg_zoh_tc_grad_docstring()
 {
     return R"(compute_tc_grad()
@@ -98,11 +98,17 @@ std::string planet_acc_v_docstring();
 std::string planet_period_docstring();
 std::string planet_elements_docstring();
 
+// Planet catalog
+std::string planet_catalog_docstring();
+std::string planet_catalog_eph_all_docstring();
+std::string planet_catalog_eph_subset_docstring();
+
 // UDPLAS
 std::string udpla_keplerian_from_elem_docstring();
 std::string udpla_keplerian_from_posvel_docstring();
 std::string udpla_jpl_lp_docstring();
 std::string udpla_vsop2013_docstring();
+std::string udpla_chebyshev_docstring();
 
 // Taylor Adaptive propagators
 // basic
@@ -121,6 +127,11 @@ std::string bcp_dyn_docstring();
 std::string get_zoh_kep_docstring();
 std::string get_zoh_kep_var_docstring();
 std::string zoh_kep_dyn_docstring();
+std::string acquire_zoh_kep_docstring();
+std::string acquire_zoh_kep_var_docstring();
+std::string ta_handle_docstring();
+std::string ta_handle_ta_docstring();
+std::string ta_handle_is_pooled_docstring();
 std::string get_zoh_eq_docstring();
 std::string get_zoh_eq_var_docstring();
 std::string zoh_eq_dyn_docstring();
@@ -152,6 +163,21 @@ inline std::string get_peq_dyn_cfunc_docstring(){return "The augmented dynamics.
 
 // Lambert Problem
 std::string lambert_problem_docstring();
+std::string lambert_problem_compute_grad_docstring();
+std::string porkchop_docstring();
+
+// Persistent JIT cache
+std::string set_jit_cache_dir_docstring();
+std::string get_jit_cache_dir_docstring();
+std::string get_jit_cache_stats_docstring();
+std::string reset_jit_cache_stats_docstring();
+std::string set_jit_memory_cache_capacity_docstring();
+std::string get_jit_memory_cache_capacity_docstring();
+std::string set_jit_cache_tol_digits_docstring();
+std::string get_jit_cache_tol_digits_docstring();
+std::string get_jit_memory_cache_stats_docstring();
+std::string reset_jit_memory_cache_stats_docstring();
+std::string prewarm_docstring();
 
 // Flybys
 std::string fb_con_docstring();
@@ -181,12 +207,22 @@ std::string leg_sf_tc_docstring();
 std::string leg_sf_mc_grad_docstring();
 
 std::string leg_sf_tc_grad_docstring();
+std::string leg_sf_grad_sparsity_docstring();
+std::string leg_sf_grad_sparse_docstring();
+
+// sims_flanagan_sequence
+std::string leg_sf_sequence_docstring();
+std::string leg_sf_sequence_x_docstring();
+std::string leg_sf_sequence_constraints_docstring();
+std::string leg_sf_sequence_grad_sparsity_docstring();
+std::string leg_sf_sequence_grad_sparse_docstring();
 std::string leg_sf_nseg_docstring();
 std::string leg_sf_nseg_fwd_docstring();
 std::string leg_sf_nseg_bck_docstring();
 // Alpha
 std::string leg_sf_alpha_docstring();
 std::string leg_sf_talphas_docstring();
+std::string leg_sf_alpha_mc_grad_docstring();
 // Zoh
 std::string leg_zoh_docstring();
 std::string leg_zoh_state0_docstring();
@@ -201,6 +237,8 @@ std::string leg_zoh_nseg_bck_docstring();
 std::string leg_zoh_mc_docstring();
 std::string leg_zoh_tc_docstring();
 std::string leg_zoh_mc_grad_docstring();
+std::string leg_zoh_grad_sparsity_docstring();
+std::string leg_zoh_grad_sparse_docstring();
 std::string leg_zoh_tc_grad_docstring();
 std::string leg_zoh_get_state_info_docstring();
 
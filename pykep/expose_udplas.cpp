@@ -13,6 +13,7 @@
 #include <pybind11/pybind11.h>
 
 #include <kep3/planet.hpp>
+#include <kep3/udpla/chebyshev.hpp>
 #include <kep3/udpla/jpl_lp.hpp>
 #include <kep3/udpla/keplerian.hpp>
 #include <kep3/udpla/vsop2013.hpp>
@@ -74,6 +75,23 @@ void expose_all_udplas(py::module &udpla_module, py::class_<kep3::planet> &plane
     // Constructors.
     vsop2013_udpla.def(py::init<std::string, double>(), py::arg("body") = "mercury", py::arg("thresh") = 1e-5,
                        pykep::udpla_vsop2013_docstring().c_str());
+
+    // chebyshev udpla.
+    auto chebyshev_udpla = pykep::expose_one_udpla<kep3::udpla::chebyshev>(
+        udpla_module, planet_class, "_chebyshev", "Piecewise Chebyshev interpolation of the ephemerides of a planet");
+    // Constructors.
+    chebyshev_udpla
+        .def(py::init<const kep3::planet &, double, double, double, unsigned>(), py::arg("source"),
+             py::arg("mjd2000_start"), py::arg("mjd2000_end"), py::arg("tol") = 1e-12, py::arg("order") = 15u,
+             pykep::udpla_chebyshev_docstring().c_str())
+        // repr().
+        .def("__repr__", &pykep::ostream_repr<kep3::udpla::chebyshev>)
+        // other methods
+        .def_property_readonly("window", &kep3::udpla::chebyshev::get_window,
+                               "The time window (MJD2000) of the interpolation.")
+        .def_property_readonly("n_segments", &kep3::udpla::chebyshev::get_n_segments, "The number of segments.")
+        .def_property_readonly("max_error", &kep3::udpla::chebyshev::get_max_error,
+                               "The largest relative error found while checking the fit against the source.");
 }
 
 } // namespace pykep
@@ -16,6 +16,7 @@ from .. import core as _core
 # Ensure original underscored names exist in the module, else pickle will fail
 _sims_flanagan = _core._sims_flanagan
 _sims_flanagan_alpha = _core._sims_flanagan_alpha
+_sims_flanagan_sequence = _core._sims_flanagan_sequence
 _zoh = _core._zoh_cpp
 _zoh_cpp = _core._zoh_cpp
 
@@ -30,6 +31,10 @@ sims_flanagan_alpha = _core._sims_flanagan_alpha
 sims_flanagan_alpha.__name__ = "sims_flanagan_alpha"
 sims_flanagan_alpha.__module__ = "pykep.leg"
 
+sims_flanagan_sequence = _core._sims_flanagan_sequence
+sims_flanagan_sequence.__name__ = "sims_flanagan_sequence"
+sims_flanagan_sequence.__module__ = "pykep.leg"
+
 zoh = _core._zoh_cpp
 zoh.__name__ = "zoh"
 zoh.__module__ = "pykep.leg"
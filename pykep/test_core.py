@@ -58,6 +58,28 @@ class anomaly_conversions_tests(_ut.TestCase):
             float_abs_error(_pk.f2zeta(_pk.zeta2f(0.1, 10.1), 10.1), 0.1) < 1e-14
         )
 
+    def test_vectorized(self):
+        import pykep as _pk
+        import numpy as _np
+
+        Ms = _np.linspace(-10.0, 10.0, 100001)
+        eccs = _np.linspace(0.0, 0.99, 100001)
+        # Per element and shared eccentricities, against the scalar versions.
+        Es = _pk.m2e_v(Ms, eccs)
+        self.assertEqual(Es.shape, Ms.shape)
+        for i in range(0, len(Ms), 997):
+            self.assertTrue(float_abs_error(Es[i], _pk.m2e(Ms[i], eccs[i])) < 1e-13)
+        Hs = _pk.n2h_v(Ms, 1.5)
+        for i in range(0, len(Ms), 997):
+            self.assertTrue(float_abs_error(Hs[i], _pk.n2h(Ms[i], 1.5)) < 1e-13)
+        # Scalars give a float, other shapes broadcast as in numpy.
+        self.assertTrue(isinstance(_pk.e2m_v(0.1, 0.1), float))
+        fs = _pk.m2f_v(Ms[:5].reshape(5, 1), eccs[:3].reshape(1, 3))
+        self.assertEqual(fs.shape, (5, 3))
+        self.assertTrue(float_abs_error(fs[4, 2], _pk.m2f(Ms[4], eccs[2])) < 1e-13)
+        # Eccentricities out of range give NaNs.
+        self.assertTrue(_np.all(_np.isnan(_pk.m2e_v(Ms[:10], 1.5))))
+
 
 class epoch_test(_ut.TestCase):
     def test_epoch_construction(self):
@@ -238,6 +260,33 @@ class planet_test(_ut.TestCase):
             pla.elements(when=_pk.epoch(0.0)) == [1.0, 2.0, 3.0, 4.0, 5.0, 6.0]
         )
 
+    def test_eph_v_out(self):
+        import pykep as _pk
+        import numpy as np
+
+        pla = _pk.planet(_pk.udpla.keplerian(_pk.epoch(0.0), [_pk.AU, 0.1, 0.2, 0.3, 0.4, 0.5], _pk.MU_SUN))
+        mjd2000s = np.linspace(0.0, 1000.0, 300)
+        # Results written in a preallocated array.
+        out = np.zeros((300, 6))
+        ret = pla.eph_v(mjd2000s, out=out)
+        self.assertTrue(np.shares_memory(ret, out))
+        self.assertTrue(np.all(out == pla.eph_v(mjd2000s)))
+        acc = np.zeros((300, 3))
+        pla.acc_v(mjd2000s, out=acc)
+        self.assertTrue(np.all(acc == pla.acc_v(mjd2000s)))
+        # Python udplas.
+        pla = _pk.planet(my_udpla_with_optionals(3.14))
+        out = np.zeros((2, 6))
+        pla.eph_v([0.0, 1.0], out)
+        self.assertTrue(np.all(out == pla.eph_v([0.0, 1.0])))
+        # Malformed outputs.
+        self.assertRaises(ValueError, lambda: pla.eph_v([0.0, 1.0], np.zeros((3, 6))))
+        self.assertRaises(ValueError, lambda: pla.eph_v([0.0, 1.0], np.zeros((6, 2)).T))
+        self.assertRaises(ValueError, lambda: pla.eph_v([0.0, 1.0], np.zeros((6, 2))))
+        self.assertRaises(ValueError, lambda: pla.eph_v([0.0, 1.0], np.zeros(12)))
+        self.assertRaises(TypeError, lambda: pla.eph_v([0.0, 1.0], np.zeros((2, 6), dtype=np.float32)))
+        self.assertRaises(ValueError, lambda: pla.eph_v([[0.0, 1.0]]))
+
     def test_pickling_python(self):
         import pickle
         import io
@@ -389,6 +438,66 @@ class vsop2013_test(_ut.TestCase):
         self.assertTrue("1e-05" in str(p))
 
 
+class planet_catalog_test(_ut.TestCase):
+    def test_basic(self):
+        import pykep as _pk
+        import numpy as np
+        import pickle
+
+        pls = [
+            _pk.planet(
+                _pk.udpla.keplerian(
+                    _pk.epoch(10.0 * i),
+                    [_pk.AU * (1.0 + 0.1 * i), 0.01 * i, 0.1, 0.2, 0.3, 0.4],
+                    _pk.MU_SUN,
+                    "body" + str(i),
+                )
+            )
+            for i in range(50)
+        ]
+        cat = _pk.planet_catalog(pls)
+        self.assertTrue(len(cat) == 50)
+        self.assertTrue(cat[7].name == "body7")
+        self.assertRaises(IndexError, lambda: cat[50])
+        self.assertRaises(ValueError, lambda: cat.append(_pk.planet(_pk.udpla.jpl_lp("earth"))))
+        rv = cat.eph_all(1234.0)
+        self.assertTrue(rv.shape == (50, 6))
+        for i in range(50):
+            r, v = pls[i].eph(1234.0)
+            self.assertTrue(np.allclose(rv[i], np.concatenate((r, v)), rtol=1e-11, atol=0.0))
+        rv = cat.eph_subset([3, 3, 49], [0.0, 100.0, 200.0])
+        self.assertTrue(rv.shape == (3, 6))
+        r, v = pls[3].eph(100.0)
+        self.assertTrue(np.allclose(rv[1], np.concatenate((r, v)), rtol=1e-11, atol=0.0))
+        cat2 = pickle.loads(pickle.dumps(cat))
+        self.assertTrue(np.all(cat2.eph_all(_pk.epoch(5.0)) == cat.eph_all(5.0)))
+
+
+class chebyshev_test(_ut.TestCase):
+    def test_basic(self):
+        import pykep as _pk
+        import numpy as np
+        import pickle
+
+        mars = _pk.planet(_pk.udpla.jpl_lp("mars"))
+        udpla = _pk.udpla.chebyshev(mars, 1000.0, 2000.0, tol=1e-10)
+        self.assertTrue(udpla.window == [1000.0, 2000.0])
+        self.assertTrue(udpla.n_segments >= 1)
+        self.assertTrue(udpla.max_error <= 1e-10)
+        p = _pk.planet(udpla)
+        self.assertTrue(p.get_name() == mars.get_name())
+        for t in np.linspace(1000.0, 2000.0, 17):
+            r, v = p.eph(t)
+            r_ref, v_ref = mars.eph(t)
+            self.assertTrue(np.linalg.norm(np.array(r) - r_ref) < 1e-9 * np.linalg.norm(r_ref))
+            self.assertTrue(np.linalg.norm(np.array(v) - v_ref) < 1e-9 * np.linalg.norm(v_ref))
+        # Outside the window.
+        self.assertRaises(ValueError, lambda: p.eph(3000.0))
+        # Pickling.
+        p2 = pickle.loads(pickle.dumps(p))
+        self.assertTrue(p2.eph(1500.0) == p.eph(1500.0))
+
+
 class propagate_test(_ut.TestCase):
     def test_lagrangian(self):
         import pykep as _pk
@@ -405,3 +514,69 @@ class propagate_test(_ut.TestCase):
         self.assertTrue(np.allclose(r, r_gt, atol=1e-13))
         self.assertTrue(np.allclose(v, v_gt, atol=1e-13))
 
+
+
+class porkchop_test(_ut.TestCase):
+    def test_porkchop(self):
+        import pykep as _pk
+        import numpy as np
+
+        earth = _pk.planet(_pk.udpla.jpl_lp("earth"))
+        mars = _pk.planet(_pk.udpla.jpl_lp("mars"))
+        t0s = np.linspace(7000.0, 7300.0, 7)
+        t1s = np.linspace(7100.0, 7800.0, 11)
+        dv_dep, dv_arr, c3, vinf_dep, vinf_arr, branch = _pk.porkchop(earth, mars, t0s, t1s, multi_revs=1)
+        self.assertEqual(dv_dep.shape, (7, 11))
+        self.assertEqual(vinf_arr.shape, (7, 11, 3))
+        self.assertTrue(np.allclose(c3, dv_dep**2, equal_nan=True))
+        self.assertTrue(np.isnan(dv_dep[-1, 0]))
+        self.assertEqual(branch[-1, 0], -1)
+
+        # We compare one cell against the Lambert problem.
+        r0, v0 = earth.eph(t0s[2])
+        r1, v1 = mars.eph(t1s[5])
+        lp = _pk.lambert_problem(r0, r1, (t1s[5] - t0s[2]) * _pk.DAY2SEC, earth.get_mu_central_body(), False, 1)
+        b = branch[2, 5]
+        self.assertTrue(np.allclose(vinf_dep[2, 5], np.array(lp.v0[b]) - v0, rtol=1e-10))
+        self.assertTrue(np.allclose(vinf_arr[2, 5], np.array(lp.v1[b]) - v1, rtol=1e-10))
+
+        # Planets around different central bodies.
+        moon = _pk.planet(
+            _pk.udpla.keplerian(
+                when=_pk.epoch(0), elem=[384400000.0, 0.05, 0.1, 0.0, 0.0, 0.0], mu_central_body=_pk.MU_EARTH
+            )
+        )
+        with self.assertRaises(ValueError):
+            _pk.porkchop(earth, moon, t0s, t1s)
+
+
+class lambert_problem_test(_ut.TestCase):
+    def test_compute_grad(self):
+        import pykep as _pk
+        import numpy as np
+
+        r0 = np.array([1.0, 0.1, -0.2])
+        r1 = np.array([-0.3, 1.2, 0.3])
+        tof, mu, h = 20.0, 1.0, 1e-6
+        lp = _pk.lambert_problem(r0, r1, tof, mu, False, 1)
+        dv0, dv1 = lp.compute_grad()
+        self.assertEqual(dv0.shape, (len(lp.v0), 3, 7))
+        self.assertEqual(dv1.shape, (len(lp.v0), 3, 7))
+        # We check the column of tof against finite differences.
+        lpp = _pk.lambert_problem(r0, r1, tof + h, mu, False, 1)
+        lpm = _pk.lambert_problem(r0, r1, tof - h, mu, False, 1)
+        for b in range(len(lp.v0)):
+            fd = (np.array(lpp.v0[b]) - np.array(lpm.v0[b])) / 2 / h
+            self.assertTrue(np.allclose(dv0[b, :, 6], fd, atol=1e-7))
+
+    def test_warm_start(self):
+        import pykep as _pk
+        import numpy as np
+
+        r0 = [1.0, 0.1, 0.0]
+        r1 = [-0.2, 1.1, 0.1]
+        lp = _pk.lambert_problem(r0, r1, 30.0, 1.0, False, 2)
+        cold = _pk.lambert_problem(r0, r1, 30.01, 1.0, False, 2)
+        warm = _pk.lambert_problem(r0, r1, 30.01, 1.0, False, 2, x_guess=lp.x)
+        self.assertTrue(np.allclose(warm.v0, cold.v0, rtol=1e-10))
+        self.assertTrue(sum(warm.iters) <= sum(cold.iters))
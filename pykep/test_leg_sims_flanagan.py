@@ -105,6 +105,68 @@ class leg_sims_flanagan_test(_ut.TestCase):
         a_grad[state_length:, state_length:state_length+throttle_length] = a_tc_grad
         self.assertTrue(np.allclose(num_grad, a_grad, atol=1e-8))
 
+    def test_grad_sparse(self):
+        import numpy as np
+        import pykep as _pk
+
+        throttles = [0.1 * np.sin(i) for i in range(15)]
+        rvs = [[1, 0.1, -0.1], [0.2, 1.0, -0.2]]
+        rvf = [[1.2, -0.1, 0.1], [-0.2, 1.023, -0.44]]
+        sf_leg = _pk.leg.sims_flanagan(rvs, 1.0, throttles, rvf, 13 / 15, 1.0, 1.0, 1.0, 1.0, 0.6)
+
+        # The dense Jacobian of [mc, tc] w.r.t. [xs, throttles, xf, tof]
+        grad_rvm, grad_rvm_bck, grad_final = sf_leg.compute_mc_grad()
+        a_grad = np.zeros((7 + 5, 15 + 15))
+        a_grad[0:7, 0:7] = grad_rvm
+        a_grad[0:7, 7:22] = grad_final[:, 0:15]
+        a_grad[0:7, 22:29] = grad_rvm_bck
+        a_grad[0:7, 29] = grad_final[:, 15]
+        a_grad[7:, 7:22] = sf_leg.compute_tc_grad()
+
+        sp = sf_leg.get_grad_sparsity()
+        self.assertEqual(sp.shape, (24 * 5 + 93, 2))
+        values = sf_leg.compute_grad_sparse()
+        s_grad = np.zeros_like(a_grad)
+        s_grad[sp[:, 0], sp[:, 1]] = values
+        self.assertTrue((s_grad == a_grad).all())
+
+        # Writing in a preallocated output
+        out = np.zeros(values.shape)
+        self.assertTrue(sf_leg.compute_grad_sparse(out=out) is out)
+        self.assertTrue((out == values).all())
+        with self.assertRaises(ValueError):
+            sf_leg.compute_grad_sparse(out=np.zeros(values.size + 1))
+        with self.assertRaises(TypeError):
+            sf_leg.compute_grad_sparse(out=np.zeros(values.shape, dtype=np.int64))
+
+    def test_mc_grad_alpha(self):
+        import numpy as np
+        import pykep as _pk
+        import pygmo as pg
+
+        throttles = [0.10, 0.11, 0.12, 0.13, 0.14, 0.15, 0.16, 0.17, 0.18, 0.19, 0.2, 0.21, 0.22, 0.23, 0.24]
+        talphas = [0.15, 0.25, 0.2, 0.1, 0.3]
+        rvs = [[1, 0.1, -0.1], [0.2, 1.0, -0.2]]
+        rvf = [[1.2, -0.1, 0.1], [-0.2, 1.023, -0.44]]
+
+        def mc(x):
+            sf = _pk.leg.sims_flanagan_alpha(
+                [x[0:3], x[3:6]], x[6], x[7:22], x[22:27], [x[27:30], x[30:33]], x[33], 1.0, 1.0, 1.0, 1.0, 0.6
+            )
+            return sf.compute_mismatch_constraints()
+
+        x = np.array(rvs[0] + rvs[1] + [1.0] + throttles + talphas + rvf[0] + rvf[1] + [13 / 15])
+        num_grad = pg.estimate_gradient_h(callable=mc, x=x).reshape((7, 34))
+
+        sf_leg = _pk.leg.sims_flanagan_alpha(rvs, 1.0, throttles, talphas, rvf, 13 / 15, 1.0, 1.0, 1.0, 1.0, 0.6)
+        grad_rvm, grad_rvm_bck, grad_final = sf_leg.compute_mc_grad()
+        self.assertEqual(grad_final.shape, (7, 21))
+        self.assertTrue(np.allclose(num_grad[:, 0:7], grad_rvm, atol=1e-8))
+        self.assertTrue(np.allclose(num_grad[:, 7:27], grad_final[:, :20], atol=1e-8))
+        self.assertTrue(np.allclose(num_grad[:, 27:], grad_rvm_bck, atol=1e-8))
+        self.assertTrue((grad_final[:, 20] == 0.0).all())
+        self.assertEqual(sf_leg.compute_tc_grad().shape, (5, 15))
+
     def test_pickling(self):
         import pickle
         import io
@@ -137,4 +199,66 @@ class leg_sims_flanagan_test(_ut.TestCase):
 
         # Verify that the original and loaded data are the same
         self.assertTrue(loaded_data.__repr__()==data.__repr__())
-        
\ No newline at end of file
+        
+    def test_sequence(self):
+        import pickle
+        import numpy as np
+        import pykep as _pk
+
+        seq = [_pk.planet(_pk.udpla.jpl_lp(name)) for name in ["earth", "venus", "earth"]]
+        nsegs = [4, 3]
+        sfs = _pk.leg.sims_flanagan_sequence(seq, nsegs, 1500.0, 0.12, 3000.0 * _pk.G0, _pk.MU_SUN, 0.6)
+        self.assertEqual(sfs.nlegs, 2)
+        self.assertEqual(sfs.nx, 1 + 2 * 8 + 3 * 7)
+        self.assertEqual(sfs.get_nec(), 14)
+        self.assertEqual(sfs.get_nic(), 7)
+        with self.assertRaises(RuntimeError):
+            sfs.compute_constraints()
+        with self.assertRaises(ValueError):
+            _pk.leg.sims_flanagan_sequence(seq, [4], 1500.0, 0.12, 3000.0 * _pk.G0, _pk.MU_SUN)
+
+        # x = [t0, mf, vinfs, vinff, throttles, tof, ...]
+        x = [1000.0]
+        for nseg, mf, tof in zip(nsegs, [1400.0, 1300.0], [150.0, 300.0]):
+            x += [mf, 1000.0, -500.0, 200.0, -300.0, 800.0, 100.0]
+            x += [0.1 * np.sin(i) for i in range(3 * nseg)]
+            x += [tof]
+        sfs.x = x
+        self.assertEqual(list(sfs.x), x)
+        self.assertEqual(len(sfs.epochs), 3)
+
+        # The constraints match those of the legs.
+        c = sfs.compute_constraints()
+        legs = sfs.legs
+        self.assertTrue((c[0:7] == legs[0].compute_mismatch_constraints()).all())
+        self.assertTrue((c[7:14] == legs[1].compute_mismatch_constraints()).all())
+        self.assertTrue((c[14:18] == legs[0].compute_throttle_constraints()).all())
+        self.assertTrue((c[18:] == legs[1].compute_throttle_constraints()).all())
+
+        # The sparse Jacobian matches central differences.
+        sp = sfs.get_grad_sparsity()
+        values = sfs.compute_grad_sparse()
+        self.assertEqual(sp.shape, (values.size, 2))
+        s_grad = np.zeros((len(c), len(x)))
+        s_grad[sp[:, 0], sp[:, 1]] = values
+        num_grad = np.zeros_like(s_grad)
+        for j in range(len(x)):
+            h = 1e-6 * max(1.0, abs(x[j]))
+            xp, xm = list(x), list(x)
+            xp[j] += h
+            xm[j] -= h
+            sfs.x = xp
+            cp = sfs.compute_constraints()
+            sfs.x = xm
+            num_grad[:, j] = (cp - sfs.compute_constraints()) / 2.0 / h
+        sfs.x = x
+        scale = np.max(np.abs(num_grad), axis=1, keepdims=True)
+        self.assertTrue((np.abs(s_grad - num_grad) <= 1e-6 * scale).all())
+        out = np.zeros(values.shape)
+        self.assertTrue(sfs.compute_grad_sparse(out=out) is out)
+        self.assertTrue((out == values).all())
+
+        # Pickling
+        sfs2 = pickle.loads(pickle.dumps(sfs))
+        self.assertEqual(sfs2.__repr__(), sfs.__repr__())
+        self.assertTrue((sfs2.compute_constraints() == c).all())
@@ -128,6 +128,56 @@ class ta_api_tests(_ut.TestCase):
         ta_var.propagate_until(0.2)
         self._assert_finite(ta_var.state[:6])
 
+    def test_prewarm(self):
+        times = _pk.prewarm([("zoh_kep", 1e-12), ("kep_var",), ("pc", 1e-12, _pk.optimality_type.TIME)])
+        self.assertEqual(len(times), 3)
+        for t in times:
+            self.assertGreaterEqual(t, 0.0)
+        with self.assertRaises(ValueError):
+            _pk.prewarm([("not_a_model", 1e-12)])
+        with self.assertRaises(ValueError):
+            _pk.prewarm([()])
+
+    def test_jit_memory_cache(self):
+        _pk.ta.get_zoh_kep(1e-12)
+        stats = _pk.get_jit_memory_cache_stats()
+        self.assertIn("ta_zoh_kep", stats)
+        self.assertGreaterEqual(stats["ta_zoh_kep"]["size"], 1)
+        self.assertGreater(stats["ta_zoh_kep"]["resident_bytes"], 0)
+        self.assertEqual(_pk.get_jit_memory_cache_capacity(), 0)
+        self.assertEqual(_pk.get_jit_cache_tol_digits(), 0)
+        _pk.reset_jit_memory_cache_stats()
+        _pk.ta.get_zoh_kep(1e-12)
+        self.assertEqual(_pk.get_jit_memory_cache_stats()["ta_zoh_kep"]["hits"], 1)
+
+    def test_acquire_zoh_kep(self):
+        h = _pk.ta.acquire_zoh_kep(1e-12)
+        h_var = _pk.ta.acquire_zoh_kep_var(1e-12)
+        self.assertTrue(h.is_pooled)
+        self.assertEqual(len(h.ta.state), 7)
+        self.assertEqual(len(h_var.ta.state), 84)
+        h.ta.pars[4] = 0.2
+        h_var.ta.pars[4] = 0.2
+        state0 = [1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0]
+        state1 = [1.2, 0.1, 0.0, 0.0, 0.9, 0.1, 0.95]
+        controls = [0.022, 0.7, 0.7, 0.1, 0.025, -0.3, 0.8, 0.4]
+        tgrid = [0.0, 0.5, 1.0]
+        leg = _pk.leg.zoh(state0, controls, state1, tgrid, cut=0.5, tas=(h, h_var))
+        self.assertEqual(leg.ta.pars[4], 0.2)
+        self._assert_finite(leg.compute_mismatch_constraints())
+        # The handles were moved into the leg.
+        with self.assertRaises(ValueError):
+            h.ta
+        with self.assertRaises(ValueError):
+            _pk.leg.zoh(state0, controls, state1, tgrid, cut=0.5, tas=(h, None))
+        # The same as with copies of the integrators.
+        ta = _pk.ta.get_zoh_kep(1e-12)
+        ta_var = _pk.ta.get_zoh_kep_var(1e-12)
+        ta.pars[4] = 0.2
+        ta_var.pars[4] = 0.2
+        leg2 = _pk.leg.zoh(state0, controls, state1, tgrid, cut=0.5, tas=(ta, ta_var))
+        self.assertEqual(leg.compute_mismatch_constraints(), leg2.compute_mismatch_constraints())
+
 
 class ta_regression_tests(_ut.TestCase):
     def test_zoh_ss_physical(self):
@@ -45,7 +45,8 @@ class sf_pl2pl_alpha:
         cut=0.6,
         mass_scaling=1500,
         r_scaling=_pk.AU,
-        v_scaling=_pk.EARTH_VELOCITY
+        v_scaling=_pk.EARTH_VELOCITY,
+        with_gradient=True,
         ):
         """
 
@@ -82,6 +83,8 @@ class sf_pl2pl_alpha:
 
             *v_scaling* (:class:`float`): Scaling factor for velocity (used to scale constraints). Defaults the Earth's velocity (:class:`~pykep.EARTH_VELOCITY`).
 
+            *with_gradient* (:class:`bool`): Indicates if gradient information should be used. Defaults True.
+
         """
         # We add as data member one single Sims-Flanagan leg and set it using problem data
         self.leg = _pk.leg.sims_flanagan_alpha()
@@ -104,6 +107,7 @@ class sf_pl2pl_alpha:
         self.mass_scaling = mass_scaling
         self.r_scaling = r_scaling
         self.v_scaling = v_scaling
+        self.with_gradient = with_gradient
 
     # z = [t0, mf, Vsx, Vsy, Vsz, Vfx, Vfy, Vfz, talphas, throttles, tof]
     def get_bounds(self):
@@ -192,11 +196,96 @@ class sf_pl2pl_alpha:
     def get_nic(self):
         return self.nseg + 2
     
-    # def has_gradient(self):
-    #     return self.with_gradient
-    
-    # def gradient(self, x):
-    #     return _pg.estimate_gradient(callable = self.fitness,x=x, dx=1e-8)
+    def has_gradient(self):
+        return self.with_gradient
+
+    def gradient(self, x):
+        rs, vs, rf, vf = self._set_leg_from_x(x)
+        mcg_xs, mcg_xf, mcg_th_ta_tof = self.leg.compute_mc_grad()
+        tcg_th = self.leg.compute_tc_grad()
+        nseg = self.nseg
+
+        # The segment durations are t_i = T log(alpha_i) / S, with S = sum_j log(alpha_j), hence
+        # dt_i/dalpha_j = (delta_ij T - t_i) / S / alpha_j and dt_i/dT = t_i / T.
+        alphas = _np.array(x[8 : 8 + nseg])
+        tof = x[-1] * _pk.DAY2SEC
+        talphas = _np.array(self.leg.talphas)
+        S = _np.sum(_np.log(alphas))
+
+        # 1 - The gradient of the objective function (obj = -mf)
+        retval = [-1.0 / self.mass_scaling]
+
+        # 2 - The gradient of the mismatch contraints (mcg). We divide them in pos,vel and mass as
+        # they have a different sparsity structure
+        for i in range(7):
+            if i < 3:
+                scaling = self.r_scaling
+            elif i < 6:
+                scaling = self.v_scaling
+            else:
+                scaling = self.mass_scaling
+            # The dependency of the final state on the arrival epoch (planet assumed keplerian, as in sf_pl2pl).
+            dxf_dtf = _np.dot(mcg_xf[i, :3], vf) - _np.dot(mcg_xf[i, 3:6], rf) * self.leg.mu / (
+                _np.linalg.norm(rf) ** 3
+            )
+            if i < 6:
+                # First w.r.t. t0 (it is in days in the decision vector, so we will need to convert)
+                tmp = (
+                    +_np.dot(mcg_xs[i, :3], vs)
+                    - _np.dot(mcg_xs[i, 3:6], rs) * self.leg.mu / (_np.linalg.norm(rs) ** 3)
+                    + dxf_dtf
+                )
+                retval.append(tmp / scaling / _pk.SEC2DAY)
+            # Then w.r.t. mf
+            retval.append(mcg_xf[i, -1] / scaling)
+            if i < 6:
+                # Then w.r.t vinfs
+                retval.extend(mcg_xs[i, 3:6] / scaling)
+                # Then w.r.t vinff
+                retval.extend(mcg_xf[i, 3:6] / scaling)
+            # Then the alphas, through the segment durations
+            g_ta = mcg_th_ta_tof[i, 3 * nseg : 4 * nseg]
+            sum_gt = _np.dot(g_ta, talphas)
+            retval.extend((g_ta * tof - sum_gt) / S / alphas / scaling)
+            # Then the throttles
+            retval.extend(mcg_th_ta_tof[i, : 3 * nseg] / scaling)
+            # And the tof, through the segment durations and the arrival epoch
+            retval.append((sum_gt / tof + dxf_dtf) / scaling * _pk.DAY2SEC)
+
+        ## 3 -  The gradient of the throttle constraints
+        for i in range(nseg):
+            retval.extend(tcg_th[i, 3 * i : 3 * i + 3])
+
+        ## 4 - The gradient of the vinfs, vinf constraints
+        retval.extend([2 * x[2], 2 * x[3], 2 * x[4], 2 * x[5], 2 * x[6], 2 * x[7]])
+        retval[-6:] = [a / self.v_scaling**2 for a in retval[-6:]]
+
+        return retval
+
+    def gradient_sparsity(self):
+        dim = 9 + 4 * self.nseg
+        # The objective function only depends on the final mass, which is in the chromosome.
+        retval = [[0, 1]]
+        # The mismatch constraints on x,y,z,vx,vy,vz depend on all variables.
+        for i in range(1, 7):
+            for j in range(dim):
+                retval.append([i, j])
+        # The mismatch constraints on m depend on all variables except the vinfs, vinff, t0
+        retval.append([7, 1])
+        for j in range(8, dim):
+            retval.append([7, j])
+        # The throttle constraints only depend on the specific throttles (3).
+        for i in range(self.nseg):
+            retval.append([8 + i, 3 * i + 8 + self.nseg])
+            retval.append([8 + i, 3 * i + 9 + self.nseg])
+            retval.append([8 + i, 3 * i + 10 + self.nseg])
+        # The constraints on vinfs, vinff only depend on the vinfs, vinff
+        for j in range(2, 5):
+            retval.append([8 + self.nseg, j])
+        for j in range(5, 8):
+            retval.append([9 + self.nseg, j])
+        # We return the sparsity pattern
+        return retval
 
     def pretty(self, x):
         """
@@ -155,6 +155,9 @@ class zoh_pl2pl:
 
                 - `ta_var`: Variational dynamics (state dim 84, same pars). When None, no gradients will be used.
 
+                Handles returned by :func:`pykep.ta.acquire_zoh_kep` are also accepted. Defaults to
+                ``(pk.ta.acquire_zoh_kep(1e-10), None)``.
+
             *cart2state* (:class:`list`): Optional list ``[transform, jacobian]`` for non-Cartesian dynamics.
                 ``transform`` is a callable that maps a 6D Cartesian state (in integrator units) to the
                 6D state expected by the dynamics. ``jacobian`` is a callable that returns the 6×6 derivative
@@ -210,7 +213,7 @@ class zoh_pl2pl:
         if vinf_arr_bounds is None:
             vinf_arr_bounds = [0.0, 0.2]
         if tas is None:
-            tas = (_pk.ta.get_zoh_kep(1e-10), None)
+            tas = (_pk.ta.acquire_zoh_kep(1e-10), None)
         if w_bounds_softmax is None:
             w_bounds_softmax = [-1.0, 1.0]
 
@@ -38,7 +38,7 @@ class zoh_point2point:
         mf_bounds=None,
         nseg=10,
         cut=0.6,
-        tas=(_pk.ta.get_zoh_kep(1e-10), None),
+        tas=None,
         time_encoding="uniform",
         w_bounds_softmax=None,
         inequalities_for_tc = False,
@@ -79,6 +79,9 @@ class zoh_point2point:
 
                 - `ta_var`: Variational dynamics (state dim 84, same pars). When None, no gradients will be used.
 
+                Handles returned by :func:`pykep.ta.acquire_zoh_kep` are also accepted. Defaults to
+                ``(pk.ta.acquire_zoh_kep(1e-10), None)``.
+
             *max_steps* (:class:`int` or None): Maximum number of Taylor integrator steps per propagation call. When None, uses the default integrator behavior.
 
         """
@@ -93,6 +96,8 @@ class zoh_point2point:
             mf_bounds = [0.2, 1]
         if w_bounds_softmax is None:
             w_bounds_softmax = [-1.0, 1.0]
+        if tas is None:
+            tas = (_pk.ta.acquire_zoh_kep(1e-10), None)
         if state2cart is not None and not callable(state2cart):
             raise ValueError("state2cart must be a callable function")
 
@@ -8,6 +8,7 @@ _keplerian = _core._keplerian
 _null_udpla = _core._null_udpla
 _jpl_lp = _core._jpl_lp
 _vsop2013 = _core._vsop2013
+_chebyshev = _core._chebyshev
 
 # alias with proper module and name for docs & usage
 keplerian = _keplerian
@@ -26,4 +27,8 @@ vsop2013 = _vsop2013
 vsop2013.__name__ = "vsop2013"
 vsop2013.__module__ = "pykep.udpla"
 
+chebyshev = _chebyshev
+chebyshev.__name__ = "chebyshev"
+chebyshev.__module__ = "pykep.udpla"
+
 del _core
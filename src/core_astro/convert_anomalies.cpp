@@ -0,0 +1,237 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+
+#include <kep3/core_astro/constants.hpp>
+#include <kep3/core_astro/convert_anomalies.hpp>
+#include <kep3/detail/kepler_simd.hpp>
+
+namespace kep3
+{
+
+namespace
+{
+
+// Arrays larger than this are split across threads, in ranges of at least par_grain elements.
+constexpr std::size_t par_threshold = 50000u;
+constexpr std::size_t par_grain = 8192u;
+// Kepler's equation is solved in chunks of this size, using buffers on the stack.
+constexpr std::size_t kep_chunk = 256u;
+
+void check_sizes(const char *name, std::size_t n_in, std::size_t n_ecc, std::size_t n_out)
+{
+    if (n_ecc != n_in && n_ecc != 1u) {
+        throw std::invalid_argument(fmt::format("{}: the eccentricities must have size N = {} or 1, while they "
+                                                "have size {}",
+                                                name, n_in, n_ecc));
+    }
+    if (n_out != n_in) {
+        throw std::invalid_argument(
+            fmt::format("{}: the output must have size N = {}, while it has size {}", name, n_in, n_out));
+    }
+}
+
+// Calls f(begin, end) on ranges covering [0, n), in parallel for large n.
+template <typename F>
+void for_each_range(std::size_t n, const F &f)
+{
+    if (n < par_threshold) {
+        f(std::size_t(0), n);
+        return;
+    }
+    oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<std::size_t>(0u, n, par_grain),
+                              [&f](const oneapi::tbb::blocked_range<std::size_t> &range) {
+                                  f(range.begin(), range.end());
+                              });
+}
+
+// The closed form conversions, element by element.
+template <double (*Conv)(double, double)>
+void convert(const char *name, std::span<const double> in, std::span<const double> eccs, std::span<double> out)
+{
+    check_sizes(name, in.size(), eccs.size(), out.size());
+    const std::size_t ecc_stride = eccs.size() == 1u ? 0u : 1u;
+    for_each_range(in.size(), [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            out[i] = Conv(in[i], eccs[i * ecc_stride]);
+        }
+    });
+}
+
+// Mean to eccentric anomaly on [begin, end), as kep3::m2e but solving Kepler's equation with the
+// vectorized kernel. The results are then mapped through Post (e.g. to the true anomaly).
+template <double (*Post)(double, double)>
+void m2e_range(std::span<const double> Ms, std::span<const double> eccs, std::size_t ecc_stride, std::span<double> out,
+               std::size_t begin, std::size_t end)
+{
+    std::array<double, kep_chunk> M_cropped{}, ecc{}, E{};
+    const double zero = 0.;
+    for (auto base = begin; base < end; base += kep_chunk) {
+        const auto n_c = std::min(kep_chunk, end - base);
+        for (std::size_t l = 0u; l < n_c; ++l) {
+            const double M = Ms[base + l];
+            const double e = eccs[(base + l) * ecc_stride];
+            // Lanes with no solution are given a trivial problem and set to NaN afterwards.
+            if (!(e < 1.)) {
+                M_cropped[l] = 0.;
+                ecc[l] = 0.;
+                E[l] = 0.;
+                continue;
+            }
+            // Same reduction and initial guess as in kep3::m2e.
+            const double sinM = std::sin(M), cosM = std::cos(M);
+            M_cropped[l] = std::atan2(sinM, cosM);
+            ecc[l] = e;
+            E[l] = M_cropped[l] + e * sinM + e * e * sinM * cosM + e * e * e * sinM * (1.5 * cosM * cosM - 0.5);
+        }
+        detail::kepDE_simd(n_c, M_cropped.data(), &zero, 0u, ecc.data(), 1u, kep3::pi, E.data());
+        for (std::size_t l = 0u; l < n_c; ++l) {
+            const double e = eccs[(base + l) * ecc_stride];
+            out[base + l] = (e < 1.) ? Post(E[l], e) : std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+}
+
+// Hyperbolic mean to hyperbolic anomaly on [begin, end), as kep3::n2h but solving Kepler's equation with
+// the vectorized kernel. The results are then mapped through Post (e.g. to the true anomaly).
+template <double (*Post)(double, double)>
+void n2h_range(std::span<const double> Ns, std::span<const double> eccs, std::size_t ecc_stride, std::span<double> out,
+               std::size_t begin, std::size_t end)
+{
+    std::array<double, kep_chunk> N{}, ecc{}, H{};
+    const double zero = 0.;
+    for (auto base = begin; base < end; base += kep_chunk) {
+        const auto n_c = std::min(kep_chunk, end - base);
+        for (std::size_t l = 0u; l < n_c; ++l) {
+            const double e = eccs[(base + l) * ecc_stride];
+            const bool valid = e > 1.;
+            // Lanes with no solution are given a trivial problem and set to NaN afterwards.
+            N[l] = valid ? Ns[base + l] : 0.;
+            ecc[l] = valid ? e : 2.;
+            // Same bracket as in kep3::n2h, the kernel computes its own initial guess for the hyperbolas.
+            H[l] = 1.;
+        }
+        detail::kepDH_simd(n_c, N.data(), &zero, 0u, ecc.data(), 1u, 20 * kep3::pi, H.data());
+        for (std::size_t l = 0u; l < n_c; ++l) {
+            const double e = eccs[(base + l) * ecc_stride];
+            out[base + l] = (e > 1.) ? Post(H[l], e) : std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+}
+
+// The identity, to get the eccentric or hyperbolic anomaly out of the ranges above.
+double identity(double x, double)
+{
+    return x;
+}
+
+template <double (*Post)(double, double)>
+void m2e_impl(const char *name, std::span<const double> Ms, std::span<const double> eccs, std::span<double> out)
+{
+    check_sizes(name, Ms.size(), eccs.size(), out.size());
+    const std::size_t ecc_stride = eccs.size() == 1u ? 0u : 1u;
+    for_each_range(Ms.size(),
+                   [&](std::size_t begin, std::size_t end) { m2e_range<Post>(Ms, eccs, ecc_stride, out, begin, end); });
+}
+
+template <double (*Post)(double, double)>
+void n2h_impl(const char *name, std::span<const double> Ns, std::span<const double> eccs, std::span<double> out)
+{
+    check_sizes(name, Ns.size(), eccs.size(), out.size());
+    const std::size_t ecc_stride = eccs.size() == 1u ? 0u : 1u;
+    for_each_range(Ns.size(),
+                   [&](std::size_t begin, std::size_t end) { n2h_range<Post>(Ns, eccs, ecc_stride, out, begin, end); });
+}
+
+} // namespace
+
+void m2e(std::span<const double> Ms, std::span<const double> eccs, std::span<double> out)
+{
+    m2e_impl<identity>("m2e", Ms, eccs, out);
+}
+
+void e2m(std::span<const double> Es, std::span<const double> eccs, std::span<double> out)
+{
+    convert<static_cast<double (*)(double, double)>(e2m)>("e2m", Es, eccs, out);
+}
+
+void e2f(std::span<const double> Es, std::span<const double> eccs, std::span<double> out)
+{
+    convert<static_cast<double (*)(double, double)>(e2f)>("e2f", Es, eccs, out);
+}
+
+void f2e(std::span<const double> fs, std::span<const double> eccs, std::span<double> out)
+{
+    convert<static_cast<double (*)(double, double)>(f2e)>("f2e", fs, eccs, out);
+}
+
+void m2f(std::span<const double> Ms, std::span<const double> eccs, std::span<double> out)
+{
+    m2e_impl<static_cast<double (*)(double, double)>(e2f)>("m2f", Ms, eccs, out);
+}
+
+void f2m(std::span<const double> fs, std::span<const double> eccs, std::span<double> out)
+{
+    convert<static_cast<double (*)(double, double)>(f2m)>("f2m", fs, eccs, out);
+}
+
+void zeta2f(std::span<const double> zetas, std::span<const double> eccs, std::span<double> out)
+{
+    convert<static_cast<double (*)(double, double)>(zeta2f)>("zeta2f", zetas, eccs, out);
+}
+
+void f2zeta(std::span<const double> fs, std::span<const double> eccs, std::span<double> out)
+{
+    convert<static_cast<double (*)(double, double)>(f2zeta)>("f2zeta", fs, eccs, out);
+}
+
+void n2h(std::span<const double> Ns, std::span<const double> eccs, std::span<double> out)
+{
+    n2h_impl<identity>("n2h", Ns, eccs, out);
+}
+
+void h2n(std::span<const double> Hs, std::span<const double> eccs, std::span<double> out)
+{
+    convert<static_cast<double (*)(double, double)>(h2n)>("h2n", Hs, eccs, out);
+}
+
+void h2f(std::span<const double> Hs, std::span<const double> eccs, std::span<double> out)
+{
+    convert<static_cast<double (*)(double, double)>(h2f)>("h2f", Hs, eccs, out);
+}
+
+void f2h(std::span<const double> fs, std::span<const double> eccs, std::span<double> out)
+{
+    convert<static_cast<double (*)(double, double)>(f2h)>("f2h", fs, eccs, out);
+}
+
+void n2f(std::span<const double> Ns, std::span<const double> eccs, std::span<double> out)
+{
+    n2h_impl<static_cast<double (*)(double, double)>(h2f)>("n2f", Ns, eccs, out);
+}
+
+void f2n(std::span<const double> fs, std::span<const double> eccs, std::span<double> out)
+{
+    convert<static_cast<double (*)(double, double)>(f2n)>("f2n", fs, eccs, out);
+}
+
+} // namespace kep3
@@ -0,0 +1,393 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+#include <boost/math/tools/roots.hpp>
+#include <fmt/core.h>
+
+#include <kep3/detail/kepler_simd.hpp>
+
+// On x86 GCC-like compilers we compile the lane kernels several times for different
+// instruction sets and pick the best one at runtime. Elsewhere we only have the default build.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KEP3_KEPLER_SIMD_DISPATCH
+#endif
+
+namespace kep3::detail
+{
+
+namespace
+{
+
+// Adding and subtracting this constant rounds a double with magnitude below 2^51 to the nearest
+// integer, which is then also found in the low bits of the mantissa of the sum.
+constexpr double round_magic = 0x1.8p52;
+
+// Sine and cosine of x, for |x| < 1e5. The argument is reduced modulo pi/2 (Cody-Waite, with pi/2
+// split in three parts) and the fdlibm kernel polynomials are evaluated on [-pi/4, pi/4]. The
+// quadrant is selected without branches, so that the function vectorizes. Accurate to about 1 ulp.
+inline void simd_sincos(double x, double &s, double &c)
+{
+    constexpr double two_over_pi = 6.36619772367581382433e-01;
+    constexpr double pio2_1 = 1.57079632673412561417e+00;
+    constexpr double pio2_2 = 6.07710050630396597660e-11;
+    constexpr double pio2_2t = 2.02226624879595063154e-21;
+    constexpr double S1 = -1.66666666666666324348e-01, S2 = 8.33333333332248946124e-03,
+                     S3 = -1.98412698298579493134e-04, S4 = 2.75573137070700676789e-06,
+                     S5 = -2.50507602534068634195e-08, S6 = 1.58969099521155010221e-10;
+    constexpr double C1 = 4.16666666666666019037e-02, C2 = -1.38888888888741095749e-03,
+                     C3 = 2.48015872894767294178e-05, C4 = -2.75573143513906633035e-07,
+                     C5 = 2.08757232129817482790e-09, C6 = -1.13596475577881948265e-11;
+
+    const double y = x * two_over_pi + round_magic;
+    const double k = y - round_magic;
+    const auto q = std::bit_cast<std::uint64_t>(y) & 3u;
+    const double r = ((x - k * pio2_1) - k * pio2_2) - k * pio2_2t;
+
+    const double z = r * r;
+    const double sr = r + r * z * (S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)))));
+    const double hz = 0.5 * z;
+    const double w = 1. - hz;
+    const double cr = w + (((1. - w) - hz) + z * z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6))))));
+
+    // Quadrants 1 and 3 swap sine and cosine, the sine is negative in 2 and 3, the cosine in 1 and 2.
+    const bool odd = (q & 1u) != 0u;
+    const double s_abs = odd ? cr : sr;
+    const double c_abs = odd ? sr : cr;
+    s = (q & 2u) != 0u ? -s_abs : s_abs;
+    c = ((q + 1u) & 2u) != 0u ? -c_abs : c_abs;
+}
+
+// Exponential of x, for |x| < 700. The argument is reduced modulo ln2 and the fdlibm rational
+// approximation is used on [-ln2/2, ln2/2]. The result is scaled by 2^k acting directly on the
+// exponent bits, so that the function vectorizes. Accurate to about 1 ulp.
+inline double simd_exp(double x)
+{
+    constexpr double ln2_hi = 6.93147180369123816490e-01;
+    constexpr double ln2_lo = 1.90821492927058770002e-10;
+    constexpr double inv_ln2 = 1.44269504088896338700e+00;
+    constexpr double P1 = 1.66666666666666019037e-01, P2 = -2.77777777770155933842e-03,
+                     P3 = 6.61375632143793436117e-05, P4 = -1.65339022054652515390e-06,
+                     P5 = 4.13813679705723846039e-08;
+
+    const double y = x * inv_ln2 + round_magic;
+    const double k = y - round_magic;
+    const double hi = x - k * ln2_hi;
+    const double lo = k * ln2_lo;
+    const double r = hi - lo;
+    const double z = r * r;
+    const double cr = r - z * (P1 + z * (P2 + z * (P3 + z * (P4 + z * P5))));
+    const double er = 1. - ((lo - (r * cr) / (2. - cr)) - hi);
+    const auto ki = std::bit_cast<std::int64_t>(y) - std::bit_cast<std::int64_t>(round_magic);
+    return std::bit_cast<double>(std::bit_cast<std::int64_t>(er) + ki * (std::int64_t(1) << 52));
+}
+
+// Natural logarithm of x, for positive normal x. The argument is split as 2^k m with m in [sqrt(2)/2, sqrt(2))
+// acting directly on the exponent bits, and the fdlibm polynomial is evaluated for log(m), so that the function
+// vectorizes. Accurate to about 1 ulp.
+inline double simd_log(double x)
+{
+    constexpr double ln2_hi = 6.93147180369123816490e-01;
+    constexpr double ln2_lo = 1.90821492927058770002e-10;
+    constexpr double Lg1 = 6.666666666666735130e-01, Lg2 = 3.999999999940941908e-01,
+                     Lg3 = 2.857142874366239149e-01, Lg4 = 2.222219843214978396e-01,
+                     Lg5 = 1.818357216161805012e-01, Lg6 = 1.531383769920937332e-01,
+                     Lg7 = 1.479819860511658591e-01;
+
+    const auto bits = std::bit_cast<std::uint64_t>(x);
+    // The high word is shifted so that the exponent is incremented when m >= sqrt(2).
+    const std::uint64_t hx = (bits >> 32) + (0x3ff00000u - 0x3fe6a09eu);
+    // The biased exponent is converted to double through the mantissa of 2^52 (as in simd_exp, AVX2 has no
+    // conversion from 64 bit integers).
+    const double k = std::bit_cast<double>((hx >> 20) | std::bit_cast<std::uint64_t>(0x1p52)) - (0x1p52 + 1023.);
+    const std::uint64_t hm = (hx & 0x000fffffu) + 0x3fe6a09eu;
+    const double f = std::bit_cast<double>((hm << 32) | (bits & 0xffffffffu)) - 1.;
+
+    const double hfsq = 0.5 * f * f;
+    const double s = f / (2. + f);
+    const double z = s * s;
+    const double w = z * z;
+    const double t1 = w * (Lg2 + w * (Lg4 + w * Lg6));
+    const double t2 = z * (Lg1 + w * (Lg3 + w * (Lg5 + w * Lg7)));
+    return k * ln2_hi - ((hfsq - (s * (hfsq + t1 + t2) + k * ln2_lo)) - f);
+}
+
+// Hyperbolic sine and cosine minus one of x, for |x| < 700. For |x| < 0.5 Taylor series are used
+// to avoid the cancellation in (e^x - e^-x) / 2 and in cosh x - 1.
+inline void simd_sinhcoshm1(double x, double &sh, double &chm1)
+{
+    const double e = simd_exp(x);
+    const double ei = 1. / e;
+    const double z = x * x;
+    const double sh_small
+        = x * (1. + z / 6. * (1. + z / 20. * (1. + z / 42. * (1. + z / 72. * (1. + z / 110. * (1. + z / 156.))))));
+    const double chm1_small
+        = z / 2.
+          * (1. + z / 12. * (1. + z / 30. * (1. + z / 56. * (1. + z / 90. * (1. + z / 132. * (1. + z / 182.))))));
+    const bool small = std::abs(x) < 0.5;
+    sh = small ? sh_small : 0.5 * (e - ei);
+    chm1 = small ? chm1_small : 0.5 * (e + ei) - 1.;
+}
+
+// The scalar path for the lanes the vectorized iterations did not solve. This is the same
+// root finder used by kep3::propagate_lagrangian and kep3::m2e.
+template <bool Hyperbolic>
+double kep_fallback(double M, double s0, double c0, double bound, double IG)
+{
+    const int digits = std::numeric_limits<double>::digits;
+    std::uintmax_t max_iter = 100u;
+    double sol = 0.;
+    if constexpr (Hyperbolic) {
+        sol = boost::math::tools::newton_raphson_iterate(
+            [M, s0, c0](double x) {
+                return std::make_tuple(-M - x + s0 * (std::cosh(x) - 1) + c0 * std::sinh(x),
+                                       -1. + s0 * std::sinh(x) + c0 * std::cosh(x));
+            },
+            IG, IG - bound, IG + bound, digits, max_iter);
+    } else {
+        sol = boost::math::tools::newton_raphson_iterate(
+            [M, s0, c0](double x) {
+                return std::make_tuple(-M + x + s0 * (1 - std::cos(x)) - c0 * std::sin(x),
+                                       1 + s0 * std::sin(x) - c0 * std::cos(x));
+            },
+            IG, IG - bound, IG + bound, digits, max_iter);
+    }
+    if (max_iter == 100u) {
+        throw std::domain_error(fmt::format("Maximum number of iterations exceeded when solving Kepler's "
+                                            "equation in {}.\nM={}\ns0={}\nc0={}\nIG={}",
+                                            Hyperbolic ? "kepDH_simd" : "kepDE_simd", M, s0, c0, IG));
+    }
+    return sol;
+}
+
+// Initial guess for the hyperbolic Kepler's equation. With ecc = sqrt(c0^2 - s0^2) and H0 = atanh(s0 / c0),
+// the equation reads ecc sinh(y) - y = N' in y = x + H0, with N' = N + s0 - H0. For N' > 0 its root lies in
+// [asinh(N' / ecc), asinh((N' + cbrt(6 N' / ecc)) / ecc)], as sinh(y) >= y + y^3 / 6. We return (up to
+// rounding) the upper end, from which Newton converges monotonically (the function is convex for y > 0, and
+// odd). Requires c0 > |s0|. The roots are written with simd_log and simd_exp: std::sqrt may set errno, which
+// prevents the vectorization of the loop.
+inline double kepDH_guess(double N, double s0, double c0)
+{
+    const double log_ecc = 0.5 * simd_log((c0 - s0) * (c0 + s0));
+    const double t = s0 / c0;
+    const double H0 = 0.5 * simd_log((1. + t) / (1. - t));
+    const double Np = N + s0 - H0;
+    // NOTE: the arguments of the logarithms are floored to avoid log(0).
+    const double aN = std::max(std::abs(Np), 1e-300);
+    const double cb = simd_exp((simd_log(6. * aN) - log_ecc) / 3.);
+    const double z = (aN + cb) * simd_exp(-log_ecc);
+    // asinh(z), avoiding the overflow of z^2.
+    const double y = simd_log(z > 1e100 ? 2. * z : z + simd_exp(0.5 * simd_log(z * z + 1.)));
+    return std::copysign(y, Np) - H0;
+}
+
+// Solves Kepler's equation in groups of W lanes. Newton iterations run in lockstep, branch free
+// across the lanes so that they can be vectorized by the compiler, while lanes that have already
+// converged are masked and keep their value of x. Lanes with non finite data or with a bracket
+// outside the domain of simd_sincos / simd_exp never enter the iterations and, as the lanes
+// that did not converge, are handed to the scalar fallback.
+template <std::size_t W, bool Hyperbolic>
+inline void kep_lanes(std::size_t n, const double *Ms, const double *s0s, std::size_t s0_stride, const double *c0s,
+                      std::size_t c0_stride, double bound, double *xs)
+{
+    constexpr unsigned iter_max = 30u;
+    constexpr double tol = 4. * std::numeric_limits<double>::epsilon();
+    constexpr double x_max = Hyperbolic ? 700. : 1e5;
+
+    std::array<double, W> M{}, s0{}, c0{}, x{}, lo{}, hi{}, err{};
+
+    for (std::size_t base = 0u; base < n; base += W) {
+        const auto n_lanes = std::min(W, n - base);
+        // 1 - Load the data. Lanes past the end replicate the last problem.
+        for (std::size_t l = 0u; l < W; ++l) {
+            const auto i = base + std::min(l, n_lanes - 1u);
+            M[l] = Ms[i];
+            s0[l] = s0s[i * s0_stride];
+            c0[l] = c0s[i * c0_stride];
+            x[l] = xs[i];
+            lo[l] = x[l] - bound;
+            hi[l] = x[l] + bound;
+            const bool valid = std::isfinite(M[l]) && std::isfinite(s0[l]) && std::isfinite(c0[l])
+                               && std::abs(x[l]) + bound < x_max;
+            // A NaN error is never above tolerance (thus the lane is inactive) nor below it (thus
+            // the lane will go to the fallback).
+            err[l] = valid ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+        }
+        if constexpr (Hyperbolic) {
+            // The initial guesses of the callers (e.g. +-1) are far from the root for large |N|, where Newton
+            // converges linearly. We start instead from an upper bound of the root, see kepDH_guess(). Lanes that
+            // are invalid, or not hyperbolas, keep the guess of the caller.
+            for (std::size_t l = 0u; l < W; ++l) {
+                const double g = kepDH_guess(M[l], s0[l], c0[l]);
+                const bool use_guess = (err[l] > 0.) & (c0[l] > std::abs(s0[l]));
+                // NOTE: std::min and std::max return references, which prevents the vectorization here.
+                const double g_clamped = g < lo[l] ? lo[l] : (g > hi[l] ? hi[l] : g);
+                x[l] = use_guess ? g_clamped : x[l];
+            }
+        }
+        // 2 - Newton iterations in lockstep.
+        for (unsigned k = 0u; k < iter_max; ++k) {
+            bool any_active = false;
+            for (std::size_t l = 0u; l < W; ++l) {
+                any_active = any_active || (err[l] > tol);
+            }
+            if (!any_active) {
+                break;
+            }
+            for (std::size_t l = 0u; l < W; ++l) {
+                double f = 0., df = 0.;
+                if constexpr (Hyperbolic) {
+                    double sh = 0., chm1 = 0.;
+                    simd_sinhcoshm1(x[l], sh, chm1);
+                    f = -M[l] - x[l] + s0[l] * chm1 + c0[l] * sh;
+                    df = -1. + s0[l] * sh + c0[l] * (chm1 + 1.);
+                } else {
+                    double s = 0., c = 0.;
+                    simd_sincos(x[l], s, c);
+                    f = -M[l] + x[l] + s0[l] * (1. - c) - c0[l] * s;
+                    df = 1. + s0[l] * s - c0[l] * c;
+                }
+                // Safeguard: the left hand sides are increasing in x, so the sign of f shrinks the bracket
+                // and Newton steps leaving it are replaced by bisection.
+                lo[l] = f < 0. ? std::max(lo[l], x[l]) : lo[l];
+                hi[l] = f > 0. ? std::min(hi[l], x[l]) : hi[l];
+                const double xn = x[l] - f / df;
+                const double xnew = (xn >= lo[l] && xn <= hi[l]) ? xn : 0.5 * (lo[l] + hi[l]);
+                const bool active = err[l] > tol;
+                err[l] = active ? std::abs(xnew - x[l]) / std::max(1., std::abs(xnew)) : err[l];
+                x[l] = active ? xnew : x[l];
+            }
+        }
+        // 3 - Store, solving the leftovers with the scalar path.
+        for (std::size_t l = 0u; l < n_lanes; ++l) {
+            const auto i = base + l;
+            if (err[l] <= tol) {
+                xs[i] = x[l];
+            } else {
+                xs[i] = kep_fallback<Hyperbolic>(M[l], s0[l], c0[l], bound, xs[i]);
+            }
+        }
+    }
+}
+
+using kep_fptr_t
+    = void (*)(std::size_t, const double *, const double *, std::size_t, const double *, std::size_t, double, double *);
+
+#if defined(KEP3_KEPLER_SIMD_DISPATCH)
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+__attribute__((target("avx512f"), flatten)) void kepDE_avx512(std::size_t n, const double *Ms, const double *s0s,
+                                                               std::size_t s0_stride, const double *c0s,
+                                                               std::size_t c0_stride, double bound, double *xs)
+{
+    kep_lanes<8, false>(n, Ms, s0s, s0_stride, c0s, c0_stride, bound, xs);
+}
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+__attribute__((target("avx512f"), flatten)) void kepDH_avx512(std::size_t n, const double *Ns, const double *s0s,
+                                                               std::size_t s0_stride, const double *c0s,
+                                                               std::size_t c0_stride, double bound, double *xs)
+{
+    kep_lanes<8, true>(n, Ns, s0s, s0_stride, c0s, c0_stride, bound, xs);
+}
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+__attribute__((target("avx2,fma"), flatten)) void kepDE_avx2(std::size_t n, const double *Ms, const double *s0s,
+                                                              std::size_t s0_stride, const double *c0s,
+                                                              std::size_t c0_stride, double bound, double *xs)
+{
+    kep_lanes<4, false>(n, Ms, s0s, s0_stride, c0s, c0_stride, bound, xs);
+}
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+__attribute__((target("avx2,fma"), flatten)) void kepDH_avx2(std::size_t n, const double *Ns, const double *s0s,
+                                                              std::size_t s0_stride, const double *c0s,
+                                                              std::size_t c0_stride, double bound, double *xs)
+{
+    kep_lanes<4, true>(n, Ns, s0s, s0_stride, c0s, c0_stride, bound, xs);
+}
+
+#endif
+
+// Scalar fallbacks (still benefit from SSE2/NEON on two lanes).
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+void kepDE_default(std::size_t n, const double *Ms, const double *s0s, std::size_t s0_stride, const double *c0s,
+                   std::size_t c0_stride, double bound, double *xs)
+{
+    kep_lanes<2, false>(n, Ms, s0s, s0_stride, c0s, c0_stride, bound, xs);
+}
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+void kepDH_default(std::size_t n, const double *Ns, const double *s0s, std::size_t s0_stride, const double *c0s,
+                   std::size_t c0_stride, double bound, double *xs)
+{
+    kep_lanes<2, true>(n, Ns, s0s, s0_stride, c0s, c0_stride, bound, xs);
+}
+
+kep_fptr_t kepDE_select()
+{
+#if defined(KEP3_KEPLER_SIMD_DISPATCH)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return &kepDE_avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return &kepDE_avx2;
+    }
+#endif
+    return &kepDE_default;
+}
+
+kep_fptr_t kepDH_select()
+{
+#if defined(KEP3_KEPLER_SIMD_DISPATCH)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return &kepDH_avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return &kepDH_avx2;
+    }
+#endif
+    return &kepDH_default;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+void kepDE_simd(std::size_t n, const double *Ms, const double *s0s, std::size_t s0_stride, const double *c0s,
+                std::size_t c0_stride, double bound, double *xs)
+{
+    // The kernel is selected once, at the first call.
+    static const auto fptr = kepDE_select();
+    fptr(n, Ms, s0s, s0_stride, c0s, c0_stride, bound, xs);
+}
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+void kepDH_simd(std::size_t n, const double *Ns, const double *s0s, std::size_t s0_stride, const double *c0s,
+                std::size_t c0_stride, double bound, double *xs)
+{
+    // The kernel is selected once, at the first call.
+    static const auto fptr = kepDH_select();
+    fptr(n, Ns, s0s, s0_stride, c0s, c0_stride, bound, xs);
+}
+
+} // namespace kep3::detail
+
+#undef KEP3_KEPLER_SIMD_DISPATCH
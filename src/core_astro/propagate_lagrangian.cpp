@@ -8,52 +8,60 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <utility>
 
 #include <boost/math/tools/roots.hpp>
 #include <fmt/core.h>
 
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+
 #include <kep3/core_astro/constants.hpp>
 #include <kep3/core_astro/convert_anomalies.hpp>
 #include <kep3/core_astro/ic2par2ic.hpp>
 #include <kep3/core_astro/kepler_equations.hpp>
 #include <kep3/core_astro/propagate_lagrangian.hpp>
 #include <kep3/core_astro/special_functions.hpp>
+#include <kep3/detail/kepler_simd.hpp>
 
 namespace kep3
 {
 
-/// Lagrangian propagation
-/**
- * This function propagates an initial Cartesian state for a time t assuming a
- * central body and a keplerian motion. Lagrange coefficients are used as basic
- * numerical technique. All units systems can be used, as long
- * as the input parameters are all expressed in the same system.
- */
-std::pair<std::array<std::array<double, 3>, 2>, std::optional<std::array<double, 36>>>
-propagate_lagrangian(const std::array<std::array<double, 3>, 2> &pos_vel0, const double tof, const double mu, bool stm)
+namespace
+{
+
+// The quantities derived from the initial state which are needed to solve Kepler's equation and,
+// later, to compute the Lagrange coefficients and the state transition matrix.
+struct lagrangian_data {
+    double R0 = 0., energy = 0., a = 0., sqrta = 0., sigma0 = 0., s0 = 0., c0 = 0.;
+    // The mean anomaly difference (DM, cropped to [0, 2pi] for ellipses, DN for hyperbolas) and
+    // the initial guess for the eccentric (DE) or hyperbolic (DH) anomaly difference.
+    double DM = 0., IG = 0.;
+};
+
+lagrangian_data propagate_lagrangian_setup(const std::array<std::array<double, 3>, 2> &pos_vel0, const double tof,
+                                           const double mu)
 {
     const auto &[r0, v0] = pos_vel0;
-    auto pos_velf = pos_vel0;
-    auto &[rf, vf] = pos_velf;
-    double R0 = std::sqrt(r0[0] * r0[0] + r0[1] * r0[1] + r0[2] * r0[2]);
-    double Rf = 0.;
+    lagrangian_data d;
+    d.R0 = std::sqrt(r0[0] * r0[0] + r0[1] * r0[1] + r0[2] * r0[2]);
     double const V02 = v0[0] * v0[0] + v0[1] * v0[1] + v0[2] * v0[2];
-    double DX = 0.;
-    double const energy = (V02 / 2 - mu / R0);
-    double a = -mu / 2.0 / energy; // will be negative for hyperbolae
-    double sqrta = 0.;
-    double F = 0., G = 0., Ft = 0., Gt = 0.;
-    double s0 = 0., c0 = 0.;
-    double sigma0 = (r0[0] * v0[0] + r0[1] * v0[1] + r0[2] * v0[2]) / std::sqrt(mu);
+    d.energy = (V02 / 2 - mu / d.R0);
+    d.a = -mu / 2.0 / d.energy; // will be negative for hyperbolae
+    d.sigma0 = (r0[0] * v0[0] + r0[1] * v0[1] + r0[2] * v0[2]) / std::sqrt(mu);
 
-    if (a > 0) { // Solve Kepler's equation in DE, elliptical case
-        sqrta = std::sqrt(a);
-        double DM = std::sqrt(mu / std::pow(a, 3)) * tof;
+    if (d.a > 0) { // Elliptical case
+        d.sqrta = std::sqrt(d.a);
+        double DM = std::sqrt(mu / std::pow(d.a, 3)) * tof;
         double const sinDM = std::sin(DM);
         double const cosDM = std::cos(DM);
         // Here we use the atan2 to recover the mean anomaly difference in the
@@ -63,25 +71,42 @@ propagate_lagrangian(const std::array<std::array<double, 3>, 2> &pos_vel0, const
         if (DM_cropped < 0) {
             DM_cropped += 2 * kep3::pi;
         }
-        s0 = sigma0 / sqrta;
-        c0 = (1 - R0 / a);
+        double const s0 = d.sigma0 / d.sqrta;
+        double const c0 = (1 - d.R0 / d.a);
         // This initial guess was developed applying Lagrange expansion theorem to
         // the Kepler's equation in DE. We stopped at 3rd order.
-        double const IG = DM_cropped + c0 * sinDM - s0 * (1 - cosDM)
-                          + (c0 * cosDM - s0 * sinDM) * (c0 * sinDM + s0 * cosDM - s0)
-                          + 0.5 * (c0 * sinDM + s0 * cosDM - s0)
-                                * (2 * std::pow(c0 * cosDM - s0 * sinDM, 2)
-                                   - (c0 * sinDM + s0 * cosDM - s0) * (c0 * sinDM + s0 * cosDM));
-
-        // Solve Kepler Equation for ellipses in DE (eccentric anomaly difference)
-        const int digits = std::numeric_limits<double>::digits;
-        std::uintmax_t max_iter = 100u;
-        // NOTE: Halley iterates may result into instabilities (specially with a
-        // poor IG)
+        d.IG = DM_cropped + c0 * sinDM - s0 * (1 - cosDM)
+               + (c0 * cosDM - s0 * sinDM) * (c0 * sinDM + s0 * cosDM - s0)
+               + 0.5 * (c0 * sinDM + s0 * cosDM - s0)
+                     * (2 * std::pow(c0 * cosDM - s0 * sinDM, 2)
+                        - (c0 * sinDM + s0 * cosDM - s0) * (c0 * sinDM + s0 * cosDM));
+        d.DM = DM_cropped;
+        d.s0 = s0;
+        d.c0 = c0;
+    } else { // Hyperbolic case
+        d.sqrta = std::sqrt(-d.a);
+        d.DM = std::sqrt(-mu / d.a / d.a / d.a) * tof;
+        d.s0 = d.sigma0 / d.sqrta;
+        d.c0 = (1 - d.R0 / d.a);
+        tof > 0. ? d.IG = 1. : d.IG = -1.; // TODO(darioizzo): find a better initial guess.
+                                           // I tried with 0 and DN (both have numercial
+                                           // problems and result in exceptions)
+    }
+    return d;
+}
 
+// Solves Kepler's equation in DE (elliptical case) or DH (hyperbolic case), one state at a time.
+double propagate_lagrangian_solve(const lagrangian_data &d)
+{
+    const int digits = std::numeric_limits<double>::digits;
+    std::uintmax_t max_iter = 100u;
+    const double DM = d.DM, sigma0 = d.sigma0, sqrta = d.sqrta, a = d.a, R0 = d.R0, IG = d.IG;
+    // NOTE: Halley iterates may result into instabilities (specially with a
+    // poor IG)
+    if (a > 0) {
         double DE = boost::math::tools::newton_raphson_iterate(
-            [DM_cropped, sigma0, sqrta, a, R0](double DE) {
-                return std::make_tuple(kepDE(DE, DM_cropped, sigma0, sqrta, a, R0), d_kepDE(DE, sigma0, sqrta, a, R0));
+            [DM, sigma0, sqrta, a, R0](double DE) {
+                return std::make_tuple(kepDE(DE, DM, sigma0, sqrta, a, R0), d_kepDE(DE, sigma0, sqrta, a, R0));
             },
             IG, IG - pi, IG + pi, digits, max_iter);
         // LCOV_EXCL_START
@@ -92,32 +117,11 @@ propagate_lagrangian(const std::array<std::array<double, 3>, 2> &pos_vel0, const
                                                 DM, sigma0, sqrta, a, R0, DE));
         }
         // LCOV_EXCL_STOP
-        Rf = a + (R0 - a) * std::cos(DE) + sigma0 * sqrta * std::sin(DE);
-
-        // Lagrange coefficients
-        F = 1 - a / R0 * (1 - std::cos(DE));
-        G = a * sigma0 / std::sqrt(mu) * (1 - std::cos(DE)) + R0 * std::sqrt(a / mu) * std::sin(DE);
-        Ft = -std::sqrt(mu * a) / (Rf * R0) * std::sin(DE);
-        Gt = 1 - a / Rf * (1 - std::cos(DE));
-        DX = DE;
-    } else { // Solve Kepler's equation in DH, hyperbolic case
-        sqrta = std::sqrt(-a);
-        double DN = std::sqrt(-mu / a / a / a) * tof;
-        double IG = 0.;
-        s0 = sigma0 / sqrta;
-        c0 = (1 - R0 / a);
-        tof > 0. ? IG = 1. : IG = -1.; // TODO(darioizzo): find a better initial guess.
-                                       // I tried with 0 and DN (both have numercial
-                                       // problems and result in exceptions)
-
-        // Solve Kepler Equation for ellipses in DH (hyperbolic anomaly difference)
-        const int digits = std::numeric_limits<double>::digits;
-        std::uintmax_t max_iter = 100u;
-        // NOTE: Halley iterates may result into instabilities (specially with a
-        // poor IG)
+        return DE;
+    } else {
         double DH = boost::math::tools::newton_raphson_iterate(
-            [DN, sigma0, sqrta, a, R0](double DH) {
-                return std::make_tuple(kepDH(DH, DN, sigma0, sqrta, a, R0), d_kepDH(DH, sigma0, sqrta, a, R0));
+            [DM, sigma0, sqrta, a, R0](double DH) {
+                return std::make_tuple(kepDH(DH, DM, sigma0, sqrta, a, R0), d_kepDH(DH, sigma0, sqrta, a, R0));
             },
             IG, IG - 50, IG + 50, digits,
             max_iter); // TODO (dario): study this hyperbolic equation in more
@@ -127,10 +131,36 @@ propagate_lagrangian(const std::array<std::array<double, 3>, 2> &pos_vel0, const
             throw std::domain_error(fmt::format("Maximum number of iterations exceeded when solving Kepler's "
                                                 "equation for the hyperbolic anomaly in propagate_lagrangian.\n"
                                                 "DN={}\nsigma0={}\nsqrta={}\na={}\nR={}\nDH={}",
-                                                DN, sigma0, sqrta, a, R0, DH));
+                                                DM, sigma0, sqrta, a, R0, DH));
         }
         // LCOV_EXCL_STOP
+        return DH;
+    }
+}
+
+// Applies the Lagrange coefficients to pos_vel0, writing the result in pos_velf, given the
+// solution DX of Kepler's equation. If stm is not null, the state transition matrix is also
+// computed and written there (36 doubles, row-major). pos_velf must not alias pos_vel0.
+void propagate_lagrangian_finish(const std::array<std::array<double, 3>, 2> &pos_vel0, const double tof,
+                                 const double mu, const lagrangian_data &d, const double DX,
+                                 std::array<std::array<double, 3>, 2> &pos_velf, double *stm)
+{
+    const auto &[r0, v0] = pos_vel0;
+    auto &[rf, vf] = pos_velf;
+    const double R0 = d.R0, a = d.a, sqrta = d.sqrta, sigma0 = d.sigma0;
+    double Rf = 0., F = 0., G = 0., Ft = 0., Gt = 0.;
 
+    if (a > 0) {
+        const double DE = DX;
+        Rf = a + (R0 - a) * std::cos(DE) + sigma0 * sqrta * std::sin(DE);
+
+        // Lagrange coefficients
+        F = 1 - a / R0 * (1 - std::cos(DE));
+        G = a * sigma0 / std::sqrt(mu) * (1 - std::cos(DE)) + R0 * std::sqrt(a / mu) * std::sin(DE);
+        Ft = -std::sqrt(mu * a) / (Rf * R0) * std::sin(DE);
+        Gt = 1 - a / Rf * (1 - std::cos(DE));
+    } else {
+        const double DH = DX;
         // Note: the following equation, according to Battin's (4.63, pag 170), is different. I suspect a typo in Battin
         // book deriving from the confusion on the convention for the semi-majoraxis being negative. The following
         // expression instead works in this context.
@@ -141,21 +171,195 @@ propagate_lagrangian(const std::array<std::array<double, 3>, 2> &pos_vel0, const
         G = a * sigma0 / std::sqrt(mu) * (1. - std::cosh(DH)) + R0 * std::sqrt(-a / mu) * std::sinh(DH);
         Ft = -std::sqrt(-mu * a) / (Rf * R0) * std::sinh(DH);
         Gt = 1. - a / Rf * (1. - std::cosh(DH));
-        DX = DH;
     }
 
     for (auto i = 0u; i < 3; i++) {
         rf[i] = F * r0[i] + G * v0[i];
         vf[i] = Ft * r0[i] + Gt * v0[i];
     }
+    if (stm != nullptr) {
+        const auto retval_stm
+            = kep3::stm_lagrangian(pos_vel0, tof, mu, R0, Rf, d.energy, sigma0, a, d.s0, d.c0, DX, F, G, Ft, Gt);
+        std::copy(retval_stm.begin(), retval_stm.end(), stm);
+    }
+}
+
+// A single propagation step, as in kep3::propagate_lagrangian but writing the state transition
+// matrix (if stm is not null) into a raw buffer.
+void propagate_lagrangian_step(const std::array<std::array<double, 3>, 2> &pos_vel0, const double tof,
+                               const double mu, std::array<std::array<double, 3>, 2> &pos_velf, double *stm)
+{
+    const auto d = propagate_lagrangian_setup(pos_vel0, tof, mu);
+    propagate_lagrangian_finish(pos_vel0, tof, mu, d, propagate_lagrangian_solve(d), pos_velf, stm);
+}
+
+// Fills the grid points [begin, end) stepping from one point to the next. Unless begin is zero,
+// the propagation is seeded by the point begin - 1, which is computed directly from the initial
+// state (the anchor).
+void propagate_lagrangian_grid_chunk(const std::array<std::array<double, 3>, 2> &pos_vel,
+                                     std::span<const double> time_grid, double mu, std::span<double> pos_vels,
+                                     std::span<double> stms, bool compose_stm, std::size_t begin, std::size_t end)
+{
+    const bool want_stm = !stms.empty();
+    std::array<std::array<double, 3>, 2> current = pos_vel, next{};
+    // phi is the state transition matrix from the start of the grid to the current point.
+    std::array<double, 36> phi{}, step{};
+    for (auto k = 0u; k < 6u; ++k) {
+        phi[7u * k] = 1.;
+    }
+
+    if (begin == 0u) {
+        for (auto j = 0u; j < 3u; ++j) {
+            pos_vels[j] = pos_vel[0][j];
+            pos_vels[3u + j] = pos_vel[1][j];
+        }
+        if (want_stm) {
+            std::copy(phi.begin(), phi.end(), stms.begin());
+        }
+        begin = 1u;
+    } else {
+        propagate_lagrangian_step(pos_vel, time_grid[begin - 1u] - time_grid[0], mu, current,
+                                  (want_stm && compose_stm) ? phi.data() : nullptr);
+    }
+
+    for (auto i = begin; i < end; ++i) {
+        propagate_lagrangian_step(current, time_grid[i] - time_grid[i - 1u], mu, next,
+                                  want_stm ? step.data() : nullptr);
+        for (auto j = 0u; j < 3u; ++j) {
+            pos_vels[6u * i + j] = next[0][j];
+            pos_vels[6u * i + 3u + j] = next[1][j];
+        }
+        if (want_stm) {
+            double *out = stms.data() + 36u * i;
+            if (compose_stm) {
+                // phi <- step * phi (row-major 6x6 matrices).
+                for (auto r = 0u; r < 6u; ++r) {
+                    for (auto c = 0u; c < 6u; ++c) {
+                        double acc = 0.;
+                        for (auto k = 0u; k < 6u; ++k) {
+                            acc += step[6u * r + k] * phi[6u * k + c];
+                        }
+                        out[6u * r + c] = acc;
+                    }
+                }
+                std::copy(out, out + 36, phi.begin());
+            } else {
+                std::copy(step.begin(), step.end(), out);
+            }
+        }
+        current = next;
+    }
+}
+
+} // namespace
+
+/// Lagrangian propagation
+/**
+ * This function propagates an initial Cartesian state for a time t assuming a
+ * central body and a keplerian motion. Lagrange coefficients are used as basic
+ * numerical technique. All units systems can be used, as long
+ * as the input parameters are all expressed in the same system.
+ */
+std::pair<std::array<std::array<double, 3>, 2>, std::optional<std::array<double, 36>>>
+propagate_lagrangian(const std::array<std::array<double, 3>, 2> &pos_vel0, const double tof, const double mu, bool stm)
+{
+    const auto d = propagate_lagrangian_setup(pos_vel0, tof, mu);
+    const double DX = propagate_lagrangian_solve(d);
+    std::array<std::array<double, 3>, 2> pos_velf{};
     if (stm) {
-        auto retval_stm = kep3::stm_lagrangian(pos_vel0, tof, mu, R0, Rf, energy, sigma0, a, s0, c0, DX, F, G, Ft, Gt);
+        std::array<double, 36> retval_stm{};
+        propagate_lagrangian_finish(pos_vel0, tof, mu, d, DX, pos_velf, retval_stm.data());
         return {pos_velf, retval_stm};
     } else {
+        propagate_lagrangian_finish(pos_vel0, tof, mu, d, DX, pos_velf, nullptr);
         return {pos_velf, std::nullopt};
     }
 }
 
+void propagate_lagrangian_batch(std::span<const double> rs, std::span<const double> vs, std::span<const double> tofs,
+                                std::span<const double> mus, std::span<double> rfs, std::span<double> vfs,
+                                std::span<double> stms)
+{
+    // 0 - Sanity checks on the buffer sizes.
+    const auto N = tofs.size();
+    if (rs.size() != 3u * N || vs.size() != 3u * N) {
+        throw std::invalid_argument(fmt::format("propagate_lagrangian_batch: the initial states must have size 3N = "
+                                                "{}, while rs has size {} and vs has size {}",
+                                                3u * N, rs.size(), vs.size()));
+    }
+    if (rfs.size() != 3u * N || vfs.size() != 3u * N) {
+        throw std::invalid_argument(fmt::format("propagate_lagrangian_batch: the final states must have size 3N = "
+                                                "{}, while rfs has size {} and vfs has size {}",
+                                                3u * N, rfs.size(), vfs.size()));
+    }
+    if (mus.size() != N && mus.size() != 1u) {
+        throw std::invalid_argument(fmt::format(
+            "propagate_lagrangian_batch: mus must have size N = {} or 1, while it has size {}", N, mus.size()));
+    }
+    if (!stms.empty() && stms.size() != 36u * N) {
+        throw std::invalid_argument(fmt::format("propagate_lagrangian_batch: the state transition matrices must have "
+                                                "size 36N = {} (or be empty), while it has size {}",
+                                                36u * N, stms.size()));
+    }
+
+    // 1 - We process the states in chunks, no allocation takes place in here. The initial states
+    // are copied locally so that the outputs may alias the inputs. In each chunk, Kepler's equation
+    // is solved by the vectorized kernels, separately for the elliptical and the hyperbolic states.
+    constexpr std::size_t chunk = 64u;
+    std::array<std::array<std::array<double, 3>, 2>, chunk> pos_vel0{};
+    std::array<lagrangian_data, chunk> data{};
+    std::array<double, chunk> DX{}, Ms{}, s0s{}, c0s{}, xs{};
+    std::array<std::size_t, chunk> idx{};
+    std::array<std::array<double, 3>, 2> pos_velf{};
+
+    // Solves Kepler's equation for the states of the chunk on the requested branch.
+    const auto solve_branch = [&](std::size_t n_c, bool hyperbolic) {
+        std::size_t n_b = 0u;
+        for (std::size_t l = 0u; l < n_c; ++l) {
+            if ((data[l].a > 0) != hyperbolic) {
+                idx[n_b] = l;
+                Ms[n_b] = data[l].DM;
+                s0s[n_b] = data[l].s0;
+                c0s[n_b] = data[l].c0;
+                xs[n_b] = data[l].IG;
+                ++n_b;
+            }
+        }
+        if (hyperbolic) {
+            // NOTE: the kernel computes its own initial guess for the hyperbolas, IG (+-1) only centers the bracket.
+            detail::kepDH_simd(n_b, Ms.data(), s0s.data(), 1u, c0s.data(), 1u, 50., xs.data());
+        } else {
+            detail::kepDE_simd(n_b, Ms.data(), s0s.data(), 1u, c0s.data(), 1u, pi, xs.data());
+        }
+        for (std::size_t k = 0u; k < n_b; ++k) {
+            DX[idx[k]] = xs[k];
+        }
+    };
+
+    for (std::size_t base = 0u; base < N; base += chunk) {
+        const auto n_c = std::min(chunk, N - base);
+        for (std::size_t l = 0u; l < n_c; ++l) {
+            const auto i = base + l;
+            for (auto j = 0u; j < 3u; ++j) {
+                pos_vel0[l][0][j] = rs[3u * i + j];
+                pos_vel0[l][1][j] = vs[3u * i + j];
+            }
+            data[l] = propagate_lagrangian_setup(pos_vel0[l], tofs[i], mus.size() == 1u ? mus[0] : mus[i]);
+        }
+        solve_branch(n_c, false);
+        solve_branch(n_c, true);
+        for (std::size_t l = 0u; l < n_c; ++l) {
+            const auto i = base + l;
+            propagate_lagrangian_finish(pos_vel0[l], tofs[i], mus.size() == 1u ? mus[0] : mus[i], data[l], DX[l],
+                                        pos_velf, stms.empty() ? nullptr : stms.data() + 36u * i);
+            for (auto j = 0u; j < 3u; ++j) {
+                rfs[3u * i + j] = pos_velf[0][j];
+                vfs[3u * i + j] = pos_velf[1][j];
+            }
+        }
+    }
+}
+
 std::vector<std::pair<std::array<std::array<double, 3>, 2>, std::optional<std::array<double, 36>>>>
 propagate_lagrangian_grid(const std::array<std::array<double, 3>, 2> &pos_vel, const std::vector<double> &time_grid,
                        double mu, bool stm)
@@ -168,6 +372,46 @@ propagate_lagrangian_grid(const std::array<std::array<double, 3>, 2> &pos_vel, c
     return retval;
 }
 
+void propagate_lagrangian_grid(const std::array<std::array<double, 3>, 2> &pos_vel, std::span<const double> time_grid,
+                               double mu, std::span<double> pos_vels, std::span<double> stms, bool compose_stm,
+                               bool parallel)
+{
+    // 0 - Sanity checks on the buffer sizes.
+    const auto N = time_grid.size();
+    if (pos_vels.size() != 6u * N) {
+        throw std::invalid_argument(fmt::format(
+            "propagate_lagrangian_grid: the states must have size 6N = {}, while they have size {}", 6u * N,
+            pos_vels.size()));
+    }
+    if (!stms.empty() && stms.size() != 36u * N) {
+        throw std::invalid_argument(fmt::format("propagate_lagrangian_grid: the state transition matrices must have "
+                                                "size 36N = {} (or be empty), while they have size {}",
+                                                36u * N, stms.size()));
+    }
+    if (N == 0u) {
+        return;
+    }
+
+    // 1 - Sequential mode, we step through the whole grid.
+    if (!parallel) {
+        propagate_lagrangian_grid_chunk(pos_vel, time_grid, mu, pos_vels, stms, compose_stm, 0u, N);
+        return;
+    }
+
+    // 2 - Parallel mode. The grid is split in chunks of fixed size (so that the results do not depend
+    // on the scheduling) each seeded by its own anchor.
+    constexpr std::size_t chunk = 256u;
+    const auto n_chunks = (N + chunk - 1u) / chunk;
+    oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<std::size_t>(0u, n_chunks),
+                              [&](const oneapi::tbb::blocked_range<std::size_t> &range) {
+                                  for (auto c = range.begin(); c != range.end(); ++c) {
+                                      propagate_lagrangian_grid_chunk(pos_vel, time_grid, mu, pos_vels, stms,
+                                                                      compose_stm, c * chunk,
+                                                                      std::min(N, (c + 1u) * chunk));
+                                  }
+                              });
+}
+
 /// Universial Variables version
 /**
  * This function has the same prototype as kep3::propagate_lgrangian, but
@@ -0,0 +1,322 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <fmt/core.h>
+
+#include <heyoka/config.hpp>
+
+#include <kep3/config.hpp>
+#include <kep3/detail/jit_cache.hpp>
+#include <kep3/detail/lru_cache.hpp>
+#include <kep3/jit_cache.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define KEP3_JIT_CACHE_X86
+#endif
+
+namespace kep3
+{
+
+namespace detail
+{
+
+namespace
+{
+
+// The cache directory, initialized from the environment on first use.
+struct jit_cache_dir_state {
+    std::mutex mutex;
+    std::string dir;
+
+    jit_cache_dir_state()
+    {
+        // NOLINTNEXTLINE(concurrency-mt-unsafe)
+        if (const auto *env = std::getenv("KEP3_JIT_CACHE_DIR")) {
+            dir = env;
+        }
+    }
+};
+
+jit_cache_dir_state &get_jit_cache_dir_state()
+{
+    static jit_cache_dir_state state;
+    return state;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::size_t> n_hits{0}, n_misses{0}, n_stores{0}, n_errors{0};
+
+// Identifies the host CPU, as the JIT compiled code targets its instruction set.
+// NOTE: outside x86 the CPU is not identified, and cache directories should not be
+// shared across machines.
+std::string host_cpu()
+{
+#if defined(KEP3_JIT_CACHE_X86)
+    // The brand string identifies the CPU model.
+    std::array<unsigned, 12> brand{};
+    if (__get_cpuid_max(0x80000000u, nullptr) >= 0x80000004u) {
+        for (auto i = 0u; i < 3u; ++i) {
+            __get_cpuid(0x80000002u + i, &brand[4u * i], &brand[4u * i + 1u], &brand[4u * i + 2u],
+                        &brand[4u * i + 3u]);
+        }
+    }
+    std::string retval(reinterpret_cast<const char *>(brand.data()), sizeof(brand));
+    retval = retval.substr(0, retval.find('\0'));
+    // The SIMD extensions, which may also be disabled (e.g. by the hypervisor) on a given model.
+    __builtin_cpu_init();
+    retval += fmt::format(",avx={:d},avx2={:d},fma={:d},avx512f={:d}", __builtin_cpu_supports("avx") != 0,
+                          __builtin_cpu_supports("avx2") != 0, __builtin_cpu_supports("fma") != 0,
+                          __builtin_cpu_supports("avx512f") != 0);
+    return retval;
+#else
+    return "unknown";
+#endif
+}
+
+// 64 bit FNV-1a, a hash that does not change across platforms and builds.
+std::uint64_t fnv1a(const std::string &s)
+{
+    std::uint64_t retval = 14695981039346656037ull;
+    for (const auto c : s) {
+        retval ^= static_cast<unsigned char>(c);
+        retval *= 1099511628211ull;
+    }
+    return retval;
+}
+
+// The in-memory caches, by name.
+struct lru_cache_registry {
+    std::shared_mutex mutex;
+    std::map<std::string, lru_cache_base *> caches;
+};
+
+lru_cache_registry &get_lru_cache_registry()
+{
+    static lru_cache_registry registry;
+    return registry;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::size_t> memory_cache_capacity{0};
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<unsigned> tol_digits{0};
+
+} // namespace
+
+lru_cache_base::~lru_cache_base()
+{
+    auto &registry = get_lru_cache_registry();
+    std::lock_guard const lock(registry.mutex);
+    std::erase_if(registry.caches, [this](const auto &p) { return p.second == this; });
+}
+
+void lru_cache_register(const std::string &name, lru_cache_base *cache)
+{
+    auto &registry = get_lru_cache_registry();
+    std::lock_guard const lock(registry.mutex);
+    registry.caches[name] = cache;
+}
+
+double normalize_tol(double tol)
+{
+    const auto digits = tol_digits.load();
+    if (digits == 0u || !std::isfinite(tol) || tol <= 0.) {
+        return tol;
+    }
+    // Rounding through the decimal representation gives the same double for all the inputs
+    // which agree on the first digits.
+    const auto str = fmt::format("{:.{}e}", tol, digits - 1u);
+    double retval = tol;
+    std::from_chars(str.data(), str.data() + str.size(), retval);
+    return retval;
+}
+
+std::optional<jit_cache_entry> jit_cache_find(const std::string &model, const std::string &params)
+{
+    std::filesystem::path dir;
+    {
+        auto &state = get_jit_cache_dir_state();
+        std::lock_guard const lock(state.mutex);
+        if (state.dir.empty()) {
+            return {};
+        }
+        dir = state.dir;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    if (ec) {
+        jit_cache_record(jit_cache_event::error);
+        return {};
+    }
+
+    static const auto host = host_cpu();
+    auto key = fmt::format("kep3={};heyoka={};cpu={};model={};{}", kep3_VERSION, HEYOKA_VERSION_STRING, host, model,
+                           params);
+    auto path = dir / fmt::format("{}-{:016x}.bin", model, fnv1a(key));
+    return jit_cache_entry{std::move(path), std::move(key)};
+}
+
+std::optional<std::string> jit_cache_read(const jit_cache_entry &entry)
+{
+    std::ifstream ifs(entry.path, std::ios::binary);
+    if (!ifs) {
+        return {};
+    }
+    std::string retval{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+    if (ifs.bad()) {
+        return {};
+    }
+    return retval;
+}
+
+void jit_cache_write(const jit_cache_entry &entry, const std::string &data)
+{
+    // We write to a unique temporary file and then rename it, so that concurrent readers
+    // (possibly in other processes) never see a partially written file.
+    static std::atomic<std::size_t> counter{0};
+    const auto salt = std::hash<std::thread::id>{}(std::this_thread::get_id())
+                      ^ static_cast<std::size_t>(std::chrono::steady_clock::now().time_since_epoch().count())
+                      ^ counter++;
+    auto tmp_path = entry.path;
+    tmp_path += fmt::format(".{:x}.tmp", salt);
+
+    bool ok = false;
+    {
+        std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+        ok = static_cast<bool>(ofs.write(data.data(), static_cast<std::streamsize>(data.size())));
+    }
+    std::error_code ec;
+    if (ok) {
+        std::filesystem::rename(tmp_path, entry.path, ec);
+    }
+    if (!ok || ec) {
+        std::filesystem::remove(tmp_path, ec);
+        jit_cache_record(jit_cache_event::error);
+    } else {
+        jit_cache_record(jit_cache_event::store);
+    }
+}
+
+void jit_cache_record(jit_cache_event event)
+{
+    switch (event) {
+        case jit_cache_event::hit:
+            ++n_hits;
+            break;
+        case jit_cache_event::miss:
+            ++n_misses;
+            break;
+        case jit_cache_event::store:
+            ++n_stores;
+            break;
+        default:
+            ++n_errors;
+    }
+}
+
+} // namespace detail
+
+void set_jit_cache_dir(const std::string &dir)
+{
+    auto &state = detail::get_jit_cache_dir_state();
+    std::lock_guard const lock(state.mutex);
+    state.dir = dir;
+}
+
+std::string get_jit_cache_dir()
+{
+    auto &state = detail::get_jit_cache_dir_state();
+    std::lock_guard const lock(state.mutex);
+    return state.dir;
+}
+
+jit_cache_stats get_jit_cache_stats()
+{
+    return {detail::n_hits.load(), detail::n_misses.load(), detail::n_stores.load(), detail::n_errors.load()};
+}
+
+void reset_jit_cache_stats()
+{
+    detail::n_hits = 0u;
+    detail::n_misses = 0u;
+    detail::n_stores = 0u;
+    detail::n_errors = 0u;
+}
+
+void set_jit_memory_cache_capacity(std::size_t capacity)
+{
+    detail::memory_cache_capacity = capacity;
+    auto &registry = detail::get_lru_cache_registry();
+    std::shared_lock const lock(registry.mutex);
+    for (const auto &[_, cache] : registry.caches) {
+        cache->trim(capacity);
+    }
+}
+
+std::size_t get_jit_memory_cache_capacity()
+{
+    return detail::memory_cache_capacity.load();
+}
+
+void set_jit_cache_tol_digits(unsigned digits)
+{
+    detail::tol_digits = digits;
+}
+
+unsigned get_jit_cache_tol_digits()
+{
+    return detail::tol_digits.load();
+}
+
+std::map<std::string, jit_memory_cache_stats> get_jit_memory_cache_stats()
+{
+    std::map<std::string, jit_memory_cache_stats> retval;
+    auto &registry = detail::get_lru_cache_registry();
+    std::shared_lock const lock(registry.mutex);
+    for (const auto &[name, cache] : registry.caches) {
+        retval.emplace(name, cache->stats());
+    }
+    return retval;
+}
+
+void reset_jit_memory_cache_stats()
+{
+    auto &registry = detail::get_lru_cache_registry();
+    std::shared_lock const lock(registry.mutex);
+    for (const auto &[_, cache] : registry.caches) {
+        cache->reset_stats();
+    }
+}
+
+} // namespace kep3
+
+#undef KEP3_JIT_CACHE_X86
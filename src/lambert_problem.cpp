@@ -10,20 +10,24 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include <fmt/core.h>
 #include <fmt/ranges.h>
-#include <xtensor-blas/xlinalg.hpp>
-#include <xtensor/containers/xadapt.hpp>
 
+#include <kep3/detail/lambert_kernels.hpp>
 #include <kep3/exceptions.hpp>
 #include <kep3/lambert_problem.hpp>
 
 namespace kep3
 {
 
-using xt::linalg::cross;
-
 const std::array<double, 3> lambert_problem::default_r0 = {{1.0, 0.0, 0.0}};
 const std::array<double, 3> lambert_problem::default_r1 = {{0.0, 1.0, 0.0}};
 
@@ -40,6 +44,24 @@ const std::array<double, 3> lambert_problem::default_r1 = {{0.0, 1.0, 0.0}};
 lambert_problem::lambert_problem(const std::array<double, 3> &r0_a, const std::array<double, 3> &r1_a,
                                  double tof, // NOLINT
                                  double mu, bool cw, unsigned multi_revs)
+    : lambert_problem(r0_a, r1_a, tof, mu, cw, multi_revs, {})
+{
+}
+
+/// Constructor with warm start
+/**
+ * Constructs and solves a Lambert problem using the values in x_guess (one per solution, ordered as
+ * returned by get_x()) as initial guesses for the Householder iterations. This is convenient when
+ * solving a sequence of nearby problems (e.g. in continuation sweeps), passing the x of the previous
+ * solution. Solutions without a guess (or whose warm started iterations fail to converge to the
+ * correct branch) use the default initial guess. The iterations reported by get_iters() include
+ * those spent on failed warm starts.
+ *
+ * \param[in] x_guess initial guesses for the x of each solution
+ */
+lambert_problem::lambert_problem(const std::array<double, 3> &r0_a, const std::array<double, 3> &r1_a,
+                                 double tof, // NOLINT
+                                 double mu, bool cw, unsigned multi_revs, const std::vector<double> &x_guess)
     : m_r0(r0_a), m_r1(r1_a), m_tof(tof), m_mu(mu), m_has_converged(true), m_multi_revs(multi_revs), m_cw(cw)
 {
     // 0 - Sanity checks
@@ -50,86 +72,17 @@ lambert_problem::lambert_problem(const std::array<double, 3> &r0_a, const std::a
         throw std::domain_error("lambert_problem: Gravity parameter is zero or negative!");
     }
 
-    // Creating xtensor objects binded to the kep3 arrays
-    const auto rs = xt::adapt(r0_a);
-    const auto rf = xt::adapt(r1_a);
-
     // 1 - Getting lambda and T
-    m_c = xt::linalg::norm(rf - rs);
-
-    double Rs = xt::linalg::norm(rs);
-    double Rf = xt::linalg::norm(rf);
-    m_s = (m_c + Rs + Rf) / 2.0;
-
-    auto irs = rs / Rs;
-    auto irf = rf / Rf;
-    auto ih = cross(irs, irf);
-    ih = ih / xt::linalg::norm(ih);
-
-    if (ih(2) == 0) {
-        throw std::domain_error("lambert_problem: The angular momentum vector has no z component, "
-                                "impossible to define automatically clock or "
-                                "counterclockwise");
-    }
-    double const lambda2 = 1.0 - m_c / m_s;
-    m_lambda = std::sqrt(lambda2);
-
-    auto its = cross(ih, irs);
-    auto itf = cross(ih, irf);
-    its = its / xt::linalg::norm(its);
-    itf = itf / xt::linalg::norm(itf);
-
-    if (ih(2) < 0.0) // Transfer angle is larger than 180 degrees as seen from
-                     // above the z axis
-    {
-        m_lambda = -m_lambda;
-        its = -its;
-        itf = -itf;
-    }
-    if (cw) { // Retrograde motion
-        m_lambda = -m_lambda;
-        its = -its;
-        itf = -itf;
-    }
-    double const lambda3 = m_lambda * lambda2;
-    double const T = std::sqrt(2.0 * m_mu / m_s / m_s / m_s) * m_tof;
+    const auto geo = detail::lambert_setup(r0_a.data(), r1_a.data(), m_tof, m_mu, cw);
+    m_c = geo.c;
+    m_s = geo.s;
+    m_lambda = geo.lambda;
+    double const T = geo.T;
 
     // 2 - We now have lambda, T and we will find all x
     // 2.1 - Let us first detect the maximum number of revolutions for which there
-    // exists a solution
-    m_Nmax = static_cast<unsigned>(T / kep3::pi);
-    m_Nmax = std::min(m_multi_revs, m_Nmax);
-    double const T00 = std::acos(m_lambda) + m_lambda * std::sqrt(1.0 - lambda2);
-    double const T0 = (T00 + m_Nmax * kep3::pi);
-    double const T1 = 2.0 / 3.0 * (1.0 - lambda3);
-    double DT = 0.0, DDT = 0.0, DDDT = 0.0;
-    if (m_Nmax > 0) {
-        if (T < T0) { // We use Halley iterations to find xM and TM
-            int it = 0;
-            double err = 1.0;
-            double T_min = T0;
-            double x_old = 0.0, x_new = 0.0;
-            while (true) {
-                dTdx(DT, DDT, DDDT, x_old, T_min);
-                if (DT != 0.0) {
-                    x_new = x_old - DT * DDT / (DDT * DDT - DT * DDDT / 2.0);
-                }
-                err = std::abs(x_old - x_new);
-                if ((err < 1e-13) || (it > 12)) {
-                    break;
-                }
-                x2tof(T_min, x_new, m_Nmax);
-                x_old = x_new;
-                it++;
-            }
-            if (T_min > T) {
-                m_Nmax -= 1;
-            }
-        }
-        // We exit this if clause with Nmax being the maximum number of revolutions
-        // for which there exists a solution. We crop it to m_multi_revs
-        m_Nmax = std::min(m_multi_revs, m_Nmax);
-    }
+    // exists a solution. We crop it to m_multi_revs
+    m_Nmax = detail::lambert_nmax(T, m_lambda, m_multi_revs);
 
     // 2.2 We now allocate the memory for the output variables
     m_v0.resize(static_cast<size_t>(m_Nmax) * 2 + 1);
@@ -137,161 +90,22 @@ lambert_problem::lambert_problem(const std::array<double, 3> &r0_a, const std::a
     m_iters.resize(static_cast<size_t>(m_Nmax) * 2 + 1);
     m_x.resize(static_cast<size_t>(m_Nmax) * 2 + 1);
 
-    // 3 - We may now find all solutions in x,y
-    // 3.1 0 rev solution
-    // 3.1.1 initial guess
-    if (T >= T00) {
-        m_x[0] = -(T - T00) / (T - T00 + 4);
-    } else if (T <= T1) {
-        m_x[0] = T1 * (T1 - T) / (2.0 / 5.0 * (1 - lambda2 * lambda3) * T) + 1;
-    } else {
-        m_x[0] = std::pow((T / T00), 0.69314718055994529 / std::log(T1 / T00)) - 1.0;
-    }
-    // 3.1.2 Householder iterations
-    m_iters[0] = householder(T, m_x[0], 0, 1e-5, 15);
-    // 3.2 multi rev solutions
-    double tmp = 0.;
-    for (std::vector<double>::size_type i = 1u; i < m_Nmax + 1; ++i) {
-        // 3.2.1 left Householder iterations
-        tmp = std::pow((static_cast<double>(i) * kep3::pi + kep3::pi) / (8.0 * T), 2.0 / 3.0);
-        m_x[2 * i - 1] = (tmp - 1) / (tmp + 1);
-        m_iters[2 * i - 1] = householder(T, m_x[2 * i - 1], static_cast<unsigned>(i), 1e-8, 15);
-        // 3.2.1 right Householder iterations
-        tmp = std::pow((8.0 * T) / (static_cast<double>(i) * kep3::pi), 2.0 / 3.0);
-        m_x[2 * i] = (tmp - 1) / (tmp + 1);
-        m_iters[2ul * i] = householder(T, m_x[2 * i], static_cast<unsigned>(i), 1e-8, 15);
-    }
-
-    // 4 - For each found x value we reconstruct the terminal velocities
-    double const gamma = std::sqrt(m_mu * m_s / 2.0);
-    double const rho = (Rs - Rf) / m_c;
-    double const sigma = std::sqrt(1 - rho * rho);
-    double vrs = 0., vts = 0., vrf = 0., vtf = 0., y = 0.;
-    for (size_t i = 0; i < m_x.size(); ++i) {
-        y = std::sqrt(1.0 - lambda2 + lambda2 * m_x[i] * m_x[i]);
-        vrs = gamma * ((m_lambda * y - m_x[i]) - rho * (m_lambda * y + m_x[i])) / Rs;
-        vrf = -gamma * ((m_lambda * y - m_x[i]) + rho * (m_lambda * y + m_x[i])) / Rf;
-        double const vt = gamma * sigma * (y + m_lambda * m_x[i]);
-        vts = vt / Rs;
-        vtf = vt / Rf;
-        for (auto j = 0lu; j < 3lu; ++j) {
-            m_v0[i][j] = vrs * irs[j] + vts * its[j];
-        }
-        for (auto j = 0lu; j < 3lu; ++j) {
-            m_v1[i][j] = vrf * irf[j] + vtf * itf[j];
-        }
-    }
-}
-
-unsigned lambert_problem::householder(double T, double &x0,
-                                      unsigned N, // NOLINT
-                                      double eps, unsigned iter_max) const
-{
-    unsigned it = 0;
-    double err = 1.0;
-    double xnew = 0.0;
-    double tof = 0.0, delta = 0.0, DT = 0.0, DDT = 0.0, DDDT = 0.0;
-    while ((err > eps) && (it < iter_max)) {
-        x2tof(tof, x0, N);
-        dTdx(DT, DDT, DDDT, x0, tof);
-        delta = tof - T;
-        double const DT2 = DT * DT;
-        xnew = x0 - delta * (DT2 - delta * DDT / 2.0) / (DT * (DT2 - delta * DDT) + DDDT * delta * delta / 6.0);
-        err = std::abs(x0 - xnew);
-        x0 = xnew;
-        it++;
-    }
-    return it;
-}
-
-void lambert_problem::dTdx(double &DT, double &DDT, double &DDDT, double x, double T) const
-{
-    double const l2 = m_lambda * m_lambda;
-    double const l3 = l2 * m_lambda;
-    double const umx2 = 1.0 - x * x;
-    double const y = std::sqrt(1.0 - l2 * umx2);
-    double const y2 = y * y;
-    double const y3 = y2 * y;
-    DT = 1.0 / umx2 * (3.0 * T * x - 2.0 + 2.0 * l3 * x / y);
-    DDT = 1.0 / umx2 * (3.0 * T + 5.0 * x * DT + 2.0 * (1.0 - l2) * l3 / y3);
-    DDDT = 1.0 / umx2 * (7.0 * x * DDT + 8.0 * DT - 6.0 * (1.0 - l2) * l2 * l3 * x / y3 / y2);
-}
-
-void lambert_problem::x2tof2(double &tof, double x, // NOLINT
-                             unsigned N) const
-{
-    double const a = 1.0 / (1.0 - x * x);
-    if (a > 0) // ellipse
-    {
-        double const alfa = 2.0 * std::acos(x);
-        double beta = 2.0 * std::asin(std::sqrt(m_lambda * m_lambda / a));
-        if (m_lambda < 0.0) {
-            beta = -beta;
-        }
-        tof = ((a * std::sqrt(a) * ((alfa - std::sin(alfa)) - (beta - std::sin(beta)) + 2.0 * kep3::pi * N)) / 2.0);
-    } else {
-        double const alfa = 2.0 * std::acosh(x);
-        double beta = 2.0 * std::asinh(std::sqrt(-m_lambda * m_lambda / a));
-        if (m_lambda < 0.0) {
-            beta = -beta;
-        }
-        tof = (-a * std::sqrt(-a) * ((beta - std::sinh(beta)) - (alfa - std::sinh(alfa))) / 2.0);
-    }
-}
-
-void lambert_problem::x2tof(double &tof, double x, unsigned N) const
-{
-    double const battin = 0.01;
-    double const lagrange = 0.2;
-    double const dist = std::abs(x - 1);
-    if (dist < lagrange && dist > battin) { // We use Lagrange tof expression
-        x2tof2(tof, x, N);
-        return;
-    }
-    double const K = m_lambda * m_lambda;
-    double const E = x * x - 1.0;
-    double const rho = std::abs(E);
-    double const z = std::sqrt(1 + K * E);
-    if (dist < battin) { // We use Battin series tof expression
-        double const eta = z - m_lambda * x;
-        double const S1 = 0.5 * (1.0 - m_lambda - x * eta);
-        double Q = hypergeometricF(S1, 1e-11);
-        Q = 4.0 / 3.0 * Q;
-        tof = (eta * eta * eta * Q + 4.0 * m_lambda * eta) / 2.0 + N * kep3::pi / std::pow(rho, 1.5);
-        return;
-    } else { // We use Lancaster tof expresion
-        double const y = std::sqrt(rho);
-        double const g = x * z - m_lambda * E;
-        double d = 0.0;
-        if (E < 0) {
-            double const l = std::acos(g);
-            d = N * kep3::pi + l;
+    // 3 - We may now find all solutions in x,y (0 rev, then left and right multi rev solutions),
+    // starting from the provided guesses when available.
+    for (std::vector<double>::size_type i = 0u; i < m_x.size(); ++i) {
+        const auto b = static_cast<unsigned>(i);
+        if (i < x_guess.size()) {
+            m_x[i] = x_guess[i];
+            m_iters[i] = detail::lambert_solve_branch_warm(geo, b, m_x[i]);
         } else {
-            double const f = y * (z - m_lambda * x);
-            d = std::log(f + g);
+            m_iters[i] = detail::lambert_solve_branch(geo, b, m_x[i]);
         }
-        tof = (x - m_lambda * z - d / y) / E;
-        return;
     }
-}
 
-double lambert_problem::hypergeometricF(double z, double tol) // NOLINT
-{ // NOLINT
-    double Sj = 1.0;
-    double Cj = 1.0;
-    double err = 1.0;
-    double Cj1 = 0.0;
-    double Sj1 = 0.0;
-    int j = 0;
-    while (err > tol) {
-        Cj1 = Cj * (3.0 + j) * (1.0 + j) / (2.5 + j) * z / (j + 1);
-        Sj1 = Sj + Cj1;
-        err = std::abs(Cj1);
-        Sj = Sj1;
-        Cj = Cj1;
-        j = j + 1;
+    // 4 - For each found x value we reconstruct the terminal velocities
+    for (size_t i = 0; i < m_x.size(); ++i) {
+        detail::lambert_velocities(geo, m_mu, m_x[i], m_v0[i].data(), m_v1[i].data());
     }
-    return Sj;
 }
 
 /// Gets velocity at r1
@@ -399,6 +213,120 @@ unsigned lambert_problem::get_Nmax() const
     return m_Nmax;
 }
 
+std::pair<std::vector<std::array<double, 21>>, std::vector<std::array<double, 21>>>
+lambert_problem::compute_grad() const
+{
+    const auto geo = detail::lambert_setup(m_r0.data(), m_r1.data(), m_tof, m_mu, m_cw);
+    std::vector<std::array<double, 21>> dv0(m_x.size()), dv1(m_x.size());
+    for (decltype(m_x.size()) b = 0u; b < m_x.size(); ++b) {
+        // Solution b lies on the branch with (b + 1) / 2 revolutions.
+        const auto N = static_cast<unsigned>((b + 1u) / 2u);
+        detail::lambert_jacobians(geo, m_r0.data(), m_r1.data(), m_tof, m_mu, m_x[b], N, dv0[b].data(),
+                                  dv1[b].data());
+    }
+    return {dv0, dv1};
+}
+
+std::tuple<std::array<double, 3>, std::array<double, 3>, unsigned>
+lambert_0rev(const std::array<double, 3> &r0, const std::array<double, 3> &r1, double tof, double mu, bool cw)
+{
+    if (tof <= 0) {
+        throw std::domain_error("lambert_0rev: Time of flight is negative!");
+    }
+    if (mu <= 0) {
+        throw std::domain_error("lambert_0rev: Gravity parameter is zero or negative!");
+    }
+    const auto geo = detail::lambert_setup(r0.data(), r1.data(), tof, mu, cw);
+    double x = 0.;
+    const auto iters = detail::lambert_solve_branch(geo, 0u, x);
+    std::array<double, 3> v0{}, v1{};
+    detail::lambert_velocities(geo, mu, x, v0.data(), v1.data());
+    return {v0, v1, iters};
+}
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+void lambert_batch(std::span<const double> r0s, std::span<const double> r1s, std::span<const double> tofs,
+                   std::span<const double> mus, std::span<const bool> cws, std::span<double> v0s,
+                   std::span<double> v1s, std::span<unsigned> iters, unsigned multi_revs)
+{
+    // 0 - Sanity checks on the buffer sizes.
+    const auto N = tofs.size();
+    const auto n_sol = static_cast<std::size_t>(multi_revs) * 2u + 1u;
+    if (r0s.size() != 3u * N || r1s.size() != 3u * N) {
+        throw std::invalid_argument(fmt::format("lambert_batch: the positions must have size 3N = {}, while r0s "
+                                                "has size {} and r1s has size {}",
+                                                3u * N, r0s.size(), r1s.size()));
+    }
+    if ((mus.size() != N && mus.size() != 1u) || (cws.size() != N && cws.size() != 1u)) {
+        throw std::invalid_argument(fmt::format("lambert_batch: mus and cws must have size N = {} or 1, while they "
+                                                "have size {} and {}",
+                                                N, mus.size(), cws.size()));
+    }
+    if (v0s.size() != 3u * n_sol * N || v1s.size() != 3u * n_sol * N) {
+        throw std::invalid_argument(fmt::format("lambert_batch: the velocities must have size 3N(2*multi_revs+1) = "
+                                                "{}, while v0s has size {} and v1s has size {}",
+                                                3u * n_sol * N, v0s.size(), v1s.size()));
+    }
+    if (!iters.empty() && iters.size() != n_sol * N) {
+        throw std::invalid_argument(fmt::format("lambert_batch: the iterations must have size N(2*multi_revs+1) = "
+                                                "{} (or be empty), while it has size {}",
+                                                n_sol * N, iters.size()));
+    }
+
+    // 1 - Sanity checks on the data.
+    for (std::size_t i = 0u; i < N; ++i) {
+        if (tofs[i] <= 0) {
+            throw std::domain_error(fmt::format("lambert_batch: Time of flight is negative for problem {}!", i));
+        }
+        if ((mus.size() == 1u ? mus[0] : mus[i]) <= 0) {
+            throw std::domain_error(
+                fmt::format("lambert_batch: Gravity parameter is zero or negative for problem {}!", i));
+        }
+    }
+
+    // 2 - Only the single revolution solutions are requested, we use the vectorized kernel.
+    if (multi_revs == 0u) {
+        detail::lambert_0rev_simd(N, r0s.data(), r1s.data(), tofs.data(), mus.data(), mus.size() == 1u ? 0u : 1u,
+                                  cws.data(), cws.size() == 1u ? 0u : 1u, v0s.data(), v1s.data(),
+                                  iters.empty() ? nullptr : iters.data());
+        return;
+    }
+
+    // 3 - We loop over the problems, no allocation takes place in here.
+    for (std::size_t i = 0u; i < N; ++i) {
+        const double tof = tofs[i];
+        const double mu = mus.size() == 1u ? mus[0] : mus[i];
+        const bool cw = cws.size() == 1u ? cws[0] : cws[i];
+        const auto geo = detail::lambert_setup(r0s.data() + 3u * i, r1s.data() + 3u * i, tof, mu, cw);
+        const auto Nmax = detail::lambert_nmax(geo.T, geo.lambda, multi_revs);
+
+        double *v0 = v0s.data() + 3u * n_sol * i;
+        double *v1 = v1s.data() + 3u * n_sol * i;
+        unsigned *it = iters.empty() ? nullptr : iters.data() + n_sol * i;
+
+        // The solutions on each branch, with the same kernel as kep3::lambert_problem.
+        for (unsigned b = 0u; b < n_sol; ++b) {
+            if ((b + 1u) / 2u <= Nmax) {
+                double x = 0.;
+                const auto it_b = detail::lambert_solve_branch(geo, b, x);
+                detail::lambert_velocities(geo, mu, x, v0 + 3u * b, v1 + 3u * b);
+                if (it != nullptr) {
+                    it[b] = it_b;
+                }
+            } else {
+                // No solution exists for this number of revolutions.
+                for (auto k = 0u; k < 3u; ++k) {
+                    v0[3u * b + k] = std::numeric_limits<double>::quiet_NaN();
+                    v1[3u * b + k] = std::numeric_limits<double>::quiet_NaN();
+                }
+                if (it != nullptr) {
+                    it[b] = 0u;
+                }
+            }
+        }
+    }
+}
+
 /// Streaming operator
 std::ostream &operator<<(std::ostream &s, const lambert_problem &lp)
 {
@@ -0,0 +1,167 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include <kep3/detail/lambert_kernels.hpp>
+
+// On x86 GCC-like compilers we compile the lane kernel several times for different
+// instruction sets and pick the best one at runtime. Elsewhere we only have the default build.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KEP3_LAMBERT_SIMD_DISPATCH
+#endif
+
+namespace kep3::detail
+{
+
+namespace
+{
+
+// Solves the zero revolution Lambert problems in groups of W lanes. Only the Householder update
+// (the derivatives of the time of flight and the step) is written branch free across the lanes
+// so that it can be vectorized by the compiler, while lanes that have already converged are masked
+// and keep their value of x. The geometry, the initial guess, the time of flight (which needs
+// transcendental functions and switches between expressions) and the velocities are evaluated lane
+// by lane and dominate the cost, so the gain over the scalar loop is modest (about 10-15%).
+// The sequence of operations in each lane is the same as in kep3::lambert_problem.
+template <std::size_t W>
+inline void lambert_0rev_lanes(std::size_t n, const double *r0s, const double *r1s, const double *tofs,
+                               const double *mus, std::size_t mu_stride, const bool *cws, std::size_t cw_stride,
+                               double *v0s, double *v1s, unsigned *iters)
+{
+    constexpr double eps = 1e-5;
+    constexpr unsigned iter_max = 15u;
+
+    std::array<lambert_geometry, W> geo{};
+    std::array<double, W> mu{}, lambda{}, T{}, x{}, tof{}, err{};
+    std::array<unsigned, W> it{};
+
+    for (std::size_t base = 0u; base < n; base += W) {
+        const auto n_lanes = std::min(W, n - base);
+        // 1 - Geometry and initial guesses. Lanes past the end replicate the last problem.
+        for (std::size_t l = 0u; l < W; ++l) {
+            const auto i = base + std::min(l, n_lanes - 1u);
+            mu[l] = mus[i * mu_stride];
+            geo[l] = lambert_setup(r0s + 3u * i, r1s + 3u * i, tofs[i], mu[l], cws[i * cw_stride]);
+            lambda[l] = geo[l].lambda;
+            T[l] = geo[l].T;
+            x[l] = lambert_x0_guess(T[l], lambda[l]);
+            err[l] = 1.;
+            it[l] = 0u;
+        }
+        // 2 - Householder iterations in lockstep.
+        for (unsigned k = 0u; k < iter_max; ++k) {
+            bool any_active = false;
+            for (std::size_t l = 0u; l < W; ++l) {
+                any_active = any_active || (err[l] > eps);
+            }
+            if (!any_active) {
+                break;
+            }
+            for (std::size_t l = 0u; l < W; ++l) {
+                if (err[l] > eps) {
+                    lambert_x2tof(tof[l], x[l], 0u, lambda[l]);
+                } else {
+                    // Converged lanes see a zero residual.
+                    tof[l] = T[l];
+                }
+            }
+            for (std::size_t l = 0u; l < W; ++l) {
+                double DT = 0., DDT = 0., DDDT = 0.;
+                lambert_dTdx(DT, DDT, DDDT, x[l], tof[l], lambda[l]);
+                const double delta = tof[l] - T[l];
+                const double DT2 = DT * DT;
+                const double xnew = x[l]
+                                    - delta * (DT2 - delta * DDT / 2.0)
+                                          / (DT * (DT2 - delta * DDT) + DDDT * delta * delta / 6.0);
+                const bool active = err[l] > eps;
+                err[l] = active ? std::abs(x[l] - xnew) : err[l];
+                x[l] = active ? xnew : x[l];
+                it[l] += active ? 1u : 0u;
+            }
+        }
+        // 3 - Terminal velocities.
+        for (std::size_t l = 0u; l < n_lanes; ++l) {
+            lambert_velocities(geo[l], mu[l], x[l], v0s + 3u * (base + l), v1s + 3u * (base + l));
+            if (iters != nullptr) {
+                iters[base + l] = it[l];
+            }
+        }
+    }
+}
+
+using lambert_0rev_fptr_t = void (*)(std::size_t, const double *, const double *, const double *, const double *,
+                                     std::size_t, const bool *, std::size_t, double *, double *, unsigned *);
+
+#if defined(KEP3_LAMBERT_SIMD_DISPATCH)
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+__attribute__((target("avx512f"), flatten)) void lambert_0rev_avx512(std::size_t n, const double *r0s,
+                                                                      const double *r1s, const double *tofs,
+                                                                      const double *mus, std::size_t mu_stride,
+                                                                      const bool *cws, std::size_t cw_stride,
+                                                                      double *v0s, double *v1s, unsigned *iters)
+{
+    lambert_0rev_lanes<8>(n, r0s, r1s, tofs, mus, mu_stride, cws, cw_stride, v0s, v1s, iters);
+}
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+__attribute__((target("avx2,fma"), flatten)) void lambert_0rev_avx2(std::size_t n, const double *r0s,
+                                                                     const double *r1s, const double *tofs,
+                                                                     const double *mus, std::size_t mu_stride,
+                                                                     const bool *cws, std::size_t cw_stride,
+                                                                     double *v0s, double *v1s, unsigned *iters)
+{
+    lambert_0rev_lanes<4>(n, r0s, r1s, tofs, mus, mu_stride, cws, cw_stride, v0s, v1s, iters);
+}
+
+#endif
+
+// Portable fallback on 2 lanes (the only kernel outside x86 GCC-like builds, still benefits from SSE2/NEON).
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+void lambert_0rev_default(std::size_t n, const double *r0s, const double *r1s, const double *tofs, const double *mus,
+                          std::size_t mu_stride, const bool *cws, std::size_t cw_stride, double *v0s, double *v1s,
+                          unsigned *iters)
+{
+    lambert_0rev_lanes<2>(n, r0s, r1s, tofs, mus, mu_stride, cws, cw_stride, v0s, v1s, iters);
+}
+
+lambert_0rev_fptr_t lambert_0rev_select()
+{
+#if defined(KEP3_LAMBERT_SIMD_DISPATCH)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return &lambert_0rev_avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return &lambert_0rev_avx2;
+    }
+#endif
+    return &lambert_0rev_default;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+void lambert_0rev_simd(std::size_t n, const double *r0s, const double *r1s, const double *tofs, const double *mus,
+                       std::size_t mu_stride, const bool *cws, std::size_t cw_stride, double *v0s, double *v1s,
+                       unsigned *iters)
+{
+    // The kernel is selected once, at the first call.
+    static const auto fptr = lambert_0rev_select();
+    fptr(n, r0s, r1s, tofs, mus, mu_stride, cws, cw_stride, v0s, v1s, iters);
+}
+
+} // namespace kep3::detail
+
+#undef KEP3_LAMBERT_SIMD_DISPATCH
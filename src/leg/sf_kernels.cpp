@@ -0,0 +1,219 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+#include <kep3/core_astro/propagate_lagrangian.hpp>
+#include <kep3/detail/sf_kernels.hpp>
+
+namespace kep3::detail
+{
+
+void sf_grad_buffers::reserve(unsigned nseg)
+{
+    if (nseg <= m_nseg && !m_M.empty()) {
+        return;
+    }
+    const auto n = static_cast<std::size_t>(nseg);
+    m_M.resize(n + 1u);
+    m_Mc.resize(n + 1u);
+    m_f.resize(n + 1u);
+    m_m.resize(n + 1u);
+    m_throttles.resize(3u * n);
+    m_dts.resize(n);
+    m_nseg = nseg;
+}
+
+namespace
+{
+
+// Performs the state updates for nseg impulses starting from rvs, ms and computes the gradients, see sf_grad_fwd().
+// a is 1 / veff, or -1 / veff for a backward half leg.
+void sf_grad_impulses(sf_grad_buffers &buf, const double *throttles, const double *dts, unsigned nseg,
+                      // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+                      const std::array<std::array<double, 3>, 2> &rvs, double ms, double max_thrust, double a,
+                      double mu, std::array<double, 49> &grad_rvm, double *grad)
+{
+    const std::size_t n_cols = 4u * nseg;
+    std::fill(grad, grad + 7u * n_cols, 0.);
+    grad_rvm.fill(0.);
+
+    // Corner case: nseg is zero
+    if (nseg == 0u) {
+        for (auto i = 0u; i < 7u; ++i) {
+            grad_rvm[8u * i] = 1.;
+        }
+        return;
+    }
+    buf.reserve(nseg);
+    auto &m = buf.m_m;
+    auto &M = buf.m_M;
+    auto &Mc = buf.m_Mc;
+    auto &f = buf.m_f;
+
+    // 1 - We compute the mass schedule
+    m[0] = ms;
+    for (decltype(nseg) i = 0u; i < nseg; ++i) {
+        const double *u = throttles + 3u * i;
+        const double un = std::sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+        m[i + 1u] = m[i] * std::exp(-(max_thrust * dts[i]) / m[i] * un * a);
+    }
+
+    // 2 - We compute the various STMs
+    std::array<std::array<double, 3>, 2> rv_it(rvs);
+    for (decltype(nseg) i = 0u; i < nseg + 1u; ++i) {
+        const double dur = 0.5 * ((i == 0u ? 0. : dts[i - 1u]) + (i == nseg ? 0. : dts[i]));
+        auto [rv_new, M_it] = kep3::propagate_lagrangian(rv_it, dur, mu, true);
+        rv_it = rv_new;
+        assert(M_it);
+        // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+        M[i] = *M_it;
+        f[i] = kep_dyn(rv_it, mu);
+        // And add the impulse if needed
+        if (i < nseg) {
+            for (auto j = 0u; j < 3u; ++j) {
+                rv_it[1][j] += max_thrust * dts[i] / m[i] * throttles[3u * i + j];
+            }
+        }
+    }
+    // Mc will contain [Mn@..@M0,Mn@..@M1, Mn]
+    Mc[nseg] = M[nseg];
+    for (auto i = nseg; i-- > 0u;) {
+        mat66_dot(Mc[i + 1u], M[i], Mc[i]);
+    }
+    // The sensitivities of the final state to the duration of each propagation: Mc[i+1] @ f[i] (f[nseg] for the last).
+    // We store them in place of f.
+    for (decltype(nseg) i = 0u; i < nseg; ++i) {
+        std::array<double, 6> g{};
+        mat61_axpy(1., Mc[i + 1u], f[i], g);
+        f[i] = g;
+    }
+
+    // 3 - We now need to apply the chain rule to assemble the gradients we want (i.e. not w.r.t DV but w.r.t. u etc...)
+    // The impulse Dv_i = c_i / m_i u_i, with c_i = T dts_i, enters the final state through Mc[i+1] @ Iv (the velocity
+    // columns of Mc[i+1]), and its gradient w.r.t. [throttles, ms, dts] is:
+    // dDv_i = c_i / m_i du_i - c_i / m_i^2 u_i^T dm_i + T / m_i u_i^T ddts_i.
+    // The masses follow m_{i+1} = m_i exp(-|Dv_i| a), hence:
+    // dm_{i+1} = alpha_i dm_i + beta_i u_i^T du_i + gamma_i ddts_i,
+    // with alpha_i = m_{i+1} a c_i / m_i^2 |u_i| + m_{i+1} / m_i, beta_i = -m_{i+1} a c_i / m_i / |u_i| and
+    // gamma_i = -m_{i+1} a T / m_i |u_i|. Each dts_i also lengthens the propagations before and after the impulse by
+    // half its value.
+    // Rather than propagating the dense rows dm_i forward (quadratic in nseg), we sweep backward once accumulating
+    // the adjoint lambda_i = sum_{k > i} w_k alpha_{i+1} ... alpha_{k-1}, where w_k = -c_k / m_k^2 Mc[k+1] @ Iv @ u_k
+    // is the sensitivity of the final state to m_k (extended with the final mass, w_nseg = [0, 0, 0, 0, 0, 0, 1]).
+    // lambda_i is the sensitivity of the final state and mass to m_{i+1}.
+    std::array<double, 7> lambda{0., 0., 0., 0., 0., 0., 1.};
+    for (auto i = nseg; i-- > 0u;) {
+        const double *u = throttles + 3u * i;
+        const double un = std::sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+        const double c = max_thrust * dts[i];
+        const double k_u = c / m[i], k_m = c / m[i] / m[i], k_t = max_thrust / m[i];
+        const double ma = m[i + 1u] * a;
+        const double alpha = ma * k_m * un + m[i + 1u] / m[i];
+        // NOTE: the norm is not differentiable for null throttles, we take the zero subgradient.
+        const double beta = (un > 0.) ? -ma * k_u / un : 0.;
+        const double gamma = -ma * k_t * un;
+        const auto &Mci = Mc[i + 1u];
+        // Mc[i+1] @ Iv @ u_i
+        std::array<double, 6> Mu{};
+        for (auto r = 0u; r < 6u; ++r) {
+            Mu[r] = Mci[6u * r + 3u] * u[0] + Mci[6u * r + 4u] * u[1] + Mci[6u * r + 5u] * u[2];
+        }
+        for (auto r = 0u; r < 7u; ++r) {
+            // a) The throttles u_i: directly through Dv_i and through the masses that follow.
+            for (auto j = 0u; j < 3u; ++j) {
+                grad[r * n_cols + 3u * i + j] = (r < 6u ? k_u * Mci[6u * r + 3u + j] : 0.) + lambda[r] * beta * u[j];
+            }
+            // b) The duration dts_i: through the propagations, through Dv_i and through the masses that follow.
+            grad[r * n_cols + 3u * nseg + i]
+                = (r < 6u ? 0.5 * (f[i][r] + f[i + 1u][r]) + k_t * Mu[r] : 0.) + lambda[r] * gamma;
+            // c) lambda_{i-1} = w_i + alpha_i lambda_i
+            lambda[r] = (r < 6u ? -k_m * Mu[r] : 0.) + alpha * lambda[r];
+        }
+    }
+    // At the end of the sweep lambda is the sensitivity to m_0 = ms.
+
+    // 4 - The gradient w.r.t. the initial conditions.
+    for (auto r = 0u; r < 6u; ++r) {
+        for (auto j = 0u; j < 6u; ++j) {
+            grad_rvm[7u * r + j] = Mc[0][6u * r + j];
+        }
+        grad_rvm[7u * r + 6u] = lambda[r];
+    }
+    grad_rvm[48] = lambda[6];
+}
+
+} // namespace
+
+void sf_grad_fwd(sf_grad_buffers &buf, const double *throttles, const double *dts, unsigned nseg,
+                 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+                 const std::array<std::array<double, 3>, 2> &rvs, double ms, double max_thrust, double veff, double mu,
+                 std::array<double, 49> &grad_rvm, double *grad)
+{
+    sf_grad_impulses(buf, throttles, dts, nseg, rvs, ms, max_thrust, 1. / veff, mu, grad_rvm, grad);
+}
+
+void sf_grad_bck(sf_grad_buffers &buf, const double *throttles, const double *dts, unsigned nseg,
+                 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+                 const std::array<std::array<double, 3>, 2> &rvf_orig, double mf, double max_thrust, double veff,
+                 double mu, std::array<double, 49> &grad_rvm, double *grad)
+{
+    buf.reserve(nseg);
+
+    // 1) we invert the starting velocity.
+    auto rvf = rvf_orig;
+    rvf[1][0] = -rvf[1][0];
+    rvf[1][1] = -rvf[1][1];
+    rvf[1][2] = -rvf[1][2];
+
+    // 2) we reverse the throttles ([1,2,3,4,5,6] -> [4,5,6,1,2,3]) and the durations
+    for (decltype(nseg) i = 0u; i < nseg; ++i) {
+        std::copy(throttles + 3u * i, throttles + 3u * i + 3u, buf.m_throttles.begin() + 3 * (nseg - 1u - i));
+    }
+    std::reverse_copy(dts, dts + nseg, buf.m_dts.begin());
+
+    // 3) We reverse the veff, hence veff (a = 1/veff), and 4) we then compute gradients as if this was a forward leg
+    sf_grad_impulses(buf, buf.m_throttles.data(), buf.m_dts.data(), nseg, rvf, mf, max_thrust, -1. / veff, mu,
+                     grad_rvm, grad);
+
+    // 5) We have computed dxf/dxs, dxf/dus and dxf/ddts, but the initial and final velocites (and us) had their
+    // sign inverted! We thus need to account for that and change sign once again of the relevant entries.
+    // We also must account for changes in the mass equation (now -a)
+    for (auto r = 0u; r < 7u; ++r) {
+        for (auto j = 0u; j < 7u; ++j) {
+            // dvf/dall, dmc/drs and dmc/dmf
+            if ((r >= 3u && r < 6u) != (j < 3u || j == 6u)) {
+                grad_rvm[7u * r + j] = -grad_rvm[7u * r + j];
+            }
+        }
+    }
+    const std::size_t n_cols = 4u * nseg;
+    for (auto r = 0u; r < 7u; ++r) {
+        double *row = grad + r * n_cols;
+        // dvf/dall and dmc/dus
+        for (std::size_t j = 0u; j < n_cols; ++j) {
+            if ((r >= 3u && r < 6u) != (j < 3u * nseg)) {
+                row[j] = -row[j];
+            }
+        }
+        // 6) Note that the throttles and the durations are ordered in reverse. Before returning we must restore the
+        // forward order
+        for (decltype(nseg) i = 0u; i < nseg / 2u; ++i) {
+            std::swap_ranges(row + 3u * i, row + 3u * i + 3u, row + 3u * (nseg - 1u - i));
+        }
+        std::reverse(row + 3u * nseg, row + n_cols);
+    }
+}
+
+} // namespace kep3::detail
@@ -8,39 +8,31 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cmath>
 #include <cstddef>
 #include <iterator>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <tuple>
 #include <vector>
 
-#include <boost/range/algorithm.hpp>
-
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 
-#include <xtensor/containers/xarray.hpp>
-#include <xtensor/containers/xadapt.hpp>
-#include <xtensor/generators/xbuilder.hpp>
-#include <xtensor/io/xio.hpp>
-#include <xtensor/core/xmath.hpp>
-#include <xtensor/views/xview.hpp>
-
 #include <kep3/core_astro/constants.hpp>
 #include <kep3/core_astro/propagate_lagrangian.hpp>
+#include <kep3/detail/sf_kernels.hpp>
 #include <kep3/epoch.hpp>
 #include <kep3/leg/sf_checks.hpp>
 #include <kep3/leg/sims_flanagan.hpp>
-#include <kep3/linalg.hpp>
 
 namespace kep3::leg
 {
 
-using kep3::linalg::_dot;
-using kep3::linalg::mat13;
-using kep3::linalg::mat61;
-using kep3::linalg::mat63;
-using kep3::linalg::mat66;
-
 // Constructors
 sims_flanagan::sims_flanagan(const std::array<std::array<double, 3>, 2> &rvs, double ms,
                              const std::vector<double> &throttles,
@@ -269,252 +261,74 @@ std::vector<double> sims_flanagan::compute_throttle_constraints() const
     return retval;
 }
 
-mat61 _dyn(std::array<std::array<double, 3>, 2> rv, double mu)
-{
-    mat61 retval;
-    auto R3 = std::pow(rv[0][0] * rv[0][0] + rv[0][1] * rv[0][1] + rv[0][2] * rv[0][2], 1.5);
-    retval(0, 0) = rv[1][0];
-    retval(1, 0) = rv[1][1];
-    retval(2, 0) = rv[1][2];
-    retval(3, 0) = -mu / R3 * rv[0][0];
-    retval(4, 0) = -mu / R3 * rv[0][1];
-    retval(5, 0) = -mu / R3 * rv[0][2];
-    return retval;
-}
-
-// Performs the state updates for nseg sarting from rvs, ms. Computes all gradient information
-std::pair<std::array<double, 49>, std::vector<double>> sims_flanagan::gradients_multiple_impulses(
-    std::vector<double>::const_iterator th1, std::vector<double>::const_iterator th2,
-    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-    const std::array<std::array<double, 3>, 2> &rvs, double ms, double c, double a, double dt) const
-{
-    assert(std::distance(th1, th2) % 3 == 0u);
-    auto nseg = static_cast<unsigned>(std::distance(th1, th2) / 3u);
-
-    // Corner case: nseg is zero
-    if (nseg == 0) {
-        std::array<double, 49> grad_rvm{}; // The mismatch constraints gradient w.r.t. extended state r,v,m
-        auto xgrad_rvm = xt::adapt(grad_rvm, {7u, 7u});
-        xgrad_rvm = xt::eye(7);
-        std::vector<double> grad(7, 0.); // The mismatch constraints gradient w.r.t. throttles (0 in this case) and tof
-        return std::make_pair(grad_rvm, std::move(grad));
-    }
-    // Allocate memory.
-    std::vector<mat13> u(nseg);
-    std::vector<xt::xarray<double>> du(nseg, xt::zeros<double>({3u, nseg * 3u + 2u}));
-    std::vector<double> m(nseg + 1, 0.);
-    std::vector<xt::xarray<double>> dm(nseg + 1u, xt::zeros<double>({1u, nseg * 3u + 2u}));
-    xt::xarray<double> dtof = xt::zeros<double>({1u, nseg * 3u + 2u});
-    std::vector<mat13> Dv(nseg);
-    std::vector<xt::xarray<double>> dDv(nseg, xt::zeros<double>({3u, nseg * 3u + 2u}));
-    std::vector<mat66> M(nseg + 1);  // The STMs
-    std::vector<mat66> Mc(nseg + 1); // Mc will contain [Mn@..@M0,Mn@..@M1, Mn]
-    std::vector<mat61> f(nseg + 1, xt::zeros<double>({6u, 1u}));
-    // Initialize values
-    m[0] = ms;
-    unsigned i_tmp = 0u;
-    for (auto it = th1; it != th2; it += 3) {
-        u[i_tmp](0, 0) = *it;
-        u[i_tmp](0, 1) = *(it + 1);
-        u[i_tmp](0, 2) = *(it + 2);
-        du[i_tmp](0, 3 * i_tmp) = 1.;
-        du[i_tmp](1, 3 * i_tmp + 1) = 1.;
-        du[i_tmp](2, 3 * i_tmp + 2) = 1.;
-        i_tmp++;
-    }
-    dm[0](0, nseg * 3u) = 1.;
-    dtof(0, nseg * 3u + 1) = 1.;
-    // 1 - We compute the mass schedule and related gradients
-    for (decltype(nseg) i = 0; i < nseg; ++i) {
-        Dv[i] = c / m[i] * u[i];
-        double un = std::sqrt(u[i](0, 0) * u[i](0, 0) + u[i](0, 1) * u[i](0, 1) + u[i](0, 2) * u[i](0, 2));
-        double Dvn = c / m[i] * un;
-        dDv[i] = c / m[i] * du[i] - c / m[i] / m[i] * xt::linalg::dot(xt::transpose(u[i]), dm[i])
-                 + m_max_thrust / m[i] * xt::linalg::dot(xt::transpose(u[i]), dtof) / nseg;
-        auto dDvn = c / m[i] / un * xt::linalg::dot(u[i], du[i]) - c / m[i] / m[i] * un * dm[i]
-                    + m_max_thrust / m[i] * un * dtof / nseg;
-        m[i + 1] = m[i] * std::exp(-Dvn * a);
-        dm[i + 1] = -m[i + 1] * a * dDvn + std::exp(-Dvn * a) * dm[i];
-    }
-    // 2 - We compute the various STMs
-    std::array<std::array<double, 3>, 2> rv_it(rvs);
-    std::optional<std::array<double, 36>> M_it;
-    for (decltype(nseg) i = 0; i < nseg + 1; ++i) {
-        auto dur = dt;
-        if (i == 0 || i == nseg) {
-            dur = dt / 2;
-        }
-
-        std::tie(rv_it, M_it) = kep3::propagate_lagrangian(rv_it, dur, m_mu, true);
-        // Now we have the STM in M_it, but its a vector, we must operate on an xtensor object instead.
-        assert(M_it);
-        // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
-        M[i] = xt::adapt(*M_it, {6, 6});
-        f[i] = _dyn(rv_it, m_mu);
-        // And add the impulse if needed
-        if (i < nseg) {
-            rv_it[1][0] += Dv[i](0, 0);
-            rv_it[1][1] += Dv[i](0, 1);
-            rv_it[1][2] += Dv[i](0, 2);
-        }
-    }
-
-    // 3 - We now need to apply the chain rule to assemble the gradients we want (i.e. not w.r.t DV but w.r.t. u etc...)
-    mat63 Iv = xt::zeros<double>({6u, 3u}); // This is the gradient of x (rv) w.r.t. v
-    Iv(3, 0) = 1.;
-    Iv(4, 1) = 1.;
-    Iv(5, 2) = 1.;
-    Mc[nseg] = M[nseg]; // Mc will contain [Mn@..@M0,Mn@..@M1, Mn]
-    for (decltype(nseg) i = 1; i < nseg + 1; ++i) {
-        Mc[nseg - i] = _dot(Mc[nseg - i + 1], M[nseg - i]);
-    }
-    // grad_tof./
-    // First the d/dtof term - example: (0.5 * f3 + M3 @ f2 + M3 @ M2 @ f1 + 0.5 * M3 @ M2 @ M1 @ f0) / N
-
-    mat61 grad_tof = 0.5 * f[nseg];
-    for (decltype(nseg) i = 0; i + 1 < nseg; ++i) { // i+1 < nseg avoids overflow
-        grad_tof += _dot(Mc[i + 2], f[i + 1]);
-    }
-
-    grad_tof += 0.5 * _dot(Mc[1], f[0]);
-    grad_tof /= nseg;
-    // Then we add the d/Dvi * dDvi/dtof - example: M3 @ Iv @ dDv2 + M3 @ M2 @ Iv @ dDv1 + M3 @ M2 @ M1 @ Iv @ dDv0
-    for (decltype(nseg) i = 0; i < nseg; ++i) {
-        grad_tof += xt::linalg::dot(_dot(Mc[i + 1], Iv),
-                                    xt::eval(xt::view(dDv[i], xt::all(), xt::range(nseg * 3 + 1, nseg * 3 + 2))));
-    }
-    // grad_u
-    xt::xarray<double> grad_u = xt::zeros<double>({6u, nseg * 3u});
-    for (decltype(nseg) i = 0u; i < nseg; ++i) {
-        grad_u += xt::linalg::dot(_dot(Mc[i + 1], Iv), xt::eval(xt::view(dDv[i], xt::all(), xt::range(0, nseg * 3))));
-    }
-    // grad_ms
-    xt::xarray<double> grad_ms = xt::zeros<double>({6u, 1u});
-    for (decltype(nseg) i = 0u; i < nseg; ++i) {
-        grad_ms += xt::linalg::dot(_dot(Mc[i + 1], Iv),
-                                   xt::eval(xt::view(dDv[i], xt::all(), xt::range(nseg * 3, nseg * 3 + 1))));
-    }
-    // grad_xs
-    mat66 grad_xs = Mc[0];
-
-    // Allocate the return values
-    std::array<double, 49> grad_rvm{}; // The mismatch constraints gradient w.r.t. extended state r,v,m
-    std::vector<double> grad((nseg * 3lu + 1) * 7,
-                             0.); // The mismatch constraints gradient w.r.t. throttles and tof
-    // Copying in the computed derivatives
-    // a) xgrad (the xtensor gradient w.r.t. throttles and tof)
-    auto xgrad_rvm = xt::adapt(grad_rvm, {7u, 7u});
-    auto xgrad = xt::adapt(grad, {7u, nseg * 3 + 1u});
-    xt::view(xgrad, xt::range(0u, 6u), xt::range(0u, nseg * 3u)) = grad_u;
-    xt::view(xgrad, xt::range(0u, 6u), xt::range(nseg * 3, nseg * 3 + 1)) = grad_tof;
-    xt::view(xgrad, xt::range(6u, 7u), xt::all()) = xt::view(dm[nseg], xt::all(), xt::range(0u, nseg * 3 + 1));
-    // At this point since the variable order is u,m,tof we have put dmf/dms in rather than dms/dtof. So we fix this.
-    xgrad(6u, nseg * 3) = dm[nseg](0, nseg * 3 + 1);
-    // b) xgrad_rvm (the xtensor gradient w.r.t. the initial conditions)
-    xt::view(xgrad_rvm, xt::range(0, 6), xt::range(0, 6)) = grad_xs;
-    xt::view(xgrad_rvm, xt::range(0, 6), xt::range(6, 7)) = grad_ms;
-    xgrad_rvm(6, 6) = dm[nseg](0, nseg * 3);
-    return std::make_pair(grad_rvm, std::move(grad));
-}
+sims_flanagan::workspace::workspace() = default;
 
-std::pair<std::array<double, 49>, std::vector<double>>
-sims_flanagan::gradients_fwd(std::vector<double>::const_iterator th1, std::vector<double>::const_iterator th2,
-                             // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-                             const std::array<std::array<double, 3>, 2> &rvs, double ms, double c, double a,
-                             double dt) const
+sims_flanagan::workspace::workspace(unsigned nseg)
 {
-    return gradients_multiple_impulses(th1, th2, rvs, ms, c, a, dt);
+    reserve(nseg);
 }
 
-std::pair<std::array<double, 49>, std::vector<double>>
-sims_flanagan::gradients_bck(std::vector<double>::const_iterator th1, std::vector<double>::const_iterator th2,
-                             // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-                             const std::array<std::array<double, 3>, 2> &rvf_orig, double mf, double c, double a,
-                             double dt) const
-{
-    // 1) we invert the starting velocity.
-    auto rvf = rvf_orig;
-    rvf[1][0] = -rvf[1][0];
-    rvf[1][1] = -rvf[1][1];
-    rvf[1][2] = -rvf[1][2];
-
-    // 2) we reverse the throttles ([1,2,3,4,5,6] -> [4,5,6,1,2,3])
-    auto size = static_cast<unsigned>(std::distance(th1, th2));
-    // Create a new vector to store the reversed values three by three.
-    // Here we allocate a vector. Might be not necessary using the C++ range library?
-    std::vector<double> reversed_throttles(size);
-    // Iterate in reverse order with a step of three
-    for (decltype(size) i = 0u, j = size - 1; i < size; i += 3, j -= 3) {
-        // Copy three elements at a time in reverse order
-        reversed_throttles[j - 2] = *(th1 + i);
-        reversed_throttles[j - 1] = *(th1 + i + 1);
-        reversed_throttles[j] = *(th1 + i + 2);
-    }
-
-    // 3) We reverse the veff, hence veff (a = 1/veff)
-    a = -a;
-
-    // 4) We then compute gradients as if this was a forward leg
-    auto [grad_rvm, grad]
-        = gradients_multiple_impulses(reversed_throttles.begin(), reversed_throttles.end(), rvf, mf, c, a, dt);
-    // 5) We have computed dxf/dxs and dxf/dus, but the initial and final velocites (and us) had their sign
-    // inverted! We thus need to account for that and change sign once again of the relevant entries.
-    // We also must account for changes in the mass equation (now -a)
-    auto xgrad_rvm = xt::adapt(grad_rvm, {7u, 7u});
-    xt::view(xgrad_rvm, xt::range(3, 6), xt::all()) *= -1; // dvf/dall
-    xt::view(xgrad_rvm, xt::all(), xt::range(0, 3)) *= -1; // dmc/drs
-    xt::view(xgrad_rvm, xt::all(), xt::range(6, 7)) *= -1; // dmc/dmf
-
-    auto xgrad = xt::adapt(grad, {7u, size + 1u});
-    xt::view(xgrad, xt::range(3, 6), xt::all()) *= -1;    // dvf/dall
-    xt::view(xgrad, xt::all(), xt::range(0, size)) *= -1; // dmc/dus
-
-    // 6) Note that the throttles in xgrad are ordered in reverse. Before returning we must restore the forward order
-    xt::view(xgrad, xt::all(), xt::range(0, size)) = xt::flip(xt::view(xgrad, xt::all(), xt::range(0, size)), 1);
-    for (decltype(size) i = 0u; i < size / 3; ++i) {
-        xt::view(xgrad, xt::all(), xt::range(3 * i, 3 * i + 3))
-            = xt::flip(xt::view(xgrad, xt::all(), xt::range(3 * i, 3 * i + 3)), 1);
+void sims_flanagan::workspace::reserve(unsigned nseg)
+{
+    if (nseg <= m_nseg && !m_dts.empty()) {
+        return;
     }
-    // And finally return.
-    return std::make_pair(grad_rvm, std::move(grad));
+    const auto n = static_cast<std::size_t>(nseg);
+    m_buf.reserve(nseg);
+    m_dts.resize(n);
+    m_grad_fwd.resize(7u * 4u * n);
+    m_grad_bck.resize(7u * 4u * n);
+    m_grad.resize(7u * (3u * n + 1u));
+    m_nseg = nseg;
 }
 
 // Computes the gradient of the mismatch constraints w.r.t. xs, xf and [throttles, tof]
 std::tuple<std::array<double, 49>, std::array<double, 49>, std::vector<double>> sims_flanagan::compute_mc_grad() const
 {
-    // Preliminaries
-    const auto dt = m_tof / static_cast<double>(m_nseg); // dt
-    const auto c = m_max_thrust * dt;                    // T*tof/nseg
-    const auto a = 1. / m_veff;                // 1/veff
+    workspace ws(m_nseg);
+    std::tuple<std::array<double, 49>, std::array<double, 49>, std::vector<double>> retval;
+    auto &[grad_rvms, grad_rvmf, grad] = retval;
+    grad.resize(static_cast<std::size_t>(7) * (m_nseg * 3u + 1u));
+    compute_mc_grad(ws, grad_rvms, grad_rvmf, grad);
+    return retval;
+}
+
+void sims_flanagan::compute_mc_grad(workspace &ws, std::array<double, 49> &grad_rvms,
+                                    std::array<double, 49> &grad_rvmf, std::span<double> grad) const
+{
+    const std::size_t n_cols = m_nseg * 3u + 1u;
+    if (grad.size() != 7u * n_cols) {
+        throw std::invalid_argument(
+            fmt::format("The gradient of the mismatch constraints of a sims_flanagan leg with {} segments must have "
+                        "size {}, while a buffer of size {} was passed",
+                        m_nseg, 7u * n_cols, grad.size()));
+    }
+    ws.reserve(m_nseg);
+
+    // All the segments last tof / nseg.
+    std::fill(ws.m_dts.begin(), ws.m_dts.begin() + m_nseg, m_tof / static_cast<double>(m_nseg));
 
     // We compute for the forward half-leg: dxf/dxs and dxf/dxu (the gradients w.r.t. initial state ant throttles )
-    auto [grad_rvm, grad_fwd]
-        = gradients_fwd(m_throttles.begin(), m_throttles.begin() + static_cast<unsigned>(3 * m_nseg_fwd), get_rvs(),
-                        get_ms(), c, a, dt);
+    kep3::detail::sf_grad_fwd(ws.m_buf, m_throttles.data(), ws.m_dts.data(), m_nseg_fwd, get_rvs(), get_ms(),
+                              m_max_thrust, m_veff, m_mu, grad_rvms, ws.m_grad_fwd.data());
     // We compute for the backward half-leg: dxf/dxs and dxf/dxu (the gradients w.r.t. final state and throttles )
-    auto [grad_rvm_bck, grad_bck] = gradients_bck(m_throttles.begin() + static_cast<unsigned>(3 * m_nseg_fwd),
-                                                  m_throttles.end(), get_rvf(), get_mf(), c, a, dt);
+    kep3::detail::sf_grad_bck(ws.m_buf, m_throttles.data() + 3u * m_nseg_fwd, ws.m_dts.data(), m_nseg_bck, get_rvf(),
+                              get_mf(), m_max_thrust, m_veff, m_mu, grad_rvmf, ws.m_grad_bck.data());
 
     // We assemble the final results
-    std::vector<double> grad_final(static_cast<size_t>(7) * (m_nseg * 3u + 1u), 0.);
-    auto xgrad_final = xt::adapt(grad_final, {7u, static_cast<unsigned>(m_nseg) * 3u + 1u});
-    auto xgrad_fwd = xt::adapt(grad_fwd, {7u, static_cast<unsigned>(m_nseg_fwd) * 3u + 1u});
-    auto xgrad_bck = xt::adapt(grad_bck, {7u, static_cast<unsigned>(m_nseg - m_nseg_fwd) * 3u + 1u});
-
-    // Copy the gradient w.r.t. the forward throttles as is
-    xt::view(xgrad_final, xt::all(), xt::range(0, m_nseg_fwd * 3))
-        = xt::view(xgrad_fwd, xt::all(), xt::range(0, m_nseg_fwd * 3));
-
-    // Copy the gradient w.r.t. the backward throttles as is
-    xt::view(xgrad_final, xt::all(), xt::range(m_nseg_fwd * 3, m_nseg * 3))
-        = xt::view(xgrad_bck, xt::all(), xt::range(0, (m_nseg - m_nseg_fwd) * 3));
-
-    // Copy the gradient w.r.t. tof as fwd-bck
-    xt::view(xgrad_final, xt::all(), xt::range(m_nseg * 3, m_nseg * 3 + 1))
-        = xt::view(xgrad_fwd, xt::all(), xt::range(m_nseg_fwd * 3, m_nseg_fwd * 3 + 1)) / m_nseg * m_nseg_fwd
-          - xt::view(xgrad_bck, xt::all(), xt::range((m_nseg - m_nseg_fwd) * 3, (m_nseg - m_nseg_fwd) * 3 + 1)) / m_nseg
-                * (m_nseg - m_nseg_fwd);
-    return {grad_rvm, grad_rvm_bck, std::move(grad_final)};
+    const std::size_t n_fwd = 4u * m_nseg_fwd, n_bck = 4u * m_nseg_bck;
+    for (auto r = 0u; r < 7u; ++r) {
+        const double *row_fwd = ws.m_grad_fwd.data() + r * n_fwd;
+        const double *row_bck = ws.m_grad_bck.data() + r * n_bck;
+        double *row = grad.data() + r * n_cols;
+        // Copy the gradient w.r.t. the forward and backward throttles as is
+        std::copy(row_fwd, row_fwd + 3u * m_nseg_fwd, row);
+        std::copy(row_bck, row_bck + 3u * m_nseg_bck, row + 3u * m_nseg_fwd);
+        // The gradient w.r.t. tof is fwd-bck, each segment duration being tof / nseg
+        const double dtof_fwd = std::accumulate(row_fwd + 3u * m_nseg_fwd, row_fwd + n_fwd, 0.);
+        const double dtof_bck = std::accumulate(row_bck + 3u * m_nseg_bck, row_bck + n_bck, 0.);
+        row[3u * m_nseg] = (dtof_fwd - dtof_bck) / m_nseg;
+    }
 }
 
 std::vector<double> sims_flanagan::compute_tc_grad() const
@@ -528,6 +342,83 @@ std::vector<double> sims_flanagan::compute_tc_grad() const
     return retval;
 }
 
+// The rows are the mismatch (7) and throttle (nseg) constraints, the columns are xs (7), the throttles (3 nseg), xf (7)
+// and the tof.
+sparsity_pattern sims_flanagan::get_grad_sparsity() const
+{
+    const std::size_t n_thr = 3u * m_nseg, col_xf = 7u + n_thr, col_tof = col_xf + 7u;
+    sparsity_pattern retval;
+    retval.reserve(get_grad_nnz());
+    // The position and velocity mismatches depend on all the variables.
+    for (std::size_t r = 0u; r < 6u; ++r) {
+        for (std::size_t j = 0u; j <= col_tof; ++j) {
+            retval.emplace_back(r, j);
+        }
+    }
+    // The mass mismatch does not depend on the positions and velocities.
+    retval.emplace_back(6u, 6u);
+    for (std::size_t j = 7u; j < col_xf; ++j) {
+        retval.emplace_back(6u, j);
+    }
+    retval.emplace_back(6u, col_xf + 6u);
+    retval.emplace_back(6u, col_tof);
+    // Each throttle constraint depends on the throttles of its segment.
+    for (std::size_t j = 0u; j < n_thr; ++j) {
+        retval.emplace_back(7u + j / 3u, 7u + j);
+    }
+    return retval;
+}
+
+// The 6 position and velocity rows are dense (3 nseg + 15 columns), the mass row depends on the throttles, ms, mf
+// and the tof (3 nseg + 3 columns) and each throttle constraint on the 3 throttles of its segment.
+std::size_t sims_flanagan::get_grad_nnz() const
+{
+    return 24u * static_cast<std::size_t>(m_nseg) + 93u;
+}
+
+std::vector<double> sims_flanagan::compute_grad_sparse() const
+{
+    workspace ws(m_nseg);
+    std::vector<double> retval(get_grad_nnz());
+    compute_grad_sparse(ws, retval);
+    return retval;
+}
+
+void sims_flanagan::compute_grad_sparse(workspace &ws, std::span<double> values) const
+{
+    const std::size_t n_thr = 3u * m_nseg, nnz = get_grad_nnz();
+    if (values.size() != nnz) {
+        throw std::invalid_argument(
+            fmt::format("The sparse gradient of the constraints of a sims_flanagan leg with {} segments must have "
+                        "size {}, while a buffer of size {} was passed",
+                        m_nseg, nnz, values.size()));
+    }
+    ws.reserve(m_nseg);
+
+    std::array<double, 49> grad_rvms{}, grad_rvmf{};
+    const std::span<double> grad(ws.m_grad.data(), 7u * (n_thr + 1u));
+    compute_mc_grad(ws, grad_rvms, grad_rvmf, grad);
+
+    // We scatter the dense blocks following get_grad_sparsity().
+    auto *out = values.data();
+    for (auto r = 0u; r < 6u; ++r) {
+        const double *row = grad.data() + r * (n_thr + 1u);
+        out = std::copy(grad_rvms.data() + 7u * r, grad_rvms.data() + 7u * r + 7u, out);
+        out = std::copy(row, row + n_thr, out);
+        out = std::copy(grad_rvmf.data() + 7u * r, grad_rvmf.data() + 7u * r + 7u, out);
+        *out++ = row[n_thr];
+    }
+    const double *row_m = grad.data() + 6u * (n_thr + 1u);
+    *out++ = grad_rvms[48];
+    out = std::copy(row_m, row_m + n_thr, out);
+    *out++ = grad_rvmf[48];
+    *out++ = row_m[n_thr];
+    for (std::size_t j = 0u; j < n_thr; ++j) {
+        *out++ = 2. * m_throttles[j];
+    }
+    assert(out == values.data() + nnz);
+}
+
 std::ostream &operator<<(std::ostream &s, const sims_flanagan &sf)
 {
     s << fmt::format("Number of segments: {}\n", sf.get_nseg());
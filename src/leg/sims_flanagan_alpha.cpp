@@ -8,9 +8,13 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstddef>
 #include <fmt/base.h>
 #include <iterator>
+#include <tuple>
 #include <vector>
 
 #include <boost/range/algorithm.hpp>
@@ -18,28 +22,16 @@
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 
-#include <xtensor/containers/xarray.hpp>
-#include <xtensor/containers/xarray.hpp>
-#include <xtensor/generators/xbuilder.hpp>
-#include <xtensor/io/xio.hpp>
-#include <xtensor/core/xmath.hpp>
-#include <xtensor/views/xview.hpp>
-
 #include <kep3/core_astro/constants.hpp>
 #include <kep3/core_astro/propagate_lagrangian.hpp>
+#include <kep3/detail/sf_kernels.hpp>
 #include <kep3/epoch.hpp>
 #include <kep3/leg/sf_checks.hpp>
 #include <kep3/leg/sims_flanagan_alpha.hpp>
-#include <kep3/linalg.hpp>
 
 namespace kep3::leg
 {
 
-using kep3::linalg::mat13;
-using kep3::linalg::mat61;
-using kep3::linalg::mat63;
-using kep3::linalg::mat66;
-
 // Constructors
 sims_flanagan_alpha::sims_flanagan_alpha(const std::array<std::array<double, 3>, 2> &rvs, double ms,
                              // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
@@ -318,6 +310,57 @@ std::vector<double> sims_flanagan_alpha::compute_throttle_constraints() const
     return retval;
 }
 
+// Computes the gradient of the mismatch constraints w.r.t. xs, xf and [throttles, talphas, tof]
+std::tuple<std::array<double, 49>, std::array<double, 49>, std::vector<double>>
+sims_flanagan_alpha::compute_mc_grad() const
+{
+    kep3::leg::_check_talphas(m_talphas, m_nseg);
+    kep3::detail::sf_grad_buffers buf;
+
+    // We compute for the forward half-leg: dxf/dxs and dxf/dxu (the gradients w.r.t. initial state, throttles and
+    // talphas)
+    std::array<double, 49> grad_rvms{};
+    std::vector<double> grad_fwd(7u * 4u * static_cast<std::size_t>(m_nseg_fwd));
+    kep3::detail::sf_grad_fwd(buf, m_throttles.data(), m_talphas.data(), m_nseg_fwd, get_rvs(), get_ms(), m_max_thrust,
+                              m_veff, m_mu, grad_rvms, grad_fwd.data());
+    // We compute for the backward half-leg: dxf/dxs and dxf/dxu (the gradients w.r.t. final state, throttles and
+    // talphas)
+    std::array<double, 49> grad_rvmf{};
+    std::vector<double> grad_bck(7u * 4u * static_cast<std::size_t>(m_nseg_bck));
+    kep3::detail::sf_grad_bck(buf, m_throttles.data() + 3u * m_nseg_fwd, m_talphas.data() + m_nseg_fwd, m_nseg_bck,
+                              get_rvf(), get_mf(), m_max_thrust, m_veff, m_mu, grad_rvmf, grad_bck.data());
+
+    // We assemble the final results
+    const std::size_t n_cols = 4u * m_nseg + 1u, n_fwd = 4u * m_nseg_fwd, n_bck = 4u * m_nseg_bck;
+    std::vector<double> grad(7u * n_cols, 0.);
+    for (auto r = 0u; r < 7u; ++r) {
+        const double *row_fwd = grad_fwd.data() + r * n_fwd;
+        const double *row_bck = grad_bck.data() + r * n_bck;
+        double *row = grad.data() + r * n_cols;
+        // Copy the gradient w.r.t. the forward and backward throttles as is
+        std::copy(row_fwd, row_fwd + 3u * m_nseg_fwd, row);
+        std::copy(row_bck, row_bck + 3u * m_nseg_bck, row + 3u * m_nseg_fwd);
+        // Copy the gradient w.r.t. the talphas as fwd, -bck
+        std::copy(row_fwd + 3u * m_nseg_fwd, row_fwd + n_fwd, row + 3u * m_nseg);
+        std::transform(row_bck + 3u * m_nseg_bck, row_bck + n_bck, row + 3u * m_nseg + m_nseg_fwd,
+                       [](double x) { return -x; });
+    }
+    // NOTE: the mismatch does not depend on the tof, as the segment durations are the talphas. We keep its (zero)
+    // column so that the layout mirrors that of sims_flanagan.
+    return {grad_rvms, grad_rvmf, std::move(grad)};
+}
+
+std::vector<double> sims_flanagan_alpha::compute_tc_grad() const
+{
+    std::vector<double> retval(static_cast<size_t>(m_nseg) * m_nseg * 3u, 0);
+    for (decltype(m_throttles.size()) i = 0u; i < m_nseg; ++i) {
+        retval[i * m_nseg * 3 + 3 * i] = 2 * m_throttles[3 * i];
+        retval[i * m_nseg * 3 + 3 * i + 1] = 2 * m_throttles[3 * i + 1];
+        retval[i * m_nseg * 3 + 3 * i + 2] = 2 * m_throttles[3 * i + 2];
+    }
+    return retval;
+}
+
 std::ostream &operator<<(std::ostream &s, const sims_flanagan_alpha &sf)
 {
     s << fmt::format("Number of segments: {}\n", sf.get_nseg());
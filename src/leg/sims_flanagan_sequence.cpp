@@ -0,0 +1,390 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+
+#include <kep3/core_astro/constants.hpp>
+#include <kep3/exceptions.hpp>
+#include <kep3/leg/sims_flanagan.hpp>
+#include <kep3/leg/sims_flanagan_sequence.hpp>
+#include <kep3/leg/sparsity.hpp>
+#include <kep3/planet.hpp>
+
+namespace kep3::leg
+{
+
+namespace
+{
+
+// The number of nonzeros of the Jacobian of the mismatch constraints of the leg i (with nseg segments) w.r.t. x.
+// The position and velocity mismatches depend on t0, on the tofs of the previous legs, on the initial mass (the
+// final mass of the previous leg) and on the whole block of the leg. The mass mismatch only depends on the masses,
+// the throttles and the tof of the leg.
+std::size_t mc_nnz(std::size_t i, std::size_t nseg)
+{
+    const std::size_t n_rv = 3u * nseg + 9u + (i > 0u ? i + 1u : 0u);
+    const std::size_t n_m = 3u * nseg + 2u + (i > 0u ? 1u : 0u);
+    return 6u * n_rv + n_m;
+}
+
+// The acceleration of a planet at an epoch (MJD2000). The udplas not implementing it (e.g. SPICE ephemerides
+// without a central body) fall back to central differences of the velocities, with a step of a few minutes
+// (accurate to a relative 1e-6 for orbital periods above about ten days).
+std::array<double, 3> node_acc(const kep3::planet &pla, double mjd2000)
+{
+    try {
+        return pla.acc(mjd2000);
+    } catch (const kep3::not_implemented_error &) {
+    }
+    constexpr double h = 2e-3;
+    const auto vp = pla.eph(mjd2000 + h)[1];
+    const auto vm = pla.eph(mjd2000 - h)[1];
+    std::array<double, 3> retval{};
+    for (auto k = 0u; k < 3u; ++k) {
+        retval[k] = (vp[k] - vm[k]) / (2. * h * kep3::DAY2SEC);
+    }
+    return retval;
+}
+
+} // namespace
+
+sims_flanagan_sequence::sims_flanagan_sequence()
+    : sims_flanagan_sequence({kep3::planet{}, kep3::planet{}}, {2u}, 1., 1., 1., 1.)
+{
+}
+
+sims_flanagan_sequence::sims_flanagan_sequence(const std::vector<kep3::planet> &seq,
+                                               const std::vector<unsigned> &nsegs, double ms, double max_thrust,
+                                               // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+                                               double veff, double mu, double cut)
+    : m_seq(seq), m_ms(ms)
+{
+    if (m_seq.size() < 2u) {
+        throw std::invalid_argument(fmt::format(
+            "A sims_flanagan_sequence needs at least two planets, while {} were passed", m_seq.size()));
+    }
+    if (nsegs.size() + 1u != m_seq.size()) {
+        throw std::invalid_argument(fmt::format("A sims_flanagan_sequence of {} planets needs the number of segments "
+                                                "of {} legs, while {} were passed",
+                                                m_seq.size(), m_seq.size() - 1u, nsegs.size()));
+    }
+    if (std::ranges::find(nsegs, 0u) != nsegs.end()) {
+        throw std::invalid_argument(
+            fmt::format("The legs of a sims_flanagan_sequence need at least one segment, while {} was passed", nsegs));
+    }
+
+    const std::array<std::array<double, 3>, 2> rv{{{1., 0., 0.}, {0., 1., 0.}}};
+    m_x_offset.push_back(1u);
+    m_mc_nnz_offset.push_back(0u);
+    m_tc_nnz_offset.push_back(0u);
+    for (decltype(nsegs.size()) i = 0u; i < nsegs.size(); ++i) {
+        // NOTE: the legs are checked here, their states and tofs are set by set_x().
+        m_legs.emplace_back(rv, ms, std::vector<double>(3u * nsegs[i], 0.), rv, ms, 0., max_thrust, veff, mu, cut);
+        m_x_offset.push_back(m_x_offset.back() + 3u * nsegs[i] + 8u);
+        m_mc_nnz_offset.push_back(m_mc_nnz_offset.back() + mc_nnz(i, nsegs[i]));
+        m_tc_nnz_offset.push_back(m_tc_nnz_offset.back() + 3u * nsegs[i]);
+    }
+    // The throttle constraints follow the mismatch constraints.
+    for (auto &off : m_tc_nnz_offset) {
+        off += m_mc_nnz_offset.back();
+    }
+}
+
+void sims_flanagan_sequence::set_x(const std::vector<double> &x)
+{
+    if (x.size() != get_nx()) {
+        throw std::invalid_argument(fmt::format("The decision vector of a sims_flanagan_sequence with {} legs must "
+                                                "have size {}, while a vector of size {} was passed",
+                                                get_nlegs(), get_nx(), x.size()));
+    }
+    const auto n_legs = get_nlegs();
+
+    // The epochs and the ephemerides at the nodes.
+    std::vector<double> epochs(n_legs + 1u);
+    epochs[0] = x[0];
+    for (std::size_t i = 0u; i < n_legs; ++i) {
+        epochs[i + 1u] = epochs[i] + x[m_x_offset[i + 1u] - 1u];
+    }
+    std::vector<std::array<std::array<double, 3>, 2>> rv(n_legs + 1u);
+    for (std::size_t j = 0u; j <= n_legs; ++j) {
+        rv[j] = m_seq[j].eph(epochs[j]);
+    }
+
+    // The legs (on a copy, so that nothing changes if a setter throws).
+    auto legs = m_legs;
+    for (std::size_t i = 0u; i < n_legs; ++i) {
+        const double *xi = x.data() + m_x_offset[i];
+        const auto nseg = legs[i].get_nseg();
+        auto rvs = rv[i], rvf = rv[i + 1u];
+        for (auto k = 0u; k < 3u; ++k) {
+            rvs[1][k] += xi[1u + k];
+            rvf[1][k] += xi[4u + k];
+        }
+        legs[i].set_rvs(rvs);
+        legs[i].set_ms(i == 0u ? m_ms : x[m_x_offset[i - 1u]]);
+        legs[i].set_throttles(x.begin() + static_cast<std::ptrdiff_t>(m_x_offset[i] + 7u),
+                              x.begin() + static_cast<std::ptrdiff_t>(m_x_offset[i] + 7u + 3u * nseg));
+        legs[i].set_rvf(rvf);
+        legs[i].set_mf(xi[0]);
+        legs[i].set_tof(xi[3u * nseg + 7u] * kep3::DAY2SEC);
+    }
+
+    m_legs = std::move(legs);
+    m_x = x;
+    m_epochs = std::move(epochs);
+    m_rv = std::move(rv);
+    // NOTE: the accelerations are only needed by the gradient, they are computed there.
+    m_acc.clear();
+}
+
+const std::vector<kep3::planet> &sims_flanagan_sequence::get_seq() const
+{
+    return m_seq;
+}
+
+double sims_flanagan_sequence::get_ms() const
+{
+    return m_ms;
+}
+
+const std::vector<sims_flanagan> &sims_flanagan_sequence::get_legs() const
+{
+    return m_legs;
+}
+
+std::size_t sims_flanagan_sequence::get_nlegs() const
+{
+    return m_legs.size();
+}
+
+const std::vector<double> &sims_flanagan_sequence::get_x() const
+{
+    return m_x;
+}
+
+const std::vector<double> &sims_flanagan_sequence::get_epochs() const
+{
+    return m_epochs;
+}
+
+std::size_t sims_flanagan_sequence::get_nx() const
+{
+    return m_x_offset.back();
+}
+
+std::size_t sims_flanagan_sequence::get_nec() const
+{
+    return 7u * get_nlegs();
+}
+
+std::size_t sims_flanagan_sequence::get_nic() const
+{
+    return (m_x_offset.back() - 1u - 8u * get_nlegs()) / 3u;
+}
+
+void sims_flanagan_sequence::check_x_set() const
+{
+    if (m_x.empty()) {
+        throw std::logic_error(
+            "The decision vector of the sims_flanagan_sequence has not been set, call set_x() first");
+    }
+}
+
+std::vector<double> sims_flanagan_sequence::compute_constraints() const
+{
+    check_x_set();
+    const auto n_legs = get_nlegs();
+    std::vector<double> retval(get_nec() + get_nic());
+    oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<std::size_t>(0u, n_legs, 1u),
+                              [&](const oneapi::tbb::blocked_range<std::size_t> &range) {
+                                  for (auto i = range.begin(); i != range.end(); ++i) {
+                                      const auto mc = m_legs[i].compute_mismatch_constraints();
+                                      std::ranges::copy(mc, retval.begin() + static_cast<std::ptrdiff_t>(7u * i));
+                                      const auto tc = m_legs[i].compute_throttle_constraints();
+                                      // The throttle constraints of the previous legs, counted from their throttles.
+                                      const auto tc_off = (m_x_offset[i] - 1u - 8u * i) / 3u;
+                                      std::ranges::copy(tc, retval.begin()
+                                                                + static_cast<std::ptrdiff_t>(get_nec() + tc_off));
+                                  }
+                              });
+    return retval;
+}
+
+sparsity_pattern sims_flanagan_sequence::get_grad_sparsity() const
+{
+    const auto n_legs = get_nlegs();
+    sparsity_pattern retval;
+    retval.reserve(get_grad_nnz());
+    // The mismatch constraints (see compute_grad_sparse()).
+    for (std::size_t i = 0u; i < n_legs; ++i) {
+        const std::size_t off = m_x_offset[i], nseg = m_legs[i].get_nseg();
+        for (std::size_t r = 7u * i; r < 7u * i + 6u; ++r) {
+            retval.emplace_back(r, 0u);
+            for (std::size_t k = 0u; k + 1u < i; ++k) {
+                retval.emplace_back(r, m_x_offset[k + 1u] - 1u);
+            }
+            if (i > 0u) {
+                retval.emplace_back(r, m_x_offset[i - 1u]);
+                retval.emplace_back(r, off - 1u);
+            }
+            for (std::size_t j = off; j < off + 3u * nseg + 8u; ++j) {
+                retval.emplace_back(r, j);
+            }
+        }
+        if (i > 0u) {
+            retval.emplace_back(7u * i + 6u, m_x_offset[i - 1u]);
+        }
+        retval.emplace_back(7u * i + 6u, off);
+        for (std::size_t j = off + 7u; j < off + 3u * nseg + 8u; ++j) {
+            retval.emplace_back(7u * i + 6u, j);
+        }
+    }
+    // The throttle constraints.
+    std::size_t r = get_nec();
+    for (std::size_t i = 0u; i < n_legs; ++i) {
+        for (std::size_t s = 0u; s < m_legs[i].get_nseg(); ++s, ++r) {
+            for (std::size_t k = 0u; k < 3u; ++k) {
+                retval.emplace_back(r, m_x_offset[i] + 7u + 3u * s + k);
+            }
+        }
+    }
+    assert(retval.size() == get_grad_nnz());
+    return retval;
+}
+
+std::size_t sims_flanagan_sequence::get_grad_nnz() const
+{
+    return m_tc_nnz_offset.back();
+}
+
+std::vector<double> sims_flanagan_sequence::compute_grad_sparse() const
+{
+    std::vector<double> retval(get_grad_nnz());
+    compute_grad_sparse(retval);
+    return retval;
+}
+
+void sims_flanagan_sequence::compute_grad_sparse(std::span<double> values) const
+{
+    if (values.size() != get_grad_nnz()) {
+        throw std::invalid_argument(
+            fmt::format("The sparse gradient of the constraints of a sims_flanagan_sequence must have size {}, while "
+                        "a buffer of size {} was passed",
+                        get_grad_nnz(), values.size()));
+    }
+    check_x_set();
+    // NOTE: the scratch memory is missing after a deserialization, the workspaces grow on the first call.
+    m_scratch.resize(get_nlegs());
+    // The accelerations of the planets at the nodes, once per decision vector (serially, as the planets may not
+    // support concurrent calls).
+    if (m_acc.empty()) {
+        m_acc.resize(get_nlegs() + 1u);
+        for (std::size_t j = 0u; j <= get_nlegs(); ++j) {
+            m_acc[j] = node_acc(m_seq[j], m_epochs[j]);
+        }
+    }
+
+    oneapi::tbb::parallel_for(
+        oneapi::tbb::blocked_range<std::size_t>(0u, get_nlegs(), 1u),
+        [&](const oneapi::tbb::blocked_range<std::size_t> &range) {
+            for (auto i = range.begin(); i != range.end(); ++i) {
+                const auto &leg = m_legs[i];
+                const std::size_t nseg = leg.get_nseg(), n_thr = 3u * nseg;
+                auto &[ws, grad] = m_scratch[i];
+                grad.resize(7u * (n_thr + 1u));
+                std::array<double, 49> grad_rvms{}, grad_rvmf{};
+                leg.compute_mc_grad(ws, grad_rvms, grad_rvmf, grad);
+
+                // The derivatives w.r.t. the epochs (in days) of the departure and arrival nodes, moving the states
+                // of the planets along their orbits.
+                std::array<double, 7> gs{}, gf{};
+                for (auto r = 0u; r < 7u; ++r) {
+                    for (auto k = 0u; k < 3u; ++k) {
+                        gs[r] += grad_rvms[7u * r + k] * m_rv[i][1][k] + grad_rvms[7u * r + 3u + k] * m_acc[i][k];
+                        gf[r] += grad_rvmf[7u * r + k] * m_rv[i + 1u][1][k]
+                                 + grad_rvmf[7u * r + 3u + k] * m_acc[i + 1u][k];
+                    }
+                    gs[r] *= kep3::DAY2SEC;
+                    gf[r] *= kep3::DAY2SEC;
+                }
+
+                // The mismatch constraints, following get_grad_sparsity(). t0 and the tofs of the previous legs
+                // move both nodes, the tof of the leg moves the arrival node.
+                auto *out = values.data() + m_mc_nnz_offset[i];
+                for (auto r = 0u; r < 6u; ++r) {
+                    const double *row = grad.data() + r * (n_thr + 1u);
+                    *out++ = gs[r] + gf[r];
+                    for (std::size_t k = 0u; k + 1u < i; ++k) {
+                        *out++ = gs[r] + gf[r];
+                    }
+                    if (i > 0u) {
+                        *out++ = grad_rvms[7u * r + 6u];
+                        *out++ = gs[r] + gf[r];
+                    }
+                    *out++ = grad_rvmf[7u * r + 6u];
+                    out = std::copy(grad_rvms.data() + 7u * r + 3u, grad_rvms.data() + 7u * r + 6u, out);
+                    out = std::copy(grad_rvmf.data() + 7u * r + 3u, grad_rvmf.data() + 7u * r + 6u, out);
+                    out = std::copy(row, row + n_thr, out);
+                    *out++ = gf[r] + row[n_thr] * kep3::DAY2SEC;
+                }
+                const double *row_m = grad.data() + 6u * (n_thr + 1u);
+                if (i > 0u) {
+                    *out++ = grad_rvms[48];
+                }
+                *out++ = grad_rvmf[48];
+                out = std::copy(row_m, row_m + n_thr, out);
+                *out++ = row_m[n_thr] * kep3::DAY2SEC;
+                assert(out == values.data() + m_mc_nnz_offset[i + 1u]);
+
+                // The throttle constraints.
+                const auto &throttles = leg.get_throttles();
+                out = values.data() + m_tc_nnz_offset[i];
+                for (std::size_t j = 0u; j < n_thr; ++j) {
+                    *out++ = 2. * throttles[j];
+                }
+            }
+        });
+}
+
+std::ostream &operator<<(std::ostream &s, const sims_flanagan_sequence &sfs)
+{
+    std::vector<std::string> names;
+    for (const auto &pla : sfs.get_seq()) {
+        names.push_back(pla.get_name());
+    }
+    s << fmt::format("Sequence of {} Sims-Flanagan legs: {}\n", sfs.get_nlegs(), names);
+    s << fmt::format("Initial mass: {}\n", sfs.get_ms());
+    if (!sfs.get_x().empty()) {
+        s << fmt::format("Epochs (MJD2000): {}\n", sfs.get_epochs());
+    }
+    std::vector<unsigned> nsegs;
+    for (const auto &leg : sfs.get_legs()) {
+        nsegs.push_back(leg.get_nseg());
+    }
+    s << fmt::format("Number of segments: {}\n", nsegs);
+    return s;
+}
+
+} // namespace kep3::leg
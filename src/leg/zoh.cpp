@@ -11,7 +11,10 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <optional>
+#include <span>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <fmt/core.h>
@@ -305,14 +308,23 @@ zoh::zoh(const std::vector<double> &state0, const std::vector<double> &controls,
          const std::vector<double> &tgrid, double cut,
          const std::pair<heyoka::taylor_adaptive<double>, std::optional<heyoka::taylor_adaptive<double>>> &tas,
          std::optional<unsigned> max_steps, unsigned dim_dynamics, unsigned dim_controls)
+    : zoh(state0, controls, state1, tgrid, cut, ta::ta_handle(tas.first),
+          tas.second ? std::optional<ta::ta_handle>(std::in_place, *tas.second) : std::nullopt, max_steps, dim_dynamics,
+          dim_controls)
+{
+}
+
+zoh::zoh(const std::vector<double> &state0, const std::vector<double> &controls, const std::vector<double> &state1,
+         const std::vector<double> &tgrid, double cut, ta::ta_handle ta, std::optional<ta::ta_handle> ta_var,
+         std::optional<unsigned> max_steps, unsigned dim_dynamics, unsigned dim_controls)
     : m_state0(state0), m_controls(controls), m_state1(state1), m_tgrid(tgrid), m_cut(cut), m_max_steps(max_steps),
-      m_dim_dynamics(dim_dynamics), m_dim_controls(dim_controls), m_ta(tas.first), m_ta_var(tas.second)
+      m_dim_dynamics(dim_dynamics), m_dim_controls(dim_controls), m_ta(std::move(ta)), m_ta_var(std::move(ta_var))
 {
     update_nseg();
     update_ic_var();
     update_pars_no_control();
 
-    const auto &sys = m_ta.get_sys();
+    const auto &sys = m_ta->get_sys();
     std::vector<heyoka::expression> dyn, vars;
     for (const auto &pair : sys) {
         vars.push_back(pair.first);
@@ -415,12 +427,12 @@ std::optional<unsigned> zoh::get_max_steps() const
 
 const heyoka::taylor_adaptive<double> &zoh::get_ta() const
 {
-    return m_ta;
+    return *m_ta;
 }
 
-const std::optional<heyoka::taylor_adaptive<double>> &zoh::get_ta_var() const
+const heyoka::taylor_adaptive<double> *zoh::get_ta_var() const
 {
-    return m_ta_var;
+    return m_ta_var ? m_ta_var->get() : nullptr;
 }
 
 bool zoh::has_ta_var() const
@@ -445,7 +457,7 @@ unsigned zoh::get_nseg_bck() const
 
 std::vector<double> zoh::compute_mismatch_constraints() const
 {
-    auto &ta = m_ta;
+    auto &ta = *m_ta;
 
     // Forward propagation.
     ta.set_time(m_tgrid.front());
@@ -508,20 +520,20 @@ zoh::compute_mc_grad() const
     const auto c = m_dim_controls;
 
     if (d == 7u && c == 4u) {
-        if (m_ta_var->get_dim() != 7u + 7u * 7u + 7u * 4u) {
+        if ((*m_ta_var)->get_dim() != 7u + 7u * 7u + 7u * 4u) {
             throw std::logic_error("zoh::compute_mc_grad() requires ta_var with compatible variational state dimension");
         }
         return compute_mc_grad_fixed_impl<7u, 4u, mat77, mat74, mat71>(
-            *m_ta_var, m_state0, m_controls, m_state1, m_tgrid, m_ic_var, m_pars_no_control, m_max_steps,
+            **m_ta_var, m_state0, m_controls, m_state1, m_tgrid, m_ic_var, m_pars_no_control, m_max_steps,
             m_dyn_cfunc, m_nseg, m_nseg_fwd, m_nseg_bck);
     }
 
     if (d == 6u && c == 2u) {
-        if (m_ta_var->get_dim() != 6u + 6u * 6u + 6u * 2u) {
+        if ((*m_ta_var)->get_dim() != 6u + 6u * 6u + 6u * 2u) {
             throw std::logic_error("zoh::compute_mc_grad() requires ta_var with compatible variational state dimension");
         }
         return compute_mc_grad_fixed_impl<6u, 2u, mat66, mat62, mat61>(
-            *m_ta_var, m_state0, m_controls, m_state1, m_tgrid, m_ic_var, m_pars_no_control, m_max_steps,
+            **m_ta_var, m_state0, m_controls, m_state1, m_tgrid, m_ic_var, m_pars_no_control, m_max_steps,
             m_dyn_cfunc, m_nseg, m_nseg_fwd, m_nseg_bck);
     }
 
@@ -529,6 +541,56 @@ zoh::compute_mc_grad() const
         "zoh::compute_mc_grad() not implemented for dim_dynamics={}, dim_controls={}", d, c));
 }
 
+sparsity_pattern zoh::get_grad_sparsity() const
+{
+    const std::size_t d = m_dim_dynamics;
+    const std::size_t n_cols = 2u * d + static_cast<std::size_t>(m_dim_controls) * m_nseg + m_nseg + 1u;
+    sparsity_pattern retval;
+    retval.reserve(get_grad_nnz());
+    for (std::size_t r = 0u; r < d; ++r) {
+        for (std::size_t j = 0u; j < n_cols; ++j) {
+            retval.emplace_back(r, j);
+        }
+    }
+    return retval;
+}
+
+std::size_t zoh::get_grad_nnz() const
+{
+    const std::size_t d = m_dim_dynamics;
+    return d * (2u * d + static_cast<std::size_t>(m_dim_controls) * m_nseg + m_nseg + 1u);
+}
+
+std::vector<double> zoh::compute_grad_sparse() const
+{
+    std::vector<double> retval(get_grad_nnz());
+    compute_grad_sparse(retval);
+    return retval;
+}
+
+void zoh::compute_grad_sparse(std::span<double> values) const
+{
+    const std::size_t d = m_dim_dynamics, n_u = static_cast<std::size_t>(m_dim_controls) * m_nseg,
+                      n_t = m_nseg + 1u;
+    const std::size_t nnz = get_grad_nnz();
+    if (values.size() != nnz) {
+        throw std::invalid_argument(
+            fmt::format("The sparse gradient of the mismatch constraints of a zoh leg with {} segments must have "
+                        "size {}, while a buffer of size {} was passed",
+                        m_nseg, nnz, values.size()));
+    }
+    const auto [dx0, dx1, du, dtgrid] = compute_mc_grad();
+
+    // We interleave the rows of the dense blocks following get_grad_sparsity().
+    auto *out = values.data();
+    for (std::size_t r = 0u; r < d; ++r) {
+        out = std::copy(dx0.data() + r * d, dx0.data() + (r + 1u) * d, out);
+        out = std::copy(du.data() + r * n_u, du.data() + (r + 1u) * n_u, out);
+        out = std::copy(dx1.data() + r * d, dx1.data() + (r + 1u) * d, out);
+        out = std::copy(dtgrid.data() + r * n_t, dtgrid.data() + (r + 1u) * n_t, out);
+    }
+}
+
 std::tuple<std::vector<std::vector<std::vector<double>>>, std::vector<std::vector<std::vector<double>>>, bool>
 zoh::get_state_info(unsigned N) const
 {
@@ -537,7 +599,7 @@ zoh::get_state_info(unsigned N) const
     }
 
     bool success = true;
-    auto &ta = m_ta;
+    auto &ta = *m_ta;
 
     std::vector<std::vector<std::vector<double>>> state_fwd;
     ta.set_time(m_tgrid.front());
@@ -627,7 +689,7 @@ void zoh::update_ic_var()
 
 void zoh::update_pars_no_control()
 {
-    const auto &pars = m_ta.get_pars();
+    const auto &pars = m_ta->get_pars();
     m_pars_no_control.assign(pars.begin() + static_cast<std::ptrdiff_t>(m_dim_controls), pars.end());
 }
 
@@ -645,16 +707,16 @@ void zoh::sanity_checks() const
         throw std::logic_error("state0/state1 sizes must match dim_dynamics.");
     }
 
-    if (m_ta.get_dim() != m_dim_dynamics) {
+    if (m_ta->get_dim() != m_dim_dynamics) {
         throw std::logic_error(fmt::format("Attempting to construct a zoh leg with a Taylor adaptive integrator state "
                                            "dimension of {}, while {} is required.",
-                                           m_ta.get_dim(), m_dim_dynamics));
+                                           m_ta->get_dim(), m_dim_dynamics));
     }
 
-    if (m_ta.get_pars().size() < m_dim_controls) {
+    if (m_ta->get_pars().size() < m_dim_controls) {
         throw std::logic_error(fmt::format("Attempting to construct a zoh leg with a Taylor adaptive integrator "
                                            "parameters dimension of {}, while >= {} is required.",
-                                           m_ta.get_pars().size(), m_dim_controls));
+                                           m_ta->get_pars().size(), m_dim_controls));
     }
 
     if ((m_controls.size() % m_dim_controls) != 0u) {
@@ -668,12 +730,12 @@ void zoh::sanity_checks() const
 
     if (m_ta_var) {
         const auto expected = m_dim_dynamics + m_dim_dynamics * m_dim_dynamics + m_dim_dynamics * m_dim_controls;
-        if (m_ta_var->get_dim() != expected) {
+        if ((*m_ta_var)->get_dim() != expected) {
             throw std::logic_error(fmt::format("Attempting to construct a zoh leg with a variational Taylor adaptive "
                                                "integrator state dimension of {}, while {} is required.",
-                                               m_ta_var->get_dim(), expected));
+                                               (*m_ta_var)->get_dim(), expected));
         }
-        if (m_ta_var->get_pars().size() != m_ta.get_pars().size()) {
+        if ((*m_ta_var)->get_pars().size() != m_ta->get_pars().size()) {
             throw std::logic_error("The variational and nominal Taylor adaptive integrators for a zoh leg must expose "
                                    "the same number of parameters.");
         }
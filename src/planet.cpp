@@ -10,10 +10,14 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <limits>
+#include <stdexcept>
 
 #include <boost/core/demangle.hpp>
 
+#include <fmt/core.h>
+
 #include <kep3/core_astro/constants.hpp>
 #include <kep3/core_astro/convert_anomalies.hpp>
 #include <kep3/core_astro/ic2par2ic.hpp>
@@ -27,6 +31,15 @@
 namespace kep3::detail
 {
 
+void check_vectorized_output(const char *name, std::size_t n_epochs, std::size_t dim, std::size_t out_size)
+{
+    if (out_size / dim != n_epochs || out_size % dim != 0u) {
+        throw std::invalid_argument(fmt::format("{}: the output must have size {} x {} (the number of epochs), while "
+                                                "it has size {}",
+                                                name, dim, n_epochs, out_size));
+    }
+}
+
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
 double period_from_energy(const std::array<double, 3> &r, const std::array<double, 3> &v, double mu)
 {
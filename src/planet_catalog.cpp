@@ -0,0 +1,232 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+
+#include <kep3/core_astro/constants.hpp>
+#include <kep3/core_astro/convert_anomalies.hpp>
+#include <kep3/detail/perifocal.hpp>
+#include <kep3/epoch.hpp>
+#include <kep3/planet.hpp>
+#include <kep3/planet_catalog.hpp>
+#include <kep3/udpla/keplerian.hpp>
+
+namespace kep3
+{
+
+namespace
+{
+
+// Queries are processed in chunks of this size, using buffers on the stack. The chunks are
+// processed in parallel for queries larger than par_threshold.
+constexpr std::size_t chunk = 256u;
+constexpr std::size_t par_threshold = 4096u;
+
+} // namespace
+
+planet_catalog::planet_catalog() = default;
+
+planet_catalog::planet_catalog(const std::vector<kep3::planet> &planets)
+{
+    for (const auto &pla : planets) {
+        push_back(pla);
+    }
+}
+
+void planet_catalog::push_back(const kep3::udpla::keplerian &udpla)
+{
+    const auto pos_vel = udpla.get_ref_pos_vel();
+    const auto ref_epoch = udpla.get_ref_epoch();
+    const auto d = detail::perifocal_setup(pos_vel, udpla.get_mu_central_body(), ref_epoch.mjd2000());
+
+    m_ref_epoch.push_back(ref_epoch);
+    m_pos_vel_0.push_back(pos_vel);
+    m_name.push_back(udpla.get_name());
+    m_mu_self.push_back(udpla.get_mu_self());
+    m_radius.push_back(udpla.get_radius());
+    m_safe_radius.push_back(udpla.get_safe_radius());
+    for (auto j = 0u; j < 3u; ++j) {
+        m_P[j].push_back(d.P[j]);
+        m_Q[j].push_back(d.Q[j]);
+    }
+    m_a.push_back(d.a);
+    m_ecc.push_back(d.ecc);
+    m_n.push_back(d.n);
+    m_anomaly0.push_back(d.anomaly0);
+    m_ref_mjd2000.push_back(d.ref_mjd2000);
+    m_mu.push_back(d.mu);
+}
+
+void planet_catalog::push_back(const kep3::planet &pla)
+{
+    const auto *udpla = pla.extract<kep3::udpla::keplerian>();
+    if (udpla == nullptr) {
+        throw std::invalid_argument(
+            fmt::format("A planet_catalog can only store Keplerian bodies, while the planet '{}' is not one",
+                        pla.get_name()));
+    }
+    push_back(*udpla);
+}
+
+std::size_t planet_catalog::size() const
+{
+    return m_a.size();
+}
+
+kep3::planet planet_catalog::get_planet(std::size_t i) const
+{
+    if (i >= size()) {
+        throw std::out_of_range(
+            fmt::format("The index {} is out of range for a planet_catalog of size {}", i, size()));
+    }
+    return kep3::planet{kep3::udpla::keplerian{m_ref_epoch[i],
+                                               m_pos_vel_0[i],
+                                               m_mu[i],
+                                               m_name[i],
+                                               {m_mu_self[i], m_radius[i], m_safe_radius[i]}}};
+}
+
+std::string planet_catalog::get_name(std::size_t i) const
+{
+    if (i >= size()) {
+        throw std::out_of_range(
+            fmt::format("The index {} is out of range for a planet_catalog of size {}", i, size()));
+    }
+    return m_name[i];
+}
+
+void planet_catalog::eph_impl(const std::size_t *bodies, std::size_t n, const double *mjd2000s, std::size_t stride,
+                              double *out) const
+{
+    const auto process = [&](std::size_t begin, std::size_t end) {
+        std::array<double, chunk> anomalies{}, eccs{}, E{}, H{};
+        const auto n_c = end - begin;
+        bool hyperbolic = false;
+        // 1 - The mean (or hyperbolic mean) anomalies.
+        for (std::size_t l = 0u; l < n_c; ++l) {
+            const auto b = bodies[begin + l];
+            anomalies[l] = m_anomaly0[b] + m_n[b] * (mjd2000s[(begin + l) * stride] - m_ref_mjd2000[b]) * kep3::DAY2SEC;
+            eccs[l] = m_ecc[b];
+            hyperbolic = hyperbolic || !(m_a[b] > 0.);
+        }
+        // 2 - Kepler's equation, for all the lanes at once. Lanes of the other conic are set to NaN.
+        const std::span<const double> anomalies_s(anomalies.data(), n_c), eccs_s(eccs.data(), n_c);
+        kep3::m2e(anomalies_s, eccs_s, std::span<double>(E.data(), n_c));
+        if (hyperbolic) {
+            kep3::n2h(anomalies_s, eccs_s, std::span<double>(H.data(), n_c));
+        }
+        // 3 - Back to the inertial frame.
+        for (std::size_t l = 0u; l < n_c; ++l) {
+            const auto b = bodies[begin + l];
+            const double a = m_a[b], ecc = eccs[l];
+            double x = 0., y = 0., vx = 0., vy = 0.;
+            if (a > 0.) {
+                const double sinE = std::sin(E[l]), cosE = std::cos(E[l]);
+                const double R = a * (1. - ecc * cosE);
+                const double semi_minor = a * std::sqrt(1. - ecc * ecc);
+                const double sqrt_mu_a = std::sqrt(m_mu[b] * a);
+                x = a * (cosE - ecc);
+                y = semi_minor * sinE;
+                vx = -sqrt_mu_a * sinE / R;
+                vy = sqrt_mu_a * semi_minor / a * cosE / R;
+            } else {
+                const double sinhH = std::sinh(H[l]), coshH = std::cosh(H[l]);
+                const double R = a * (1. - ecc * coshH);
+                const double semi_minor = -a * std::sqrt(ecc * ecc - 1.);
+                const double sqrt_mu_a = std::sqrt(-m_mu[b] * a);
+                x = a * (coshH - ecc);
+                y = semi_minor * sinhH;
+                vx = -sqrt_mu_a * sinhH / R;
+                vy = -sqrt_mu_a * semi_minor / a * coshH / R;
+            }
+            double *o = out + 6u * (begin + l);
+            for (auto j = 0u; j < 3u; ++j) {
+                o[j] = x * m_P[j][b] + y * m_Q[j][b];
+                o[3u + j] = vx * m_P[j][b] + vy * m_Q[j][b];
+            }
+        }
+    };
+
+    // NOTE: the chunks have a fixed size, so that the results do not depend on the scheduling.
+    const auto n_chunks = (n + chunk - 1u) / chunk;
+    if (n < par_threshold) {
+        for (std::size_t c = 0u; c < n_chunks; ++c) {
+            process(c * chunk, std::min(n, (c + 1u) * chunk));
+        }
+    } else {
+        oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<std::size_t>(0u, n_chunks),
+                                  [&](const oneapi::tbb::blocked_range<std::size_t> &range) {
+                                      for (auto c = range.begin(); c != range.end(); ++c) {
+                                          process(c * chunk, std::min(n, (c + 1u) * chunk));
+                                      }
+                                  });
+    }
+}
+
+std::vector<double> planet_catalog::eph_all(double mjd2000) const
+{
+    std::vector<std::size_t> bodies(size());
+    std::iota(bodies.begin(), bodies.end(), std::size_t(0));
+    std::vector<double> retval(6u * size());
+    eph_impl(bodies.data(), bodies.size(), &mjd2000, 0u, retval.data());
+    return retval;
+}
+
+std::vector<double> planet_catalog::eph_all(const kep3::epoch &ep) const
+{
+    return eph_all(ep.mjd2000());
+}
+
+std::vector<double> planet_catalog::eph_subset(const std::vector<std::size_t> &indices,
+                                               const std::vector<double> &mjd2000s) const
+{
+    if (mjd2000s.size() != indices.size() && mjd2000s.size() != 1u) {
+        throw std::invalid_argument(fmt::format("planet_catalog::eph_subset: the epochs must have size K = {} or 1, "
+                                                "while they have size {}",
+                                                indices.size(), mjd2000s.size()));
+    }
+    for (const auto i : indices) {
+        if (i >= size()) {
+            throw std::out_of_range(
+                fmt::format("The index {} is out of range for a planet_catalog of size {}", i, size()));
+        }
+    }
+    std::vector<double> retval(6u * indices.size());
+    eph_impl(indices.data(), indices.size(), mjd2000s.data(), mjd2000s.size() == 1u ? 0u : 1u, retval.data());
+    return retval;
+}
+
+std::ostream &operator<<(std::ostream &os, const planet_catalog &cat)
+{
+    os << fmt::format("Planet catalog of {} Keplerian bodies\n", cat.size());
+    for (std::size_t i = 0u; i < std::min<std::size_t>(cat.size(), 5u); ++i) {
+        os << fmt::format("  {}: {}\n", i, cat.get_name(i));
+    }
+    if (cat.size() > 5u) {
+        os << "  ...\n";
+    }
+    return os;
+}
+
+} // namespace kep3
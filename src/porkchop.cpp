@@ -0,0 +1,116 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include <oneapi/tbb/blocked_range2d.h>
+#include <oneapi/tbb/parallel_for.h>
+
+#include <kep3/core_astro/constants.hpp>
+#include <kep3/detail/lambert_kernels.hpp>
+#include <kep3/planet.hpp>
+#include <kep3/porkchop.hpp>
+
+namespace kep3
+{
+
+porkchop_data porkchop(const planet &pl0, const planet &pl1, const std::vector<double> &t0s,
+                       const std::vector<double> &t1s, unsigned multi_revs, bool cw)
+{
+    // 0 - Sanity checks.
+    const double mu = pl0.get_mu_central_body();
+    if (!(mu > 0.)) {
+        throw std::invalid_argument(fmt::format(
+            "porkchop: the central body parameter of the departure planet must be positive, while it is {}", mu));
+    }
+    if (pl1.get_mu_central_body() != mu) {
+        throw std::invalid_argument(
+            fmt::format("porkchop: the two planets must share the same central body, while their mu are {} and {}",
+                        mu, pl1.get_mu_central_body()));
+    }
+
+    // 1 - The ephemerides, once per grid axis.
+    const auto eph0 = pl0.eph_v(t0s);
+    const auto eph1 = pl1.eph_v(t1s);
+
+    // 2 - Allocate the results.
+    porkchop_data retval;
+    retval.n_dep = t0s.size();
+    retval.n_arr = t1s.size();
+    const auto n_cells = retval.n_dep * retval.n_arr;
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    retval.dv_dep.resize(n_cells, nan);
+    retval.dv_arr.resize(n_cells, nan);
+    retval.c3.resize(n_cells, nan);
+    retval.vinf_dep.resize(3u * n_cells, nan);
+    retval.vinf_arr.resize(3u * n_cells, nan);
+    retval.branch.resize(n_cells, -1);
+
+    // 3 - The Lambert grid. Each cell is independent and only writes to its own slots.
+    oneapi::tbb::parallel_for(
+        oneapi::tbb::blocked_range2d<std::size_t>(0u, retval.n_dep, 0u, retval.n_arr),
+        [&](const oneapi::tbb::blocked_range2d<std::size_t> &range) {
+            std::array<double, 3> v0{}, v1{};
+            for (auto i = range.rows().begin(); i != range.rows().end(); ++i) {
+                const double *rv0 = eph0.data() + 6u * i;
+                for (auto j = range.cols().begin(); j != range.cols().end(); ++j) {
+                    const double tof = (t1s[j] - t0s[i]) * kep3::DAY2SEC;
+                    if (!(tof > 0.)) {
+                        continue;
+                    }
+                    const double *rv1 = eph1.data() + 6u * j;
+                    // NOTE: an ill defined Lambert problem (e.g. both positions in a plane containing the z axis)
+                    // leaves the cell empty rather than aborting the whole grid.
+                    detail::lambert_geometry geo;
+                    try {
+                        geo = detail::lambert_setup(rv0, rv1, tof, mu, cw);
+                    } catch (const std::domain_error &) {
+                        continue;
+                    }
+                    const auto Nmax = detail::lambert_nmax(geo.T, geo.lambda, multi_revs);
+
+                    // We loop over all existing branches and retain the one with the lowest total DV.
+                    const auto cell = retval.n_arr * i + j;
+                    double best = std::numeric_limits<double>::infinity();
+                    for (unsigned b = 0u; b < 2u * Nmax + 1u; ++b) {
+                        double x = 0.;
+                        detail::lambert_solve_branch(geo, b, x);
+                        detail::lambert_velocities(geo, mu, x, v0.data(), v1.data());
+                        const std::array<double, 3> vinf0 = {v0[0] - rv0[3], v0[1] - rv0[4], v0[2] - rv0[5]};
+                        const std::array<double, 3> vinf1 = {v1[0] - rv1[3], v1[1] - rv1[4], v1[2] - rv1[5]};
+                        const double dv0 = std::sqrt(vinf0[0] * vinf0[0] + vinf0[1] * vinf0[1] + vinf0[2] * vinf0[2]);
+                        const double dv1 = std::sqrt(vinf1[0] * vinf1[0] + vinf1[1] * vinf1[1] + vinf1[2] * vinf1[2]);
+                        if (dv0 + dv1 < best) {
+                            best = dv0 + dv1;
+                            retval.dv_dep[cell] = dv0;
+                            retval.dv_arr[cell] = dv1;
+                            retval.c3[cell] = dv0 * dv0;
+                            for (auto k = 0u; k < 3u; ++k) {
+                                retval.vinf_dep[3u * cell + k] = vinf0[k];
+                                retval.vinf_arr[3u * cell + k] = vinf1[k];
+                            }
+                            retval.branch[cell] = static_cast<int>(b);
+                        }
+                    }
+                }
+            }
+        });
+
+    return retval;
+}
+
+} // namespace kep3
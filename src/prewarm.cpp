@@ -0,0 +1,129 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+
+#include <kep3/prewarm.hpp>
+#include <kep3/ta/bcp.hpp>
+#include <kep3/ta/cr3bp.hpp>
+#include <kep3/ta/kep.hpp>
+#include <kep3/ta/pontryagin_cartesian.hpp>
+#include <kep3/ta/pontryagin_equinoctial.hpp>
+#include <kep3/ta/zoh_cr3bp.hpp>
+#include <kep3/ta/zoh_eq.hpp>
+#include <kep3/ta/zoh_kep.hpp>
+#include <kep3/ta/zoh_ss.hpp>
+#include <kep3/udpla/vsop2013.hpp>
+
+namespace kep3
+{
+
+namespace
+{
+
+using prewarm_f = std::function<void(const prewarm_spec &)>;
+
+// The prefix of the VSOP2013 models, followed by the body name.
+const std::string vsop2013_prefix = "vsop2013:";
+
+const std::map<std::string, prewarm_f> &prewarm_table()
+{
+    static const std::map<std::string, prewarm_f> table = {
+        {"kep", [](const prewarm_spec &s) { ta::get_ta_kep(s.tol); }},
+        {"kep_var", [](const prewarm_spec &s) { ta::get_ta_kep_var(s.tol); }},
+        {"cr3bp", [](const prewarm_spec &s) { ta::get_ta_cr3bp(s.tol); }},
+        {"cr3bp_var", [](const prewarm_spec &s) { ta::get_ta_cr3bp_var(s.tol); }},
+        {"bcp", [](const prewarm_spec &s) { ta::get_ta_bcp(s.tol); }},
+        {"bcp_var", [](const prewarm_spec &s) { ta::get_ta_bcp_var(s.tol); }},
+        {"zoh_kep", [](const prewarm_spec &s) { ta::get_ta_zoh_kep(s.tol); }},
+        {"zoh_kep_var", [](const prewarm_spec &s) { ta::get_ta_zoh_kep_var(s.tol); }},
+        {"zoh_eq", [](const prewarm_spec &s) { ta::get_ta_zoh_eq(s.tol); }},
+        {"zoh_eq_var", [](const prewarm_spec &s) { ta::get_ta_zoh_eq_var(s.tol); }},
+        {"zoh_cr3bp", [](const prewarm_spec &s) { ta::get_ta_zoh_cr3bp(s.tol); }},
+        {"zoh_cr3bp_var", [](const prewarm_spec &s) { ta::get_ta_zoh_cr3bp_var(s.tol); }},
+        {"zoh_ss", [](const prewarm_spec &s) { ta::get_ta_zoh_ss(s.tol); }},
+        {"zoh_ss_var", [](const prewarm_spec &s) { ta::get_ta_zoh_ss_var(s.tol); }},
+        {"pc", [](const prewarm_spec &s) { ta::get_ta_pc(s.tol, s.optimality); }},
+        {"pc_var", [](const prewarm_spec &s) { ta::get_ta_pc_var(s.tol, s.optimality); }},
+        {"peq", [](const prewarm_spec &s) { ta::get_ta_peq(s.tol, s.optimality); }},
+        {"peq_var", [](const prewarm_spec &s) { ta::get_ta_peq_var(s.tol, s.optimality); }},
+        {"pc_cfuncs",
+         [](const prewarm_spec &s) {
+             ta::get_pc_H_cfunc(s.optimality);
+             ta::get_pc_SF_cfunc(s.optimality);
+             ta::get_pc_u_cfunc(s.optimality);
+             ta::get_pc_i_vers_cfunc(s.optimality);
+             ta::get_pc_dyn_cfunc(s.optimality);
+         }},
+        {"peq_cfuncs",
+         [](const prewarm_spec &s) {
+             ta::get_peq_H_cfunc(s.optimality);
+             ta::get_peq_SF_cfunc(s.optimality);
+             ta::get_peq_u_cfunc(s.optimality);
+             ta::get_peq_i_vers_cfunc(s.optimality);
+             ta::get_peq_dyn_cfunc(s.optimality);
+         }},
+    };
+    return table;
+}
+
+// The VSOP2013 series are cached by the constructor of the udpla (scalar function) and by its first
+// eph_v call (batch function).
+void prewarm_vsop2013(const prewarm_spec &s)
+{
+    const udpla::vsop2013 pl(s.model.substr(vsop2013_prefix.size()), s.tol);
+    [[maybe_unused]] const auto pos_vel = pl.eph_v(std::vector<double>{0.});
+}
+
+} // namespace
+
+std::vector<double> prewarm(const std::vector<prewarm_spec> &specs)
+{
+    // Resolve all the models first, so that nothing is compiled if one is not known.
+    std::vector<prewarm_f> fs;
+    fs.reserve(specs.size());
+    for (const auto &s : specs) {
+        if (s.model.starts_with(vsop2013_prefix)) {
+            fs.emplace_back(prewarm_vsop2013);
+        } else if (auto it = prewarm_table().find(s.model); it != prewarm_table().end()) {
+            fs.push_back(it->second);
+        } else {
+            throw std::invalid_argument(fmt::format("prewarm: the model '{}' is not known", s.model));
+        }
+    }
+
+    // Each item is a task. The caches compile outside their locks, hence all the items compile
+    // concurrently, except duplicated ones (which wait for the first compilation).
+    std::vector<double> retval(specs.size());
+    oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<std::size_t>(0u, specs.size(), 1u),
+                              [&](const oneapi::tbb::blocked_range<std::size_t> &range) {
+                                  for (auto i = range.begin(); i != range.end(); ++i) {
+                                      const auto start = std::chrono::steady_clock::now();
+                                      fs[i](specs[i]);
+                                      retval[i] = std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                                                                - start)
+                                                      .count();
+                                  }
+                              });
+    return retval;
+}
+
+} // namespace kep3
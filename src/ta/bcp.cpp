@@ -8,8 +8,6 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
-#include <mutex>
-#include <unordered_map>
 #include <vector>
 
 #include <heyoka/config.hpp>
@@ -23,6 +21,8 @@
 #include <heyoka/taylor.hpp>
 
 #include <kep3/core_astro/constants.hpp>
+#include <kep3/detail/jit_cache.hpp>
+#include <kep3/detail/lru_cache.hpp>
 #include <kep3/ta/bcp.hpp>
 
 using heyoka::expression;
@@ -71,62 +71,47 @@ std::vector<std::pair<expression, expression>> bcp_dyn()
 };
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::mutex ta_bcp_mutex;
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::unordered_map<double, taylor_adaptive<double>> ta_bcp_cache;
+kep3::detail::lru_cache<double, taylor_adaptive<double>> ta_bcp_cache("ta_bcp");
 
-const heyoka::taylor_adaptive<double> &get_ta_bcp(double tol)
+heyoka::taylor_adaptive<double> get_ta_bcp(double tol)
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_bcp_mutex);
-
-    // Lookup.
-    if (auto it = ta_bcp_cache.find(tol); it == ta_bcp_cache.end()) {
+    tol = kep3::detail::normalize_tol(tol);
+    return *ta_bcp_cache.get_ptr(tol, [&]() {
         // Cache miss, create new one.
         const std::vector init_state = {1., 1., 1., 1., 1., 1.};
-        auto new_ta = taylor_adaptive<double>{bcp_dyn(), init_state, heyoka::kw::tol = tol};
-        return ta_bcp_cache.insert(std::make_pair(tol, std::move(new_ta))).first->second;
-    } else {
-        // Cache hit, return existing.
-        return it->second;
-    }
+        return kep3::detail::jit_cache_load_or_build<taylor_adaptive<double>>(
+            "ta_bcp", kep3::detail::jit_cache_params(tol),
+            [&]() { return taylor_adaptive<double>{bcp_dyn(), init_state, heyoka::kw::tol = tol}; });
+    });
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::mutex ta_bcp_var_mutex;
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::unordered_map<double, taylor_adaptive<double>> ta_bcp_var_cache;
+kep3::detail::lru_cache<double, taylor_adaptive<double>> ta_bcp_var_cache("ta_bcp_var");
 
-const heyoka::taylor_adaptive<double> &get_ta_bcp_var(double tol)
+heyoka::taylor_adaptive<double> get_ta_bcp_var(double tol)
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_bcp_var_mutex);
-
-    // Lookup.
-    if (auto it = ta_bcp_var_cache.find(tol); it == ta_bcp_var_cache.end()) {
+    tol = kep3::detail::normalize_tol(tol);
+    return *ta_bcp_var_cache.get_ptr(tol, [&]() {
         auto [x, y, z, vx, vy, vz] = make_vars("x", "y", "z", "vx", "vy", "vz");
         auto vsys = var_ode_sys(bcp_dyn(), {x, y, z, vx, vy, vz}, 1);
         // Cache miss, create new one.
         const std::vector init_state = {1., 1., 1., 1., 1., 1.};
-        auto new_ta = taylor_adaptive<double>{vsys, init_state, heyoka::kw::tol = tol, heyoka::kw::compact_mode = true};
-        return ta_bcp_var_cache.insert(std::make_pair(tol, std::move(new_ta))).first->second;
-    } else {
-        // Cache hit, return existing.
-        return it->second;
-    }
+        return kep3::detail::jit_cache_load_or_build<taylor_adaptive<double>>(
+            "ta_bcp_var", kep3::detail::jit_cache_params(tol),
+            [&]() {
+                return taylor_adaptive<double>{vsys, init_state, heyoka::kw::tol = tol,
+                                               heyoka::kw::compact_mode = true};
+            });
+    });
 }
 
 size_t get_ta_bcp_cache_dim()
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_bcp_mutex);
     return ta_bcp_cache.size();
 }
 
 size_t get_ta_bcp_var_cache_dim()
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_bcp_mutex);
     return ta_bcp_var_cache.size();
 }
 
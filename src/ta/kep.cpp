@@ -9,8 +9,6 @@
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include <heyoka/kw.hpp>
-#include <mutex>
-#include <unordered_map>
 #include <vector>
 
 #include <heyoka/config.hpp>
@@ -23,6 +21,8 @@
 #include <heyoka/taylor.hpp>
 
 #include <kep3/core_astro/constants.hpp>
+#include <kep3/detail/jit_cache.hpp>
+#include <kep3/detail/lru_cache.hpp>
 #include <kep3/ta/kep.hpp>
 
 using heyoka::expression;
@@ -58,63 +58,49 @@ std::vector<std::pair<expression, expression>> kep_dyn()
 };
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::mutex ta_kep_mutex;
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::unordered_map<double, taylor_adaptive<double>> ta_kep_cache;
+kep3::detail::lru_cache<double, taylor_adaptive<double>> ta_kep_cache("ta_kep");
 
-const heyoka::taylor_adaptive<double> &get_ta_kep(double tol)
+heyoka::taylor_adaptive<double> get_ta_kep(double tol)
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_kep_mutex);
-
-    // Lookup.
-    if (auto it = ta_kep_cache.find(tol); it == ta_kep_cache.end()) {
+    tol = kep3::detail::normalize_tol(tol);
+    return *ta_kep_cache.get_ptr(tol, [&]() {
         // Cache miss, create new one.
         const std::vector init_state = {1., 1., 1., 1., 1., 1.};
-        auto new_ta = taylor_adaptive<double>{kep_dyn(), init_state, heyoka::kw::tol = tol, heyoka::kw::pars = {1.}};
-        return ta_kep_cache.insert(std::make_pair(tol, std::move(new_ta))).first->second;
-    } else {
-        // Cache hit, return existing.
-        return it->second;
-    }
+        return kep3::detail::jit_cache_load_or_build<taylor_adaptive<double>>(
+            "ta_kep", kep3::detail::jit_cache_params(tol),
+            [&]() {
+                return taylor_adaptive<double>{kep_dyn(), init_state, heyoka::kw::tol = tol, heyoka::kw::pars = {1.}};
+            });
+    });
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::mutex ta_kep_var_mutex;
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::unordered_map<double, taylor_adaptive<double>> ta_kep_var_cache;
+kep3::detail::lru_cache<double, taylor_adaptive<double>> ta_kep_var_cache("ta_kep_var");
 
-const heyoka::taylor_adaptive<double> &get_ta_kep_var(double tol)
+heyoka::taylor_adaptive<double> get_ta_kep_var(double tol)
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_kep_var_mutex);
-
-    // Lookup.
-    if (auto it = ta_kep_var_cache.find(tol); it == ta_kep_var_cache.end()) {
+    tol = kep3::detail::normalize_tol(tol);
+    return *ta_kep_var_cache.get_ptr(tol, [&]() {
         auto [x, y, z, vx, vy, vz] = make_vars("x", "y", "z", "vx", "vy", "vz");
         auto vsys = var_ode_sys(kep_dyn(), {x, y, z, vx, vy, vz}, 1);
         // Cache miss, create new one.
         const std::vector init_state = {1., 1., 1., 1., 1., 1.};
-        auto new_ta = taylor_adaptive<double>{vsys, init_state, heyoka::kw::tol = tol, heyoka::kw::compact_mode = true,
-                                              heyoka::kw::pars = {1.}};
-        return ta_kep_var_cache.insert(std::make_pair(tol, std::move(new_ta))).first->second;
-    } else {
-        // Cache hit, return existing.
-        return it->second;
-    }
+        return kep3::detail::jit_cache_load_or_build<taylor_adaptive<double>>(
+            "ta_kep_var", kep3::detail::jit_cache_params(tol),
+            [&]() {
+                return taylor_adaptive<double>{vsys, init_state, heyoka::kw::tol = tol, heyoka::kw::compact_mode = true,
+                                               heyoka::kw::pars = {1.}};
+            });
+    });
 }
 
 size_t get_ta_kep_cache_dim()
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_kep_mutex);
     return ta_kep_cache.size();
 }
 
 size_t get_ta_kep_var_cache_dim()
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_kep_mutex);
     return ta_kep_var_cache.size();
 }
 
@@ -9,11 +9,11 @@
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include <map>
-#include <mutex>
 #include <tuple>
-#include <unordered_map>
 #include <vector>
 
+#include <fmt/core.h>
+
 #include <heyoka/config.hpp>
 #include <heyoka/expression.hpp>
 #include <heyoka/math/log.hpp>
@@ -23,6 +23,8 @@
 #include <heyoka/taylor.hpp>
 
 #include <kep3/core_astro/constants.hpp>
+#include <kep3/detail/jit_cache.hpp>
+#include <kep3/detail/lru_cache.hpp>
 #include <kep3/ta/pontryagin_cartesian.hpp>
 
 using heyoka::diff;
@@ -136,117 +138,111 @@ std::vector<std::pair<expression, expression>> pc_dyn(kep3::optimality_type opti
     return std::get<0>(pc_expression_factory(optimality));
 }
 
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::mutex ta_pc_mutex;
+// The caches of the integrators, keyed by tolerance and optimality.
+using ta_pc_cache_t
+    = kep3::detail::lru_cache<std::pair<double, kep3::optimality_type>, taylor_adaptive<double>,
+                              kep3::ta::detail::pair_hash>;
+
 // Use a Function-Local static Variable (Lazy Initialization)
-std::unordered_map<std::pair<double, kep3::optimality_type>, taylor_adaptive<double>, kep3::ta::detail::pair_hash> &
-get_ta_pc_cache()
+ta_pc_cache_t &get_ta_pc_cache()
 {
-    static std::unordered_map<std::pair<double, kep3::optimality_type>, taylor_adaptive<double>,
-                              kep3::ta::detail::pair_hash>
-        ta_pc_cache;
-    return ta_pc_cache;
+    static ta_pc_cache_t cache("ta_pc");
+    return cache;
 }
 
-const taylor_adaptive<double> &get_ta_pc(double tol, kep3::optimality_type optimality)
+taylor_adaptive<double> get_ta_pc(double tol, kep3::optimality_type optimality)
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_pc_mutex);
-
-    // Lookup.
-    if (auto it = get_ta_pc_cache().find({tol, optimality}); it == get_ta_pc_cache().end()) {
+    tol = kep3::detail::normalize_tol(tol);
+    return *get_ta_pc_cache().get_ptr({tol, optimality}, [&]() {
         // Cache miss, create new one.
-        auto new_ta = taylor_adaptive<double>{std::get<0>(pc_expression_factory(optimality)), heyoka::kw::tol = tol};
-        return get_ta_pc_cache()
-            .insert(std::make_pair(std::make_pair(tol, optimality), std::move(new_ta)))
-            .first->second;
-    } else {
-        // Cache hit, return existing.
-        return it->second;
-    }
+        return kep3::detail::jit_cache_load_or_build<taylor_adaptive<double>>(
+            "ta_pc", kep3::detail::jit_cache_params(tol, optimality),
+            [&]() {
+                return taylor_adaptive<double>{std::get<0>(pc_expression_factory(optimality)), heyoka::kw::tol = tol};
+            });
+    });
 }
 
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::mutex ta_pc_var_mutex;
 // Use a Function-Local static Variable (Lazy Initialization)
-std::unordered_map<std::pair<double, kep3::optimality_type>, taylor_adaptive<double>, kep3::ta::detail::pair_hash> &
-get_ta_pc_var_cache()
+ta_pc_cache_t &get_ta_pc_var_cache()
 {
-    static std::unordered_map<std::pair<double, kep3::optimality_type>, taylor_adaptive<double>,
-                              kep3::ta::detail::pair_hash>
-        ta_pc_cache;
-    return ta_pc_cache;
+    static ta_pc_cache_t cache("ta_pc_var");
+    return cache;
 }
 
-const taylor_adaptive<double> &get_ta_pc_var(double tol, kep3::optimality_type optimality)
+taylor_adaptive<double> get_ta_pc_var(double tol, kep3::optimality_type optimality)
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_pc_var_mutex);
-
-    // Lookup.
-    if (auto it = get_ta_pc_var_cache().find({tol, optimality}); it == get_ta_pc_var_cache().end()) {
+    tol = kep3::detail::normalize_tol(tol);
+    return *get_ta_pc_var_cache().get_ptr({tol, optimality}, [&]() {
         auto [lx, ly, lz, lvx, lvy, lvz, lm] = make_vars("lx", "ly", "lz", "lvx", "lvy", "lvz", "lm");
         auto vsys
             = var_ode_sys(std::get<0>(pc_expression_factory(optimality)), {lx, ly, lz, lvx, lvy, lvz, lm, par[4]}, 1);
         // Cache miss, create new one.
-        auto new_ta = taylor_adaptive<double>{vsys, heyoka::kw::tol = tol, heyoka::kw::compact_mode = true};
-        return get_ta_pc_var_cache()
-            .insert(std::make_pair(std::make_pair(tol, optimality), std::move(new_ta)))
-            .first->second;
-    } else {
-        // Cache hit, return existing.
-        return it->second;
-    }
+        return kep3::detail::jit_cache_load_or_build<taylor_adaptive<double>>(
+            "ta_pc_var", kep3::detail::jit_cache_params(tol, optimality),
+            [&]() { return taylor_adaptive<double>{vsys, heyoka::kw::tol = tol, heyoka::kw::compact_mode = true}; });
+    });
 }
 
 size_t get_ta_pc_cache_dim()
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_pc_mutex);
     return get_ta_pc_cache().size();
 }
 
 size_t get_ta_pc_var_cache_dim()
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_pc_mutex);
     return get_ta_pc_var_cache().size();
 }
 
 // Factory functions to help the static variable initialization later
 auto pc_H_cfunc_factory(kep3::optimality_type optimality)
 {
-    auto [x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm]
-        = make_vars("x", "y", "z", "vx", "vy", "vz", "m", "lx", "ly", "lz", "lvx", "lvy", "lvz", "lm");
-    return heyoka::cfunc<double>({std::get<1>(pc_expression_factory(optimality))},
-                                 {x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm});
+    return kep3::detail::jit_cache_load_or_build<heyoka::cfunc<double>>(
+        "pc_H_cfunc", fmt::format("optimality={}", static_cast<int>(optimality)), [&]() {
+            auto [x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm]
+                = make_vars("x", "y", "z", "vx", "vy", "vz", "m", "lx", "ly", "lz", "lvx", "lvy", "lvz", "lm");
+            return heyoka::cfunc<double>({std::get<1>(pc_expression_factory(optimality))},
+                                         {x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm});
+        });
 }
 auto pc_SF_cfunc_factory(kep3::optimality_type optimality)
 {
-    auto [x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm]
-        = make_vars("x", "y", "z", "vx", "vy", "vz", "m", "lx", "ly", "lz", "lvx", "lvy", "lvz", "lm");
-    return heyoka::cfunc<double>({std::get<2>(pc_expression_factory(optimality))},
-                                 {x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm});
+    return kep3::detail::jit_cache_load_or_build<heyoka::cfunc<double>>(
+        "pc_SF_cfunc", fmt::format("optimality={}", static_cast<int>(optimality)), [&]() {
+            auto [x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm]
+                = make_vars("x", "y", "z", "vx", "vy", "vz", "m", "lx", "ly", "lz", "lvx", "lvy", "lvz", "lm");
+            return heyoka::cfunc<double>({std::get<2>(pc_expression_factory(optimality))},
+                                         {x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm});
+        });
 }
 auto pc_u_cfunc_factory(kep3::optimality_type optimality)
 {
-    auto [x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm]
-        = make_vars("x", "y", "z", "vx", "vy", "vz", "m", "lx", "ly", "lz", "lvx", "lvy", "lvz", "lm");
-    return heyoka::cfunc<double>({std::get<3>(pc_expression_factory(optimality))},
-                                 {x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm});
+    return kep3::detail::jit_cache_load_or_build<heyoka::cfunc<double>>(
+        "pc_u_cfunc", fmt::format("optimality={}", static_cast<int>(optimality)), [&]() {
+            auto [x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm]
+                = make_vars("x", "y", "z", "vx", "vy", "vz", "m", "lx", "ly", "lz", "lvx", "lvy", "lvz", "lm");
+            return heyoka::cfunc<double>({std::get<3>(pc_expression_factory(optimality))},
+                                         {x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm});
+        });
 }
 auto pc_i_vers_cfunc_factory(kep3::optimality_type optimality)
 {
-    auto [lvx, lvy, lvz] = make_vars("lvx", "lvy", "lvz");
-    return heyoka::cfunc<double>({std::get<4>(pc_expression_factory(optimality))}, {lvx, lvy, lvz});
+    return kep3::detail::jit_cache_load_or_build<heyoka::cfunc<double>>(
+        "pc_i_vers_cfunc", fmt::format("optimality={}", static_cast<int>(optimality)), [&]() {
+            auto [lvx, lvy, lvz] = make_vars("lvx", "lvy", "lvz");
+            return heyoka::cfunc<double>({std::get<4>(pc_expression_factory(optimality))}, {lvx, lvy, lvz});
+        });
 }
 auto pc_dyn_cfunc_factory(kep3::optimality_type optimality)
 {
-    auto [x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm]
-        = make_vars("x", "y", "z", "vx", "vy", "vz", "m", "lx", "ly", "lz", "lvx", "lvy", "lvz", "lm");
-    auto rhs = std::get<5>(pc_expression_factory(optimality));
-    return heyoka::cfunc<double>({rhs[0], rhs[1], rhs[2], rhs[3], rhs[4], rhs[5], rhs[13]},
-                                 {x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm});
+    return kep3::detail::jit_cache_load_or_build<heyoka::cfunc<double>>(
+        "pc_dyn_cfunc", fmt::format("optimality={}", static_cast<int>(optimality)), [&]() {
+            auto [x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm]
+                = make_vars("x", "y", "z", "vx", "vy", "vz", "m", "lx", "ly", "lz", "lvx", "lvy", "lvz", "lm");
+            auto rhs = std::get<5>(pc_expression_factory(optimality));
+            return heyoka::cfunc<double>({rhs[0], rhs[1], rhs[2], rhs[3], rhs[4], rhs[5], rhs[13]},
+                                         {x, y, z, vx, vy, vz, m, lx, ly, lz, lvx, lvy, lvz, lm});
+        });
 }
 
 // Function-level static variable: it is initialised the first time the function is invoked
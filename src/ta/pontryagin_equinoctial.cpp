@@ -10,10 +10,11 @@
 
 #include <heyoka/kw.hpp>
 #include <map>
-#include <mutex>
 #include <tuple>
 #include <vector>
 
+#include <fmt/core.h>
+
 #include <heyoka/config.hpp>
 #include <heyoka/expression.hpp>
 #include <heyoka/math/cos.hpp>
@@ -25,6 +26,8 @@
 #include <heyoka/taylor.hpp>
 
 #include <kep3/core_astro/constants.hpp>
+#include <kep3/detail/jit_cache.hpp>
+#include <kep3/detail/lru_cache.hpp>
 #include <kep3/ta/pontryagin_equinoctial.hpp>
 
 using heyoka::cos;
@@ -185,119 +188,114 @@ std::vector<std::pair<expression, expression>> peq_dyn(kep3::optimality_type opt
     return std::get<0>(peq_expression_factory(optimality));
 }
 
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::mutex ta_peq_mutex;
+// The caches of the integrators, keyed by tolerance and optimality.
+using ta_peq_cache_t
+    = kep3::detail::lru_cache<std::pair<double, kep3::optimality_type>, taylor_adaptive<double>,
+                              kep3::ta::detail::pair_hash>;
+
 // Use a Function-Local static Variable (Lazy Initialization)
-std::unordered_map<std::pair<double, kep3::optimality_type>, taylor_adaptive<double>, kep3::ta::detail::pair_hash> &
-get_ta_peq_cache()
+ta_peq_cache_t &get_ta_peq_cache()
 {
-    static std::unordered_map<std::pair<double, kep3::optimality_type>, taylor_adaptive<double>,
-                              kep3::ta::detail::pair_hash>
-        ta_peq_cache;
-    return ta_peq_cache;
+    static ta_peq_cache_t cache("ta_peq");
+    return cache;
 }
 
-const taylor_adaptive<double> &get_ta_peq(double tol, kep3::optimality_type optimality)
+taylor_adaptive<double> get_ta_peq(double tol, kep3::optimality_type optimality)
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_peq_mutex);
-    // Lookup.
-    if (auto it = get_ta_peq_cache().find({tol, optimality}); it == get_ta_peq_cache().end()) {
+    tol = kep3::detail::normalize_tol(tol);
+    return *get_ta_peq_cache().get_ptr({tol, optimality}, [&]() {
         // Cache miss, create new one.
-        auto new_ta = taylor_adaptive<double>{std::get<0>(peq_expression_factory(optimality)), heyoka::kw::tol = tol,
-                                              heyoka::kw::compact_mode = true};
-        return get_ta_peq_cache()
-            .insert(std::make_pair(std::make_pair(tol, optimality), std::move(new_ta)))
-            .first->second;
-    } else {
-        // Cache hit, return existing.
-        return it->second;
-    }
+        return kep3::detail::jit_cache_load_or_build<taylor_adaptive<double>>(
+            "ta_peq", kep3::detail::jit_cache_params(tol, optimality),
+            [&]() {
+                return taylor_adaptive<double>{std::get<0>(peq_expression_factory(optimality)), heyoka::kw::tol = tol,
+                                               heyoka::kw::compact_mode = true};
+            });
+    });
 }
 
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::mutex ta_peq_var_mutex;
 // Use a Function-Local static Variable (Lazy Initialization)
-std::unordered_map<std::pair<double, kep3::optimality_type>, taylor_adaptive<double>, kep3::ta::detail::pair_hash> &
-get_ta_peq_var_cache()
+ta_peq_cache_t &get_ta_peq_var_cache()
 {
-    static std::unordered_map<std::pair<double, kep3::optimality_type>, taylor_adaptive<double>,
-                              kep3::ta::detail::pair_hash>
-        ta_peq_cache;
-    return ta_peq_cache;
+    static ta_peq_cache_t cache("ta_peq_var");
+    return cache;
 }
 
-const taylor_adaptive<double> &get_ta_peq_var(double tol, kep3::optimality_type optimality)
+taylor_adaptive<double> get_ta_peq_var(double tol, kep3::optimality_type optimality)
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_peq_var_mutex);
-
-    // Lookup.
-    if (auto it = get_ta_peq_var_cache().find({tol, optimality}); it == get_ta_peq_var_cache().end()) {
+    tol = kep3::detail::normalize_tol(tol);
+    return *get_ta_peq_var_cache().get_ptr({tol, optimality}, [&]() {
         auto [lp, lf, lg, lh, lk, lL, lm] = make_vars("lp", "lf", "lg", "lh", "lk", "lL", "lm");
         auto vsys
             = var_ode_sys(std::get<0>(peq_expression_factory(optimality)), {lp, lf, lg, lh, lk, lL, lm, par[4]}, 1);
         // Cache miss, create new one.
-        auto new_ta = taylor_adaptive<double>{vsys, heyoka::kw::tol = tol, heyoka::kw::compact_mode = true};
-        return get_ta_peq_var_cache()
-            .insert(std::make_pair(std::make_pair(tol, optimality), std::move(new_ta)))
-            .first->second;
-    } else {
-        // Cache hit, return existing.
-        return it->second;
-    }
+        return kep3::detail::jit_cache_load_or_build<taylor_adaptive<double>>(
+            "ta_peq_var", kep3::detail::jit_cache_params(tol, optimality),
+            [&]() { return taylor_adaptive<double>{vsys, heyoka::kw::tol = tol, heyoka::kw::compact_mode = true}; });
+    });
 }
 
 size_t get_ta_peq_cache_dim()
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_peq_mutex);
     return get_ta_peq_cache().size();
 }
 
 size_t get_ta_peq_var_cache_dim()
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_peq_mutex);
     return get_ta_peq_var_cache().size();
 }
 
 // Factory functions to help the static variable initialization later
 auto peq_H_cfunc_factory(kep3::optimality_type optimality)
 {
-    auto [p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm]
-        = make_vars("p", "f", "g", "h", "k", "L", "m", "lp", "lf", "lg", "lh", "lk", "lL", "lm");
-    return heyoka::cfunc<double>({std::get<1>(peq_expression_factory(optimality))},
-                                 {p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm});
+    return kep3::detail::jit_cache_load_or_build<heyoka::cfunc<double>>(
+        "peq_H_cfunc", fmt::format("optimality={}", static_cast<int>(optimality)), [&]() {
+            auto [p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm]
+                = make_vars("p", "f", "g", "h", "k", "L", "m", "lp", "lf", "lg", "lh", "lk", "lL", "lm");
+            return heyoka::cfunc<double>({std::get<1>(peq_expression_factory(optimality))},
+                                         {p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm});
+        });
 }
 auto peq_SF_cfunc_factory(kep3::optimality_type optimality)
 {
-    auto [p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm]
-        = make_vars("p", "f", "g", "h", "k", "L", "m", "lp", "lf", "lg", "lh", "lk", "lL", "lm");
-    return heyoka::cfunc<double>({std::get<2>(peq_expression_factory(optimality))},
-                                 {p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm});
+    return kep3::detail::jit_cache_load_or_build<heyoka::cfunc<double>>(
+        "peq_SF_cfunc", fmt::format("optimality={}", static_cast<int>(optimality)), [&]() {
+            auto [p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm]
+                = make_vars("p", "f", "g", "h", "k", "L", "m", "lp", "lf", "lg", "lh", "lk", "lL", "lm");
+            return heyoka::cfunc<double>({std::get<2>(peq_expression_factory(optimality))},
+                                         {p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm});
+        });
 }
 auto peq_u_cfunc_factory(kep3::optimality_type optimality)
 {
-    auto [p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm]
-        = make_vars("p", "f", "g", "h", "k", "L", "m", "lp", "lf", "lg", "lh", "lk", "lL", "lm");
-    return heyoka::cfunc<double>({std::get<3>(peq_expression_factory(optimality))},
-                                 {p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm});
+    return kep3::detail::jit_cache_load_or_build<heyoka::cfunc<double>>(
+        "peq_u_cfunc", fmt::format("optimality={}", static_cast<int>(optimality)), [&]() {
+            auto [p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm]
+                = make_vars("p", "f", "g", "h", "k", "L", "m", "lp", "lf", "lg", "lh", "lk", "lL", "lm");
+            return heyoka::cfunc<double>({std::get<3>(peq_expression_factory(optimality))},
+                                         {p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm});
+        });
 }
 auto peq_i_vers_cfunc_factory(kep3::optimality_type optimality)
 {
-    auto [p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm]
-        = make_vars("p", "f", "g", "h", "k", "L", "m", "lp", "lf", "lg", "lh", "lk", "lL", "lm");
-    return heyoka::cfunc<double>({std::get<4>(peq_expression_factory(optimality))},
-                                 {p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm});
+    return kep3::detail::jit_cache_load_or_build<heyoka::cfunc<double>>(
+        "peq_i_vers_cfunc", fmt::format("optimality={}", static_cast<int>(optimality)), [&]() {
+            auto [p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm]
+                = make_vars("p", "f", "g", "h", "k", "L", "m", "lp", "lf", "lg", "lh", "lk", "lL", "lm");
+            return heyoka::cfunc<double>({std::get<4>(peq_expression_factory(optimality))},
+                                         {p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm});
+        });
 }
 auto peq_dyn_cfunc_factory(kep3::optimality_type optimality)
 {
-    auto [p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm]
-        = make_vars("p", "f", "g", "h", "k", "L", "m", "lp", "lf", "lg", "lh", "lk", "lL", "lm");
-    auto rhs = std::get<5>(peq_expression_factory(optimality));
-    return heyoka::cfunc<double>({rhs[0], rhs[1], rhs[2], rhs[3], rhs[4], rhs[5], rhs[13]},
-                                 {p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm});
+    return kep3::detail::jit_cache_load_or_build<heyoka::cfunc<double>>(
+        "peq_dyn_cfunc", fmt::format("optimality={}", static_cast<int>(optimality)), [&]() {
+            auto [p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm]
+                = make_vars("p", "f", "g", "h", "k", "L", "m", "lp", "lf", "lg", "lh", "lk", "lL", "lm");
+            auto rhs = std::get<5>(peq_expression_factory(optimality));
+            return heyoka::cfunc<double>({rhs[0], rhs[1], rhs[2], rhs[3], rhs[4], rhs[5], rhs[13]},
+                                         {p, f, g, h, k, L, m, lp, lf, lg, lh, lk, lL, lm});
+        });
 }
 
 // Function-level static variable: it is initialised the first time the function is invoked
@@ -0,0 +1,200 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <heyoka/taylor.hpp>
+
+#include <kep3/detail/lru_cache.hpp>
+#include <kep3/ta/pool.hpp>
+
+namespace kep3::ta
+{
+
+namespace
+{
+
+using ta_pool_key_t = std::pair<ta_getter_t, double>;
+
+// NOTE: the built-in operator< does not order function pointers, std::less does.
+struct ta_pool_key_less {
+    bool operator()(const ta_pool_key_t &a, const ta_pool_key_t &b) const
+    {
+        if (a.first != b.first) {
+            return std::less<ta_getter_t>{}(a.first, b.first);
+        }
+        return a.second < b.second;
+    }
+};
+
+struct ta_free_list {
+    std::vector<std::unique_ptr<heyoka::taylor_adaptive<double>>> tas;
+    // Tick of the last release, to evict from the least recently used list when the pool is full.
+    std::uint64_t last_used = 0;
+};
+
+// The free copies of the calling thread, per getter and normalized tolerance. As the pool is thread
+// local, no locking is needed.
+struct ta_pool_t {
+    std::map<ta_pool_key_t, ta_free_list, ta_pool_key_less> lists;
+    std::size_t size = 0;
+    std::uint64_t tick = 0;
+};
+
+ta_pool_t &get_ta_pool()
+{
+    thread_local ta_pool_t pool;
+    return pool;
+}
+
+std::unique_ptr<heyoka::taylor_adaptive<double>> ta_pool_take(const ta_pool_key_t &key)
+{
+    auto &pool = get_ta_pool();
+    const auto it = pool.lists.find(key);
+    if (it == pool.lists.end()) {
+        return nullptr;
+    }
+    auto retval = std::move(it->second.tas.back());
+    it->second.tas.pop_back();
+    if (it->second.tas.empty()) {
+        pool.lists.erase(it);
+    }
+    --pool.size;
+    return retval;
+}
+
+void ta_pool_put(const ta_pool_key_t &key, std::unique_ptr<heyoka::taylor_adaptive<double>> ta)
+{
+    auto &pool = get_ta_pool();
+    auto &list = pool.lists[key];
+    if (list.tas.size() == ta_pool_max_free) {
+        return;
+    }
+    if (pool.size == ta_pool_max_size) {
+        // Make room by dropping a copy of the least recently used integrator.
+        auto lru = pool.lists.end();
+        for (auto it = pool.lists.begin(); it != pool.lists.end(); ++it) {
+            if (!it->second.tas.empty() && (lru == pool.lists.end() || it->second.last_used < lru->second.last_used)) {
+                lru = it;
+            }
+        }
+        lru->second.tas.pop_back();
+        if (lru->second.tas.empty() && lru->first != key) {
+            pool.lists.erase(lru);
+        }
+        --pool.size;
+    }
+    list.tas.push_back(std::move(ta));
+    list.last_used = ++pool.tick;
+    ++pool.size;
+}
+
+} // namespace
+
+ta_handle::ta_handle() : m_ta(std::make_unique<heyoka::taylor_adaptive<double>>()) {}
+
+ta_handle::ta_handle(heyoka::taylor_adaptive<double> ta)
+    : m_ta(std::make_unique<heyoka::taylor_adaptive<double>>(std::move(ta)))
+{
+}
+
+// NOTE: the getters normalize the tolerance, we do the same so that the tolerances sharing a cache
+// entry also share the pool.
+ta_handle::ta_handle(ta_getter_t getter, double tol)
+    : m_getter(getter), m_tol(kep3::detail::normalize_tol(tol)), m_ta(ta_pool_take({m_getter, m_tol}))
+{
+    if (!m_ta) {
+        // Pool miss, copy from the cache (this compiles the integrator if needed).
+        m_ta = std::make_unique<heyoka::taylor_adaptive<double>>(m_getter(m_tol));
+    }
+}
+
+ta_handle::ta_handle(const ta_handle &other)
+    : m_getter(other.m_getter), m_tol(other.m_tol),
+      m_ta(std::make_unique<heyoka::taylor_adaptive<double>>(*other.m_ta))
+{
+}
+
+ta_handle::ta_handle(ta_handle &&other) noexcept
+    : m_getter(other.m_getter), m_tol(other.m_tol), m_ta(std::move(other.m_ta))
+{
+}
+
+ta_handle &ta_handle::operator=(const ta_handle &other)
+{
+    if (this != &other) {
+        *this = ta_handle(other);
+    }
+    return *this;
+}
+
+ta_handle &ta_handle::operator=(ta_handle &&other) noexcept
+{
+    if (this != &other) {
+        release();
+        m_getter = other.m_getter;
+        m_tol = other.m_tol;
+        m_ta = std::move(other.m_ta);
+    }
+    return *this;
+}
+
+ta_handle::~ta_handle()
+{
+    release();
+}
+
+void ta_handle::release() noexcept
+{
+    if (!m_ta || m_getter == nullptr) {
+        return;
+    }
+    try {
+        ta_pool_put({m_getter, m_tol}, std::move(m_ta));
+        // LCOV_EXCL_START
+    } catch (...) {
+        // Out of memory while growing the pool: the copy is simply destroyed.
+    }
+    // LCOV_EXCL_STOP
+    m_ta.reset();
+}
+
+heyoka::taylor_adaptive<double> &ta_handle::operator*() const
+{
+    return *m_ta;
+}
+
+heyoka::taylor_adaptive<double> *ta_handle::operator->() const
+{
+    return m_ta.get();
+}
+
+heyoka::taylor_adaptive<double> *ta_handle::get() const
+{
+    return m_ta.get();
+}
+
+bool ta_handle::is_pooled() const
+{
+    return m_getter != nullptr;
+}
+
+size_t get_ta_pool_dim()
+{
+    return get_ta_pool().size;
+}
+
+} // namespace kep3::ta
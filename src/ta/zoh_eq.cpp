@@ -9,8 +9,6 @@
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include <heyoka/kw.hpp>
-#include <mutex>
-#include <unordered_map>
 #include <vector>
 
 #include <heyoka/expression.hpp>
@@ -21,6 +19,8 @@
 #include <heyoka/math/sqrt.hpp>
 #include <heyoka/taylor.hpp>
 
+#include <kep3/detail/jit_cache.hpp>
+#include <kep3/detail/lru_cache.hpp>
 #include <kep3/ta/zoh_eq.hpp>
 
 using heyoka::cos;
@@ -73,52 +73,44 @@ std::vector<std::pair<expression, expression>> zoh_eq_dyn()
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::mutex ta_zoh_eq_mutex;
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::unordered_map<double, taylor_adaptive<double>> ta_zoh_eq_cache;
+kep3::detail::lru_cache<double, taylor_adaptive<double>> ta_zoh_eq_cache("ta_zoh_eq");
 
-const heyoka::taylor_adaptive<double> &get_ta_zoh_eq(double tol)
+heyoka::taylor_adaptive<double> get_ta_zoh_eq(double tol)
 {
-    std::lock_guard const lock(ta_zoh_eq_mutex);
-
-    if (auto it = ta_zoh_eq_cache.find(tol); it == ta_zoh_eq_cache.end()) {
+    tol = kep3::detail::normalize_tol(tol);
+    return *ta_zoh_eq_cache.get_ptr(tol, [&]() {
         const std::vector init_state = {1., 1., 1., 1., 1., 1., 1.};
-        auto new_ta = taylor_adaptive<double>{zoh_eq_dyn(), init_state, heyoka::kw::tol = tol,
-                                              heyoka::kw::pars = {1., 1., 0., 0., 0.}};
-        return ta_zoh_eq_cache.insert(std::make_pair(tol, std::move(new_ta))).first->second;
-    } else {
-        return it->second;
-    }
+        return kep3::detail::jit_cache_load_or_build<taylor_adaptive<double>>(
+            "ta_zoh_eq", kep3::detail::jit_cache_params(tol),
+            [&]() {
+                return taylor_adaptive<double>{zoh_eq_dyn(), init_state, heyoka::kw::tol = tol,
+                                               heyoka::kw::pars = {1., 1., 0., 0., 0.}};
+            });
+    });
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::mutex ta_zoh_eq_var_mutex;
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::unordered_map<double, taylor_adaptive<double>> ta_zoh_eq_var_cache;
+kep3::detail::lru_cache<double, taylor_adaptive<double>> ta_zoh_eq_var_cache("ta_zoh_eq_var");
 
-const heyoka::taylor_adaptive<double> &get_ta_zoh_eq_var(double tol)
+heyoka::taylor_adaptive<double> get_ta_zoh_eq_var(double tol)
 {
-    std::lock_guard const lock(ta_zoh_eq_var_mutex);
-
-    if (auto it = ta_zoh_eq_var_cache.find(tol); it == ta_zoh_eq_var_cache.end()) {
+    tol = kep3::detail::normalize_tol(tol);
+    return *ta_zoh_eq_var_cache.get_ptr(tol, [&]() {
         auto [p, f, g, h, k, L, m] = make_vars("p", "f", "g", "h", "k", "L", "m");
         auto vsys = var_ode_sys(zoh_eq_dyn(), {p, f, g, h, k, L, m, par[0], par[1], par[2], par[3]}, 1);
-        auto new_ta = taylor_adaptive<double>{vsys, heyoka::kw::tol = tol, heyoka::kw::compact_mode = true};
-        return ta_zoh_eq_var_cache.insert(std::make_pair(tol, std::move(new_ta))).first->second;
-    } else {
-        return it->second;
-    }
+        return kep3::detail::jit_cache_load_or_build<taylor_adaptive<double>>(
+            "ta_zoh_eq_var", kep3::detail::jit_cache_params(tol),
+            [&]() { return taylor_adaptive<double>{vsys, heyoka::kw::tol = tol, heyoka::kw::compact_mode = true}; });
+    });
 }
 
 size_t get_ta_zoh_eq_cache_dim()
 {
-    std::lock_guard const lock(ta_zoh_eq_mutex);
     return ta_zoh_eq_cache.size();
 }
 
 size_t get_ta_zoh_eq_var_cache_dim()
 {
-    std::lock_guard const lock(ta_zoh_eq_var_mutex);
     return ta_zoh_eq_var_cache.size();
 }
 
@@ -9,8 +9,6 @@
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include <heyoka/kw.hpp>
-#include <mutex>
-#include <unordered_map>
 #include <vector>
 
 #include <heyoka/expression.hpp>
@@ -19,6 +17,8 @@
 #include <heyoka/math/sum.hpp>
 #include <heyoka/taylor.hpp>
 
+#include <kep3/detail/jit_cache.hpp>
+#include <kep3/detail/lru_cache.hpp>
 #include <kep3/ta/zoh_kep.hpp>
 
 using heyoka::exp;
@@ -62,62 +62,56 @@ std::vector<std::pair<expression, expression>> zoh_kep_dyn()
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::mutex ta_zoh_kep_mutex;
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::unordered_map<double, taylor_adaptive<double>> ta_zoh_kep_cache;
+kep3::detail::lru_cache<double, taylor_adaptive<double>> ta_zoh_kep_cache("ta_zoh_kep");
 
-const heyoka::taylor_adaptive<double> &get_ta_zoh_kep(double tol)
+heyoka::taylor_adaptive<double> get_ta_zoh_kep(double tol)
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_zoh_kep_mutex);
-
-    // Lookup.
-    if (auto it = ta_zoh_kep_cache.find(tol); it == ta_zoh_kep_cache.end()) {
+    tol = kep3::detail::normalize_tol(tol);
+    return *ta_zoh_kep_cache.get_ptr(tol, [&]() {
         // Cache miss, create new one.
         const std::vector init_state = {1., 1., 1., 1., 1., 1., 1.};
-        auto new_ta = taylor_adaptive<double>{zoh_kep_dyn(), init_state, heyoka::kw::tol = tol,
-                                              heyoka::kw::pars = {1., 1., 0., 0., 0.}};
-        return ta_zoh_kep_cache.insert(std::make_pair(tol, std::move(new_ta))).first->second;
-    } else {
-        // Cache hit, return existing.
-        return it->second;
-    }
+        return kep3::detail::jit_cache_load_or_build<taylor_adaptive<double>>(
+            "ta_zoh_kep", kep3::detail::jit_cache_params(tol),
+            [&]() {
+                return taylor_adaptive<double>{zoh_kep_dyn(), init_state, heyoka::kw::tol = tol,
+                                               heyoka::kw::pars = {1., 1., 0., 0., 0.}};
+            });
+    });
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::mutex ta_zoh_kep_var_mutex;
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::unordered_map<double, taylor_adaptive<double>> ta_zoh_kep_var_cache;
+kep3::detail::lru_cache<double, taylor_adaptive<double>> ta_zoh_kep_var_cache("ta_zoh_kep_var");
 
-const heyoka::taylor_adaptive<double> &get_ta_zoh_kep_var(double tol)
+heyoka::taylor_adaptive<double> get_ta_zoh_kep_var(double tol)
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_zoh_kep_var_mutex);
-
-    // Lookup.
-    if (auto it = ta_zoh_kep_var_cache.find(tol); it == ta_zoh_kep_var_cache.end()) {
+    tol = kep3::detail::normalize_tol(tol);
+    return *ta_zoh_kep_var_cache.get_ptr(tol, [&]() {
         auto [x, y, z, vx, vy, vz, m] = make_vars("x", "y", "z", "vx", "vy", "vz", "m");
         auto vsys = var_ode_sys(zoh_kep_dyn(), {x, y, z, vx, vy, vz, m, par[0], par[1], par[2], par[3]}, 1);
         // Cache miss, create new one.
-        auto new_ta = taylor_adaptive<double>{vsys, heyoka::kw::tol = tol, heyoka::kw::compact_mode = true};
-        return ta_zoh_kep_var_cache.insert(std::make_pair(tol, std::move(new_ta))).first->second;
-    } else {
-        // Cache hit, return existing.
-        return it->second;
-    }
+        return kep3::detail::jit_cache_load_or_build<taylor_adaptive<double>>(
+            "ta_zoh_kep_var", kep3::detail::jit_cache_params(tol),
+            [&]() { return taylor_adaptive<double>{vsys, heyoka::kw::tol = tol, heyoka::kw::compact_mode = true}; });
+    });
+}
+
+ta_handle acquire_ta_zoh_kep(double tol)
+{
+    return {&get_ta_zoh_kep, tol};
+}
+
+ta_handle acquire_ta_zoh_kep_var(double tol)
+{
+    return {&get_ta_zoh_kep_var, tol};
 }
 
 size_t get_ta_zoh_kep_cache_dim()
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_zoh_kep_mutex);
     return ta_zoh_kep_cache.size();
 }
 
 size_t get_ta_zoh_kep_var_cache_dim()
 {
-    // Lock down for access to cache.
-    std::lock_guard const lock(ta_zoh_kep_var_mutex);
     return ta_zoh_kep_var_cache.size();
 }
 
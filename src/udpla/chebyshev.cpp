@@ -0,0 +1,322 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/math/constants/constants.hpp>
+
+#include <fmt/core.h>
+
+#include <kep3/core_astro/constants.hpp>
+#include <kep3/planet.hpp>
+#include <kep3/udpla/chebyshev.hpp>
+
+namespace kep3::udpla
+{
+
+namespace
+{
+
+// Maximum number of bisections of the window.
+constexpr unsigned max_depth = 32u;
+
+// Maximum order of the fits.
+constexpr unsigned max_order = 64u;
+
+// Maximum number of fits (i.e. of calls to the source eph_v) over the whole window. It bounds the
+// construction time and, since the segments are at most as many as the fits, the memory footprint.
+constexpr std::size_t max_fits = 16384u;
+
+// Smallest admissible tolerance: below a few ulps the check is dominated by round-off, and the
+// bisection would only stop at max_depth or max_fits.
+constexpr double min_tol = 100. * std::numeric_limits<double>::epsilon();
+
+// Evaluates the Chebyshev series with coefficients c[0], ..., c[n - 1] at x in [-1, 1] (Clenshaw).
+double cheb_eval(const double *c, unsigned n, double x)
+{
+    double b1 = 0., b2 = 0.;
+    for (auto k = n - 1u; k > 0u; --k) {
+        const double tmp = c[k] + 2. * x * b1 - b2;
+        b2 = b1;
+        b1 = tmp;
+    }
+    return c[0] + x * b1 - b2;
+}
+
+// Evaluates the derivative (with respect to x) of the Chebyshev series.
+double cheb_eval_dx(const double *c, unsigned n, double x)
+{
+    // T_k and T_k' by recurrence.
+    double t0 = 1., t1 = x, dt0 = 0., dt1 = 1.;
+    double retval = (n > 1u) ? c[1] : 0.;
+    for (auto k = 2u; k < n; ++k) {
+        const double t2 = 2. * x * t1 - t0;
+        const double dt2 = 2. * t1 + 2. * x * dt1 - dt0;
+        retval += c[k] * dt2;
+        t0 = t1;
+        t1 = t2;
+        dt0 = dt1;
+        dt1 = dt2;
+    }
+    return retval;
+}
+
+// Fits [a, b] (bisecting it as needed), appending the segments to breaks and coeffs.
+void fit_segment(const kep3::planet &source, double a, double b, double tol, unsigned order, unsigned depth,
+                 std::size_t &n_fits, std::vector<double> &breaks, std::vector<double> &coeffs, double &max_error)
+{
+    if (n_fits == max_fits) {
+        throw std::domain_error(
+            fmt::format("The Chebyshev fit of the ephemerides could not reach the requested tolerance of {} within {} "
+                        "fits (the window would need too many segments): try a larger tolerance or order, or a "
+                        "shorter time window",
+                        tol, max_fits));
+    }
+    ++n_fits;
+
+    const double pi = boost::math::constants::pi<double>();
+    const unsigned n = order + 1u;
+    const double mid = 0.5 * (a + b), half = 0.5 * (b - a);
+
+    // The fitting nodes (Chebyshev points of the first kind) followed by the check points (the extrema
+    // of T_n, i.e. the midpoints between the nodes and the segment boundaries).
+    std::vector<double> taus(2u * n + 1u), epochs(2u * n + 1u);
+    for (auto j = 0u; j < n; ++j) {
+        taus[j] = std::cos(pi * (j + 0.5) / n);
+    }
+    for (auto j = 0u; j <= n; ++j) {
+        taus[n + j] = std::cos(pi * j / n);
+    }
+    for (decltype(taus.size()) j = 0u; j < taus.size(); ++j) {
+        epochs[j] = mid + half * taus[j];
+    }
+    const auto values = source.eph_v(epochs);
+
+    // The coefficients.
+    std::vector<double> c(6u * n, 0.);
+    for (auto comp = 0u; comp < 6u; ++comp) {
+        for (auto k = 0u; k < n; ++k) {
+            double acc = 0.;
+            for (auto j = 0u; j < n; ++j) {
+                acc += values[6u * j + comp] * std::cos(pi * k * (j + 0.5) / n);
+            }
+            c[comp * n + k] = 2. * acc / n;
+        }
+        c[comp * n] *= 0.5;
+    }
+
+    // The check.
+    double scale_r = 0., scale_v = 0., err_r = 0., err_v = 0.;
+    for (auto j = 0u; j < 2u * n + 1u; ++j) {
+        std::array<double, 6> d{};
+        double r2 = 0., v2 = 0.;
+        for (auto comp = 0u; comp < 6u; ++comp) {
+            d[comp] = cheb_eval(&c[comp * n], n, taus[j]) - values[6u * j + comp];
+            (comp < 3u ? r2 : v2) += values[6u * j + comp] * values[6u * j + comp];
+        }
+        scale_r = std::max(scale_r, std::sqrt(r2));
+        scale_v = std::max(scale_v, std::sqrt(v2));
+        if (j >= n) {
+            err_r = std::max(err_r, std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]));
+            err_v = std::max(err_v, std::sqrt(d[3] * d[3] + d[4] * d[4] + d[5] * d[5]));
+        }
+    }
+    const double err
+        = std::max(scale_r > 0. ? err_r / scale_r : err_r, scale_v > 0. ? err_v / scale_v : err_v);
+
+    if (err <= tol) {
+        breaks.push_back(b);
+        coeffs.insert(coeffs.end(), c.begin(), c.end());
+        max_error = std::max(max_error, err);
+        return;
+    }
+    if (depth == max_depth) {
+        throw std::domain_error(
+            fmt::format("The Chebyshev fit of the ephemerides could not reach the requested tolerance of {} (the "
+                        "error is {} on the segment [{}, {}] after {} bisections): try a larger tolerance or order",
+                        tol, err, a, b, max_depth));
+    }
+    fit_segment(source, a, mid, tol, order, depth + 1u, n_fits, breaks, coeffs, max_error);
+    fit_segment(source, mid, b, tol, order, depth + 1u, n_fits, breaks, coeffs, max_error);
+}
+
+} // namespace
+
+chebyshev::chebyshev(const kep3::planet &source, double mjd2000_start, double mjd2000_end, double tol,
+                     unsigned order)
+    : m_start(mjd2000_start), m_end(mjd2000_end), m_tol(tol), m_order(order), m_name(source.get_name()),
+      m_mu_central_body(source.get_mu_central_body()), m_mu_self(source.get_mu_self()),
+      m_radius(source.get_radius()), m_safe_radius(source.get_safe_radius())
+{
+    if (!std::isfinite(mjd2000_start) || !std::isfinite(mjd2000_end) || !(mjd2000_end > mjd2000_start)) {
+        throw std::invalid_argument(fmt::format("The time window of a Chebyshev udpla must be finite and non "
+                                                "empty, while [{}, {}] was detected",
+                                                mjd2000_start, mjd2000_end));
+    }
+    if (!std::isfinite(tol) || !(tol >= min_tol)) {
+        throw std::invalid_argument(fmt::format(
+            "The tolerance of a Chebyshev udpla must be finite and at least {}, while {} was detected", min_tol, tol));
+    }
+    if (order == 0u || order > max_order) {
+        throw std::invalid_argument(fmt::format(
+            "The order of a Chebyshev udpla must be in [1, {}], while {} was detected", max_order, order));
+    }
+    m_breaks.push_back(m_start);
+    std::size_t n_fits = 0u;
+    fit_segment(source, m_start, m_end, m_tol, m_order, 0u, n_fits, m_breaks, m_coeffs, m_max_error);
+}
+
+std::size_t chebyshev::segment(double mjd2000) const
+{
+    // NOTE: the negated checks also catch NaNs.
+    if (!(mjd2000 >= m_start && mjd2000 <= m_end)) {
+        throw std::domain_error(fmt::format("The epoch {} (MJD2000) is outside the time window [{}, {}] of the "
+                                            "Chebyshev udpla",
+                                            mjd2000, m_start, m_end));
+    }
+    const auto it = std::upper_bound(m_breaks.begin() + 1, m_breaks.end() - 1, mjd2000);
+    return static_cast<std::size_t>(std::distance(m_breaks.begin() + 1, it));
+}
+
+std::array<std::array<double, 3>, 2> chebyshev::eph(double mjd2000) const
+{
+    const auto seg = segment(mjd2000);
+    const auto n = m_order + 1u;
+    const double a = m_breaks[seg], b = m_breaks[seg + 1u];
+    const double x = (2. * mjd2000 - a - b) / (b - a);
+    const double *c = m_coeffs.data() + seg * 6u * n;
+    return {{{cheb_eval(c, n, x), cheb_eval(c + n, n, x), cheb_eval(c + 2u * n, n, x)},
+             {cheb_eval(c + 3u * n, n, x), cheb_eval(c + 4u * n, n, x), cheb_eval(c + 5u * n, n, x)}}};
+}
+
+void chebyshev::eph_v(std::span<const double> mjd2000s, std::span<double> out) const
+{
+    kep3::detail::check_vectorized_output("eph_v", mjd2000s.size(), 6u, out.size());
+    for (decltype(mjd2000s.size()) i = 0u; i < mjd2000s.size(); ++i) {
+        const auto [r, v] = eph(mjd2000s[i]);
+        std::copy(r.begin(), r.end(), out.begin() + static_cast<std::ptrdiff_t>(6u * i));
+        std::copy(v.begin(), v.end(), out.begin() + static_cast<std::ptrdiff_t>(6u * i + 3u));
+    }
+}
+
+std::vector<double> chebyshev::eph_v(const std::vector<double> &mjd2000s) const
+{
+    std::vector<double> retval(mjd2000s.size() * 6u);
+    eph_v(mjd2000s, retval);
+    return retval;
+}
+
+std::array<double, 3> chebyshev::acc(double mjd2000) const
+{
+    const auto seg = segment(mjd2000);
+    const auto n = m_order + 1u;
+    const double a = m_breaks[seg], b = m_breaks[seg + 1u];
+    const double x = (2. * mjd2000 - a - b) / (b - a);
+    const double *c = m_coeffs.data() + seg * 6u * n;
+    // dx/dt, with t in seconds.
+    const double dxdt = 2. / ((b - a) * kep3::DAY2SEC);
+    return {cheb_eval_dx(c + 3u * n, n, x) * dxdt, cheb_eval_dx(c + 4u * n, n, x) * dxdt,
+            cheb_eval_dx(c + 5u * n, n, x) * dxdt};
+}
+
+void chebyshev::acc_v(std::span<const double> mjd2000s, std::span<double> out) const
+{
+    kep3::detail::check_vectorized_output("acc_v", mjd2000s.size(), 3u, out.size());
+    for (decltype(mjd2000s.size()) i = 0u; i < mjd2000s.size(); ++i) {
+        const auto a = acc(mjd2000s[i]);
+        std::copy(a.begin(), a.end(), out.begin() + static_cast<std::ptrdiff_t>(3u * i));
+    }
+}
+
+std::vector<double> chebyshev::acc_v(const std::vector<double> &mjd2000s) const
+{
+    std::vector<double> retval(mjd2000s.size() * 3u);
+    acc_v(mjd2000s, retval);
+    return retval;
+}
+
+std::string chebyshev::get_name() const
+{
+    return m_name;
+}
+
+double chebyshev::get_mu_central_body() const
+{
+    return m_mu_central_body;
+}
+
+double chebyshev::get_mu_self() const
+{
+    return m_mu_self;
+}
+
+double chebyshev::get_radius() const
+{
+    return m_radius;
+}
+
+double chebyshev::get_safe_radius() const
+{
+    return m_safe_radius;
+}
+
+std::array<double, 2> chebyshev::get_window() const
+{
+    return {m_start, m_end};
+}
+
+double chebyshev::get_tol() const
+{
+    return m_tol;
+}
+
+unsigned chebyshev::get_order() const
+{
+    return m_order;
+}
+
+std::size_t chebyshev::get_n_segments() const
+{
+    return m_breaks.size() - 1u;
+}
+
+double chebyshev::get_max_error() const
+{
+    return m_max_error;
+}
+
+std::string chebyshev::get_extra_info() const
+{
+    return fmt::format("Chebyshev interpolation of the ephemerides: \n")
+           + fmt::format("Time window (MJD2000): [{}, {}]\n", m_start, m_end)
+           + fmt::format("Tolerance (relative): {}\n", m_tol) + fmt::format("Order: {}\n", m_order)
+           + fmt::format("Number of segments: {}\n", get_n_segments())
+           + fmt::format("Max. error (relative): {}\n", m_max_error);
+}
+
+std::ostream &operator<<(std::ostream &os, const kep3::udpla::chebyshev &udpla)
+{
+    os << udpla.get_extra_info() << "\n";
+    return os;
+}
+
+} // namespace kep3::udpla
+
+// NOLINTNEXTLINE
+KEP3_S11N_EXPORT_IMPLEMENT_AND_INSTANTIATE(kep3::udpla::chebyshev, kep3::detail::planet_iface)
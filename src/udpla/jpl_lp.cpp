@@ -8,8 +8,14 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
 #include <stdexcept>
 #include <unordered_map>
+#include <vector>
 
 #include <boost/algorithm/string.hpp>
 
@@ -155,6 +161,113 @@ std::array<std::array<double, 3>, 2> jpl_lp::eph(double mjd2000) const
     return par2ic(elements_f, get_mu_central_body());
 }
 
+namespace
+{
+
+// Kepler's equation is solved in chunks of this size, using buffers on the stack.
+constexpr std::size_t lp_chunk = 256u;
+
+// Calls f(i, r, v) for each epoch. The elements and their rates are converted once to meters
+// and radians, the Kepler's equations of a chunk of epochs are solved at once by the
+// vectorized kep3::m2e and the state is then built directly from the eccentric anomaly.
+template <typename F>
+void lp_for_each(const std::array<double, 6> &elements, const std::array<double, 6> &elements_dot, double mu,
+                 std::span<const double> mjd2000s, const F &f)
+{
+    for (auto mjd2000 : mjd2000s) {
+        if (mjd2000 <= -73048.0 || mjd2000 >= 18263.0) {
+            throw std::domain_error("Low precision Ephemeris are only valid in the "
+                                    "range range [1800-2050]");
+        }
+    }
+    // a,e,i,L,W,w as in the tables (W is the longitude of the perihelion, w of the ascending node).
+    std::array<double, 6> el{}, el_dot{};
+    const std::array<double, 6> factor
+        = {kep3::AU, 1., kep3::DEG2RAD, kep3::DEG2RAD, kep3::DEG2RAD, kep3::DEG2RAD};
+    for (auto j = 0u; j < 6u; ++j) {
+        el[j] = elements[j] * factor[j];
+        el_dot[j] = elements_dot[j] * factor[j];
+    }
+
+    std::array<double, lp_chunk> E{}, ecc{};
+    const auto size = mjd2000s.size();
+    for (decltype(mjd2000s.size()) base = 0u; base < size; base += lp_chunk) {
+        const auto n_c = std::min(lp_chunk, size - base);
+        for (std::size_t l = 0u; l < n_c; ++l) {
+            const double T = (mjd2000s[base + l] - 0.5) / 36525.;
+            ecc[l] = el[1] + el_dot[1] * T;
+            E[l] = (el[3] + el_dot[3] * T) - (el[4] + el_dot[4] * T);
+        }
+        kep3::m2e(std::span<const double>(E.data(), n_c), std::span<const double>(ecc.data(), n_c),
+                  std::span<double>(E.data(), n_c));
+        for (std::size_t l = 0u; l < n_c; ++l) {
+            const double T = (mjd2000s[base + l] - 0.5) / 36525.;
+            const double a = el[0] + el_dot[0] * T;
+            const double e = ecc[l];
+            const double inc = el[2] + el_dot[2] * T;
+            const double node = el[5] + el_dot[5] * T;
+            const double argp = el[4] + el_dot[4] * T - node;
+            // Perifocal position and velocity.
+            const double sinE = std::sin(E[l]), cosE = std::cos(E[l]);
+            const double sqrt1me2 = std::sqrt(1. - e * e);
+            const double R = a * (1. - e * cosE);
+            const double vfact = std::sqrt(mu * a) / R;
+            const double x = a * (cosE - e), y = a * sqrt1me2 * sinE;
+            const double vx = -vfact * sinE, vy = vfact * sqrt1me2 * cosE;
+            // First two columns of the rotation matrix from the perifocal to the inertial frame (as in par2ic).
+            const double cosW = std::cos(node), sinW = std::sin(node);
+            const double cosw = std::cos(argp), sinw = std::sin(argp);
+            const double cosi = std::cos(inc), sini = std::sin(inc);
+            const std::array<double, 3> P
+                = {cosW * cosw - sinW * sinw * cosi, sinW * cosw + cosW * sinw * cosi, sinw * sini};
+            const std::array<double, 3> Q
+                = {-cosW * sinw - sinW * cosw * cosi, -sinW * sinw + cosW * cosw * cosi, cosw * sini};
+            f(base + l, std::array<double, 3>{x * P[0] + y * Q[0], x * P[1] + y * Q[1], x * P[2] + y * Q[2]},
+              std::array<double, 3>{vx * P[0] + vy * Q[0], vx * P[1] + vy * Q[1], vx * P[2] + vy * Q[2]});
+        }
+    }
+}
+
+} // namespace
+
+void jpl_lp::eph_v(std::span<const double> mjd2000s, std::span<double> out) const
+{
+    kep3::detail::check_vectorized_output("eph_v", mjd2000s.size(), 6u, out.size());
+    lp_for_each(m_elements, m_elements_dot, get_mu_central_body(), mjd2000s,
+                [&out](std::size_t i, const std::array<double, 3> &r, const std::array<double, 3> &v) {
+                    std::copy(r.begin(), r.end(), out.begin() + static_cast<std::ptrdiff_t>(6u * i));
+                    std::copy(v.begin(), v.end(), out.begin() + static_cast<std::ptrdiff_t>(6u * i + 3u));
+                });
+}
+
+std::vector<double> jpl_lp::eph_v(const std::vector<double> &mjd2000s) const
+{
+    std::vector<double> retval(mjd2000s.size() * 6u);
+    eph_v(mjd2000s, retval);
+    return retval;
+}
+
+void jpl_lp::acc_v(std::span<const double> mjd2000s, std::span<double> out) const
+{
+    kep3::detail::check_vectorized_output("acc_v", mjd2000s.size(), 3u, out.size());
+    const double mu = get_mu_central_body();
+    lp_for_each(m_elements, m_elements_dot, mu, mjd2000s,
+                [&out, mu](std::size_t i, const std::array<double, 3> &r, const std::array<double, 3> &) {
+                    const double R = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+                    const double coeff = -mu / (R * R * R);
+                    for (auto j = 0u; j < 3u; ++j) {
+                        out[3u * i + j] = coeff * r[j];
+                    }
+                });
+}
+
+std::vector<double> jpl_lp::acc_v(const std::vector<double> &mjd2000s) const
+{
+    std::vector<double> retval(mjd2000s.size() * 3u);
+    acc_v(mjd2000s, retval);
+    return retval;
+}
+
 std::array<double, 6> jpl_lp::elements(double mjd2000, kep3::elements_type el_type) const
 {
     auto elements = _f_elements(mjd2000);
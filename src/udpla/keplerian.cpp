@@ -8,29 +8,141 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <limits>
 
 #include <chrono>
+#include <cstddef>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+
 #include <kep3/core_astro/constants.hpp>
 #include <kep3/core_astro/convert_anomalies.hpp>
 #include <kep3/core_astro/mee2par2mee.hpp>
 #include <kep3/core_astro/ic2mee2ic.hpp>
 #include <kep3/core_astro/ic2par2ic.hpp>
 #include <kep3/core_astro/propagate_lagrangian.hpp>
+#include <kep3/detail/perifocal.hpp>
 #include <kep3/epoch.hpp>
 #include <kep3/planet.hpp>
 #include <kep3/udpla/keplerian.hpp>
 
+namespace kep3::detail
+{
+
+perifocal_data perifocal_setup(const std::array<std::array<double, 3>, 2> &pos_vel, double mu, double ref_mjd2000)
+{
+    const auto &[r, v] = pos_vel;
+    const double R = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+    const double v2 = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+    const double rv = r[0] * v[0] + r[1] * v[1] + r[2] * v[2];
+    // Angular momentum.
+    const std::array<double, 3> h = {r[1] * v[2] - r[2] * v[1], r[2] * v[0] - r[0] * v[2], r[0] * v[1] - r[1] * v[0]};
+    const double H = std::sqrt(h[0] * h[0] + h[1] * h[1] + h[2] * h[2]);
+    // Eccentricity vector e = ((v^2 - mu / R) r - (r.v) v) / mu.
+    std::array<double, 3> e{};
+    for (auto i = 0u; i < 3u; ++i) {
+        e[i] = ((v2 - mu / R) * r[i] - rv * v[i]) / mu;
+    }
+    perifocal_data d{};
+    d.mu = mu;
+    d.ref_mjd2000 = ref_mjd2000;
+    d.ecc = std::sqrt(e[0] * e[0] + e[1] * e[1] + e[2] * e[2]);
+    d.a = -mu / 2. / (v2 / 2. - mu / R);
+    d.ellipse = d.a > 0.;
+    d.n = std::sqrt(mu / std::abs(d.a * d.a * d.a));
+    // For a circular orbit the periapsis is taken at the reference position.
+    const auto &P_dir = d.ecc > std::numeric_limits<double>::epsilon() ? e : r;
+    const double P_norm = d.ecc > std::numeric_limits<double>::epsilon() ? d.ecc : R;
+    for (auto i = 0u; i < 3u; ++i) {
+        d.P[i] = P_dir[i] / P_norm;
+    }
+    d.Q = {(h[1] * d.P[2] - h[2] * d.P[1]) / H, (h[2] * d.P[0] - h[0] * d.P[2]) / H,
+           (h[0] * d.P[1] - h[1] * d.P[0]) / H};
+    // True anomaly at the reference epoch, then mean (or hyperbolic mean) anomaly.
+    const double f0 = std::atan2(r[0] * d.Q[0] + r[1] * d.Q[1] + r[2] * d.Q[2],
+                                 r[0] * d.P[0] + r[1] * d.P[1] + r[2] * d.P[2]);
+    d.anomaly0 = d.ellipse ? kep3::f2m(f0, d.ecc) : kep3::f2n(f0, d.ecc);
+    return d;
+}
+
+} // namespace kep3::detail
+
 namespace kep3::udpla
 {
 
+namespace
+{
+
+using kep3::detail::perifocal_data;
+using kep3::detail::perifocal_setup;
+
+// The epochs are processed in chunks of this size, using buffers on the stack. The chunks are
+// processed in parallel for more than par_threshold epochs.
+constexpr std::size_t chunk = 256u;
+constexpr std::size_t par_threshold = 50000u;
+
+// Calls f(i, x, y, vx, vy) for each epoch, with the position and velocity in the perifocal frame.
+// Kepler's equation is solved for a chunk of epochs at once by the vectorized anomaly conversions.
+template <typename F>
+void perifocal_for_each(const perifocal_data &d, std::span<const double> mjd2000s, const F &f)
+{
+    const auto size = mjd2000s.size();
+    const std::span<const double> ecc(&d.ecc, 1u);
+    const double b = d.ellipse ? d.a * std::sqrt(1. - d.ecc * d.ecc) : -d.a * std::sqrt(d.ecc * d.ecc - 1.);
+    const double sqrt_mu_a = std::sqrt(std::abs(d.mu * d.a));
+
+    const auto process = [&](std::size_t begin, std::size_t end) {
+        std::array<double, chunk> buffer{};
+        const std::span<double> anomalies(buffer.data(), end - begin);
+        for (std::size_t l = 0u; l < anomalies.size(); ++l) {
+            anomalies[l] = d.anomaly0 + d.n * (mjd2000s[begin + l] - d.ref_mjd2000) * kep3::DAY2SEC;
+        }
+        if (d.ellipse) {
+            kep3::m2e(anomalies, ecc, anomalies);
+            for (std::size_t l = 0u; l < anomalies.size(); ++l) {
+                const double sinE = std::sin(anomalies[l]), cosE = std::cos(anomalies[l]);
+                const double R = d.a * (1. - d.ecc * cosE);
+                f(begin + l, d.a * (cosE - d.ecc), b * sinE, -sqrt_mu_a * sinE / R, sqrt_mu_a * b / d.a * cosE / R);
+            }
+        } else {
+            kep3::n2h(anomalies, ecc, anomalies);
+            for (std::size_t l = 0u; l < anomalies.size(); ++l) {
+                const double sinhH = std::sinh(anomalies[l]), coshH = std::cosh(anomalies[l]);
+                const double R = d.a * (1. - d.ecc * coshH);
+                f(begin + l, d.a * (coshH - d.ecc), b * sinhH, -sqrt_mu_a * sinhH / R,
+                  -sqrt_mu_a * b / d.a * coshH / R);
+            }
+        }
+    };
+
+    const auto n_chunks = (size + chunk - 1u) / chunk;
+    if (size < par_threshold) {
+        for (std::size_t c = 0u; c < n_chunks; ++c) {
+            process(c * chunk, std::min(size, (c + 1u) * chunk));
+        }
+    } else {
+        oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<std::size_t>(0u, n_chunks),
+                                  [&](const oneapi::tbb::blocked_range<std::size_t> &range) {
+                                      for (auto c = range.begin(); c != range.end(); ++c) {
+                                          process(c * chunk, std::min(size, (c + 1u) * chunk));
+                                      }
+                                  });
+    }
+}
+
+} // namespace
+
 keplerian::keplerian(const epoch &ref_epoch, const std::array<std::array<double, 3>, 2> &pos_vel,
                      double mu_central_body, std::string name, std::array<double, 3> added_params)
     : m_ref_epoch(ref_epoch), m_name(std::move(name)), m_mu_central_body(mu_central_body), m_mu_self(added_params[0]),
@@ -104,6 +216,47 @@ std::array<std::array<double, 3>, 2> keplerian::eph(double mjd2000) const
     return retval;
 }
 
+// The vectorized version of eph, avoiding one full Lagrangian propagation per epoch.
+void keplerian::eph_v(std::span<const double> mjd2000s, std::span<double> out) const
+{
+    kep3::detail::check_vectorized_output("eph_v", mjd2000s.size(), 6u, out.size());
+    const auto d = perifocal_setup(m_pos_vel_0, m_mu_central_body, m_ref_epoch.mjd2000());
+    perifocal_for_each(d, mjd2000s, [&d, &out](std::size_t i, double x, double y, double vx, double vy) {
+        for (auto j = 0u; j < 3u; ++j) {
+            out[6u * i + j] = x * d.P[j] + y * d.Q[j];
+            out[6u * i + 3u + j] = vx * d.P[j] + vy * d.Q[j];
+        }
+    });
+}
+
+std::vector<double> keplerian::eph_v(const std::vector<double> &mjd2000s) const
+{
+    std::vector<double> retval(mjd2000s.size() * 6u);
+    eph_v(mjd2000s, retval);
+    return retval;
+}
+
+// The Keplerian acceleration, evaluated with the same kernel as eph_v.
+void keplerian::acc_v(std::span<const double> mjd2000s, std::span<double> out) const
+{
+    kep3::detail::check_vectorized_output("acc_v", mjd2000s.size(), 3u, out.size());
+    const auto d = perifocal_setup(m_pos_vel_0, m_mu_central_body, m_ref_epoch.mjd2000());
+    perifocal_for_each(d, mjd2000s, [&d, &out](std::size_t i, double x, double y, double, double) {
+        const double R = std::sqrt(x * x + y * y);
+        const double coeff = -d.mu / (R * R * R);
+        for (auto j = 0u; j < 3u; ++j) {
+            out[3u * i + j] = coeff * (x * d.P[j] + y * d.Q[j]);
+        }
+    });
+}
+
+std::vector<double> keplerian::acc_v(const std::vector<double> &mjd2000s) const
+{
+    std::vector<double> retval(mjd2000s.size() * 3u);
+    acc_v(mjd2000s, retval);
+    return retval;
+}
+
 std::string keplerian::get_name() const
 {
     return m_name;
@@ -139,6 +292,11 @@ kep3::epoch keplerian::get_ref_epoch() const
     return m_ref_epoch;
 }
 
+std::array<std::array<double, 3>, 2> keplerian::get_ref_pos_vel() const
+{
+    return m_pos_vel_0;
+}
+
 //std::array<double, 6> keplerian::elements(double, kep3::elements_type el_type) const
 //{
 //    std::array<double, 6> retval{};
@@ -8,29 +8,39 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <array>
-#include <cassert>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/container_hash/hash.hpp>
+#include <boost/serialization/version.hpp>
 
 #include <fmt/core.h>
 
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+
 #include <heyoka/expression.hpp>
+#include <heyoka/kw.hpp>
 #include <heyoka/llvm_state.hpp>
 #include <heyoka/model/vsop2013.hpp>
 
 #include <kep3/core_astro/constants.hpp>
+#include <kep3/detail/jit_cache.hpp>
+#include <kep3/detail/lru_cache.hpp>
 #include <kep3/detail/s11n.hpp>
 #include <kep3/planet.hpp>
 #include <kep3/udpla/vsop2013.hpp>
@@ -50,12 +60,16 @@ const std::unordered_map<std::string, std::uint32_t> pl_idx_map
     = {{"mercury", 1u}, {"venus", 2u},  {"earth_moon", 3u}, {"mars", 4u}, {"jupiter", 5u},
        {"saturn", 6u},  {"uranus", 7u}, {"neptune", 8u},    {"pluto", 9u}};
 
+// The key of the JIT cache: planet index, threshold and batch size.
+using state_key_t = std::tuple<std::uint32_t, double, std::uint32_t>;
+
 // Hasher for the JIT cache.
 struct state_dict_hasher {
-    std::size_t operator()(const std::pair<std::uint32_t, double> &p) const noexcept
+    std::size_t operator()(const state_key_t &k) const noexcept
     {
-        std::size_t seed = std::hash<std::uint32_t>{}(p.first);
-        boost::hash_combine(seed, std::hash<double>{}(p.second));
+        std::size_t seed = std::hash<std::uint32_t>{}(std::get<0>(k));
+        boost::hash_combine(seed, std::hash<double>{}(std::get<1>(k)));
+        boost::hash_combine(seed, std::hash<std::uint32_t>{}(std::get<2>(k)));
 
         return seed;
     }
@@ -63,11 +77,38 @@ struct state_dict_hasher {
 
 // The JIT cache.
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::unordered_map<std::pair<std::uint32_t, double>, heyoka::llvm_state, state_dict_hasher> state_dict;
+kep3::detail::lru_cache<state_key_t, heyoka::llvm_state, state_dict_hasher> state_dict("vsop2013");
 
-// Mutex for thread-safe access to the cache.
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-std::mutex state_dict_mutex;
+// eph_v splits epoch vectors larger than this across threads, in ranges of at least par_grain epochs.
+constexpr std::size_t par_threshold = 20000u;
+constexpr std::size_t par_grain = 2048u;
+
+// Fetches the compiled state from the cache, creating it on a miss. The state contains a single function (eval_f),
+// compiled with the given batch size: 1 for eph, the SIMD width of the host for eph_v.
+// NOTE: the compiled state may also come from the persistent JIT cache.
+std::shared_ptr<const heyoka::llvm_state> get_state(std::uint32_t pl_index, double thresh, std::uint32_t batch_size)
+{
+    return state_dict.get_ptr({pl_index, thresh, batch_size}, [&]() {
+        return kep3::detail::jit_cache_load_or_build<heyoka::llvm_state>(
+            "vsop2013", fmt::format("pl={};thresh={:a};batch_size={}", pl_index, thresh, batch_size), [&]() {
+                // Time variable.
+                auto tm = heyoka::expression("tm");
+
+                // Create the expression for the VSOP2013 solution.
+                // NOTE: we use (tm - 0.5) / 365250 as time coordinate because:
+                // - VSOP2013 counts time from J2000 and not MJD2000 (they differ by 12 hours),
+                // - VSOP2013 measures time in thousands of Julian years.
+                auto v_ex = heyoka::model::vsop2013_cartesian_icrf(
+                    pl_index, heyoka::kw::time_expr = (tm - 0.5) / 365250., heyoka::kw::thresh = thresh);
+
+                // Create the llvm_state and add the compiled function.
+                heyoka::llvm_state st;
+                heyoka::add_cfunc<double>(st, "eval_f", v_ex, {tm}, heyoka::kw::batch_size = batch_size);
+                st.compile();
+                return st;
+            });
+    });
+}
 
 } // namespace
 
@@ -81,23 +122,49 @@ struct vsop2013::impl {
     double m_mu = 0;
     std::string m_pl_name;
     double m_thresh = 0;
+    // The same function compiled in batch mode (inputs and outputs laid out as [component][lane]), used by eph_v.
+    // NOTE: most objects only ever call eph, hence the batch function is fetched (and, on a miss of both caches,
+    // compiled) on the first call to eph_v. It is neither copied nor serialized.
+    std::uint32_t m_batch_size = heyoka::recommended_simd_size<double>();
+    std::once_flag m_batch_flag;
+    heyoka::llvm_state m_batch_state;
+    fptr_t eval_f_batch = nullptr;
 
     impl() = default;
     explicit impl(heyoka::llvm_state s, double mu, std::string pl_name, double thresh)
         : m_state(std::move(s)), m_mu(mu), m_pl_name(std::move(pl_name)), m_thresh(thresh)
     {
-        eval_f = reinterpret_cast<fptr_t>(m_state.jit_lookup("eval_f"));
+        lookup();
     }
     impl(impl &&) noexcept = delete;
     impl(const impl &other)
         : m_state(other.m_state), m_mu(other.m_mu), m_pl_name(other.m_pl_name), m_thresh(other.m_thresh)
     {
-        eval_f = reinterpret_cast<fptr_t>(m_state.jit_lookup("eval_f"));
+        lookup();
     }
     impl &operator=(impl &&) noexcept = delete;
     impl &operator=(const impl &) = delete;
     ~impl() = default;
 
+    void lookup()
+    {
+        eval_f = reinterpret_cast<fptr_t>(m_state.jit_lookup("eval_f"));
+    }
+
+    // Returns the batch function, fetching it on the first call. Thread safe.
+    fptr_t get_eval_f_batch()
+    {
+        std::call_once(m_batch_flag, [this]() {
+            if (m_batch_size == 1u) {
+                eval_f_batch = eval_f;
+                return;
+            }
+            m_batch_state = *detail::get_state(detail::pl_idx_map.at(m_pl_name), m_thresh, m_batch_size);
+            eval_f_batch = reinterpret_cast<fptr_t>(m_batch_state.jit_lookup("eval_f"));
+        });
+        return eval_f_batch;
+    }
+
     void save(boost::archive::binary_oarchive &ar, unsigned) const
     {
         ar << m_state;
@@ -105,18 +172,32 @@ struct vsop2013::impl {
         ar << m_pl_name;
         ar << m_thresh;
     }
-    void load(boost::archive::binary_iarchive &ar, unsigned)
+    void load(boost::archive::binary_iarchive &ar, unsigned version)
     {
         ar >> m_state;
         ar >> m_mu;
         ar >> m_pl_name;
         ar >> m_thresh;
-
-        eval_f = reinterpret_cast<fptr_t>(m_state.jit_lookup("eval_f"));
+        if (version == 1u) {
+            // The archives of version 1 also store the batch size of the batch function, which is now compiled on
+            // the first call to eph_v on the loading host.
+            std::uint32_t batch_size = 0;
+            ar >> batch_size;
+        }
+
+        lookup();
     }
     BOOST_SERIALIZATION_SPLIT_MEMBER()
 };
 
+} // namespace kep3::udpla
+
+// NOTE: version 1 added the batch size, version 2 removed it (the batch function is compiled lazily).
+BOOST_CLASS_VERSION(kep3::udpla::vsop2013::impl, 2)
+
+namespace kep3::udpla
+{
+
 vsop2013::vsop2013() : vsop2013("mercury") {}
 
 vsop2013::vsop2013(std::string pl_name, double thresh)
@@ -140,37 +221,11 @@ vsop2013::vsop2013(std::string pl_name, double thresh)
     // The original mu is in AU**3/day**2, convert it to SI units.
     mu = mu * kep3::AU * kep3::AU * kep3::AU / (kep3::DAY2SEC * kep3::DAY2SEC);
 
-    // Lock down for access to the cache.
-    std::lock_guard lock(detail::state_dict_mutex);
-
-    if (auto it = detail::state_dict.find({pl_index, thresh}); it == detail::state_dict.end()) {
-        // Cache miss, we need to create a new compiled function.
+    // NOTE: only the scalar function is fetched here, the batch one is fetched by the first call to eph_v.
+    const auto s = detail::get_state(pl_index, thresh, 1u);
 
-        // Time variable.
-        auto tm = heyoka::expression("tm");
-
-        // Create the expression for the VSOP2013 solution.
-        // NOTE: we use (tm - 0.5) / 365250 as time coordinate because:
-        // - VSOP2013 counts time from J2000 and not MJD2000 (they differ by 12 hours),
-        // - VSOP2013 measures time in thousands of Julian years.
-        auto v_ex = heyoka::model::vsop2013_cartesian_icrf(pl_index, heyoka::kw::time_expr = (tm - 0.5) / 365250.,
-                                                           heyoka::kw::thresh = thresh);
-
-        // Create the llvm_state and add the compiled function.
-        heyoka::llvm_state s;
-        heyoka::add_cfunc<double>(s, "eval_f", v_ex, {tm});
-        s.compile();
-
-        // Add the compiled state to the cache.
-        [[maybe_unused]] auto [_, flag] = detail::state_dict.insert({{pl_index, thresh}, s});
-        assert(flag);
-
-        // Build the impl.
-        m_impl = std::make_unique<impl>(std::move(s), mu, std::move(pl_name), thresh);
-    } else {
-        // Cache hit, build the impl from the cache content.
-        m_impl = std::make_unique<impl>(it->second, mu, std::move(pl_name), thresh);
-    }
+    // Build the impl (which holds a copy of the state, as cache entries can be evicted).
+    m_impl = std::make_unique<impl>(*s, mu, std::move(pl_name), thresh);
 }
 
 vsop2013::vsop2013(vsop2013 &&) noexcept = default;
@@ -217,6 +272,53 @@ std::array<std::array<double, 3>, 2> vsop2013::eph(double mjd2000) const
          {{out[3] * kep3::AU / kep3::DAY2SEC, out[4] * kep3::AU / kep3::DAY2SEC, out[5] * kep3::AU / kep3::DAY2SEC}}}};
 }
 
+void vsop2013::eph_v(std::span<const double> mjd2000s, std::span<double> out) const
+{
+    kep3::detail::check_vectorized_output("eph_v", mjd2000s.size(), 6u, out.size());
+    const auto size = mjd2000s.size();
+    auto *f = m_impl->get_eval_f_batch();
+    const std::size_t batch_size = m_impl->m_batch_size;
+
+    // Evaluates the epochs in [begin, end), batch_size at a time. The last batch is padded
+    // by repeating its last epoch.
+    auto eval_range = [&](std::size_t begin, std::size_t end) {
+        std::vector<double> in(batch_size), b_out(batch_size * 6u);
+        for (auto base = begin; base < end; base += batch_size) {
+            const auto n_b = std::min(batch_size, end - base);
+            std::copy(mjd2000s.begin() + static_cast<std::ptrdiff_t>(base),
+                      mjd2000s.begin() + static_cast<std::ptrdiff_t>(base + n_b), in.begin());
+            std::fill(in.begin() + static_cast<std::ptrdiff_t>(n_b), in.end(), mjd2000s[base + n_b - 1u]);
+            f(b_out.data(), in.data(), nullptr, nullptr);
+            for (std::size_t j = 0u; j < n_b; ++j) {
+                auto *pos_vel = out.data() + 6u * (base + j);
+                for (auto k = 0u; k < 3u; ++k) {
+                    pos_vel[k] = b_out[k * batch_size + j] * kep3::AU;
+                    pos_vel[k + 3u] = b_out[(k + 3u) * batch_size + j] * kep3::AU / kep3::DAY2SEC;
+                }
+            }
+        }
+    };
+
+    if (size < detail::par_threshold) {
+        eval_range(0u, size);
+    } else {
+        // The ranges are aligned to the batch size, so that only the last one needs padding.
+        const auto n_batches = (size + batch_size - 1u) / batch_size;
+        oneapi::tbb::parallel_for(
+            oneapi::tbb::blocked_range<std::size_t>(0u, n_batches, detail::par_grain / batch_size + 1u),
+            [&](const oneapi::tbb::blocked_range<std::size_t> &range) {
+                eval_range(range.begin() * batch_size, std::min(range.end() * batch_size, size));
+            });
+    }
+}
+
+std::vector<double> vsop2013::eph_v(const std::vector<double> &mjd2000s) const
+{
+    std::vector<double> retval(mjd2000s.size() * 6u);
+    eph_v(mjd2000s, retval);
+    return retval;
+}
+
 std::string vsop2013::get_name() const
 {
     return fmt::format("vsop2013 {}, threshold={}", m_impl->m_pl_name, m_impl->m_thresh);
@@ -8,10 +8,18 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <cmath>
 #include <random>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
+#include <kep3/core_astro/constants.hpp>
 #include <kep3/core_astro/convert_anomalies.hpp>
+#include <kep3/core_astro/kepler_equations.hpp>
+#include <kep3/detail/kepler_simd.hpp>
 
 #include "catch.hpp"
 
@@ -142,4 +150,115 @@ TEST_CASE("nans")
     REQUIRE(!std::isfinite(kep3::f2h(0.3, 0.1)));
     REQUIRE(!std::isfinite(kep3::zeta2f(0.3, 0.1)));
     REQUIRE(!std::isfinite(kep3::f2zeta(0.3, 0.1)));
-}
\ No newline at end of file
+}
+TEST_CASE("kepDE_simd")
+{
+    // NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp)
+    std::mt19937 rng_engine(1220202343u);
+    std::uniform_real_distribution<double> ecc_d(0., 0.99);
+    std::uniform_real_distribution<double> M_d(-kep3::pi, kep3::pi);
+    std::uniform_real_distribution<double> s0_d(-0.5, 0.5);
+
+    // The eccentric anomaly (kepE), against m2e. The odd size exercises the last partial pack.
+    const auto N = 10001u;
+    std::vector<double> M(N), ecc(N), E(N);
+    for (auto i = 0u; i < N; ++i) {
+        M[i] = M_d(rng_engine);
+        ecc[i] = ecc_d(rng_engine);
+        E[i] = M[i];
+    }
+    const double zero = 0.;
+    kep3::detail::kepDE_simd(N, M.data(), &zero, 0u, ecc.data(), 1u, kep3::pi, E.data());
+    for (auto i = 0u; i < N; ++i) {
+        REQUIRE(std::abs(E[i] - m2e(M[i], ecc[i])) < 1e-13);
+    }
+
+    // The eccentric anomaly difference (kepDE), against its residual.
+    std::vector<double> s0(N), DE(N);
+    for (auto i = 0u; i < N; ++i) {
+        s0[i] = s0_d(rng_engine) * std::sqrt(1. - ecc[i] * ecc[i]);
+        DE[i] = M[i];
+    }
+    kep3::detail::kepDE_simd(N, M.data(), s0.data(), 1u, ecc.data(), 1u, kep3::pi, DE.data());
+    for (auto i = 0u; i < N; ++i) {
+        REQUIRE(std::abs(kep3::kepDE(DE[i], M[i], s0[i], 1., 1., 1. - ecc[i])) < 1e-13);
+    }
+
+    // Lanes outside the domain of the vectorized kernel go to the scalar fallback.
+    const double M_big = 2e5, ecc_big = 0.5;
+    double E_big = M_big;
+    kep3::detail::kepDE_simd(1u, &M_big, &zero, 0u, &ecc_big, 0u, kep3::pi, &E_big);
+    REQUIRE(std::abs(kep3::kepE(E_big, M_big, ecc_big)) < 1e-10);
+}
+
+TEST_CASE("kepDH_simd")
+{
+    // NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp)
+    std::mt19937 rng_engine(1220202343u);
+    std::uniform_real_distribution<double> ecc_d(1.01, 20.);
+    std::uniform_real_distribution<double> N_d(-50., 50.);
+
+    // The hyperbolic anomaly (kepH), against n2h.
+    const auto N = 10001u;
+    std::vector<double> Ns(N), ecc(N), H(N, 1.);
+    for (auto i = 0u; i < N; ++i) {
+        Ns[i] = N_d(rng_engine);
+        ecc[i] = ecc_d(rng_engine);
+    }
+    const double zero = 0.;
+    kep3::detail::kepDH_simd(N, Ns.data(), &zero, 0u, ecc.data(), 1u, 20 * kep3::pi, H.data());
+    for (auto i = 0u; i < N; ++i) {
+        REQUIRE(std::abs(H[i] - kep3::n2h(Ns[i], ecc[i])) < 1e-13);
+    }
+}
+
+TEST_CASE("array_conversions")
+{
+    using conv_t = double (*)(double, double);
+    using conv_v_t = void (*)(std::span<const double>, std::span<const double>, std::span<double>);
+    // NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp)
+    std::mt19937 rng_engine(1220202343u);
+    std::uniform_real_distribution<double> ecc_d(0., 2.);
+    std::uniform_real_distribution<double> x_d(-10., 10.);
+
+    // Large enough to be processed in parallel, with eccentricities both below and above 1.
+    const auto N = 100001u;
+    std::vector<double> xs(N), eccs(N), out(N);
+    for (auto i = 0u; i < N; ++i) {
+        xs[i] = x_d(rng_engine);
+        eccs[i] = ecc_d(rng_engine);
+    }
+    const std::vector<std::pair<conv_t, conv_v_t>> convs
+        = {{kep3::m2e, kep3::m2e},     {kep3::e2m, kep3::e2m},       {kep3::e2f, kep3::e2f},
+           {kep3::f2e, kep3::f2e},     {kep3::m2f, kep3::m2f},       {kep3::f2m, kep3::f2m},
+           {kep3::zeta2f, kep3::zeta2f}, {kep3::f2zeta, kep3::f2zeta}, {kep3::n2h, kep3::n2h},
+           {kep3::h2n, kep3::h2n},     {kep3::h2f, kep3::h2f},       {kep3::f2h, kep3::f2h},
+           {kep3::n2f, kep3::n2f},     {kep3::f2n, kep3::f2n}};
+    for (const auto &[conv, conv_v] : convs) {
+        // Per element eccentricities.
+        conv_v(xs, eccs, out);
+        for (auto i = 0u; i < N; ++i) {
+            const auto ref = conv(xs[i], eccs[i]);
+            REQUIRE(std::isfinite(ref) == std::isfinite(out[i]));
+            if (std::isfinite(ref)) {
+                REQUIRE(std::abs(out[i] - ref) <= 1e-13 * std::max(1., std::abs(ref)));
+            }
+        }
+        // Shared eccentricity, in place.
+        for (const double ecc : {0.3, 1.7}) {
+            std::vector<double> in_out(xs.begin(), xs.begin() + 1001);
+            conv_v(in_out, std::vector<double>{ecc}, in_out);
+            for (auto i = 0u; i < in_out.size(); ++i) {
+                const auto ref = conv(xs[i], ecc);
+                REQUIRE(std::isfinite(ref) == std::isfinite(in_out[i]));
+                if (std::isfinite(ref)) {
+                    REQUIRE(std::abs(in_out[i] - ref) <= 1e-13 * std::max(1., std::abs(ref)));
+                }
+            }
+        }
+        // Inconsistent sizes.
+        std::vector<double> short_out(N - 1u);
+        REQUIRE_THROWS_AS(conv_v(xs, eccs, short_out), std::invalid_argument);
+        REQUIRE_THROWS_AS(conv_v(xs, std::vector<double>{0.1, 0.2}, out), std::invalid_argument);
+    }
+}
@@ -0,0 +1,214 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/serialization/vector.hpp>
+
+#include <kep3/detail/jit_cache.hpp>
+#include <kep3/detail/lru_cache.hpp>
+#include <kep3/jit_cache.hpp>
+
+#include "catch.hpp"
+
+using kep3::detail::jit_cache_load_or_build;
+
+TEST_CASE("jit_cache")
+{
+    const auto dir = std::filesystem::temp_directory_path() / "kep3_jit_cache_test";
+    std::filesystem::remove_all(dir);
+    const auto old_dir = kep3::get_jit_cache_dir();
+
+    unsigned n_builds = 0u;
+    const auto build = [&n_builds]() {
+        ++n_builds;
+        return std::vector<double>{1., 2., 3.};
+    };
+
+    // Disabled cache: the object is always built, and nothing is recorded.
+    kep3::set_jit_cache_dir("");
+    REQUIRE(kep3::get_jit_cache_dir().empty());
+    kep3::reset_jit_cache_stats();
+    REQUIRE(jit_cache_load_or_build<std::vector<double>>("test", "a", build) == std::vector<double>{1., 2., 3.});
+    REQUIRE(jit_cache_load_or_build<std::vector<double>>("test", "a", build) == std::vector<double>{1., 2., 3.});
+    REQUIRE(n_builds == 2u);
+    REQUIRE(kep3::get_jit_cache_stats().misses == 0u);
+    REQUIRE(kep3::get_jit_cache_stats().hits == 0u);
+
+    // Enabled cache: the first request is a miss, the following ones are hits.
+    kep3::set_jit_cache_dir(dir.string());
+    REQUIRE(kep3::get_jit_cache_dir() == dir.string());
+    n_builds = 0u;
+    REQUIRE(jit_cache_load_or_build<std::vector<double>>("test", "a", build) == std::vector<double>{1., 2., 3.});
+    REQUIRE(jit_cache_load_or_build<std::vector<double>>("test", "a", build) == std::vector<double>{1., 2., 3.});
+    REQUIRE(n_builds == 1u);
+    auto stats = kep3::get_jit_cache_stats();
+    REQUIRE(stats.misses == 1u);
+    REQUIRE(stats.stores == 1u);
+    REQUIRE(stats.hits == 1u);
+    REQUIRE(stats.errors == 0u);
+
+    // Different parameters are a different object.
+    REQUIRE(jit_cache_load_or_build<std::vector<double>>("test", "b", build) == std::vector<double>{1., 2., 3.});
+    REQUIRE(n_builds == 2u);
+    REQUIRE(kep3::get_jit_cache_stats().misses == 2u);
+
+    // Corrupted files are counted as errors, rebuilt and overwritten.
+    for (const auto &file : std::filesystem::directory_iterator(dir)) {
+        std::ofstream(file.path(), std::ios::binary | std::ios::trunc) << "garbage";
+    }
+    kep3::reset_jit_cache_stats();
+    REQUIRE(jit_cache_load_or_build<std::vector<double>>("test", "a", build) == std::vector<double>{1., 2., 3.});
+    REQUIRE(n_builds == 3u);
+    stats = kep3::get_jit_cache_stats();
+    REQUIRE(stats.errors == 1u);
+    REQUIRE(stats.misses == 1u);
+    REQUIRE(stats.stores == 1u);
+    REQUIRE(jit_cache_load_or_build<std::vector<double>>("test", "a", build) == std::vector<double>{1., 2., 3.});
+    REQUIRE(n_builds == 3u);
+    REQUIRE(kep3::get_jit_cache_stats().hits == 1u);
+
+    // Reset.
+    kep3::reset_jit_cache_stats();
+    stats = kep3::get_jit_cache_stats();
+    REQUIRE(stats.hits + stats.misses + stats.stores + stats.errors == 0u);
+
+    kep3::set_jit_cache_dir(old_dir);
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("lru_cache")
+{
+    kep3::detail::lru_cache<double, std::vector<double>> cache("test_lru");
+    unsigned n_builds = 0u;
+    const auto build = [&n_builds](double x) {
+        return [&n_builds, x]() {
+            ++n_builds;
+            return std::vector<double>(100u, x);
+        };
+    };
+
+    // Unbounded by default.
+    REQUIRE(kep3::get_jit_memory_cache_capacity() == 0u);
+    for (auto i = 0; i < 5; ++i) {
+        REQUIRE((*cache.get_ptr(i, build(i)))[0] == i);
+    }
+    REQUIRE((*cache.get_ptr(0., build(0.)))[0] == 0.);
+    REQUIRE(n_builds == 5u);
+    REQUIRE(cache.size() == 5u);
+
+    auto stats = kep3::get_jit_memory_cache_stats().at("test_lru");
+    REQUIRE(stats.size == 5u);
+    REQUIRE(stats.hits == 1u);
+    REQUIRE(stats.misses == 5u);
+    REQUIRE(stats.evictions == 0u);
+    REQUIRE(stats.compile_time >= 0.);
+    REQUIRE(stats.resident_bytes >= 5u * 100u * sizeof(double));
+
+    // Setting the capacity trims right away, evicting the least recently used entries (1 and 2, as 0 was
+    // used last).
+    kep3::set_jit_memory_cache_capacity(3u);
+    REQUIRE(kep3::get_jit_memory_cache_capacity() == 3u);
+    REQUIRE(cache.size() == 3u);
+    stats = kep3::get_jit_memory_cache_stats().at("test_lru");
+    REQUIRE(stats.evictions == 2u);
+    REQUIRE(stats.resident_bytes >= 3u * 100u * sizeof(double));
+    REQUIRE(stats.resident_bytes < 4u * 100u * sizeof(double));
+    cache.get_ptr(0., build(0.));
+    cache.get_ptr(3., build(3.));
+    cache.get_ptr(4., build(4.));
+    REQUIRE(n_builds == 5u);
+    cache.get_ptr(1., build(1.));
+    REQUIRE(n_builds == 6u);
+
+    // Objects held through the returned pointers outlive their eviction.
+    const auto ptr = cache.get_ptr(5., build(5.));
+    cache.get_ptr(6., build(6.));
+    cache.get_ptr(7., build(7.));
+    cache.get_ptr(8., build(8.));
+    REQUIRE((*ptr)[0] == 5.);
+    REQUIRE(cache.size() == 3u);
+
+    // Reset.
+    kep3::reset_jit_memory_cache_stats();
+    stats = kep3::get_jit_memory_cache_stats().at("test_lru");
+    REQUIRE(stats.hits + stats.misses + stats.evictions == 0u);
+    REQUIRE(stats.size == 3u);
+
+    kep3::set_jit_memory_cache_capacity(0u);
+}
+
+TEST_CASE("lru_cache_concurrency")
+{
+    kep3::detail::lru_cache<double, std::vector<double>> cache("test_lru_concurrency");
+    std::atomic<unsigned> n_builds{0u};
+    std::promise<void> started, go;
+    auto go_fut = go.get_future().share();
+
+    // A thread builds the key 0 and blocks in the middle of the build.
+    std::thread t0([&]() {
+        cache.get_ptr(0., [&]() {
+            ++n_builds;
+            started.set_value();
+            go_fut.wait();
+            return std::vector<double>(10u, 0.);
+        });
+    });
+    started.get_future().wait();
+
+    // Meanwhile other keys are built and looked up.
+    REQUIRE((*cache.get_ptr(1., [&]() {
+        ++n_builds;
+        return std::vector<double>(10u, 1.);
+    }))[0] == 1.);
+
+    // A second thread asking for the key 0 waits for the first build.
+    std::thread t1([&]() {
+        const auto ptr = cache.get_ptr(0., [&]() {
+            ++n_builds;
+            return std::vector<double>(10u, -1.);
+        });
+        REQUIRE((*ptr)[0] == 0.);
+    });
+    go.set_value();
+    t0.join();
+    t1.join();
+    REQUIRE(n_builds == 2u);
+    REQUIRE(cache.size() == 2u);
+
+    // A failed build is not cached.
+    REQUIRE_THROWS_AS(cache.get_ptr(2., []() -> std::vector<double> { throw std::runtime_error("failed"); }),
+                      std::runtime_error);
+    REQUIRE(cache.size() == 2u);
+    REQUIRE((*cache.get_ptr(2., []() { return std::vector<double>(10u, 2.); }))[0] == 2.);
+    REQUIRE(cache.size() == 3u);
+}
+
+TEST_CASE("normalize_tol")
+{
+    using kep3::detail::normalize_tol;
+    REQUIRE(kep3::get_jit_cache_tol_digits() == 0u);
+    REQUIRE(normalize_tol(1.0000000001e-10) == 1.0000000001e-10);
+    kep3::set_jit_cache_tol_digits(3u);
+    REQUIRE(kep3::get_jit_cache_tol_digits() == 3u);
+    REQUIRE(normalize_tol(1.0000000001e-10) == 1e-10);
+    REQUIRE(normalize_tol(1e-10) == 1e-10);
+    REQUIRE(normalize_tol(1.2345e-16) == 1.23e-16);
+    REQUIRE(normalize_tol(0.) == 0.);
+    REQUIRE(normalize_tol(-1.) == -1.);
+    kep3::set_jit_cache_tol_digits(0u);
+}
@@ -8,8 +8,12 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <cmath>
 #include <iostream>
+#include <memory>
+#include <span>
 #include <stdexcept>
+#include <vector>
 
 #include <fmt/core.h>
 #include <fmt/ranges.h>
@@ -121,4 +125,280 @@ TEST_CASE("serialization_test")
     auto after = boost::lexical_cast<std::string>(lp2);
     // Compare the string represetation
     REQUIRE(before == after);
-}
\ No newline at end of file
+}
+
+TEST_CASE("lambert_batch")
+{
+    // Here we test that the batched solver returns the same solutions as the class
+    // on a number of randomly generated Lambert Problems
+
+    // NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp)
+    std::mt19937 rng_engine(12201203u);
+    std::uniform_int_distribution<unsigned> cw_d(0, 1);
+    std::uniform_real_distribution<double> r_d(-2, 2);
+    std::uniform_real_distribution<double> tof_d(2., 40.);
+    std::uniform_real_distribution<double> mu_d(0.9, 1.1);
+    const unsigned revs_max = 5u;
+    const unsigned n_sol = 2u * revs_max + 1u;
+    const unsigned trials = 1000u;
+
+    std::vector<double> r0s(3u * trials), r1s(3u * trials), tofs(trials), mus(trials);
+    auto cws = std::make_unique<bool[]>(trials);
+    for (auto i = 0u; i < trials; ++i) {
+        for (auto j = 0u; j < 3u; ++j) {
+            r0s[3u * i + j] = r_d(rng_engine);
+            r1s[3u * i + j] = r_d(rng_engine);
+        }
+        tofs[i] = tof_d(rng_engine);
+        cws[i] = static_cast<bool>(cw_d(rng_engine));
+        mus[i] = mu_d(rng_engine);
+    }
+    std::vector<double> v0s(3u * n_sol * trials), v1s(3u * n_sol * trials);
+    std::vector<unsigned> iters(n_sol * trials);
+    kep3::lambert_batch(r0s, r1s, tofs, mus, std::span<const bool>(cws.get(), trials), v0s, v1s, iters, revs_max);
+
+    for (auto i = 0u; i < trials; ++i) {
+        kep3::lambert_problem lp({r0s[3u * i], r0s[3u * i + 1], r0s[3u * i + 2]},
+                                 {r1s[3u * i], r1s[3u * i + 1], r1s[3u * i + 2]}, tofs[i], mus[i], cws[i], revs_max);
+        for (auto j = 0u; j < n_sol; ++j) {
+            if (j < lp.get_v0().size()) {
+                REQUIRE(iters[n_sol * i + j] == lp.get_iters()[j]);
+                for (auto k = 0u; k < 3u; ++k) {
+                    REQUIRE(v0s[3u * (n_sol * i + j) + k] == lp.get_v0()[j][k]);
+                    REQUIRE(v1s[3u * (n_sol * i + j) + k] == lp.get_v1()[j][k]);
+                }
+            } else {
+                // Non existing solutions are marked.
+                REQUIRE(iters[n_sol * i + j] == 0u);
+                REQUIRE(std::isnan(v0s[3u * (n_sol * i + j)]));
+                REQUIRE(std::isnan(v1s[3u * (n_sol * i + j)]));
+            }
+        }
+    }
+
+    // Shared mu and cw and no iterations requested.
+    std::vector<double> v0(3u), v1(3u);
+    const std::array<bool, 1> cw = {true};
+    kep3::lambert_batch(std::vector<double>{1., 0., 0.}, std::vector<double>{0., 1., 0.},
+                        std::vector<double>{3 * kep3::pi / 2}, std::vector<double>{1.}, cw, v0, v1);
+    REQUIRE(kep3_tests::floating_point_error_vector({v0[0], v0[1], v0[2]}, {0, -1, 0}) < 1e-13);
+    REQUIRE(kep3_tests::floating_point_error_vector({v1[0], v1[1], v1[2]}, {1, 0, 0}) < 1e-13);
+
+    // And we test the throws
+    REQUIRE_THROWS_AS(kep3::lambert_batch(std::vector<double>{1., 0.}, std::vector<double>{0., 1., 0.},
+                                          std::vector<double>{1.}, std::vector<double>{1.}, cw, v0, v1),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(kep3::lambert_batch(std::vector<double>{1., 0., 0.}, std::vector<double>{0., 1., 0.},
+                                          std::vector<double>{1.}, std::vector<double>{1.}, cw, v0, v1, {}, 1u),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(kep3::lambert_batch(std::vector<double>{1., 0., 0.}, std::vector<double>{0., 1., 0.},
+                                          std::vector<double>{-1.}, std::vector<double>{1.}, cw, v0, v1),
+                      std::domain_error);
+    REQUIRE_THROWS_AS(kep3::lambert_batch(std::vector<double>{1., 0., 0.}, std::vector<double>{0., 1., 0.},
+                                          std::vector<double>{1.}, std::vector<double>{-1.}, cw, v0, v1),
+                      std::domain_error);
+}
+
+TEST_CASE("lambert_batch_0rev")
+{
+    // Here we test that the vectorized zero revolution kernel agrees with the class
+    // on a number of randomly generated Lambert Problems. The number of problems is not
+    // a multiple of the lane width, so that partially filled lane groups are exercised too.
+
+    // NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp)
+    std::mt19937 rng_engine(12201203u);
+    std::uniform_int_distribution<unsigned> cw_d(0, 1);
+    std::uniform_real_distribution<double> r_d(-2, 2);
+    std::uniform_real_distribution<double> tof_d(0.1, 40.);
+    std::uniform_real_distribution<double> mu_d(0.9, 1.1);
+    const unsigned trials = 10001u;
+
+    std::vector<double> r0s(3u * trials), r1s(3u * trials), tofs(trials), mus(trials);
+    auto cws = std::make_unique<bool[]>(trials);
+    for (auto i = 0u; i < trials; ++i) {
+        for (auto j = 0u; j < 3u; ++j) {
+            r0s[3u * i + j] = r_d(rng_engine);
+            r1s[3u * i + j] = r_d(rng_engine);
+        }
+        tofs[i] = tof_d(rng_engine);
+        cws[i] = static_cast<bool>(cw_d(rng_engine));
+        mus[i] = mu_d(rng_engine);
+    }
+    std::vector<double> v0s(3u * trials), v1s(3u * trials);
+    std::vector<unsigned> iters(trials);
+    kep3::lambert_batch(r0s, r1s, tofs, mus, std::span<const bool>(cws.get(), trials), v0s, v1s, iters);
+
+    for (auto i = 0u; i < trials; ++i) {
+        const std::array<double, 3> r0 = {r0s[3u * i], r0s[3u * i + 1], r0s[3u * i + 2]};
+        const std::array<double, 3> r1 = {r1s[3u * i], r1s[3u * i + 1], r1s[3u * i + 2]};
+        kep3::lambert_problem lp(r0, r1, tofs[i], mus[i], cws[i], 0u);
+        REQUIRE(iters[i] == lp.get_iters()[0]);
+        const std::array<double, 3> v0 = {v0s[3u * i], v0s[3u * i + 1], v0s[3u * i + 2]};
+        const std::array<double, 3> v1 = {v1s[3u * i], v1s[3u * i + 1], v1s[3u * i + 2]};
+        REQUIRE(kep3_tests::floating_point_error_vector(v0, lp.get_v0()[0]) < 1e-12);
+        REQUIRE(kep3_tests::floating_point_error_vector(v1, lp.get_v1()[0]) < 1e-12);
+        REQUIRE(kep3_tests::delta_guidance_error(r0, r1, v0, mus[i]) < 1e-12);
+    }
+
+    // Fewer problems than lanes.
+    std::vector<double> v0(3u), v1(3u);
+    std::vector<unsigned> it(1u);
+    const std::array<bool, 1> cw = {true};
+    kep3::lambert_batch(std::vector<double>{1., 0., 0.}, std::vector<double>{0., 1., 0.},
+                        std::vector<double>{3 * kep3::pi / 2}, std::vector<double>{1.}, cw, v0, v1, it);
+    REQUIRE(kep3_tests::floating_point_error_vector({v0[0], v0[1], v0[2]}, {0, -1, 0}) < 1e-13);
+    REQUIRE(kep3_tests::floating_point_error_vector({v1[0], v1[1], v1[2]}, {1, 0, 0}) < 1e-13);
+    REQUIRE(it[0] == 3u);
+
+    // Ill defined problems in the middle of a lane group are detected.
+    std::vector<double> r0_bad = {1., 0., 0., 0., 0., 1.};
+    std::vector<double> r1_bad = {0., 1., 0., 0., 1., 0.};
+    std::vector<double> v_bad(6u);
+    REQUIRE_THROWS_AS(kep3::lambert_batch(r0_bad, r1_bad, std::vector<double>{1., 1.}, std::vector<double>{1.}, cw,
+                                          v_bad, v_bad),
+                      std::domain_error);
+}
+
+TEST_CASE("compute_grad")
+{
+    // Here we test the analytical Jacobians against central finite differences
+    // on a number of randomly generated Lambert Problems
+
+    // NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp)
+    std::mt19937 rng_engine(12201203u);
+    std::uniform_int_distribution<unsigned> cw_d(0, 1);
+    std::uniform_real_distribution<double> r_d(-2, 2);
+    std::uniform_real_distribution<double> tof_d(2., 40.);
+    std::uniform_real_distribution<double> mu_d(0.9, 1.1);
+    const unsigned revs_max = 3u;
+    const unsigned trials = 200u;
+    const double h = 1e-6;
+
+    for (auto i = 0u; i < trials; ++i) {
+        std::array<double, 3> r0 = {r_d(rng_engine), r_d(rng_engine), r_d(rng_engine)};
+        std::array<double, 3> r1 = {r_d(rng_engine), r_d(rng_engine), r_d(rng_engine)};
+        const double tof = tof_d(rng_engine);
+        const bool cw = static_cast<bool>(cw_d(rng_engine));
+        const double mu = mu_d(rng_engine);
+        const kep3::lambert_problem lp(r0, r1, tof, mu, cw, revs_max);
+        const auto [dv0, dv1] = lp.compute_grad();
+        REQUIRE(dv0.size() == lp.get_v0().size());
+        REQUIRE(dv1.size() == lp.get_v0().size());
+
+        // Perturbed problems (the perturbations are too small to change the number of solutions).
+        for (auto k = 0u; k < 7u; ++k) {
+            auto r0p = r0, r1p = r1, r0m = r0, r1m = r1;
+            double tofp = tof, tofm = tof;
+            if (k < 3u) {
+                r0p[k] += h;
+                r0m[k] -= h;
+            } else if (k < 6u) {
+                r1p[k - 3u] += h;
+                r1m[k - 3u] -= h;
+            } else {
+                tofp += h;
+                tofm -= h;
+            }
+            const kep3::lambert_problem lpp(r0p, r1p, tofp, mu, cw, revs_max);
+            const kep3::lambert_problem lpm(r0m, r1m, tofm, mu, cw, revs_max);
+            if (lpp.get_Nmax() != lp.get_Nmax() || lpm.get_Nmax() != lp.get_Nmax()) {
+                continue;
+            }
+            for (decltype(dv0.size()) b = 0u; b < dv0.size(); ++b) {
+                for (auto j = 0u; j < 3u; ++j) {
+                    const double fd0 = (lpp.get_v0()[b][j] - lpm.get_v0()[b][j]) / (2. * h);
+                    const double fd1 = (lpp.get_v1()[b][j] - lpm.get_v1()[b][j]) / (2. * h);
+                    REQUIRE(kep3_tests::floating_point_error(dv0[b][7u * j + k], fd0) < 1e-6);
+                    REQUIRE(kep3_tests::floating_point_error(dv1[b][7u * j + k], fd1) < 1e-6);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("lambert_0rev")
+{
+    // Here we test that the single revolution fast path returns the same solution as the class
+    // on a number of randomly generated Lambert Problems
+
+    // NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp)
+    std::mt19937 rng_engine(12201203u);
+    std::uniform_int_distribution<unsigned> cw_d(0, 1);
+    std::uniform_real_distribution<double> r_d(-2, 2);
+    std::uniform_real_distribution<double> tof_d(0.1, 40.);
+    std::uniform_real_distribution<double> mu_d(0.9, 1.1);
+    const unsigned trials = 10000u;
+
+    for (auto i = 0u; i < trials; ++i) {
+        const std::array<double, 3> r0 = {r_d(rng_engine), r_d(rng_engine), r_d(rng_engine)};
+        const std::array<double, 3> r1 = {r_d(rng_engine), r_d(rng_engine), r_d(rng_engine)};
+        const double tof = tof_d(rng_engine);
+        const bool cw = static_cast<bool>(cw_d(rng_engine));
+        const double mu = mu_d(rng_engine);
+        const kep3::lambert_problem lp(r0, r1, tof, mu, cw, 0u);
+        const auto [v0, v1, iters] = kep3::lambert_0rev(r0, r1, tof, mu, cw);
+        REQUIRE(v0 == lp.get_v0()[0]);
+        REQUIRE(v1 == lp.get_v1()[0]);
+        REQUIRE(iters == lp.get_iters()[0]);
+    }
+
+    // And we test the throws
+    REQUIRE_THROWS_AS(kep3::lambert_0rev({1., 0., 0.}, {0., 1., 0.}, -1., 1.), std::domain_error);
+    REQUIRE_THROWS_AS(kep3::lambert_0rev({1., 0., 0.}, {0., 1., 0.}, 1., 0.), std::domain_error);
+    REQUIRE_THROWS_AS(kep3::lambert_0rev({0., 0., 1.}, {0., 1., 0.}, 1., 1.), std::domain_error);
+}
+
+TEST_CASE("warm_start")
+{
+    // Here we test that warm started solves return the same solutions as cold ones
+    // on a number of randomly generated Lambert Problems perturbed in the time of flight
+
+    // NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp)
+    std::mt19937 rng_engine(12201203u);
+    std::uniform_int_distribution<unsigned> cw_d(0, 1);
+    std::uniform_real_distribution<double> r_d(-2, 2);
+    std::uniform_real_distribution<double> tof_d(2., 40.);
+    std::uniform_real_distribution<double> mu_d(0.9, 1.1);
+    std::uniform_real_distribution<double> dtof_d(-0.05, 0.05);
+    const unsigned revs_max = 5u;
+    const unsigned trials = 2000u;
+    unsigned iters_cold = 0u, iters_warm = 0u;
+
+    for (auto i = 0u; i < trials; ++i) {
+        const std::array<double, 3> r0 = {r_d(rng_engine), r_d(rng_engine), r_d(rng_engine)};
+        const std::array<double, 3> r1 = {r_d(rng_engine), r_d(rng_engine), r_d(rng_engine)};
+        const double tof = tof_d(rng_engine);
+        const bool cw = static_cast<bool>(cw_d(rng_engine));
+        const double mu = mu_d(rng_engine);
+        const kep3::lambert_problem lp(r0, r1, tof, mu, cw, revs_max);
+        const double tof2 = tof + dtof_d(rng_engine);
+        const kep3::lambert_problem cold(r0, r1, tof2, mu, cw, revs_max);
+        const kep3::lambert_problem warm(r0, r1, tof2, mu, cw, revs_max, lp.get_x());
+        REQUIRE(warm.get_Nmax() == cold.get_Nmax());
+        for (decltype(cold.get_v0().size()) j = 0u; j < cold.get_v0().size(); ++j) {
+            REQUIRE(kep3_tests::floating_point_error_vector(warm.get_v0()[j], cold.get_v0()[j]) < 1e-10);
+            REQUIRE(kep3_tests::floating_point_error_vector(warm.get_v1()[j], cold.get_v1()[j]) < 1e-10);
+            iters_cold += cold.get_iters()[j];
+            iters_warm += warm.get_iters()[j];
+        }
+    }
+    // The warm start must reduce the total number of iterations.
+    REQUIRE(iters_warm < iters_cold);
+
+    // Bad guesses (out of domain, non finite, left and right branches swapped) fall back to the default guess.
+    const kep3::lambert_problem cold({1., 0.1, 0.}, {-0.2, 1., 0.1}, 30., 1., false, 2u);
+    REQUIRE(cold.get_Nmax() == 2u);
+    const std::vector<double> bad = {std::nan(""), cold.get_x()[2], cold.get_x()[1], 1.5, -3.};
+    const kep3::lambert_problem warm({1., 0.1, 0.}, {-0.2, 1., 0.1}, 30., 1., false, 2u, bad);
+    for (auto j = 0u; j < 5u; ++j) {
+        REQUIRE(kep3_tests::floating_point_error_vector(warm.get_v0()[j], cold.get_v0()[j]) < 1e-10);
+        REQUIRE(kep3_tests::floating_point_error_vector(warm.get_v1()[j], cold.get_v1()[j]) < 1e-10);
+    }
+    // Fewer guesses than solutions.
+    const kep3::lambert_problem partial({1., 0.1, 0.}, {-0.2, 1., 0.1}, 30., 1., false, 2u, {cold.get_x()[0]});
+    REQUIRE(kep3_tests::floating_point_error_vector(partial.get_v0()[0], cold.get_v0()[0]) < 1e-10);
+    for (auto j = 1u; j < 5u; ++j) {
+        REQUIRE(partial.get_v0()[j] == cold.get_v0()[j]);
+        REQUIRE(partial.get_iters()[j] == cold.get_iters()[j]);
+    }
+}
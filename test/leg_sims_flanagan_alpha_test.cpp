@@ -9,6 +9,8 @@
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <stdexcept>
 #include <vector>
 
@@ -347,6 +349,146 @@ TEST_CASE("mismatch_constraints_MatchHardCodedGroundTruth")
     REQUIRE(std::abs((retval[5] - ground_truth[5]) / retval[5]) < 1e-13);
 }
 
+TEST_CASE("grad_test")
+{
+    // Here we test the analytical gradient against an equivalent numerical one. We do so through the udp "sf_test_udp"
+    std::array<std::array<double, 3>, 2> rvs{
+        {{1 * kep3::AU, 0.1 * kep3::AU, -0.1 * kep3::AU},
+         {0.2 * kep3::EARTH_VELOCITY, 1 * kep3::EARTH_VELOCITY, -0.2 * kep3::EARTH_VELOCITY}}};
+    //
+    std::array<std::array<double, 3>, 2> rvf{
+        {{1.2 * kep3::AU, -0.1 * kep3::AU, 0.1 * kep3::AU},
+         {-0.2 * kep3::EARTH_VELOCITY, 1.023 * kep3::EARTH_VELOCITY, -0.44 * kep3::EARTH_VELOCITY}}};
+    //
+    double ms = 1500.;
+
+    sf_test_udp udp{rvs, ms, rvf, 0.12, 100, 5};
+    std::vector<double> x = {0.10, 0.11, 0.12, 0.13, 0.14, 0.15, 0.16, 0.17, 0.18, 0.19, 0.2, 0.21,
+                             0.22, 0.23, 0.24, 0.71, 0.75, 0.8,  0.85, 0.88, 324., 1300.};
+    auto grad = udp.gradient_numerical(x);
+    auto grad_a = udp.gradient(x);
+    REQUIRE(grad.size() == grad_a.size());
+    // NOTE: the derivatives w.r.t. the alphas are large, so we check the relative error.
+    for (decltype(grad.size()) i = 0u; i < grad.size(); ++i) {
+        REQUIRE(std::abs(grad[i] - grad_a[i]) < 1e-7 * std::max(1., std::abs(grad[i])));
+    }
+}
+
+TEST_CASE("compute_mc_grad_test")
+{
+    // We check the analytical gradients against central differences of the mismatch constraints, with uneven
+    // segment durations.
+    std::array<std::array<double, 3>, 2> rvs{{{1., 0.1, -0.1}, {0.2, 1., -0.2}}};
+    std::array<std::array<double, 3>, 2> rvf{{{1.2, -0.1, 0.1}, {-0.2, 1.023, -0.44}}};
+    const double ms = 1., mf = 0.9, h = 1e-6;
+    for (const unsigned nseg : {1u, 5u, 12u}) {
+        std::vector<double> throttles(nseg * 3u), talphas(nseg);
+        for (decltype(throttles.size()) i = 0u; i < throttles.size(); ++i) {
+            throttles[i] = 0.4 * std::sin(1.3 * static_cast<double>(i) + 0.2);
+        }
+        for (decltype(talphas.size()) i = 0u; i < talphas.size(); ++i) {
+            talphas[i] = (1. + 0.5 * std::cos(static_cast<double>(i))) / nseg;
+        }
+        // A null throttle.
+        throttles[0] = throttles[1] = throttles[2] = 0.;
+        for (const double cut : {0., 0.4, 1.}) {
+            const kep3::leg::sims_flanagan_alpha sf{rvs, ms, throttles, talphas, rvf, mf, 1., 0.05, 2., 1., cut};
+            const auto [grad_rvms, grad_rvmf, grad] = sf.compute_mc_grad();
+            const auto n_cols = nseg * 4u + 1u;
+            REQUIRE(grad.size() == 7u * n_cols);
+            // d/dthrottles and d/dtalphas
+            for (auto j = 0u; j < nseg * 4u; ++j) {
+                auto th_p = throttles, th_m = throttles, ta_p = talphas, ta_m = talphas;
+                if (j < nseg * 3u) {
+                    th_p[j] += h;
+                    th_m[j] -= h;
+                } else {
+                    ta_p[j - nseg * 3u] += h;
+                    ta_m[j - nseg * 3u] -= h;
+                }
+                const auto mc_p = kep3::leg::sims_flanagan_alpha{rvs, ms, th_p, ta_p, rvf, mf, 1., 0.05, 2., 1., cut}
+                                      .compute_mismatch_constraints();
+                const auto mc_m = kep3::leg::sims_flanagan_alpha{rvs, ms, th_m, ta_m, rvf, mf, 1., 0.05, 2., 1., cut}
+                                      .compute_mismatch_constraints();
+                for (auto i = 0u; i < 7u; ++i) {
+                    REQUIRE(std::abs((mc_p[i] - mc_m[i]) / 2. / h - grad[i * n_cols + j]) < 1e-7);
+                }
+            }
+            // d/dtof
+            for (auto i = 0u; i < 7u; ++i) {
+                REQUIRE(grad[i * n_cols + nseg * 4u] == 0.);
+            }
+            // d/dxs and d/dxf
+            for (auto j = 0u; j < 7u; ++j) {
+                auto rvs_p = rvs, rvs_m = rvs, rvf_p = rvf, rvf_m = rvf;
+                auto ms_p = ms, ms_m = ms, mf_p = mf, mf_m = mf;
+                if (j < 6u) {
+                    rvs_p[j / 3u][j % 3u] += h;
+                    rvs_m[j / 3u][j % 3u] -= h;
+                    rvf_p[j / 3u][j % 3u] += h;
+                    rvf_m[j / 3u][j % 3u] -= h;
+                } else {
+                    ms_p += h;
+                    ms_m -= h;
+                    mf_p += h;
+                    mf_m -= h;
+                }
+                const auto mcs_p
+                    = kep3::leg::sims_flanagan_alpha{rvs_p, ms_p, throttles, talphas, rvf, mf, 1., 0.05, 2., 1., cut}
+                          .compute_mismatch_constraints();
+                const auto mcs_m
+                    = kep3::leg::sims_flanagan_alpha{rvs_m, ms_m, throttles, talphas, rvf, mf, 1., 0.05, 2., 1., cut}
+                          .compute_mismatch_constraints();
+                const auto mcf_p
+                    = kep3::leg::sims_flanagan_alpha{rvs, ms, throttles, talphas, rvf_p, mf_p, 1., 0.05, 2., 1., cut}
+                          .compute_mismatch_constraints();
+                const auto mcf_m
+                    = kep3::leg::sims_flanagan_alpha{rvs, ms, throttles, talphas, rvf_m, mf_m, 1., 0.05, 2., 1., cut}
+                          .compute_mismatch_constraints();
+                for (auto i = 0u; i < 7u; ++i) {
+                    REQUIRE(std::abs((mcs_p[i] - mcs_m[i]) / 2. / h - grad_rvms[i * 7u + j]) < 1e-7);
+                    REQUIRE(std::abs((mcf_p[i] - mcf_m[i]) / 2. / h - grad_rvmf[i * 7u + j]) < 1e-7);
+                }
+            }
+        }
+    }
+    // Inconsistent talphas are detected.
+    kep3::leg::sims_flanagan_alpha sf{};
+    sf.set_talphas({1., 2., 3.});
+    REQUIRE_THROWS_AS(sf.compute_mc_grad(), std::logic_error);
+}
+
+TEST_CASE("compare_grad_withandwithout_alpha")
+{
+    // With equal talphas the gradients w.r.t. the states and the throttles are those of sims_flanagan, and the
+    // derivative w.r.t. the tof is the average of those w.r.t. the talphas.
+    std::array<std::array<double, 3>, 2> rvs{{{1., 0.1, -0.1}, {0.2, 1., -0.2}}};
+    std::array<std::array<double, 3>, 2> rvf{{{1.2, -0.1, 0.1}, {-0.2, 1.023, -0.44}}};
+    const std::vector<double> throttles
+        = {0.10, 0.11, 0.12, 0.13, 0.14, 0.15, 0.16, 0.17, 0.18, 0.19, 0.2, 0.21, 0.22, 0.23, 0.24};
+    const double tof = 1.3;
+    const kep3::leg::sims_flanagan sf(rvs, 1., throttles, rvf, 0.9, tof, 0.05, 2., 1., 0.6);
+    const kep3::leg::sims_flanagan_alpha sf_alpha(rvs, 1., throttles, std::vector<double>(5, tof / 5), rvf, 0.9, tof,
+                                                  0.05, 2., 1., 0.6);
+    const auto [grad_rvms, grad_rvmf, grad] = sf.compute_mc_grad();
+    const auto [grad_rvms_a, grad_rvmf_a, grad_a] = sf_alpha.compute_mc_grad();
+    for (auto i = 0u; i < 49u; ++i) {
+        REQUIRE(std::abs(grad_rvms[i] - grad_rvms_a[i]) < 1e-13);
+        REQUIRE(std::abs(grad_rvmf[i] - grad_rvmf_a[i]) < 1e-13);
+    }
+    for (auto i = 0u; i < 7u; ++i) {
+        double dtof = 0.;
+        for (auto j = 0u; j < 5u; ++j) {
+            dtof += grad_a[i * 21u + 15u + j] / 5.;
+        }
+        REQUIRE(std::abs(grad[i * 16u + 15u] - dtof) < 1e-13);
+        for (auto j = 0u; j < 15u; ++j) {
+            REQUIRE(std::abs(grad[i * 16u + j] - grad_a[i * 21u + j]) < 1e-13);
+        }
+    }
+    REQUIRE(sf.compute_tc_grad() == sf_alpha.compute_tc_grad());
+}
+
 TEST_CASE("serialization_test")
 {
     // Instantiate a generic lambert problem
@@ -11,7 +11,10 @@
 #ifndef kep3_TEST_LEG_SIMS_FLANAGAN_ALPHA_UDP_H
 #define kep3_TEST_LEG_SIMS_FLANAGAN_ALPHA_UDP_H
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <tuple>
 #include <vector>
 
 #include <xtensor/containers/xarray.hpp>
@@ -77,8 +80,62 @@ struct sf_test_udp {
 
     [[nodiscard]] std::vector<double> gradient(const std::vector<double> &x) const
     {
-        // Currently numerical, in the future we can add analytical
-        return gradient_numerical(x);
+        // x = [throttles, alphas, tof (in days), mf (in kg)]
+        double tof = x[m_nseg * 4] * kep3::DAY2SEC; // in s
+        double mf = x[m_nseg * 4 + 1];              // in kg
+        const std::vector<double> alphas(x.begin() + static_cast<long>(m_nseg) * 3l, x.end() - 2l);
+        const std::vector<double> talphas = kep3::alpha2direct(alphas, tof);
+        const std::vector<double> throttles(x.begin(), x.begin() + static_cast<long>(m_nseg) * 3l);
+        kep3::leg::sims_flanagan_alpha leg(m_rvs, m_ms, throttles, talphas, m_rvf, mf, tof, m_max_thrust, m_veff,
+                                           kep3::MU_SUN);
+
+        // We compute the gradients
+        const auto grad_mc_all = leg.compute_mc_grad();
+        const auto &grad_mc_xf = std::get<1>(grad_mc_all);
+        const auto &grad_mc = std::get<2>(grad_mc_all);
+        const auto grad_tc = leg.compute_tc_grad();
+
+        // The talphas are t_i = tof log(alpha_i) / S, with S = sum_j log(alpha_j), hence:
+        // dt_i/dalpha_j = (delta_ij tof - t_i) / S / alpha_j and dt_i/dtof = t_i / tof.
+        double S = 0.;
+        for (const auto alpha : alphas) {
+            S += std::log(alpha);
+        }
+
+        const auto n_x = m_nseg * 4u + 2u, n_mc = m_nseg * 4u + 1u;
+        std::vector<double> gradient((1u + 7u + m_nseg) * n_x, 0.);
+        // Fitness gradient - obj fun
+        gradient[m_nseg * 4u + 1u] = -1.;
+        // Mismatch constraints gradient
+        const std::array<double, 7> scaling
+            = {kep3::AU, kep3::AU, kep3::AU, kep3::EARTH_VELOCITY, kep3::EARTH_VELOCITY, kep3::EARTH_VELOCITY, 1e8};
+        for (decltype(m_nseg) i = 0u; i < 7u; ++i) {
+            const double *row_mc = grad_mc.data() + i * n_mc;
+            double *row = gradient.data() + (1u + i) * n_x;
+            // throttles
+            std::copy(row_mc, row_mc + m_nseg * 3u, row);
+            // alphas and tof, through the talphas
+            double sum_gt = 0.;
+            for (decltype(m_nseg) j = 0u; j < m_nseg; ++j) {
+                sum_gt += row_mc[m_nseg * 3u + j] * talphas[j];
+            }
+            for (decltype(m_nseg) j = 0u; j < m_nseg; ++j) {
+                row[m_nseg * 3u + j] = (row_mc[m_nseg * 3u + j] * tof - sum_gt) / S / alphas[j];
+            }
+            row[m_nseg * 4u] = sum_gt / tof * kep3::DAY2SEC;
+            // mf
+            row[m_nseg * 4u + 1u] = grad_mc_xf[7u * i + 6u];
+            for (decltype(m_nseg) j = 0u; j < n_x; ++j) {
+                row[j] /= scaling[i];
+            }
+        }
+        // Throttle constraints gradient
+        for (decltype(m_nseg) i = 0u; i < m_nseg; ++i) {
+            std::copy(grad_tc.begin() + static_cast<long>(i * m_nseg * 3u),
+                      grad_tc.begin() + static_cast<long>((i + 1u) * m_nseg * 3u),
+                      gradient.begin() + static_cast<long>((8u + i) * n_x));
+        }
+        return gradient;
     }
 
     [[nodiscard]] std::pair<std::vector<double>, std::vector<double>> get_bounds() const
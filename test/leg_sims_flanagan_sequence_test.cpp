@@ -0,0 +1,276 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+
+#include <kep3/core_astro/constants.hpp>
+#include <kep3/epoch.hpp>
+#include <kep3/exceptions.hpp>
+#include <kep3/leg/sims_flanagan.hpp>
+#include <kep3/leg/sims_flanagan_sequence.hpp>
+#include <kep3/planet.hpp>
+#include <kep3/udpla/keplerian.hpp>
+
+#include "catch.hpp"
+
+using kep3::leg::sims_flanagan_sequence;
+
+// A planet only implementing the ephemerides, as the SPICE udplas without a central body.
+struct eph_only_udpla {
+    eph_only_udpla() = default;
+    explicit eph_only_udpla(kep3::udpla::keplerian pl) : m_pl(std::move(pl)) {}
+    [[nodiscard]] std::array<std::array<double, 3>, 2> eph(double mjd2000) const
+    {
+        return m_pl.eph(mjd2000);
+    }
+    [[nodiscard]] std::string get_name() const
+    {
+        return m_pl.get_name();
+    }
+
+private:
+    kep3::udpla::keplerian m_pl;
+
+    friend class boost::serialization::access;
+    template <typename Archive>
+    void serialize(Archive &ar, unsigned)
+    {
+        ar & m_pl;
+    }
+};
+
+KEP3_S11N_EXPORT_WRAP(eph_only_udpla, kep3::detail::planet_iface)
+
+namespace
+{
+// Four planets on inner solar system like orbits.
+std::vector<kep3::planet> make_seq()
+{
+    std::vector<kep3::planet> retval;
+    const std::vector<std::array<double, 6>> elems
+        = {{1. * kep3::AU, 0.02, 0.01, 0.1, 0.2, 0.3},
+           {0.72 * kep3::AU, 0.01, 0.05, 1.1, 0.4, 2.1},
+           {1. * kep3::AU, 0.02, 0.01, 0.1, 0.2, 0.3},
+           {1.52 * kep3::AU, 0.09, 0.03, 0.8, 4.9, 5.5}};
+    for (decltype(elems.size()) i = 0u; i < elems.size(); ++i) {
+        retval.emplace_back(kep3::udpla::keplerian{kep3::epoch(0.), elems[i], kep3::MU_SUN, std::to_string(i)});
+    }
+    return retval;
+}
+
+// A decision vector for the legs with nsegs segments.
+std::vector<double> make_x(const std::vector<unsigned> &nsegs, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u_d(-0.5, 0.5), vinf_d(-2000., 2000.), tof_d(150., 300.);
+    std::vector<double> x = {1000.};
+    double mf = 1000.;
+    for (const auto nseg : nsegs) {
+        mf -= 50.;
+        x.push_back(mf);
+        for (auto k = 0u; k < 6u; ++k) {
+            x.push_back(vinf_d(rng));
+        }
+        for (auto k = 0u; k < 3u * nseg; ++k) {
+            x.push_back(u_d(rng));
+        }
+        x.push_back(tof_d(rng));
+    }
+    return x;
+}
+} // namespace
+
+TEST_CASE("constructor")
+{
+    {
+        sims_flanagan_sequence sfs;
+        REQUIRE(sfs.get_nlegs() == 1u);
+        REQUIRE(sfs.get_nx() == 15u);
+        REQUIRE(sfs.get_nec() == 7u);
+        REQUIRE(sfs.get_nic() == 2u);
+        REQUIRE(sfs.get_x().empty());
+        REQUIRE_THROWS_AS(sfs.compute_constraints(), std::logic_error);
+        REQUIRE_THROWS_AS(sfs.compute_grad_sparse(), std::logic_error);
+    }
+    const auto seq = make_seq();
+    const std::vector<unsigned> nsegs = {5u, 3u, 4u};
+    sims_flanagan_sequence sfs(seq, nsegs, 1000., 0.3, 3000. * kep3::G0, kep3::MU_SUN, 0.6);
+    REQUIRE(sfs.get_nlegs() == 3u);
+    REQUIRE(sfs.get_nx() == 1u + 3u * 12u + 3u * 8u);
+    REQUIRE(sfs.get_nec() == 21u);
+    REQUIRE(sfs.get_nic() == 12u);
+    for (std::size_t i = 0u; i < 3u; ++i) {
+        REQUIRE(sfs.get_legs()[i].get_nseg() == nsegs[i]);
+        REQUIRE(sfs.get_legs()[i].get_cut() == 0.6);
+    }
+    REQUIRE_THROWS_AS(sims_flanagan_sequence({seq[0]}, {}, 1000., 0.3, 3000. * kep3::G0, kep3::MU_SUN),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(sims_flanagan_sequence(seq, {5u, 3u}, 1000., 0.3, 3000. * kep3::G0, kep3::MU_SUN),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(sims_flanagan_sequence(seq, {5u, 0u, 4u}, 1000., 0.3, 3000. * kep3::G0, kep3::MU_SUN),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(sims_flanagan_sequence(seq, nsegs, 1000., -0.3, 3000. * kep3::G0, kep3::MU_SUN),
+                      std::domain_error);
+    REQUIRE_THROWS_AS(sfs.set_x(std::vector<double>(10u, 0.)), std::invalid_argument);
+}
+
+TEST_CASE("compute_constraints")
+{
+    const auto seq = make_seq();
+    const std::vector<unsigned> nsegs = {5u, 3u, 4u};
+    sims_flanagan_sequence sfs(seq, nsegs, 1000., 0.3, 3000. * kep3::G0, kep3::MU_SUN, 0.6);
+    const auto x = make_x(nsegs, 1u);
+    sfs.set_x(x);
+    REQUIRE(sfs.get_x() == x);
+
+    // The same legs, built one by one.
+    const auto c = sfs.compute_constraints();
+    REQUIRE(c.size() == sfs.get_nec() + sfs.get_nic());
+    double t = x[0], ms = 1000.;
+    std::size_t off = 1u, tc_off = sfs.get_nec();
+    for (std::size_t i = 0u; i < 3u; ++i) {
+        const auto nseg = nsegs[i];
+        const double tof = x[off + 3u * nseg + 7u];
+        REQUIRE(sfs.get_epochs()[i] == t);
+        auto rvs = seq[i].eph(t), rvf = seq[i + 1u].eph(t + tof);
+        for (auto k = 0u; k < 3u; ++k) {
+            rvs[1][k] += x[off + 1u + k];
+            rvf[1][k] += x[off + 4u + k];
+        }
+        const std::vector<double> throttles(x.begin() + static_cast<std::ptrdiff_t>(off + 7u),
+                                            x.begin() + static_cast<std::ptrdiff_t>(off + 7u + 3u * nseg));
+        const kep3::leg::sims_flanagan leg(rvs, ms, throttles, rvf, x[off], tof * kep3::DAY2SEC, 0.3,
+                                           3000. * kep3::G0, kep3::MU_SUN, 0.6);
+        const auto mc = leg.compute_mismatch_constraints();
+        const auto tc = leg.compute_throttle_constraints();
+        for (auto k = 0u; k < 7u; ++k) {
+            REQUIRE(c[7u * i + k] == mc[k]);
+        }
+        for (auto k = 0u; k < nseg; ++k) {
+            REQUIRE(c[tc_off + k] == tc[k]);
+        }
+        ms = x[off];
+        t += tof;
+        off += 3u * nseg + 8u;
+        tc_off += nseg;
+    }
+    REQUIRE(sfs.get_epochs()[3] == t);
+}
+
+TEST_CASE("grad_sparse")
+{
+    const auto seq = make_seq();
+    for (const auto &nsegs : {std::vector<unsigned>{1u}, std::vector<unsigned>{5u, 3u, 4u}}) {
+        std::vector<kep3::planet> seq_n(seq.begin(), seq.begin() + static_cast<std::ptrdiff_t>(nsegs.size() + 1u));
+        sims_flanagan_sequence sfs(seq_n, nsegs, 1000., 0.3, 3000. * kep3::G0, kep3::MU_SUN, 0.6);
+        const auto x = make_x(nsegs, 2u);
+        sfs.set_x(x);
+
+        const auto sp = sfs.get_grad_sparsity();
+        const auto values = sfs.compute_grad_sparse();
+        REQUIRE(values.size() == sp.size());
+        REQUIRE(sfs.get_grad_nnz() == sp.size());
+        REQUIRE(std::is_sorted(sp.begin(), sp.end()));
+        REQUIRE(std::adjacent_find(sp.begin(), sp.end()) == sp.end());
+        const std::size_t n_rows = sfs.get_nec() + sfs.get_nic(), n_cols = sfs.get_nx();
+        std::vector<double> jac(n_rows * n_cols, 0.);
+        for (decltype(sp.size()) k = 0u; k < sp.size(); ++k) {
+            jac[sp[k].first * n_cols + sp[k].second] = values[k];
+        }
+
+        // Central differences, with steps scaled on the variables.
+        std::vector<double> jac_num(n_rows * n_cols);
+        auto sfs_h = sfs;
+        for (std::size_t j = 0u; j < n_cols; ++j) {
+            const double h = 1e-6 * std::max(1., std::abs(x[j]));
+            auto xp = x, xm = x;
+            xp[j] += h;
+            xm[j] -= h;
+            sfs_h.set_x(xp);
+            const auto cp = sfs_h.compute_constraints();
+            sfs_h.set_x(xm);
+            const auto cm = sfs_h.compute_constraints();
+            for (std::size_t r = 0u; r < n_rows; ++r) {
+                jac_num[r * n_cols + j] = (cp[r] - cm[r]) / 2. / h;
+            }
+        }
+        // The entries outside the pattern are zero, and the others match.
+        for (std::size_t r = 0u; r < n_rows; ++r) {
+            double scale = 0.;
+            for (std::size_t j = 0u; j < n_cols; ++j) {
+                scale = std::max(scale, std::abs(jac_num[r * n_cols + j]));
+            }
+            for (std::size_t j = 0u; j < n_cols; ++j) {
+                REQUIRE(std::abs(jac[r * n_cols + j] - jac_num[r * n_cols + j]) <= 1e-6 * scale);
+            }
+        }
+
+        std::vector<double> buffer(values.size() + 1u);
+        REQUIRE_THROWS_AS(sfs.compute_grad_sparse(buffer), std::invalid_argument);
+        buffer.pop_back();
+        sfs.compute_grad_sparse(buffer);
+        REQUIRE(buffer == values);
+    }
+}
+
+TEST_CASE("grad_sparse_eph_only")
+{
+    // The planets without accelerations can be used, their accelerations are approximated in the gradient.
+    const auto seq = make_seq();
+    std::vector<kep3::planet> seq_eph;
+    for (const auto &pla : seq) {
+        seq_eph.emplace_back(eph_only_udpla{*pla.extract<kep3::udpla::keplerian>()});
+    }
+    REQUIRE_THROWS_AS(seq_eph[0].acc(0.), kep3::not_implemented_error);
+    const std::vector<unsigned> nsegs = {5u, 3u, 4u};
+    sims_flanagan_sequence sfs(seq, nsegs, 1000., 0.3, 3000. * kep3::G0, kep3::MU_SUN, 0.6);
+    sims_flanagan_sequence sfs_eph(seq_eph, nsegs, 1000., 0.3, 3000. * kep3::G0, kep3::MU_SUN, 0.6);
+    const auto x = make_x(nsegs, 4u);
+    sfs.set_x(x);
+    sfs_eph.set_x(x);
+    REQUIRE(sfs_eph.compute_constraints() == sfs.compute_constraints());
+    const auto values = sfs.compute_grad_sparse();
+    const auto values_eph = sfs_eph.compute_grad_sparse();
+    for (decltype(values.size()) k = 0u; k < values.size(); ++k) {
+        REQUIRE(std::abs(values_eph[k] - values[k]) <= 1e-6 * std::max(1., std::abs(values[k])));
+    }
+}
+
+TEST_CASE("serialization_test")
+{
+    const std::vector<unsigned> nsegs = {5u, 3u, 4u};
+    sims_flanagan_sequence sfs(make_seq(), nsegs, 1000., 0.3, 3000. * kep3::G0, kep3::MU_SUN, 0.6);
+    sfs.set_x(make_x(nsegs, 3u));
+    std::stringstream ss;
+    {
+        boost::archive::binary_oarchive oarchive(ss);
+        oarchive << sfs;
+    }
+    sims_flanagan_sequence sfs2;
+    {
+        boost::archive::binary_iarchive iarchive(ss);
+        iarchive >> sfs2;
+    }
+    REQUIRE(sfs2.get_x() == sfs.get_x());
+    REQUIRE(sfs2.compute_constraints() == sfs.compute_constraints());
+    REQUIRE(sfs2.compute_grad_sparse() == sfs.compute_grad_sparse());
+    REQUIRE(boost::lexical_cast<std::string>(sfs2) == boost::lexical_cast<std::string>(sfs));
+}
@@ -9,6 +9,9 @@
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <stdexcept>
 #include <vector>
 
@@ -28,6 +31,7 @@
 #include <kep3/core_astro/constants.hpp>
 #include <kep3/lambert_problem.hpp>
 #include <kep3/leg/sims_flanagan.hpp>
+#include <kep3/leg/sparsity.hpp>
 #include <kep3/planet.hpp>
 #include <kep3/udpla/vsop2013.hpp>
 #include <kep3/detail/s11n.hpp>
@@ -285,6 +289,132 @@ TEST_CASE("mismatch_constraints_MatchHardCodedGroundTruth")
     REQUIRE(std::abs((retval[5] - ground_truth[5]) / retval[5]) < 1e-13);
 }
 
+TEST_CASE("grad_regression_test")
+{
+    // We test compute_mc_grad against reference values computed with the previous implementation (which assembled the
+    // gradients from the full chain of segment transfer matrices rather than by back propagating the mismatch).
+    const std::vector<std::vector<double>> grad_gt = {
+        {
+        -0.06303849557631748, 0.0018409714077257298, -0.00076818327162294275, 0.37245863097299703,
+        0.0018493519030974665, -0.063022475488283561, 0.00077961909150658937, 0.65779593225133903,
+        -0.00077233881790039771, 0.00078026543559595052, -0.061489909520632643,
+        -0.35636991678181562, 0.084512490616806005, -0.0065725667709274731, 0.0027947640567534591,
+        -0.15708295010775927, -0.0066312318922993434, 0.085933867059277233, -0.0031785352683222361,
+        0.26252009289313327, 0.002823853643973973, -0.0031830597370848444, 0.079852868257549822,
+        -0.075530864545029885, -0.0085432188928799401, -0.024326156564513431, -0.028668122697174794,
+        -0.017141205731410362
+        },
+        {
+        0.010166382893306292, 0.0001351174400143762, -3.9018018075746383e-05, -0.011065299313260928,
+        5.4188375820480209e-05, -2.5729816427079849e-05, -0.034756782618960071,
+        0.0018480361762578819, -0.00092059062953300981, 0.13857022829930468, 0.00013536817666803813,
+        0.0099939956887025918, -2.1487539525466562e-05, 5.420684401103208e-05,
+        -0.011067850457798928, 2.6397449653003757e-05, 0.0018761839717143754, -0.03331942434913298,
+        0.00065940676999215887, 0.78665488264276817, -3.9048693491657481e-05,
+        -2.1464755551684849e-05, 0.0099250745837451797, -2.5737775651459526e-05,
+        2.6396622343166824e-05, -0.011024759887380199, -0.00093272154414247225,
+        0.00065814644343777041, -0.032309708580420711, -0.23838533461747879, 0.032834850094050815,
+        0.0012875183223737265, -0.0003535382545050148, 0.034992375008299229,
+        -0.00048882139950973222, 0.0002310557480250004, 0.037952406346074434,
+        -0.0052812687921825604, 0.0025770399154793205, -0.31910584184436913, 0.001292014756848481,
+        0.031461126783760562, -0.00021325962412666047, -0.00048915162400925698, 0.03506503409825721,
+        -0.00024944882097491998, -0.0054282464819775406, 0.035780979448067241,
+        -0.002204037291312225, 0.033706565052556453, -0.00035408839375629852,
+        -0.00021285107467082048, 0.030735799190460825, 0.00023119806662938433,
+        -0.00024943403596001219, 0.034654899916926225, 0.0026403832018084324,
+        -0.0021974563252143758, 0.032296099814578268, -0.032830047010919884, -0.010839173417194562,
+        -0.010228788096387732, -0.0048076439046269041, -0, -0, -0, 0.012292482531703109,
+        0.0014476494052668074, -0.0100780358566124, -0.0095848785209223034
+        },
+        {
+        0.028227696464780978, 0.003818927365503052, -0.00065694536125514389, 0.016049721328859835,
+        0.00071203021425814269, -0.00011543576507372204, 0.0053589204819667049,
+        2.1975473182804119e-05, -3.1195499239033588e-06, -0.0058352844902493459,
+        1.7385594352441253e-05, -1.0025363556896742e-05, -0.018185011905825547,
+        0.00049431045002521141, -0.00034505363728067604, -0.20255988161193161,
+        0.0039367558755340907, 0.027547985419314334, -0.00062062618674336024,
+        0.00070471186339695409, 0.016338390166605803, -0.00014791763704113036,
+        2.1980505739742842e-05, 0.0053802767410100916, -4.9827256960937282e-06,
+        1.7388856221685123e-05, -0.005824822711083269, 7.4623483925494126e-06,
+        0.00051336915084843125, -0.017462882061689972, 0.00018008684617833816, 0.64082702655539703,
+        -0.00072736765438898606, -0.00064736634396209516, 0.023959058126140079,
+        -0.00013453796568679469, -0.00015968367555325562, 0.015472408323516942,
+        -3.1199798717158793e-06, -4.9822763375447504e-06, 0.0053458404546518311,
+        -1.0026626125250619e-05, 7.4618914496596467e-06, -0.0058161659786518652,
+        -0.00032417848688594416, 0.00019421695664881663, -0.017288056876750005,
+        -0.12777788195179091, 0.02552814545784127, 0.0088353920015263633, -0.0014305518210141648,
+        0.023198252061508114, 0.0028326816122711896, -0.00044049403162617481, 0.023266520752460808,
+        0.00027685039340532712, -3.8678125919117023e-05, 0.025442463008796688,
+        -0.00022112038001031873, 0.00012573490678308621, 0.027420449457154373,
+        -0.0020753326323127456, 0.0013703673078950664, -0.24891348671396685, 0.0095188773937731723,
+        0.027732572757531781, -0.0017190792370299489, 0.0028189577314463219, 0.025064705651105162,
+        -0.00063668430540613169, 0.00027697871131379822, 0.023561226168734174,
+        -6.4382250818572029e-05, -0.00022120157208343406, 0.025329448364997668,
+        -9.7783818476416751e-05, -0.0021718487762567278, 0.025180255411547857,
+        -0.00083831670611194222, -0.15959012339701001, -0.0014926016767817963,
+        -0.0016744786705426963, 0.017277738316018844, -0.00052429265522351909,
+        -0.00068544085872954174, 0.021153852615653692, -3.8689114074171552e-05,
+        -6.4370730000557895e-05, 0.023108751023762929, 0.00012576639296014733,
+        -9.7772434271560036e-05, 0.025212817557418759, 0.0012852680483619139,
+        -0.00089737767887149275, 0.024262682522344158, -0.023043416863320523,
+        -0.0092152743382493893, -0.0017439325455317497, 0.0065476079730471667,
+        0.0077168101098475921, 0.0075076928649710625, 0.0037675903547616345, -0.0018976544839402038,
+        -0.0070012433246220522, -0.0088120380322895004, -0.0092098989848650153,
+        -0.0015607532655529748, 0.0068224391019911226, 0.0079235358481620465, 0.0076145367935023037,
+        0.0037243021044389892, -0.014852948565454067
+        }};
+    // The mass column of the gradients with respect to the initial and final states.
+    const std::vector<std::vector<double>> ms_col_gt = {
+        {
+        0, 0, 0, 0, 0, 0, 1
+        },
+        {
+        -0.0049510439387813873, -0.0046043831680243992, -0.0020923168258392619,
+        -0.016328965267863035, -0.014880655075766606, -0.0063005662361249179, 0.99993971612647792
+        },
+        {
+        -0.003612576153181256, 0.0021531193445086323, 0.0074526140135329679,
+        -0.00086703750400924035, -0.0025128958435097076, -0.0019132723242609017, 0.99992472364956098
+        }};
+    const std::vector<std::vector<double>> mf_col_gt = {
+        {
+        0.009912114186287695, 0.028728857132755876, 0.033638361373385349, -0.012342218682052679,
+        -0.037332861749506695, -0.042968518258605835, -0.99960674892831902
+        },
+        {
+        -0.013242362930913885, -0.0010145526210162072, 0.010047684750967135, 0.013804151832221783,
+        0.00023226457549095961, -0.0094450204874152784, -0.99996735532280834
+        },
+        {
+        -0.0071218553805139856, -0.0082032382321213428, -0.0061459913678422757,
+        0.003528157036436004, 0.0098062249719879611, 0.013861284419463918, -0.99994258619604837
+        }};
+    auto close = [](double a, double b) { return std::abs(a - b) <= 1e-13 + 1e-11 * std::abs(b); };
+    for (unsigned seed = 0u; seed < 3u; ++seed) {
+        const unsigned nseg = 1u + 2u * seed;
+        std::array<std::array<double, 3>, 2> rvs{{{1., 0.1 * seed, -0.1}, {0.2, 1., -0.2 + 0.05 * seed}}};
+        std::array<std::array<double, 3>, 2> rvf{{{1.2, -0.1, 0.1 * seed}, {-0.2, 1.023, -0.44}}};
+        std::vector<double> throttles(3u * nseg);
+        for (std::size_t i = 0u; i < throttles.size(); ++i) {
+            throttles[i] = 0.5 * std::sin(0.7 * static_cast<double>(i) + seed + 0.3);
+        }
+        if (seed == 1u) {
+            // A null throttle segment.
+            throttles[3] = throttles[4] = throttles[5] = 0.;
+        }
+        kep3::leg::sims_flanagan sf{rvs, 1., throttles, rvf, 0.9, 1.5 + 0.4 * seed, 0.05, 2., 1., 0.3 + 0.2 * seed};
+        auto [grad_rvms, grad_rvmf, grad] = sf.compute_mc_grad();
+        REQUIRE(grad.size() == grad_gt[seed].size());
+        for (std::size_t i = 0u; i < grad.size(); ++i) {
+            REQUIRE(close(grad[i], grad_gt[seed][i]));
+        }
+        for (std::size_t r = 0u; r < 7u; ++r) {
+            REQUIRE(close(grad_rvms[7u * r + 6u], ms_col_gt[seed][r]));
+            REQUIRE(close(grad_rvmf[7u * r + 6u], mf_col_gt[seed][r]));
+        }
+    }
+}
+
 TEST_CASE("grad_test")
 {
     // Here we test the analytical gradient against an equivalent numerical one. We do so through the udp "sf_test_udp"
@@ -309,6 +439,191 @@ TEST_CASE("grad_test")
             < 1e-8); // With the high fidelity gradient this is still the best we can achieve
 }
 
+TEST_CASE("grad_workspace_test")
+{
+    std::array<std::array<double, 3>, 2> rvs{{{1., 0.1, -0.1}, {0.2, 1., -0.2}}};
+    std::array<std::array<double, 3>, 2> rvf{{{1.2, -0.1, 0.1}, {-0.2, 1.023, -0.44}}};
+    kep3::leg::sims_flanagan::workspace ws;
+    std::array<double, 49> grad_rvms{}, grad_rvmf{};
+    // The same workspace is reused for legs of different sizes and cuts.
+    for (auto nseg : {10u, 3u, 25u, 1u}) {
+        for (auto cut : {0., 0.3, 1.}) {
+            std::vector<double> throttles(nseg * 3u);
+            for (decltype(throttles.size()) i = 0u; i < throttles.size(); ++i) {
+                throttles[i] = 0.3 * std::sin(static_cast<double>(i));
+            }
+            kep3::leg::sims_flanagan sf{rvs, 1., throttles, rvf, 0.9, 2.3, 0.05, 2., 1., cut};
+            const auto [grad_rvms_ref, grad_rvmf_ref, grad_ref] = sf.compute_mc_grad();
+            std::vector<double> grad(grad_ref.size());
+            sf.compute_mc_grad(ws, grad_rvms, grad_rvmf, grad);
+            REQUIRE(grad_rvms == grad_rvms_ref);
+            REQUIRE(grad_rvmf == grad_rvmf_ref);
+            REQUIRE(grad == grad_ref);
+            // No stale values from the previous (larger or smaller) legs: we also check the gradient w.r.t. the
+            // throttles and the tof against central differences.
+            const double h = 1e-6;
+            const auto n_cols = nseg * 3u + 1u;
+            for (auto j = 0u; j < n_cols; ++j) {
+                auto th_p = throttles, th_m = throttles;
+                auto tof_p = 2.3, tof_m = 2.3;
+                if (j < nseg * 3u) {
+                    th_p[j] += h;
+                    th_m[j] -= h;
+                } else {
+                    tof_p += h;
+                    tof_m -= h;
+                }
+                const auto mc_p = kep3::leg::sims_flanagan{rvs, 1., th_p, rvf, 0.9, tof_p, 0.05, 2., 1., cut}
+                                      .compute_mismatch_constraints();
+                const auto mc_m = kep3::leg::sims_flanagan{rvs, 1., th_m, rvf, 0.9, tof_m, 0.05, 2., 1., cut}
+                                      .compute_mismatch_constraints();
+                for (auto i = 0u; i < 7u; ++i) {
+                    REQUIRE(std::abs((mc_p[i] - mc_m[i]) / 2. / h - grad[i * n_cols + j]) < 1e-6);
+                }
+            }
+            grad.resize(grad.size() - 1u);
+            REQUIRE_THROWS_AS(sf.compute_mc_grad(ws, grad_rvms, grad_rvmf, grad), std::invalid_argument);
+        }
+    }
+}
+
+TEST_CASE("grad_long_leg_test")
+{
+    // The gradients are computed by an adjoint sweep, linear in the number of segments. We check them against
+    // central differences of the mismatch constraints on a long leg.
+    std::array<std::array<double, 3>, 2> rvs{{{1., 0.1, -0.1}, {0.2, 1., -0.2}}};
+    std::array<std::array<double, 3>, 2> rvf{{{1.2, -0.1, 0.1}, {-0.2, 1.023, -0.44}}};
+    const unsigned nseg = 150u;
+    std::vector<double> throttles(nseg * 3u);
+    for (decltype(throttles.size()) i = 0u; i < throttles.size(); ++i) {
+        throttles[i] = 0.4 * std::sin(1.3 * static_cast<double>(i) + 0.2);
+    }
+    const double ms = 1., mf = 0.9, tof = 2.3, cut = 0.37;
+    kep3::leg::sims_flanagan sf{rvs, ms, throttles, rvf, mf, tof, 0.05, 2., 1., cut};
+    const auto [grad_rvms, grad_rvmf, grad] = sf.compute_mc_grad();
+
+    const double h = 1e-6;
+    const auto n_cols = nseg * 3u + 1u;
+    // d/dthrottles and d/dtof
+    for (auto j = 0u; j < n_cols; ++j) {
+        auto th_p = throttles, th_m = throttles;
+        auto tof_p = tof, tof_m = tof;
+        if (j < nseg * 3u) {
+            th_p[j] += h;
+            th_m[j] -= h;
+        } else {
+            tof_p += h;
+            tof_m -= h;
+        }
+        const auto mc_p
+            = kep3::leg::sims_flanagan{rvs, ms, th_p, rvf, mf, tof_p, 0.05, 2., 1., cut}.compute_mismatch_constraints();
+        const auto mc_m
+            = kep3::leg::sims_flanagan{rvs, ms, th_m, rvf, mf, tof_m, 0.05, 2., 1., cut}.compute_mismatch_constraints();
+        for (auto i = 0u; i < 7u; ++i) {
+            REQUIRE(std::abs((mc_p[i] - mc_m[i]) / 2. / h - grad[i * n_cols + j]) < 1e-6);
+        }
+    }
+    // d/dxs and d/dxf
+    for (auto j = 0u; j < 7u; ++j) {
+        auto rvs_p = rvs, rvs_m = rvs, rvf_p = rvf, rvf_m = rvf;
+        auto ms_p = ms, ms_m = ms, mf_p = mf, mf_m = mf;
+        if (j < 6u) {
+            rvs_p[j / 3u][j % 3u] += h;
+            rvs_m[j / 3u][j % 3u] -= h;
+            rvf_p[j / 3u][j % 3u] += h;
+            rvf_m[j / 3u][j % 3u] -= h;
+        } else {
+            ms_p += h;
+            ms_m -= h;
+            mf_p += h;
+            mf_m -= h;
+        }
+        const auto mcs_p = kep3::leg::sims_flanagan{rvs_p, ms_p, throttles, rvf, mf, tof, 0.05, 2., 1., cut}
+                               .compute_mismatch_constraints();
+        const auto mcs_m = kep3::leg::sims_flanagan{rvs_m, ms_m, throttles, rvf, mf, tof, 0.05, 2., 1., cut}
+                               .compute_mismatch_constraints();
+        const auto mcf_p = kep3::leg::sims_flanagan{rvs, ms, throttles, rvf_p, mf_p, tof, 0.05, 2., 1., cut}
+                               .compute_mismatch_constraints();
+        const auto mcf_m = kep3::leg::sims_flanagan{rvs, ms, throttles, rvf_m, mf_m, tof, 0.05, 2., 1., cut}
+                               .compute_mismatch_constraints();
+        for (auto i = 0u; i < 7u; ++i) {
+            REQUIRE(std::abs((mcs_p[i] - mcs_m[i]) / 2. / h - grad_rvms[i * 7u + j]) < 1e-6);
+            REQUIRE(std::abs((mcf_p[i] - mcf_m[i]) / 2. / h - grad_rvmf[i * 7u + j]) < 1e-6);
+        }
+    }
+}
+
+TEST_CASE("grad_sparse_test")
+{
+    std::array<std::array<double, 3>, 2> rvs{{{1., 0.1, -0.1}, {0.2, 1., -0.2}}};
+    std::array<std::array<double, 3>, 2> rvf{{{1.2, -0.1, 0.1}, {-0.2, 1.023, -0.44}}};
+    kep3::leg::sims_flanagan::workspace ws;
+    for (auto nseg : {1u, 4u, 17u}) {
+        for (auto cut : {0., 0.6, 1.}) {
+            std::vector<double> throttles(nseg * 3u);
+            for (decltype(throttles.size()) i = 0u; i < throttles.size(); ++i) {
+                throttles[i] = 0.3 * std::sin(static_cast<double>(i));
+            }
+            // A null throttle.
+            throttles[0] = 0.;
+            kep3::leg::sims_flanagan sf{rvs, 1., throttles, rvf, 0.9, 2.3, 0.05, 2., 1., cut};
+
+            // The dense Jacobian of [mc, tc] w.r.t. [xs, throttles, xf, tof].
+            const std::size_t n_rows = 7u + nseg, n_cols = 3u * nseg + 15u;
+            std::vector<double> jac(n_rows * n_cols, 0.);
+            const auto [grad_rvms, grad_rvmf, grad] = sf.compute_mc_grad();
+            const auto tc_grad = sf.compute_tc_grad();
+            for (std::size_t r = 0u; r < 7u; ++r) {
+                for (std::size_t j = 0u; j < 7u; ++j) {
+                    jac[r * n_cols + j] = grad_rvms[r * 7u + j];
+                    jac[r * n_cols + 3u * nseg + 7u + j] = grad_rvmf[r * 7u + j];
+                }
+                for (std::size_t j = 0u; j < 3u * nseg; ++j) {
+                    jac[r * n_cols + 7u + j] = grad[r * (3u * nseg + 1u) + j];
+                }
+                jac[r * n_cols + n_cols - 1u] = grad[r * (3u * nseg + 1u) + 3u * nseg];
+            }
+            for (std::size_t r = 0u; r < nseg; ++r) {
+                for (std::size_t j = 0u; j < 3u * nseg; ++j) {
+                    jac[(7u + r) * n_cols + 7u + j] = tc_grad[r * 3u * nseg + j];
+                }
+            }
+
+            const auto sp = sf.get_grad_sparsity();
+            const auto values = sf.compute_grad_sparse();
+            REQUIRE(sf.get_grad_nnz() == sp.size());
+            REQUIRE(values.size() == sp.size());
+            REQUIRE(std::is_sorted(sp.begin(), sp.end()));
+            std::vector<double> jac_sparse(n_rows * n_cols, 0.);
+            for (decltype(sp.size()) k = 0u; k < sp.size(); ++k) {
+                REQUIRE(sp[k].first < n_rows);
+                REQUIRE(sp[k].second < n_cols);
+                jac_sparse[sp[k].first * n_cols + sp[k].second] = values[k];
+            }
+            // The values match, and the entries outside the pattern are zero.
+            REQUIRE(jac_sparse == jac);
+
+            // The allocation free version.
+            std::vector<double> values_ws(sp.size());
+            sf.compute_grad_sparse(ws, values_ws);
+            REQUIRE(values_ws == values);
+            values_ws.push_back(0.);
+            REQUIRE_THROWS_AS(sf.compute_grad_sparse(ws, values_ws), std::invalid_argument);
+
+            // The CSR row pointers.
+            const auto row_ptr = kep3::leg::csr_row_ptr(sp, n_rows);
+            REQUIRE(row_ptr.size() == n_rows + 1u);
+            REQUIRE(row_ptr[7] == 6u * n_cols + 3u * nseg + 3u);
+            REQUIRE(row_ptr[n_rows] == sp.size());
+            for (std::size_t r = 0u; r < n_rows; ++r) {
+                for (auto k = row_ptr[r]; k < row_ptr[r + 1u]; ++k) {
+                    REQUIRE(sp[k].first == r);
+                }
+            }
+        }
+    }
+}
+
 TEST_CASE("serialization_test")
 {
     // Instantiate a generic lambert problem
@@ -9,12 +9,16 @@
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include <array>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
 #include <vector>
 
 #include <kep3/core_astro/constants.hpp>
 #include <kep3/lambert_problem.hpp>
 #include <kep3/leg/zoh.hpp>
 #include <kep3/planet.hpp>
+#include <kep3/ta/pool.hpp>
 #include <kep3/ta/zoh_kep.hpp>
 #include <kep3/udpla/jpl_lp.hpp>
 #include <kep3/detail/s11n.hpp>
@@ -163,6 +167,40 @@ TEST_CASE("compute_mc_grad")
     REQUIRE(kep3_tests::L_infinity_norm_rel(dmc_dtgrid, ref_dmc_dtgrid) < 1e-10);
 }
 
+TEST_CASE("compute_grad_sparse")
+{
+    auto data = make_reference_case();
+
+    kep3::leg::zoh leg{data.state0, data.controls, data.state1, data.tgrid, data.cut, {data.ta, data.ta_var}};
+
+    const auto [dmc_dx0, dmc_dx1, dmc_dcontrols, dmc_dtgrid] = leg.compute_mc_grad();
+    const auto sp = leg.get_grad_sparsity();
+    const auto values = leg.compute_grad_sparse();
+
+    // The columns are [x0, controls, x1, tgrid].
+    const std::size_t d = 7u, n_u = 4u * leg.get_nseg(), n_t = leg.get_nseg() + 1u;
+    REQUIRE(sp.size() == d * (2u * d + n_u + n_t));
+    REQUIRE(leg.get_grad_nnz() == sp.size());
+    REQUIRE(values.size() == sp.size());
+    for (decltype(sp.size()) k = 0u; k < sp.size(); ++k) {
+        const auto [r, j] = sp[k];
+        double ref = 0.;
+        if (j < d) {
+            ref = dmc_dx0[r * d + j];
+        } else if (j < d + n_u) {
+            ref = dmc_dcontrols[r * n_u + j - d];
+        } else if (j < 2u * d + n_u) {
+            ref = dmc_dx1[r * d + j - d - n_u];
+        } else {
+            ref = dmc_dtgrid[r * n_t + j - 2u * d - n_u];
+        }
+        REQUIRE(values[k] == ref);
+    }
+
+    std::vector<double> buffer(sp.size() + 1u);
+    REQUIRE_THROWS_AS(leg.compute_grad_sparse(buffer), std::invalid_argument);
+}
+
 TEST_CASE("get_state_info")
 {
     auto data = make_reference_case();
@@ -227,4 +265,47 @@ TEST_CASE("serialization")
     auto after = boost::lexical_cast<std::string>(zoh2);
     // Compare the string representations
     REQUIRE(before == after);
-}
\ No newline at end of file
+}
+
+TEST_CASE("pooled_integrators")
+{
+    auto data = make_reference_case();
+    const kep3::leg::zoh ref{data.state0, data.controls, data.state1, data.tgrid, data.cut, {data.ta, data.ta_var}};
+
+    const auto pool_dim = kep3::ta::get_ta_pool_dim();
+    const heyoka::taylor_adaptive<double> *first = nullptr;
+    for (auto i = 0; i < 3; ++i) {
+        const kep3::leg::zoh leg{data.state0,
+                                 data.controls,
+                                 data.state1,
+                                 data.tgrid,
+                                 data.cut,
+                                 kep3::ta::acquire_ta_zoh_kep(1e-14),
+                                 kep3::ta::acquire_ta_zoh_kep_var(1e-14)};
+        // The integrators are recycled by the legs constructed after the first one.
+        if (i == 0) {
+            first = &leg.get_ta();
+        } else {
+            REQUIRE(&leg.get_ta() == first);
+        }
+        REQUIRE(leg.compute_mismatch_constraints() == ref.compute_mismatch_constraints());
+        REQUIRE(leg.compute_mc_grad() == ref.compute_mc_grad());
+    }
+    REQUIRE(kep3::ta::get_ta_pool_dim() == pool_dim + 2u);
+
+    // Serialization does not depend on the origin of the integrators.
+    const kep3::leg::zoh leg{data.state0, data.controls, data.state1, data.tgrid, data.cut,
+                             kep3::ta::acquire_ta_zoh_kep(1e-14), std::nullopt};
+    std::stringstream ss;
+    {
+        boost::archive::binary_oarchive oarchive(ss);
+        oarchive << leg;
+    }
+    kep3::leg::zoh leg2{};
+    {
+        boost::archive::binary_iarchive iarchive(ss);
+        iarchive >> leg2;
+    }
+    REQUIRE(leg2.get_ta_var() == nullptr);
+    REQUIRE(leg2.compute_mismatch_constraints() == leg.compute_mismatch_constraints());
+}
@@ -0,0 +1,164 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+
+#include <fmt/core.h>
+
+#include <kep3/core_astro/constants.hpp>
+#include <kep3/epoch.hpp>
+#include <kep3/planet.hpp>
+#include <kep3/planet_catalog.hpp>
+#include <kep3/udpla/jpl_lp.hpp>
+#include <kep3/udpla/keplerian.hpp>
+
+#include "catch.hpp"
+
+using kep3::planet_catalog;
+
+namespace
+{
+// A catalog of random ellipses and hyperbolas, and the same bodies as planets.
+std::vector<kep3::planet> random_planets(std::size_t n, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> a_d(0.5, 5.), e_d(0., 0.95), ang_d(0., 2 * kep3::pi), t_d(-1000., 1000.),
+        h_d(1.1, 3.), f_d(-0.5, 0.5);
+    std::vector<kep3::planet> retval;
+    for (std::size_t i = 0u; i < n; ++i) {
+        std::array<double, 6> elem{};
+        if (i % 10u == 9u) {
+            // Hyperbola, close to periapsis.
+            elem = {-a_d(rng) * kep3::AU, h_d(rng), ang_d(rng), ang_d(rng), ang_d(rng), f_d(rng)};
+        } else {
+            elem = {a_d(rng) * kep3::AU, e_d(rng), ang_d(rng), ang_d(rng), ang_d(rng), ang_d(rng)};
+        }
+        retval.emplace_back(kep3::udpla::keplerian{kep3::epoch(t_d(rng)), elem, kep3::MU_SUN, fmt::format("b{}", i),
+                                                   {1., 2., 3.}});
+    }
+    return retval;
+}
+
+double rel_err(const double *a, const double *b)
+{
+    double err = 0., ref = 0.;
+    for (auto j = 0u; j < 3u; ++j) {
+        err += (a[j] - b[j]) * (a[j] - b[j]);
+        ref += b[j] * b[j];
+    }
+    return std::sqrt(err / ref);
+}
+} // namespace
+
+TEST_CASE("construction")
+{
+    planet_catalog cat;
+    REQUIRE(cat.size() == 0u);
+    REQUIRE(cat.eph_all(0.).empty());
+    REQUIRE(cat.eph_subset({}, {}).empty());
+
+    const auto planets = random_planets(20u, 1u);
+    cat = planet_catalog(planets);
+    REQUIRE(cat.size() == 20u);
+    cat.push_back(kep3::udpla::keplerian{});
+    REQUIRE(cat.size() == 21u);
+    REQUIRE_THROWS_AS(cat.push_back(kep3::planet{kep3::udpla::jpl_lp{"earth"}}), std::invalid_argument);
+    REQUIRE_THROWS_AS(planet_catalog(std::vector<kep3::planet>{kep3::planet{}}), std::invalid_argument);
+    REQUIRE(cat.size() == 21u);
+
+    // Single body access.
+    for (std::size_t i = 0u; i < planets.size(); ++i) {
+        const auto pla = cat.get_planet(i);
+        REQUIRE(pla.get_name() == planets[i].get_name());
+        REQUIRE(cat.get_name(i) == planets[i].get_name());
+        REQUIRE(pla.get_mu_central_body() == kep3::MU_SUN);
+        REQUIRE(pla.get_mu_self() == 1.);
+        REQUIRE(pla.get_radius() == 2.);
+        REQUIRE(pla.get_safe_radius() == 3.);
+        REQUIRE(pla.extract<kep3::udpla::keplerian>()->get_ref_epoch()
+                == planets[i].extract<kep3::udpla::keplerian>()->get_ref_epoch());
+        REQUIRE(pla.eph(123.) == planets[i].eph(123.));
+    }
+    REQUIRE_THROWS_AS(cat.get_planet(21u), std::out_of_range);
+    REQUIRE_THROWS_AS(cat.get_name(21u), std::out_of_range);
+}
+
+TEST_CASE("eph_all")
+{
+    // Large enough to be processed in parallel.
+    const auto planets = random_planets(5000u, 2u);
+    const planet_catalog cat(planets);
+    for (const double t : {-3000., 0., 1234.5}) {
+        const auto rv = cat.eph_all(t);
+        REQUIRE(rv.size() == 6u * planets.size());
+        REQUIRE(rv == cat.eph_all(kep3::epoch(t)));
+        for (std::size_t i = 0u; i < planets.size(); ++i) {
+            const auto [r, v] = planets[i].eph(t);
+            REQUIRE(rel_err(&rv[6u * i], r.data()) < 1e-11);
+            REQUIRE(rel_err(&rv[6u * i + 3u], v.data()) < 1e-11);
+        }
+    }
+}
+
+TEST_CASE("eph_subset")
+{
+    const auto planets = random_planets(100u, 3u);
+    const planet_catalog cat(planets);
+    const std::vector<std::size_t> idx = {3u, 99u, 3u, 19u, 0u};
+    const std::vector<double> eps = {0., 100., -200., 3000., 5.};
+
+    // One epoch per index.
+    auto rv = cat.eph_subset(idx, eps);
+    REQUIRE(rv.size() == 6u * idx.size());
+    for (std::size_t k = 0u; k < idx.size(); ++k) {
+        const auto [r, v] = planets[idx[k]].eph(eps[k]);
+        REQUIRE(rel_err(&rv[6u * k], r.data()) < 1e-11);
+        REQUIRE(rel_err(&rv[6u * k + 3u], v.data()) < 1e-11);
+    }
+
+    // A shared epoch.
+    rv = cat.eph_subset(idx, {100.});
+    const auto rv_all = cat.eph_all(100.);
+    for (std::size_t k = 0u; k < idx.size(); ++k) {
+        for (auto j = 0u; j < 6u; ++j) {
+            REQUIRE(rv[6u * k + j] == rv_all[6u * idx[k] + j]);
+        }
+    }
+
+    REQUIRE_THROWS_AS(cat.eph_subset(idx, {1., 2.}), std::invalid_argument);
+    REQUIRE_THROWS_AS(cat.eph_subset({0u, 100u}, {1.}), std::out_of_range);
+}
+
+TEST_CASE("serialization_test")
+{
+    const planet_catalog cat(random_planets(30u, 4u));
+    std::stringstream ss;
+    {
+        boost::archive::binary_oarchive oarchive(ss);
+        oarchive << cat;
+    }
+    planet_catalog cat2;
+    {
+        boost::archive::binary_iarchive iarchive(ss);
+        iarchive >> cat2;
+    }
+    REQUIRE(cat2.size() == cat.size());
+    REQUIRE(cat2.eph_all(42.) == cat.eph_all(42.));
+    REQUIRE(boost::lexical_cast<std::string>(cat2) == boost::lexical_cast<std::string>(cat));
+}
@@ -8,10 +8,14 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <fmt/core.h>
 
@@ -201,6 +205,31 @@ private:
 
 KEP3_S11N_EXPORT_WRAP(complete_udpla, kep3::detail::planet_iface)
 
+// An udpla only implementing the allocation free eph_v.
+struct span_udpla {
+    static std::array<std::array<double, 3>, 2> eph(double mjd2000)
+    {
+        return {{{mjd2000, 0., 0.}, {0., mjd2000, 0.}}};
+    };
+    static void eph_v(std::span<const double> mjd2000s, std::span<double> out)
+    {
+        for (decltype(mjd2000s.size()) i = 0u; i < mjd2000s.size(); ++i) {
+            const auto [r, v] = eph(mjd2000s[i]);
+            std::copy(r.begin(), r.end(), out.begin() + static_cast<std::ptrdiff_t>(6u * i));
+            std::copy(v.begin(), v.end(), out.begin() + static_cast<std::ptrdiff_t>(6u * i + 3u));
+        }
+    };
+
+private:
+    friend class boost::serialization::access;
+    template <typename Archive>
+    void serialize(Archive &, unsigned)
+    {
+    }
+};
+
+KEP3_S11N_EXPORT_WRAP(span_udpla, kep3::detail::planet_iface)
+
 TEST_CASE("construction")
 {
     {
@@ -426,17 +455,57 @@ TEST_CASE("acc_test")
         std::array<double, 3> gt = {mur3 * pos[0], mur3 * pos[1], mur3 * pos[2]};
         REQUIRE(acc_mu == gt);
     }
-    // 4 - The vectorized (defaulted) implementation
+    // 4 - The vectorized implementation. It is native in the keplerian udpla, so it matches acc only up to
+    // the conditioning of the anomaly (the test orbit has a period of a few seconds, i.e. ~1e6 revolutions here).
     std::vector<double> mjd2000s = {12.,34.,0.03,-323.231};
     auto res = pla_kep.acc_v(mjd2000s);
     for (auto i = 0u; i < 4u; ++i) {
         auto gt = pla_kep.acc(mjd2000s[i]);
-        REQUIRE(res[3*i] == gt[0]);
-        REQUIRE(res[3*i+1] == gt[1]);
-        REQUIRE(res[3*i+2] == gt[2]);
+        REQUIRE(kep3_tests::floating_point_error(res[3*i], gt[0]) < 1e-8);
+        REQUIRE(kep3_tests::floating_point_error(res[3*i+1], gt[1]) < 1e-8);
+        REQUIRE(kep3_tests::floating_point_error(res[3*i+2], gt[2]) < 1e-8);
     }
 }
 
+TEST_CASE("eph_v_span_test")
+{
+    REQUIRE(kep3::detail::udpla_has_eph_v_span<span_udpla>);
+    REQUIRE(!kep3::detail::udpla_has_eph_v<span_udpla>);
+    REQUIRE(kep3::detail::udpla_has_eph_v_span<kep3::udpla::keplerian>);
+    REQUIRE(kep3::detail::udpla_has_acc_v_span<kep3::udpla::keplerian>);
+    REQUIRE(!kep3::detail::udpla_has_eph_v_span<complete_udpla>);
+
+    // NOTE: complete_udpla::eph_v always returns two epochs.
+    const std::vector<double> mjd2000s = {12., -323.231};
+    std::vector<double> out(12u), out_acc(6u);
+    // A user provided span version, a user provided vector version, the default and a keplerian udpla.
+    for (const auto &pla : {planet{span_udpla{}}, planet{complete_udpla{}}, planet{simple_udpla{}},
+                            planet{kep3::udpla::keplerian{kep3::epoch(0.),
+                                                          {{{0.33, 1.3, 0.12}, {0.01, 1.123, 0.2}}},
+                                                          1.12,
+                                                          "enterprise"}}}) {
+        pla.eph_v(mjd2000s, out);
+        REQUIRE(out == pla.eph_v(mjd2000s));
+        // Wrong output sizes.
+        std::vector<double> wrong(11u);
+        REQUIRE_THROWS_AS(pla.eph_v(mjd2000s, wrong), std::invalid_argument);
+        REQUIRE_THROWS_AS(pla.acc_v(mjd2000s, wrong), std::invalid_argument);
+    }
+    REQUIRE(planet{span_udpla{}}.eph_v(mjd2000s)[6] == -323.231);
+
+    // The accelerations.
+    const planet pla_kep{kep3::udpla::keplerian{
+        kep3::epoch(0.), {{{0.33, 1.3, 0.12}, {0.01, 1.123, 0.2}}}, 1.12, "enterprise"}};
+    pla_kep.acc_v(mjd2000s, out_acc);
+    REQUIRE(out_acc == pla_kep.acc_v(mjd2000s));
+    const planet pla_mu{simple_udpla_mu{}};
+    pla_mu.acc_v(mjd2000s, out_acc);
+    REQUIRE(out_acc == pla_mu.acc_v(mjd2000s));
+
+    // Empty inputs.
+    REQUIRE_NOTHROW(pla_kep.eph_v(std::span<const double>{}, std::span<double>{}));
+}
+
 TEST_CASE("serialization_test")
 {
     // Instantiate a planet
@@ -0,0 +1,109 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <kep3/core_astro/constants.hpp>
+#include <kep3/epoch.hpp>
+#include <kep3/lambert_problem.hpp>
+#include <kep3/planet.hpp>
+#include <kep3/porkchop.hpp>
+#include <kep3/udpla/keplerian.hpp>
+
+#include "catch.hpp"
+#include "test_helpers.hpp"
+
+using kep3::udpla::keplerian;
+
+TEST_CASE("porkchop")
+{
+    // Earth and Mars like planets.
+    const kep3::epoch ref_epoch{0., kep3::epoch::julian_type::MJD2000};
+    const std::array<double, 6> par_earth = {1. * kep3::AU, 0.0167, 0.0001, 0., 1.99, 6.24};
+    const std::array<double, 6> par_mars = {1.5237 * kep3::AU, 0.0934, 0.0323, 0.865, 5.0, 0.338};
+    const kep3::planet earth{keplerian{ref_epoch, par_earth, kep3::MU_SUN}};
+    const kep3::planet mars{keplerian{ref_epoch, par_mars, kep3::MU_SUN}};
+
+    std::vector<double> t0s, t1s;
+    for (auto i = 0u; i < 23u; ++i) {
+        t0s.push_back(i * 20.);
+    }
+    for (auto i = 0u; i < 31u; ++i) {
+        t1s.push_back(100. + i * 25.);
+    }
+    const unsigned multi_revs = 2u;
+    const auto pc = kep3::porkchop(earth, mars, t0s, t1s, multi_revs);
+    REQUIRE(pc.n_dep == t0s.size());
+    REQUIRE(pc.n_arr == t1s.size());
+    REQUIRE(pc.dv_dep.size() == t0s.size() * t1s.size());
+    REQUIRE(pc.vinf_arr.size() == 3u * t0s.size() * t1s.size());
+
+    // We check all cells against kep3::lambert_problem and the planet ephemerides.
+    for (auto i = 0u; i < t0s.size(); ++i) {
+        for (auto j = 0u; j < t1s.size(); ++j) {
+            const auto cell = t1s.size() * i + j;
+            if (t1s[j] <= t0s[i]) {
+                REQUIRE(std::isnan(pc.dv_dep[cell]));
+                REQUIRE(std::isnan(pc.c3[cell]));
+                REQUIRE(std::isnan(pc.vinf_arr[3u * cell]));
+                REQUIRE(pc.branch[cell] == -1);
+                continue;
+            }
+            const auto [r0, v0] = earth.eph(t0s[i]);
+            const auto [r1, v1] = mars.eph(t1s[j]);
+            const kep3::lambert_problem lp{r0, r1, (t1s[j] - t0s[i]) * kep3::DAY2SEC, kep3::MU_SUN, false, multi_revs};
+            double best = std::numeric_limits<double>::infinity();
+            std::size_t best_idx = 0u;
+            for (decltype(lp.get_v0().size()) k = 0u; k < lp.get_v0().size(); ++k) {
+                std::array<double, 3> dv0 = {lp.get_v0()[k][0] - v0[0], lp.get_v0()[k][1] - v0[1],
+                                             lp.get_v0()[k][2] - v0[2]};
+                std::array<double, 3> dv1 = {lp.get_v1()[k][0] - v1[0], lp.get_v1()[k][1] - v1[1],
+                                             lp.get_v1()[k][2] - v1[2]};
+                const double dv = std::sqrt(dv0[0] * dv0[0] + dv0[1] * dv0[1] + dv0[2] * dv0[2])
+                                  + std::sqrt(dv1[0] * dv1[0] + dv1[1] * dv1[1] + dv1[2] * dv1[2]);
+                if (dv < best) {
+                    best = dv;
+                    best_idx = k;
+                }
+            }
+            REQUIRE(pc.branch[cell] == static_cast<int>(best_idx));
+            REQUIRE(kep3_tests::floating_point_error(pc.dv_dep[cell] + pc.dv_arr[cell], best) < 1e-10);
+            REQUIRE(kep3_tests::floating_point_error(pc.c3[cell], pc.dv_dep[cell] * pc.dv_dep[cell]) < 1e-14);
+            const std::array<double, 3> vinf0 = {pc.vinf_dep[3u * cell], pc.vinf_dep[3u * cell + 1],
+                                                 pc.vinf_dep[3u * cell + 2]};
+            const std::array<double, 3> vinf0_lp = {lp.get_v0()[best_idx][0] - v0[0], lp.get_v0()[best_idx][1] - v0[1],
+                                                    lp.get_v0()[best_idx][2] - v0[2]};
+            REQUIRE(kep3_tests::floating_point_error_vector(vinf0, vinf0_lp) < 1e-10);
+        }
+    }
+
+    // Empty grids.
+    REQUIRE(kep3::porkchop(earth, mars, {}, t1s).dv_dep.empty());
+
+    // Planets orbiting different bodies.
+    const std::array<double, 6> par_moon = {384400000., 0.05, 0.1, 0., 0., 0.};
+    const kep3::planet moon{keplerian{ref_epoch, par_moon, kep3::MU_EARTH}};
+    REQUIRE_THROWS_AS(kep3::porkchop(earth, moon, t0s, t1s), std::invalid_argument);
+
+    // Planets moving in the x-z plane: all Lambert problems are ill defined and all cells are left empty.
+    const kep3::planet polar0{keplerian{ref_epoch, {{{1., 0., 0.}, {0., 0., 1.}}}, 1.}};
+    const kep3::planet polar1{keplerian{ref_epoch, {{{0., 0., 1.5}, {0.8, 0., 0.}}}, 1.}};
+    const auto pc_polar = kep3::porkchop(polar0, polar1, {0., 0.5}, {1., 2., 3.});
+    REQUIRE(pc_polar.dv_dep.size() == 6u);
+    for (auto cell = 0u; cell < 6u; ++cell) {
+        REQUIRE(std::isnan(pc_polar.dv_dep[cell]));
+        REQUIRE(std::isnan(pc_polar.dv_arr[cell]));
+        REQUIRE(pc_polar.branch[cell] == -1);
+    }
+}
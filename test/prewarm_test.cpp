@@ -0,0 +1,53 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <stdexcept>
+#include <vector>
+
+#include <kep3/core_astro/constants.hpp>
+#include <kep3/prewarm.hpp>
+#include <kep3/ta/kep.hpp>
+#include <kep3/ta/pontryagin_cartesian.hpp>
+#include <kep3/ta/zoh_kep.hpp>
+
+#include "catch.hpp"
+
+using kep3::prewarm;
+
+TEST_CASE("prewarm")
+{
+    REQUIRE(prewarm({}).empty());
+
+    // Unknown models throw before anything is compiled.
+    REQUIRE_THROWS_AS(prewarm({{"zoh_kep", 1e-12}, {"not_a_model", 1e-12}}), std::invalid_argument);
+    REQUIRE_THROWS_AS(prewarm({{"vsop2013", 1e-5}}), std::invalid_argument);
+    REQUIRE(kep3::ta::get_ta_zoh_kep_cache_dim() == 0u);
+    // Unknown bodies throw while compiling.
+    REQUIRE_THROWS_AS(prewarm({{"vsop2013:vulcan", 1e-5}}), std::invalid_argument);
+
+    // The requested items end up in the in-memory caches.
+    const auto times = prewarm({{"zoh_kep", 1e-12},
+                                {"zoh_kep_var", 1e-12},
+                                {"kep", 1e-10},
+                                {"pc", 1e-12, kep3::optimality_type::TIME},
+                                {"pc_cfuncs", 0., kep3::optimality_type::TIME}});
+    REQUIRE(times.size() == 5u);
+    for (const auto t : times) {
+        REQUIRE(t >= 0.);
+    }
+    REQUIRE(kep3::ta::get_ta_zoh_kep_cache_dim() == 1u);
+    REQUIRE(kep3::ta::get_ta_zoh_kep_var_cache_dim() == 1u);
+    REQUIRE(kep3::ta::get_ta_kep_cache_dim() == 1u);
+    REQUIRE(kep3::ta::get_ta_pc_cache_dim() == 1u);
+
+    // Items already cached are not compiled again.
+    prewarm({{"zoh_kep", 1e-12}, {"zoh_kep", 1e-12}});
+    REQUIRE(kep3::ta::get_ta_zoh_kep_cache_dim() == 1u);
+}
@@ -8,9 +8,12 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <boost/move/detail/meta_utils.hpp>
 #include <functional>
+#include <random>
 #include <stdexcept>
+#include <vector>
 
 #include <fmt/core.h>
 #include <fmt/ranges.h>
@@ -181,3 +184,129 @@ TEST_CASE("vectorized") {
     auto res = kep3::propagate_lagrangian_grid(pos_vel, tofs, 1.24);
     REQUIRE(res.size() == 9);
 }
+
+TEST_CASE("batch")
+{
+    // NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp)
+    std::mt19937 rng_engine(1220202343u);
+    std::uniform_real_distribution<double> sma_d(1.1, 10.);
+    std::uniform_real_distribution<double> ecc_d(0, 0.9);
+    std::uniform_real_distribution<double> angle_d(0., kep3::pi);
+    std::uniform_real_distribution<double> time_d(-2. * kep3::pi, 2. * kep3::pi);
+    std::uniform_real_distribution<double> mu_d(0.5, 2.);
+
+    // A mix of ellipses and hyperbolas, each with its own tof and mu. Kepler's equation is solved by
+    // the vectorized kernels, so we only expect agreement with propagate_lagrangian to round-off.
+    const auto N = 1000u;
+    std::vector<double> rs(3u * N), vs(3u * N), tofs(N), mus(N);
+    for (auto i = 0u; i < N; ++i) {
+        double sma = sma_d(rng_engine);
+        double ecc = ecc_d(rng_engine);
+        if (i % 2u) {
+            sma = -sma;
+            ecc += 1.1;
+        }
+        mus[i] = mu_d(rng_engine);
+        tofs[i] = time_d(rng_engine);
+        std::array<double, 6> par = {sma, ecc, angle_d(rng_engine), angle_d(rng_engine), angle_d(rng_engine), 0.1};
+        const auto pos_vel = kep3::par2ic(par, mus[i]);
+        std::copy(pos_vel[0].begin(), pos_vel[0].end(), rs.begin() + 3u * i);
+        std::copy(pos_vel[1].begin(), pos_vel[1].end(), vs.begin() + 3u * i);
+    }
+
+    // Per state mu, with the state transition matrices.
+    std::vector<double> rfs(3u * N), vfs(3u * N), stms(36u * N);
+    kep3::propagate_lagrangian_batch(rs, vs, tofs, mus, rfs, vfs, stms);
+    for (auto i = 0u; i < N; ++i) {
+        const std::array<std::array<double, 3>, 2> pos_vel
+            = {{{rs[3u * i], rs[3u * i + 1], rs[3u * i + 2]}, {vs[3u * i], vs[3u * i + 1], vs[3u * i + 2]}}};
+        const auto res = propagate_lagrangian(pos_vel, tofs[i], mus[i], true);
+        for (auto j = 0u; j < 3u; ++j) {
+            REQUIRE(kep3_tests::floating_point_error(rfs[3u * i + j], res.first[0][j]) < 1e-13);
+            REQUIRE(kep3_tests::floating_point_error(vfs[3u * i + j], res.first[1][j]) < 1e-13);
+        }
+        for (auto j = 0u; j < 36u; ++j) {
+            REQUIRE(kep3_tests::floating_point_error(stms[36u * i + j], res.second.value()[j]) < 1e-12);
+        }
+    }
+
+    // Shared mu, no state transition matrices, in place.
+    std::vector<double> rfs2(rs), vfs2(vs);
+    kep3::propagate_lagrangian_batch(rfs2, vfs2, tofs, std::vector<double>{1.3}, rfs2, vfs2);
+    for (auto i = 0u; i < N; ++i) {
+        const std::array<std::array<double, 3>, 2> pos_vel
+            = {{{rs[3u * i], rs[3u * i + 1], rs[3u * i + 2]}, {vs[3u * i], vs[3u * i + 1], vs[3u * i + 2]}}};
+        const auto res = propagate_lagrangian(pos_vel, tofs[i], 1.3);
+        for (auto j = 0u; j < 3u; ++j) {
+            REQUIRE(kep3_tests::floating_point_error(rfs2[3u * i + j], res.first[0][j]) < 1e-13);
+            REQUIRE(kep3_tests::floating_point_error(vfs2[3u * i + j], res.first[1][j]) < 1e-13);
+        }
+    }
+
+    // Inconsistent buffers.
+    std::vector<double> wrong3(3u), wrong36(36u);
+    REQUIRE_THROWS_AS(kep3::propagate_lagrangian_batch(std::vector<double>(3u * N - 1u), vs, tofs, mus, rfs, vfs),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(kep3::propagate_lagrangian_batch(rs, vs, tofs, mus, rfs, wrong3),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(kep3::propagate_lagrangian_batch(rs, vs, tofs, std::vector<double>{1., 2.}, rfs, vfs),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(kep3::propagate_lagrangian_batch(rs, vs, tofs, mus, rfs, vfs, wrong36),
+                      std::invalid_argument);
+    // Empty batches are allowed.
+    REQUIRE_NOTHROW(kep3::propagate_lagrangian_batch({}, {}, {}, std::vector<double>{1.}, {}, {}));
+}
+
+TEST_CASE("grid_streaming")
+{
+    // An ellipse over several revolutions and a hyperbola, with unevenly spaced (and repeated) epochs.
+    const std::array<std::array<std::array<double, 3>, 2>, 2> ics
+        = {{{{{1.223, 0.3123, -0.432}, {0.06345, 0.43234, -0.874634}}},
+            {{{1.223, 0.3123, -0.432}, {-3.06345, 4.43234, -0.874634}}}}};
+    std::vector<double> time_grid;
+    for (auto i = 0u; i < 1000u; ++i) {
+        time_grid.push_back(1.2 + 0.04 * i + 0.01 * std::sin(i));
+    }
+    time_grid[10] = time_grid[9];
+    const auto N = time_grid.size();
+
+    for (const auto &pos_vel : ics) {
+        const auto ref = kep3::propagate_lagrangian_grid(pos_vel, time_grid, 1.24, true);
+        for (const bool parallel : {false, true}) {
+            // States and composed state transition matrices.
+            std::vector<double> pos_vels(6u * N), stms(36u * N);
+            kep3::propagate_lagrangian_grid(pos_vel, time_grid, 1.24, pos_vels, stms, true, parallel);
+            for (decltype(ref.size()) i = 0u; i < N; ++i) {
+                const std::array<double, 3> r = {pos_vels[6u * i], pos_vels[6u * i + 1], pos_vels[6u * i + 2]};
+                const std::array<double, 3> v = {pos_vels[6u * i + 3], pos_vels[6u * i + 4], pos_vels[6u * i + 5]};
+                REQUIRE(kep3_tests::floating_point_error_vector(r, ref[i].first[0]) < 1e-12);
+                REQUIRE(kep3_tests::floating_point_error_vector(v, ref[i].first[1]) < 1e-12);
+                for (auto j = 0u; j < 36u; ++j) {
+                    REQUIRE(kep3_tests::floating_point_error(stms[36u * i + j], ref[i].second.value()[j]) < 1e-9);
+                }
+            }
+            // Step by step state transition matrices.
+            kep3::propagate_lagrangian_grid(pos_vel, time_grid, 1.24, pos_vels, stms, false, parallel);
+            for (auto j = 0u; j < 36u; ++j) {
+                REQUIRE(stms[j] == (j % 7u == 0u ? 1. : 0.));
+            }
+            for (decltype(ref.size()) i = 1u; i < N; ++i) {
+                const auto step
+                    = propagate_lagrangian(ref[i - 1u].first, time_grid[i] - time_grid[i - 1u], 1.24, true);
+                for (auto j = 0u; j < 36u; ++j) {
+                    REQUIRE(kep3_tests::floating_point_error(stms[36u * i + j], step.second.value()[j]) < 1e-9);
+                }
+            }
+            // States only.
+            std::vector<double> pos_vels2(6u * N);
+            kep3::propagate_lagrangian_grid(pos_vel, time_grid, 1.24, pos_vels2, {}, true, parallel);
+            REQUIRE(pos_vels2 == pos_vels);
+        }
+    }
+
+    // Inconsistent buffers.
+    std::vector<double> wrong(6u * N - 1u), pos_vels(6u * N), wrong_stms(36u);
+    REQUIRE_THROWS_AS(kep3::propagate_lagrangian_grid(ics[0], time_grid, 1.24, wrong), std::invalid_argument);
+    REQUIRE_THROWS_AS(kep3::propagate_lagrangian_grid(ics[0], time_grid, 1.24, pos_vels, wrong_stms),
+                      std::invalid_argument);
+}
@@ -9,10 +9,14 @@
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <heyoka/taylor.hpp>
 
+#include <kep3/jit_cache.hpp>
 #include <kep3/ta/zoh_kep.hpp>
 
 #include "catch.hpp"
@@ -144,3 +148,105 @@ TEST_CASE("variational_propagation")
                 std::vector<double>(ta_var.get_state().begin(), ta_var.get_state().begin() + 7), ta.get_state())
             <= 1e-13);
 }
+
+TEST_CASE("pool")
+{
+    const auto pool_dim = kep3::ta::get_ta_pool_dim();
+    const auto *first = static_cast<const taylor_adaptive<double> *>(nullptr);
+    {
+        auto h = kep3::ta::acquire_ta_zoh_kep(1e-16);
+        REQUIRE(h->get_dim() == 7);
+        REQUIRE(h->is_variational() == false);
+        first = h.get();
+        // Two handles alive at the same time own different copies.
+        auto h2 = kep3::ta::acquire_ta_zoh_kep(1e-16);
+        REQUIRE(h2.get() != first);
+        (*h).set_time(1.);
+    }
+    REQUIRE(kep3::ta::get_ta_pool_dim() == pool_dim + 2u);
+    {
+        // The copies are reused, with the time left by the previous user.
+        auto h = kep3::ta::acquire_ta_zoh_kep(1e-16);
+        auto h2 = kep3::ta::acquire_ta_zoh_kep(1e-16);
+        REQUIRE((h.get() == first || h2.get() == first));
+        REQUIRE(kep3::ta::get_ta_pool_dim() == pool_dim);
+        // Moving does not return the copy to the pool.
+        auto h3 = std::move(h);
+        REQUIRE(kep3::ta::get_ta_pool_dim() == pool_dim);
+        // Different integrators and tolerances are pooled separately.
+        auto h4 = kep3::ta::acquire_ta_zoh_kep_var(1e-16);
+        REQUIRE(h4->is_variational() == true);
+        auto h5 = kep3::ta::acquire_ta_zoh_kep(1e-8);
+        REQUIRE(h5->get_tol() == 1e-8);
+    }
+    REQUIRE(kep3::ta::get_ta_pool_dim() == pool_dim + 4u);
+    // The cache is not affected.
+    REQUIRE(get_ta_zoh_kep_cache_dim() == 2u);
+    // Copies are pooled as well, integrators which do not come from a pool are not.
+    {
+        const auto h = kep3::ta::acquire_ta_zoh_kep(1e-8);
+        REQUIRE(h.is_pooled());
+        const auto h2 = h;
+        REQUIRE(h2.is_pooled());
+        REQUIRE(h2.get() != h.get());
+        const kep3::ta::ta_handle h3(kep3::ta::get_ta_zoh_kep(1e-8));
+        REQUIRE(!h3.is_pooled());
+    }
+    REQUIRE(kep3::ta::get_ta_pool_dim() == pool_dim + 5u);
+    // The free copies are capped, per tolerance and in total.
+    {
+        std::vector<kep3::ta::ta_handle> hs;
+        for (auto i = 0u; i < kep3::ta::ta_pool_max_free + 2u; ++i) {
+            hs.push_back(kep3::ta::acquire_ta_zoh_kep(1e-12));
+        }
+    }
+    REQUIRE(kep3::ta::get_ta_pool_dim() == pool_dim + 5u + kep3::ta::ta_pool_max_free);
+    {
+        std::vector<kep3::ta::ta_handle> hs;
+        for (auto tol : {1e-9, 1e-10, 1e-11}) {
+            for (auto i = 0u; i < kep3::ta::ta_pool_max_free; ++i) {
+                hs.push_back(kep3::ta::acquire_ta_zoh_kep(tol));
+            }
+        }
+    }
+    REQUIRE(kep3::ta::get_ta_pool_dim() == kep3::ta::ta_pool_max_size);
+}
+
+TEST_CASE("concurrent_getters")
+{
+    // Threads asking for the same integrator concurrently compile it once, the others wait for it.
+    kep3::reset_jit_memory_cache_stats();
+    const auto dim = get_ta_zoh_kep_var_cache_dim();
+    // NOTE: Catch2 assertions are not thread safe, the results are checked after the join.
+    std::vector<std::size_t> sizes(4u);
+    std::vector<std::thread> threads;
+    for (auto i = 0u; i < 4u; ++i) {
+        threads.emplace_back([&sizes, i]() { sizes[i] = get_ta_zoh_kep_var(1e-11).get_state().size(); });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    // 7 states and their derivatives with respect to the 7 states and the 4 parameters.
+    REQUIRE(std::ranges::all_of(sizes, [](std::size_t n) { return n == 84u; }));
+    REQUIRE(get_ta_zoh_kep_var_cache_dim() == dim + 1u);
+    const auto stats = kep3::get_jit_memory_cache_stats().at("ta_zoh_kep_var");
+    REQUIRE(stats.misses == 1u);
+    REQUIRE(stats.hits == 3u);
+}
+
+TEST_CASE("pool_normalized_tol")
+{
+    kep3::set_jit_cache_tol_digits(3u);
+    const auto *first = static_cast<const taylor_adaptive<double> *>(nullptr);
+    {
+        const auto h = kep3::ta::acquire_ta_zoh_kep(1.0000000001e-14);
+        REQUIRE(h->get_tol() == 1e-14);
+        first = h.get();
+    }
+    {
+        // Tolerances sharing a cache entry share the pool.
+        const auto h = kep3::ta::acquire_ta_zoh_kep(1e-14);
+        REQUIRE(h.get() == first);
+    }
+    kep3::set_jit_cache_tol_digits(0u);
+}
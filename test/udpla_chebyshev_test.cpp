@@ -0,0 +1,155 @@
+// Copyright (c) 2023-2026 Dario Izzo (dario.izzo@gmail.com)
+//                          Advanced Concepts Team, European Space Agency (ESA)
+//
+// This file is part of the kep3 library.
+//
+// SPDX-License-Identifier: MPL-2.0
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+
+#include <kep3/core_astro/constants.hpp>
+#include <kep3/epoch.hpp>
+#include <kep3/planet.hpp>
+#include <kep3/udpla/chebyshev.hpp>
+#include <kep3/udpla/jpl_lp.hpp>
+#include <kep3/udpla/keplerian.hpp>
+
+#include "catch.hpp"
+
+using kep3::udpla::chebyshev;
+
+namespace
+{
+double rel_err(const std::array<double, 3> &a, const std::array<double, 3> &b)
+{
+    return std::sqrt((a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) + (a[2] - b[2]) * (a[2] - b[2]))
+           / std::sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+}
+} // namespace
+
+TEST_CASE("constructor")
+{
+    REQUIRE_NOTHROW(chebyshev{});
+    REQUIRE_NOTHROW(kep3::planet{chebyshev{}});
+    const kep3::planet earth{kep3::udpla::jpl_lp{"earth"}};
+    REQUIRE_THROWS_AS((chebyshev{earth, 10., 10.}), std::invalid_argument);
+    REQUIRE_THROWS_AS((chebyshev{earth, 10., 0.}), std::invalid_argument);
+    REQUIRE_THROWS_AS((chebyshev{earth, 0., std::numeric_limits<double>::infinity()}), std::invalid_argument);
+    REQUIRE_THROWS_AS((chebyshev{earth, 0., 10., 0.}), std::invalid_argument);
+    REQUIRE_THROWS_AS((chebyshev{earth, 0., 10., -1e-3}), std::invalid_argument);
+    REQUIRE_THROWS_AS((chebyshev{earth, 0., 10., 1e-10, 0u}), std::invalid_argument);
+    REQUIRE_THROWS_AS((chebyshev{earth, 0., 10., 1e-10, 65u}), std::invalid_argument);
+    REQUIRE_THROWS_AS((chebyshev{earth, 0., 10., 1e-30}), std::invalid_argument);
+    REQUIRE_THROWS_AS((chebyshev{earth, 0., 10., std::numeric_limits<double>::epsilon()}), std::invalid_argument);
+    // Unreachable tolerance within the budget of fits.
+    REQUIRE_THROWS_AS((chebyshev{earth, 0., 10000., 1e-13, 1u}), std::domain_error);
+    // Out of the source validity.
+    REQUIRE_THROWS_AS((chebyshev{earth, 0., 1e6}), std::domain_error);
+
+    // The physical parameters are copied from the source.
+    const kep3::planet pla{chebyshev{earth, 0., 1000.}};
+    REQUIRE(pla.get_name() == earth.get_name());
+    REQUIRE(pla.get_mu_central_body() == earth.get_mu_central_body());
+    REQUIRE(pla.get_mu_self() == earth.get_mu_self());
+    REQUIRE(pla.get_radius() == earth.get_radius());
+    REQUIRE(pla.get_safe_radius() == earth.get_safe_radius());
+}
+
+TEST_CASE("eph")
+{
+    const kep3::planet mars{kep3::udpla::jpl_lp{"mars"}};
+    const double tol = 1e-10;
+    const chebyshev udpla{mars, 1000., 5000., tol};
+    REQUIRE(udpla.get_window() == std::array<double, 2>{1000., 5000.});
+    REQUIRE(udpla.get_tol() == tol);
+    REQUIRE(udpla.get_order() == 15u);
+    REQUIRE(udpla.get_n_segments() > 1u);
+    REQUIRE(udpla.get_max_error() <= tol);
+
+    // The error is (about) within the tolerance also away from the check points.
+    std::mt19937 rng(3245u);
+    std::uniform_real_distribution<double> dist(1000., 5000.);
+    std::vector<double> epochs{1000., 5000.};
+    for (auto i = 0u; i < 1000u; ++i) {
+        epochs.push_back(dist(rng));
+    }
+    for (const auto ep : epochs) {
+        const auto [r, v] = udpla.eph(ep);
+        const auto [r_ref, v_ref] = mars.eph(ep);
+        REQUIRE(rel_err(r, r_ref) < 10 * tol);
+        REQUIRE(rel_err(v, v_ref) < 10 * tol);
+    }
+
+    // Vectorized version.
+    const auto pv = udpla.eph_v(epochs);
+    REQUIRE(pv.size() == epochs.size() * 6u);
+    for (decltype(epochs.size()) i = 0u; i < epochs.size(); ++i) {
+        const auto [r, v] = udpla.eph(epochs[i]);
+        REQUIRE(pv[6 * i] == r[0]);
+        REQUIRE(pv[6 * i + 4] == v[1]);
+    }
+
+    // Out of the window.
+    REQUIRE_THROWS_AS(udpla.eph(999.), std::domain_error);
+    REQUIRE_THROWS_AS(udpla.eph(5000.1), std::domain_error);
+    REQUIRE_THROWS_AS(udpla.eph(std::numeric_limits<double>::quiet_NaN()), std::domain_error);
+    REQUIRE_THROWS_AS(udpla.eph_v({1000., 6000.}), std::domain_error);
+    REQUIRE_THROWS_AS(udpla.acc(6000.), std::domain_error);
+}
+
+TEST_CASE("acc")
+{
+    // On a Keplerian orbit the derivative of the velocity is the Keplerian acceleration.
+    const std::array<double, 6> elem = {1.3 * kep3::AU, 0.2, 0.1, 0.3, 0.4, 0.5};
+    const kep3::planet source{kep3::udpla::keplerian{kep3::epoch(0.), elem, kep3::MU_SUN, "source"}};
+    const kep3::planet pla{chebyshev{source, 0., 2000., 1e-12}};
+    for (auto i = 0u; i <= 100u; ++i) {
+        const double ep = 20. * i;
+        REQUIRE(rel_err(pla.acc(ep), source.acc(ep)) < 1e-8);
+    }
+    const auto acc = pla.acc_v({0., 1000., 2000.});
+    REQUIRE(acc.size() == 9u);
+    REQUIRE(acc[3] == pla.acc(1000.)[0]);
+    // The span overloads of the udpla check the size of the output.
+    const chebyshev udpla{source, 0., 2000., 1e-12};
+    const std::vector<double> epochs{0., 1000.};
+    std::vector<double> out(5u);
+    REQUIRE_THROWS_AS(udpla.eph_v(epochs, out), std::invalid_argument);
+    REQUIRE_THROWS_AS(udpla.acc_v(epochs, out), std::invalid_argument);
+}
+
+TEST_CASE("serialization_test")
+{
+    const kep3::planet earth{kep3::udpla::jpl_lp{"earth"}};
+    const kep3::planet pla{chebyshev{earth, 0., 3000., 1e-11, 12u}};
+
+    std::stringstream ss;
+    auto before = boost::lexical_cast<std::string>(pla);
+    {
+        boost::archive::binary_oarchive oarchive(ss);
+        oarchive << pla;
+    }
+    kep3::planet pla2{};
+    {
+        boost::archive::binary_iarchive iarchive(ss);
+        iarchive >> pla2;
+    }
+    auto after = boost::lexical_cast<std::string>(pla2);
+    REQUIRE(before == after);
+    REQUIRE(pla2.extract<chebyshev>() != nullptr);
+    for (auto ep : {0., 123.456, 1500., 3000.}) {
+        REQUIRE(pla.eph(ep) == pla2.eph(ep));
+    }
+}
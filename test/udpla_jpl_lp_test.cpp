@@ -136,6 +136,47 @@ TEST_CASE("eph")
     REQUIRE_THROWS_AS(udpla.eph(5347534.), std::domain_error);
 }
 
+TEST_CASE("eph_v")
+{
+    std::vector<double> mjd2000s;
+    for (auto i = 0u; i < 1000u; ++i) {
+        mjd2000s.push_back(-73000. + 91.2 * i);
+    }
+    for (const auto *name : {"mercury", "venus", "earth", "mars", "jupiter", "saturn", "uranus", "neptune"}) {
+        kep3::planet pla{jpl_lp{name}};
+        auto pos_vels = pla.eph_v(mjd2000s);
+        auto accs = pla.acc_v(mjd2000s);
+        REQUIRE(pos_vels.size() == 6u * mjd2000s.size());
+        REQUIRE(accs.size() == 3u * mjd2000s.size());
+        // The two paths round differently: the mean anomaly reaches thousands of radians at the range ends.
+        for (decltype(mjd2000s.size()) i = 0u; i < mjd2000s.size(); ++i) {
+            auto [r, v] = pla.eph(mjd2000s[i]);
+            auto a = pla.acc(mjd2000s[i]);
+            std::array<double, 3> r_v = {pos_vels[6 * i], pos_vels[6 * i + 1], pos_vels[6 * i + 2]};
+            std::array<double, 3> v_v = {pos_vels[6 * i + 3], pos_vels[6 * i + 4], pos_vels[6 * i + 5]};
+            std::array<double, 3> a_v = {accs[3 * i], accs[3 * i + 1], accs[3 * i + 2]};
+            REQUIRE(kep3_tests::floating_point_error_vector(r, r_v) < 1e-8);
+            REQUIRE(kep3_tests::floating_point_error_vector(v, v_v) < 1e-8);
+            REQUIRE(kep3_tests::floating_point_error_vector(a, a_v) < 1e-8);
+        }
+    }
+    // Out of the validity range.
+    jpl_lp udpla{"uranus"};
+    REQUIRE_THROWS_AS(udpla.eph_v({0., 5347534.}), std::domain_error);
+    REQUIRE_THROWS_AS(udpla.acc_v({-73048.}), std::domain_error);
+    REQUIRE(udpla.eph_v({}).empty());
+    // The span overloads write into the output and check its size.
+    std::vector<double> out(6u * mjd2000s.size());
+    udpla.eph_v(mjd2000s, out);
+    REQUIRE(out == udpla.eph_v(mjd2000s));
+    out.resize(3u * mjd2000s.size());
+    udpla.acc_v(mjd2000s, out);
+    REQUIRE(out == udpla.acc_v(mjd2000s));
+    REQUIRE_THROWS_AS(udpla.eph_v(mjd2000s, out), std::invalid_argument);
+    out.resize(3u * mjd2000s.size() + 3u);
+    REQUIRE_THROWS_AS(udpla.acc_v(mjd2000s, out), std::invalid_argument);
+}
+
 TEST_CASE("elements")
 {
     double ref_epoch = 12.22;
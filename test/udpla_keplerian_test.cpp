@@ -11,6 +11,7 @@
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 #include <stdexcept>
+#include <vector>
 
 #include <kep3/core_astro/constants.hpp>
 #include <kep3/core_astro/convert_anomalies.hpp>
@@ -114,6 +115,50 @@ TEST_CASE("eph")
     REQUIRE(kep3_tests::floating_point_error_vector(pos_vel[1], pos_vel_0[1]) > 1e-4);
 }
 
+TEST_CASE("eph_v")
+{
+    kep3::epoch ref_epoch{12.22, kep3::epoch::julian_type::MJD2000};
+    std::vector<double> mjd2000s;
+    for (auto i = 0u; i < 1000u; ++i) {
+        mjd2000s.push_back(ref_epoch.mjd2000() - 3000. + 6.123 * i);
+    }
+    // Ellipses (also circular and equatorial) and hyperbolas, with both constructors.
+    std::vector<keplerian> udplas{
+        keplerian{ref_epoch, {{{kep3::AU, 0., 0.}, {0., kep3::EARTH_VELOCITY, 0.}}}, kep3::MU_SUN},
+        keplerian{ref_epoch, {{{kep3::AU, 0.1 * kep3::AU, 0.}, {-2000., 35000., 1200.}}}, kep3::MU_SUN},
+        keplerian{ref_epoch, {{{kep3::AU, 0.1 * kep3::AU, 0.}, {-2000., 35000., -9000.}}}, kep3::MU_SUN},
+        keplerian{ref_epoch, std::array<double, 6>{1.3 * kep3::AU, 0.9, 0.3, 1.2, 2.2, 3.}, kep3::MU_SUN},
+        keplerian{ref_epoch, std::array<double, 6>{1.3 * kep3::AU, 0., 0., 0., 0., 0.}, kep3::MU_SUN},
+        keplerian{ref_epoch, std::array<double, 6>{-2. * kep3::AU, 1.5, 0.3, 1.2, 2.2, 0.2}, kep3::MU_SUN},
+        keplerian{ref_epoch, {{{kep3::AU, 0., 0.}, {0., 3. * kep3::EARTH_VELOCITY, 1000.}}}, kep3::MU_SUN}};
+    for (const auto &udpla : udplas) {
+        kep3::planet pla{udpla};
+        auto pos_vels = pla.eph_v(mjd2000s);
+        auto accs = pla.acc_v(mjd2000s);
+        REQUIRE(pos_vels.size() == 6u * mjd2000s.size());
+        REQUIRE(accs.size() == 3u * mjd2000s.size());
+        // The two paths round differently, and errors grow with the number of revolutions since the reference epoch.
+        for (decltype(mjd2000s.size()) i = 0u; i < mjd2000s.size(); ++i) {
+            auto [r, v] = pla.eph(mjd2000s[i]);
+            auto a = pla.acc(mjd2000s[i]);
+            std::array<double, 3> r_v = {pos_vels[6 * i], pos_vels[6 * i + 1], pos_vels[6 * i + 2]};
+            std::array<double, 3> v_v = {pos_vels[6 * i + 3], pos_vels[6 * i + 4], pos_vels[6 * i + 5]};
+            std::array<double, 3> a_v = {accs[3 * i], accs[3 * i + 1], accs[3 * i + 2]};
+            REQUIRE(kep3_tests::floating_point_error_vector(r, r_v) < 1e-9);
+            REQUIRE(kep3_tests::floating_point_error_vector(v, v_v) < 1e-9);
+            REQUIRE(kep3_tests::floating_point_error_vector(a, a_v) < 1e-9);
+        }
+    }
+    // Empty input.
+    REQUIRE(kep3::planet{keplerian{}}.eph_v({}).empty());
+    REQUIRE(kep3::planet{keplerian{}}.acc_v({}).empty());
+    // The span overloads of the udpla check the size of the output.
+    std::vector<double> out(6u * mjd2000s.size() - 1u);
+    REQUIRE_THROWS_AS(udplas[0].eph_v(mjd2000s, out), std::invalid_argument);
+    out.resize(3u * mjd2000s.size() + 3u);
+    REQUIRE_THROWS_AS(udplas[0].acc_v(mjd2000s, out), std::invalid_argument);
+}
+
 TEST_CASE("elements")
 {
     kep3::epoch ref_epoch{12.22, kep3::epoch::julian_type::MJD2000};
@@ -10,7 +10,9 @@
 
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -23,6 +25,7 @@
 #include <kep3/core_astro/ic2par2ic.hpp>
 #include <kep3/detail/s11n.hpp>
 #include <kep3/exceptions.hpp>
+#include <kep3/jit_cache.hpp>
 #include <kep3/udpla/jpl_lp.hpp>
 #include <kep3/udpla/vsop2013.hpp>
 
@@ -223,3 +226,66 @@ TEST_CASE("eph")
     REQUIRE(eph[1][1] == Approx(30061.035989651813));
     REQUIRE(eph[1][2] == Approx(14201.00090492195));
 }
+
+TEST_CASE("eph_v")
+{
+    planet p{vsop2013{"mars", 1e-6}};
+
+    // Sizes around the batch size and above the parallel threshold.
+    for (auto n : {0u, 1u, 3u, 17u, 1000u, 50001u}) {
+        std::vector<double> mjd2000s(n);
+        for (decltype(n) i = 0u; i < n; ++i) {
+            mjd2000s[i] = -20000. + 0.731 * i;
+        }
+        auto pos_vels = p.eph_v(mjd2000s);
+        REQUIRE(pos_vels.size() == 6u * n);
+        for (decltype(n) i = 0u; i < n; i += 7u) {
+            auto [r, v] = p.eph(mjd2000s[i]);
+            for (auto k = 0u; k < 3u; ++k) {
+                REQUIRE(pos_vels[6u * i + k] == Approx(r[k]).epsilon(1e-12));
+                REQUIRE(pos_vels[6u * i + 3u + k] == Approx(v[k]).epsilon(1e-12));
+            }
+        }
+        // The span overload writes into the output.
+        std::vector<double> out(6u * n);
+        p.extract<vsop2013>()->eph_v(mjd2000s, out);
+        REQUIRE(out == pos_vels);
+    }
+    // The span overload checks the size of the output.
+    std::vector<double> out(5u);
+    REQUIRE_THROWS_AS(p.extract<vsop2013>()->eph_v(std::vector<double>{0.}, out), std::invalid_argument);
+}
+
+TEST_CASE("lazy_batch")
+{
+    // A threshold not used elsewhere, so that the cache starts cold.
+    const auto misses = [] { return kep3::get_jit_memory_cache_stats().at("vsop2013").misses; };
+    const planet p{vsop2013{"venus", 3.21e-4}};
+    const auto n_misses = misses();
+    // eph only uses the scalar function.
+    REQUIRE_NOTHROW(p.eph(0.));
+    REQUIRE(misses() == n_misses);
+
+    // The first eph_v calls of many threads fetch the batch function once.
+    const auto *udpla = p.extract<vsop2013>();
+    std::vector<std::vector<double>> results(4u);
+    std::vector<std::thread> threads;
+    for (auto &res : results) {
+        threads.emplace_back([&res, udpla]() { res = udpla->eph_v(std::vector<double>{0., 1000.}); });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    REQUIRE(misses() <= n_misses + 1u);
+    for (const auto &res : results) {
+        REQUIRE(res == results[0]);
+    }
+    auto [r, v] = p.eph(1000.);
+    REQUIRE(results[0][6] == Approx(r[0]).epsilon(1e-12));
+    REQUIRE(results[0][9] == Approx(v[0]).epsilon(1e-12));
+
+    // Copies fetch it again, from the in-memory cache.
+    const planet p2 = p;
+    REQUIRE(p2.eph_v({0., 1000.}) == results[0]);
+    REQUIRE(misses() <= n_misses + 1u);
+}
@@ -19,7 +19,7 @@ conda config --add channels conda-forge
 # Enforce strict channel priority.
 conda config --set channel_priority strict
 # Install build and runtime dependencies.
-conda install cmake ninja c-compiler cxx-compiler "libboost>=1.73" "fmt>=10" "heyoka>=7" "heyoka.py>=7" spdlog "xtensor>=0.26" xtensor-blas pagmo-devel pygmo pybind11 sgp4 spiceypy matplotlib scipy "eigen>=3,<5" "nlopt<2.10.1"
+conda install cmake ninja c-compiler cxx-compiler "libboost>=1.73" "fmt>=10" "heyoka>=7" "heyoka.py>=7" spdlog tbb-devel "xtensor>=0.26" xtensor-blas pagmo-devel pygmo pybind11 sgp4 spiceypy matplotlib scipy "eigen>=3,<5" "nlopt<2.10.1"
 
 # Build and install kep3 + pykep.
 # Remove previous build directory if it exists.